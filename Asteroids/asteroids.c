@@ -4,13 +4,14 @@
  * Author: GeorgeET15
  * Description:
  * A simplified Asteroids-inspired game built using the Arcade Library. The
- * player controls a red square (ship) that moves left/right and shoots yellow
- * bullets to destroy gray asteroids falling from the top of the screen. The
- * goal is to score points by destroying asteroids while avoiding collisions.
- * The game features three states (Start, Playing, GameOver), a high score
- * system, and increasing difficulty (asteroid speed). All asteroids are
- * removed from the screen in GameOver state. It uses color-based sprites and
- * is cross-platform (Windows with Win32, Linux with X11).
+ * player controls a red ship that moves left/right and shoots yellow bullets
+ * to destroy spinning rocks falling from the top of the screen. The goal is
+ * to score points by destroying asteroids while avoiding collisions. The game
+ * features three states (Start, Playing, GameOver), a high score system, and
+ * increasing difficulty (asteroid speed). All asteroids are removed from the
+ * screen in GameOver state. Everything is drawn as vector shapes (filled and
+ * antialiased polygons, circles) and it is cross-platform (Windows with
+ * Win32, Linux with X11).
  *
  * Controls:
  * - Left Arrow: Move ship left (Playing state)
@@ -18,27 +19,33 @@
  * - Space: Shoot bullet (Playing state, one bullet at a time), Start game
  *         (Start state)
  * - R: Restart game (GameOver state)
+ * - Backspace (hold): Rewind up to 3 seconds (Playing and GameOver states)
  * - ESC: Quit (closes the window)
  *
  * Compilation:
+ * With make (links ../arcade's libarcade, built once for all games):
+ *   make
  * Linux:
- *   gcc -D_POSIX_C_SOURCE=199309L -o asteroids asteroids.c arcade.c -lX11 -lm
+ *   gcc -D_POSIX_C_SOURCE=199309L -o asteroids asteroids.c -I../arcade ../arcade/arcade.c -lX11 -lm -lpthread
  * Windows (MinGW):
- *   gcc -o asteroids asteroids.c arcade.c -lgdi32 -lwinmm
+ *   gcc -o asteroids asteroids.c -I../arcade ../arcade/arcade.c -lgdi32 -lwinmm -lws2_32
  * Run:
  *   Linux: ./asteroids
  *   Windows: asteroids.exe
  *
  * Dependencies:
  * - Arcade Library (arcade.h, arcade.c)
+ * - asteroids_sim.h: Play area constants, shared with the two-ship match
+ *   played on the match server
  * - STB libraries (included via arcade.c, though not used here since no
  *   image sprites)
  * - Linux: libX11, libm
  * - Windows: gdi32, winmm
  *
  * Notes:
- * - Uses color-based sprites (`ArcadeSprite`) for simplicity; image sprites
- *   could be added for better visuals.
+ * - Positions and hitboxes are color sprites (`ArcadeSprite`) that are never
+ *   drawn; the ship, bullet and rocks are drawn over them as vector shapes
+ *   with arcade_screen and arcade_present. Collisions stay box-based.
  * - Asteroid spawn rate (2% per frame) and speed increase (0.1 per asteroid
  *   destroyed, capped at 5.0) balance difficulty.
  * - High score persists in memory during a session but resets on exit.
@@ -46,20 +53,32 @@
  *   60 FPS.
  * - No audio effects; consider adding sounds for shooting, collisions, etc.
  * - In GameOver state, all asteroids are deactivated to clear the screen.
+ * - A crash flashes the screen red, fading out over a third of a second
+ *   (arcade_pixel_pass with arcade_effect_mix).
+ * - All simulation state lives in one flat GameData struct. Rewind copies it
+ *   into an ArcadeSnapshotRing every tick, and restart copies a start state
+ *   built once at startup.
+ * - The game is split into init/update/shutdown entry points
+ *   (asteroids_game), so the launcher in ../Launcher can host it; built
+ *   with -DARCADE_LAUNCHER it has no main.
  * ========================================================================= */
 
-#define ARCADE_IMPLEMENTATION
 #include "arcade.h"
+#include "asteroids_sim.h"
+#include <math.h>
 
 /* =========================================================================
  * Game Constants
  * =========================================================================
  * Define core game parameters, controlling the play area and object limits.
- * Adjust these to tweak game size or difficulty.
+ * Adjust these to tweak game size or difficulty. The play area and asteroid
+ * limit live in asteroids_sim.h, shared with the match server.
  */
-#define MAX_ASTEROIDS 5   /* Maximum number of active asteroids. Balances performance and challenge. */
-#define WINDOW_WIDTH 400  /* Window width (pixels). Narrow for focused gameplay. */
-#define WINDOW_HEIGHT 800 /* Window height (pixels). Tall to allow reaction time for falling asteroids. */
+#define REWIND_FRAMES 180 /* Ticks kept for rewind (3 seconds at 60 FPS). */
+#define ROCK_POINTS 10    /* Vertices of a rock outline. */
+#define ROCK_RADIUS_MIN 11.0f /* Closest a rock vertex lies to its center (pixels); the hitbox is 30x30. */
+#define ROCK_RADIUS_MAX 16.0f /* Farthest a rock vertex lies from its center (pixels). */
+#define ROCK_SPIN_MAX 0.04f   /* Fastest rock rotation (radians/frame at 60 FPS, either way). */
 
 /* =========================================================================
  * GameState Enum
@@ -80,65 +99,136 @@ typedef enum
 /* =========================================================================
  * Asteroid Structure
  * =========================================================================
- * Represents a single asteroid with its sprite properties.
- * - sprite: ArcadeSprite for position, size, velocity, color, and active state.
- * Note: Uses color-based sprites (gray); could use `ArcadeImageSprite` for
- * textured asteroids.
+ * Represents a single asteroid: its hitbox and the shape of its rock.
+ * - sprite: ArcadeSprite for position, size, velocity, and active state.
+ * - radius: Distance of each outline vertex from the center, for a jagged
+ *   rock; rolled when the asteroid spawns.
+ * - angle, spin: Rotation of the outline and its change per frame.
  */
 typedef struct
 {
-    ArcadeSprite sprite; /* Asteroid’s sprite (position, velocity, color) */
+    ArcadeSprite sprite;       /* Asteroid’s hitbox (position, velocity) */
+    float radius[ROCK_POINTS]; /* Outline vertex distances from the center */
+    float angle, spin;         /* Rotation (radians) and radians per frame */
 } Asteroid;
 
 /* =========================================================================
- * main Function
+ * GameData Structure
  * =========================================================================
- * Entry point for the game. Initializes the Arcade environment, sets up
- * sprites, manages the game loop, and handles cleanup. The game loop processes
- * input, updates game state, and renders the scene at ~60 FPS using
- * arcade_delta_time for frame-rate-independent movement.
- * Parameters: None.
- * Returns:
- * - 0 on successful exit.
- * - 1 if initialization fails (e.g., window creation).
- * Example:
- *   int main(void) {
- *       arcade_init(WINDOW_WIDTH, WINDOW_HEIGHT, "ARCADE: Asteroids", 0x000000);
- *       while (arcade_running() && arcade_update()) {
- *           float dt = arcade_delta_time();
- *           // Update and render game
- *       }
- *       arcade_quit();
- *       return 0;
- *   }
+ * Holds the whole simulation state of one game in a single flat struct with
+ * no pointers, so it can be copied with memcpy into the rewind ring or over
+ * a freshly built start state.
+ * - state: Current GameState.
+ * - player, bullet: Ship and its single bullet.
+ * - asteroids: Asteroid slots (active or waiting to spawn).
+ * - score: Asteroids destroyed.
+ * - asteroid_speed: Current downward speed; rises with every hit.
+ * - rng: Random stream for asteroid spawns, so rewinding replays the same
+ *   spawns.
+ * Note: high_score is session state, not game state, and stays outside so
+ * rewinding or restarting never lowers it.
+ */
+typedef struct
+{
+    GameState state;                  /* Start, Playing or GameOver */
+    ArcadeSprite player;              /* Player ship */
+    ArcadeSprite bullet;              /* Single bullet, inactive until shot */
+    Asteroid asteroids[MAX_ASTEROIDS]; /* Asteroid slots */
+    int score;                        /* Asteroids destroyed */
+    float asteroid_speed;             /* Current asteroid downward speed */
+    ArcadeRng rng;                    /* Spawn random stream */
+} GameData;
+
+/* =========================================================================
+ * shape_rock Function
+ * =========================================================================
+ * Rolls a new jagged outline and spin for an asteroid.
+ * Parameters:
+ * - asteroid: Asteroid to shape.
+ * - rng: Random stream to draw from (the game's, so rewinds replay it).
+ * Returns: None.
+ */
+static void shape_rock(Asteroid *asteroid, ArcadeRng *rng)
+{
+    for (int i = 0; i < ROCK_POINTS; i++)
+        asteroid->radius[i] = arcade_rng_float_range(rng, ROCK_RADIUS_MIN, ROCK_RADIUS_MAX);
+    asteroid->angle = arcade_rng_float_range(rng, 0.0f, 6.2831853f);
+    asteroid->spin = arcade_rng_float_range(rng, -ROCK_SPIN_MAX, ROCK_SPIN_MAX);
+}
+
+/* =========================================================================
+ * draw_game Function
+ * =========================================================================
+ * Draws one frame into the window's pixel buffer: the background, then the
+ * rocks (dark fill, antialiased outline), the bullet and the ship.
+ * Parameters:
+ * - screen: Framebuffer of the window (arcade_screen).
+ * - g: GameData to draw.
+ * Returns: None.
  * Notes:
- * - Initializes random seed for asteroid spawning.
- * - Uses arcade_sleep(16) for approximate 60 FPS; consider removing for full
- *   frame-rate independence.
- * - Cleans up sprite group and Arcade resources on exit.
- * - Prints final score and high score to console on exit.
+ * - Does not present the frame; text goes on after arcade_present.
  */
-int main(void)
+static void draw_game(ArcadeFramebuffer *screen, const GameData *g)
 {
-    /* Seed random number generator for asteroid spawning and positioning */
-    srand(time(NULL));
+    arcade_fill_rect(screen, 0, 0, screen->width, screen->height, screen->bg_color);
 
-    /* Game parameters */
-    float player_speed = 5.0f;       /* Ship’s horizontal speed (pixels/frame at 60 FPS) */
-    float bullet_speed = 30.0f;      /* Bullet’s upward speed (pixels/frame at 60 FPS, negative = up) */
-    float asteroid_speed = 2.0f;     /* Initial asteroid downward speed (pixels/frame at 60 FPS) */
-    float asteroid_speed_max = 5.0f; /* Maximum asteroid speed for difficulty cap */
-    float asteroid_speed_inc = 0.1f; /* Speed increase per asteroid destroyed */
-    int score = 0;                   /* Current player score (asteroids destroyed) */
-    int high_score = 0;              /* Highest score in session, persists across restarts */
-    char text[64];                   /* Buffer for rendering score and messages */
-    char textGameOver[64];           /* Buffer for game over message */
-    char textHighScore[64];          /* Buffer for high score message */
-    char textRestart[64];            /* Buffer for restart prompt */
-    GameState state = Start;         /* Start in Start state (shows instructions) */
+    for (int i = 0; i < MAX_ASTEROIDS; i++)
+    {
+        const Asteroid *a = &g->asteroids[i];
+        if (!a->sprite.active)
+            continue;
+        float cx = a->sprite.x + a->sprite.width / 2, cy = a->sprite.y + a->sprite.height / 2;
+        ArcadePoint rock[ROCK_POINTS];
+        for (int k = 0; k < ROCK_POINTS; k++)
+        {
+            float angle = a->angle + k * (6.2831853f / ROCK_POINTS);
+            rock[k] = (ArcadePoint){cx + a->radius[k] * cosf(angle), cy + a->radius[k] * sinf(angle)};
+        }
+        arcade_fill_polygon(screen, rock, ROCK_POINTS, 0x303030);    /* Dark gray body */
+        arcade_draw_polygon_aa(screen, rock, ROCK_POINTS, 0xB0B0B0); /* Light gray edge */
+    }
+
+    if (g->bullet.active)
+    {
+        arcade_fill_circle(screen, g->bullet.x + g->bullet.width / 2, g->bullet.y + g->bullet.height / 2,
+                           g->bullet.width / 2, 0xFFFF00); /* Yellow */
+    }
 
-    /* Initialize player sprite (red square, starts near bottom-center) */
-    ArcadeSprite player = {
+    if (g->player.active)
+    {
+        /* Arrowhead filling the hitbox, notched at the bottom */
+        const ArcadeSprite *p = &g->player;
+        ArcadePoint ship[4] = {
+            {p->x + p->width / 2, p->y},
+            {p->x + p->width, p->y + p->height},
+            {p->x + p->width / 2, p->y + p->height * 0.7f},
+            {p->x, p->y + p->height}};
+        arcade_fill_polygon(screen, ship, 4, 0x800000);    /* Dark red body */
+        arcade_draw_polygon_aa(screen, ship, 4, 0xFF4040); /* Red edge */
+    }
+}
+
+/* =========================================================================
+ * init_game Function
+ * =========================================================================
+ * Builds the start state: ship near the bottom-center, no bullet, all
+ * asteroids waiting above the screen, and the starting asteroid speed.
+ * Parameters:
+ * - g: GameData to fill.
+ * - seed: Seed of the spawn random stream.
+ * Returns: None.
+ * Notes:
+ * - Called once at startup; restarts copy the result instead of rebuilding.
+ */
+static void init_game(GameData *g, uint64_t seed)
+{
+    memset(g, 0, sizeof(*g));
+    arcade_rng_seed(&g->rng, seed);
+    g->state = Start;           /* Start in Start state (shows instructions) */
+    g->asteroid_speed = 2.0f;   /* Initial asteroid downward speed (pixels/frame at 60 FPS) */
+
+    /* Initialize player sprite (ship hitbox, starts near bottom-center) */
+    g->player = (ArcadeSprite){
         .x = WINDOW_WIDTH / 2 - 10.0f, /* Center horizontally */
         .y = WINDOW_HEIGHT - 50.0f,    /* Near bottom of screen */
         .width = 20.0f,
@@ -149,10 +239,10 @@ int main(void)
         .active = 1        /* Visible and collidable */
     };
 
-    /* Initialize bullet sprite (yellow square, inactive until shot) */
-    ArcadeSprite bullet = {
-        .x = player.x + 10.0f, /* Aligned with player’s center (updated on shoot) */
-        .y = player.y,         /* Starts at player’s top */
+    /* Initialize bullet sprite (yellow dot, inactive until shot) */
+    g->bullet = (ArcadeSprite){
+        .x = g->player.x + 10.0f, /* Aligned with player’s center (updated on shoot) */
+        .y = g->player.y,         /* Starts at player’s top */
         .width = 5.0f,
         .height = 5.0f, /* 5x5 pixel square */
         .vy = 0.0f,
@@ -161,244 +251,313 @@ int main(void)
         .active = 0        /* Inactive until Space is pressed */
     };
 
-    /* Initialize asteroids array (gray squares, initially inactive) */
-    Asteroid asteroids[MAX_ASTEROIDS];
+    /* Initialize asteroids array (rock hitboxes, initially inactive) */
     for (int i = 0; i < MAX_ASTEROIDS; i++)
     {
-        asteroids[i].sprite.x = rand() % (WINDOW_WIDTH - 30) + 15;            /* Random x within bounds */
-        asteroids[i].sprite.y = rand() % (WINDOW_HEIGHT / 2) - WINDOW_HEIGHT; /* Off-screen above */
-        asteroids[i].sprite.width = 30.0f;                                    /* 30x30 pixel square */
-        asteroids[i].sprite.height = 30.0f;
-        asteroids[i].sprite.vy = asteroid_speed; /* Initial downward speed */
-        asteroids[i].sprite.vx = 0.0f;           /* No horizontal movement */
-        asteroids[i].sprite.color = 0x808080;    /* Gray */
-        asteroids[i].sprite.active = 0;          /* Inactive until spawned */
+        ArcadeSprite *asteroid = &g->asteroids[i].sprite;
+        asteroid->x = arcade_rng_range(&g->rng, 15, WINDOW_WIDTH - 16);                    /* Random x within bounds */
+        asteroid->y = arcade_rng_range(&g->rng, -WINDOW_HEIGHT, -WINDOW_HEIGHT / 2 - 1); /* Off-screen above */
+        asteroid->width = 30.0f;                                    /* 30x30 pixel square */
+        asteroid->height = 30.0f;
+        asteroid->vy = g->asteroid_speed; /* Initial downward speed */
+        asteroid->vx = 0.0f;              /* No horizontal movement */
+        asteroid->color = 0x808080;       /* Gray */
+        asteroid->active = 0;             /* Inactive until spawned */
+        shape_rock(&g->asteroids[i], &g->rng);
     }
+}
 
-    /* Initialize sprite group for rendering */
-    SpriteGroup group;
-    arcade_init_group(&group, MAX_ASTEROIDS + 2); /* Capacity for player, bullet, asteroids */
+/* =========================================================================
+ * Session State
+ * =========================================================================
+ * What lives for the whole time the game is open: the running game, the
+ * start state restarts copy, the rewind history and the high score.
+ * - seed: Seed of the current game's spawns; every restart uses the next one.
+ * - high_score: Highest score since the program started (kept when the
+ *   launcher leaves and re-enters the game).
+ * - crash_flash: Strength of the red crash flash (0-255), fading each frame.
+ */
+static uint64_t seed;                 /* Seed for asteroid spawning; restarts count up from it */
+static int high_score = 0;            /* Highest score in session, persists across restarts */
+static GameData game, start_game;     /* Live game and the state every restart copies */
+static ArcadeSnapshotRing history;    /* Rewind history: one snapshot per Playing tick */
+static float crash_flash;             /* Red flash over the frame after a crash (0 = none) */
 
-    /* Initialize Arcade environment (window, rendering, input) */
-    if (arcade_init(WINDOW_WIDTH, WINDOW_HEIGHT, "ARCADE: Asteroids", 0x000000) != 0)
+/* =========================================================================
+ * asteroids_init Function
+ * =========================================================================
+ * Builds the start state and the rewind history once the window is open.
+ * Parameters: None.
+ * Returns:
+ * - 0 on success.
+ * - 1 if the rewind history cannot be allocated.
+ * Notes:
+ * - Seeds asteroid spawning from the clock.
+ */
+static int asteroids_init(void)
+{
+    seed = (uint64_t)time(NULL);
+
+    /* Build the start state once; the game and every restart copy it */
+    init_game(&start_game, seed);
+    game = start_game;
+    crash_flash = 0.0f;
+
+    if (arcade_snapshot_ring_init(&history, sizeof(GameData), REWIND_FRAMES) != 0)
     {
-        arcade_free_group(&group);
-        fprintf(stderr, "Initialization failed\n");
-        return 1; /* Exit if window creation fails */
+        fprintf(stderr, "Rewind history allocation failed\n");
+        return 1;
     }
+    return 0;
+}
 
-    /* Main game loop: runs until window is closed or ESC is pressed */
-    while (arcade_running() && arcade_update())
+/* =========================================================================
+ * asteroids_update Function
+ * =========================================================================
+ * Runs one frame: draws the scene, then handles input and game logic for
+ * the current state, using arcade_delta_time for frame-rate-independent
+ * movement.
+ * Parameters: None.
+ * Returns: 1 (the game only ends when its window closes).
+ */
+static int asteroids_update(void)
+{
+    /* Game parameters */
+    float player_speed = 5.0f;       /* Ship’s horizontal speed (pixels/frame at 60 FPS) */
+    float bullet_speed = 30.0f;      /* Bullet’s upward speed (pixels/frame at 60 FPS, negative = up) */
+    float asteroid_speed_max = 5.0f; /* Maximum asteroid speed for difficulty cap */
+    float asteroid_speed_inc = 0.1f; /* Speed increase per asteroid destroyed */
+    char text[64];                   /* Buffer for rendering score and messages */
+    char textGameOver[64];           /* Buffer for game over message */
+    char textHighScore[64];          /* Buffer for high score message */
+    char textRestart[64];            /* Buffer for restart prompt */
+
+    /* Get delta time for frame-rate-independent movement */
+    float delta_time = arcade_delta_time();
+    float scale = delta_time * 60.0f; /* Normalize to 60 FPS */
+
+    /* Update score display (rendered every frame) */
+    snprintf(text, sizeof(text), "Score: %d", game.score);
+
+    /* Draw the frame into the window's pixels, then show it */
+    ArcadeFramebuffer screen = arcade_screen();
+    draw_game(&screen, &game);
+    if (crash_flash > 0.0f)
     {
-        /* Get delta time for frame-rate-independent movement */
-        float delta_time = arcade_delta_time();
-        float scale = delta_time * 60.0f; /* Normalize to 60 FPS */
+        arcade_pixel_pass(arcade_effect_mix, &(ArcadeMix){0xFF0000, (int)crash_flash});
+        crash_flash -= 12.0f * scale; /* Gone in about 20 frames */
+    }
+    arcade_present();
+    arcade_render_text(text, 10.0f, 30.0f, 0xFFFFFF); /* Score in top-left (white) */
 
-        /* Update score display (rendered every frame) */
-        snprintf(text, sizeof(text), "Score: %d", score);
+    /* Handle game logic based on current state */
+    switch (game.state)
+    {
+    case Start:
+        /* Show blinking start prompt and high score */
+        arcade_render_text_centered_blink("Press Space to Start", WINDOW_HEIGHT / 2.0f, 0xFFFFFF, 30); /* Blinks every 0.5s */
+        snprintf(text, sizeof(text), "High Score: %d", high_score);
+        arcade_render_text_centered(text, WINDOW_HEIGHT / 2.0f + 50.0f, 0xFFFFFF); /* High score below prompt */
+        if (arcade_key_pressed_once(a_space) == 2)
+        {
+            arcade_clear_keys(); /* Clear input to prevent immediate shoot */
+            game.state = Playing;     /* Transition to gameplay */
+        }
+        break;
 
-        /* Reset sprite group to rebuild with active sprites */
-        group.count = 0;
+    case Playing:
+        /* Hold Backspace to rewind: step back one tick per frame instead of simulating */
+        if (arcade_key_pressed(a_backspace) == 2 && arcade_snapshot_pop(&history, &game) == 0)
+        {
+            break;
+        }
+        arcade_snapshot_push(&history, &game); /* Record the state this tick starts from */
 
-        /* Add active sprites to render group (player, bullet, asteroids) */
-        if (player.active)
+        /* Handle player movement (left/right arrow keys) */
+        if (arcade_key_pressed(a_right) == 2 && game.player.active)
         {
-            arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = player}, SPRITE_COLOR);
+            game.player.vx = player_speed; /* Set rightward velocity */
         }
-        if (bullet.active)
+        else if (arcade_key_pressed(a_left) == 2 && game.player.active)
         {
-            arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = bullet}, SPRITE_COLOR);
+            game.player.vx = -player_speed; /* Set leftward velocity */
         }
-        for (int i = 0; i < MAX_ASTEROIDS; i++)
+        else
         {
-            if (asteroids[i].sprite.active)
-            {
-                arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = asteroids[i].sprite}, SPRITE_COLOR);
-            }
+            game.player.vx = 0.0f; /* Stop movement */
         }
 
-        /* Render the scene (clears screen, draws sprites, updates window) */
-        arcade_render_group(&group);
-        arcade_render_text(text, 10.0f, 30.0f, 0xFFFFFF); /* Score in top-left (white) */
-
-        /* Handle game logic based on current state */
-        switch (state)
+        /* Update player position and clamp to window bounds */
+        if (game.player.active)
         {
-        case Start:
-            /* Show blinking start prompt and high score */
-            arcade_render_text_centered_blink("Press Space to Start", WINDOW_HEIGHT / 2.0f, 0xFFFFFF, 30); /* Blinks every 0.5s */
-            snprintf(text, sizeof(text), "High Score: %d", high_score);
-            arcade_render_text_centered(text, WINDOW_HEIGHT / 2.0f + 50.0f, 0xFFFFFF); /* High score below prompt */
-            if (arcade_key_pressed_once(a_space) == 2)
+            game.player.x += game.player.vx * scale; /* Scale movement by delta time */
+            if (game.player.x < 0)
             {
-                arcade_clear_keys(); /* Clear input to prevent immediate shoot */
-                state = Playing;     /* Transition to gameplay */
+                game.player.x = 0; /* Prevent moving off left edge */
             }
-            break;
-
-        case Playing:
-            /* Handle player movement (left/right arrow keys) */
-            if (arcade_key_pressed(a_right) == 2 && player.active)
+            else if (game.player.x + game.player.width > WINDOW_WIDTH)
             {
-                player.vx = player_speed; /* Set rightward velocity */
-            }
-            else if (arcade_key_pressed(a_left) == 2 && player.active)
-            {
-                player.vx = -player_speed; /* Set leftward velocity */
-            }
-            else
-            {
-                player.vx = 0.0f; /* Stop movement */
+                game.player.x = WINDOW_WIDTH - game.player.width; /* Prevent moving off right edge */
             }
+        }
 
-            /* Update player position and clamp to window bounds */
-            if (player.active)
-            {
-                player.x += player.vx * scale; /* Scale movement by delta time */
-                if (player.x < 0)
-                {
-                    player.x = 0; /* Prevent moving off left edge */
-                }
-                else if (player.x + player.width > WINDOW_WIDTH)
-                {
-                    player.x = WINDOW_WIDTH - player.width; /* Prevent moving off right edge */
-                }
-            }
+        /* Handle shooting (Space key, one bullet at a time) */
+        if (arcade_key_pressed_once(a_space) == 2 && game.player.active && !game.bullet.active)
+        {
+            game.bullet.x = game.player.x + game.player.width / 2 - game.bullet.width / 2; /* Center bullet on player */
+            game.bullet.y = game.player.y;                                       /* Start at player’s top */
+            game.bullet.vy = -bullet_speed;                                 /* Move upward */
+            game.bullet.active = 1;                                         /* Activate bullet */
+            /* Note: Could add shooting sound here (e.g., arcade_play_sound("shoot.wav")) */
+        }
 
-            /* Handle shooting (Space key, one bullet at a time) */
-            if (arcade_key_pressed_once(a_space) == 2 && player.active && !bullet.active)
+        /* Update bullet position */
+        if (game.bullet.active)
+        {
+            game.bullet.y += game.bullet.vy * scale; /* Scale movement by delta time */
+            if (game.bullet.y < 0)
             {
-                bullet.x = player.x + player.width / 2 - bullet.width / 2; /* Center bullet on player */
-                bullet.y = player.y;                                       /* Start at player’s top */
-                bullet.vy = -bullet_speed;                                 /* Move upward */
-                bullet.active = 1;                                         /* Activate bullet */
-                /* Note: Could add shooting sound here (e.g., arcade_play_sound("shoot.wav")) */
+                game.bullet.active = 0; /* Deactivate when off-screen */
             }
+        }
 
-            /* Update bullet position */
-            if (bullet.active)
-            {
-                bullet.y += bullet.vy * scale; /* Scale movement by delta time */
-                if (bullet.y < 0)
-                {
-                    bullet.active = 0; /* Deactivate when off-screen */
-                }
+        /* Update and spawn asteroids */
+        for (int i = 0; i < MAX_ASTEROIDS; i++)
+        {
+            if (!game.asteroids[i].sprite.active && arcade_rng_below(&game.rng, 100) < 2)
+            {                                                                                /* 2% spawn chance per frame */
+                game.asteroids[i].sprite.x = arcade_rng_range(&game.rng, 15, WINDOW_WIDTH - 16); /* Random x within bounds */
+                game.asteroids[i].sprite.y = -30.0f;                            /* Start above screen */
+                game.asteroids[i].sprite.vy = game.asteroid_speed;                   /* Current downward speed */
+                game.asteroids[i].sprite.active = 1;                            /* Activate asteroid */
+                shape_rock(&game.asteroids[i], &game.rng);                      /* New rock outline */
             }
 
-            /* Update and spawn asteroids */
-            for (int i = 0; i < MAX_ASTEROIDS; i++)
+            if (game.asteroids[i].sprite.active)
             {
-                if (!asteroids[i].sprite.active && rand() % 100 < 2)
-                {                                                              /* 2% spawn chance per frame */
-                    asteroids[i].sprite.x = rand() % (WINDOW_WIDTH - 30) + 15; /* Random x within bounds */
-                    asteroids[i].sprite.y = -30.0f;                            /* Start above screen */
-                    asteroids[i].sprite.vy = asteroid_speed;                   /* Current downward speed */
-                    asteroids[i].sprite.active = 1;                            /* Activate asteroid */
-                }
-
-                if (asteroids[i].sprite.active)
+                game.asteroids[i].sprite.y += game.asteroids[i].sprite.vy * scale; /* Scale movement by delta time */
+                game.asteroids[i].angle += game.asteroids[i].spin * scale;         /* Tumble */
+                if (game.asteroids[i].sprite.y > WINDOW_HEIGHT)
                 {
-                    asteroids[i].sprite.y += asteroids[i].sprite.vy * scale; /* Scale movement by delta time */
-                    if (asteroids[i].sprite.y > WINDOW_HEIGHT)
-                    {
-                        asteroids[i].sprite.active = 0; /* Deactivate when off-screen */
-                    }
+                    game.asteroids[i].sprite.active = 0; /* Deactivate when off-screen */
                 }
             }
+        }
 
-            /* Collision detection: Bullet vs. Asteroids */
-            if (bullet.active)
+        /* Collision detection: Bullet vs. Asteroids */
+        if (game.bullet.active)
+        {
+            for (int i = 0; i < MAX_ASTEROIDS; i++)
             {
-                for (int i = 0; i < MAX_ASTEROIDS; i++)
+                if (arcade_check_collision(&game.bullet, &game.asteroids[i].sprite))
                 {
-                    if (arcade_check_collision(&bullet, &asteroids[i].sprite))
+                    game.asteroids[i].sprite.active = 0; /* Destroy asteroid */
+                    game.bullet.active = 0;              /* Destroy bullet */
+                    game.score++;                        /* Increment score */
+                    if (game.score > high_score)
+                        high_score = game.score;               /* Update high score */
+                    game.asteroid_speed += asteroid_speed_inc; /* Increase difficulty */
+                    if (game.asteroid_speed > asteroid_speed_max)
                     {
-                        asteroids[i].sprite.active = 0; /* Destroy asteroid */
-                        bullet.active = 0;              /* Destroy bullet */
-                        score++;                        /* Increment score */
-                        if (score > high_score)
-                            high_score = score;               /* Update high score */
-                        asteroid_speed += asteroid_speed_inc; /* Increase difficulty */
-                        if (asteroid_speed > asteroid_speed_max)
-                        {
-                            asteroid_speed = asteroid_speed_max; /* Cap speed */
-                        }
-                        /* Note: Could add explosion sound here (e.g., arcade_play_sound("explode.wav")) */
-                        break; /* Stop checking after first hit */
+                        game.asteroid_speed = asteroid_speed_max; /* Cap speed */
                     }
-                }
-            }
-
-            /* Collision detection: Player vs. Asteroids */
-            for (int i = 0; i < MAX_ASTEROIDS; i++)
-            {
-                if (arcade_check_collision(&player, &asteroids[i].sprite))
-                {
-                    player.active = 0; /* Disable player */
-                    state = GameOver;  /* End game */
-                    /* Note: Could add crash sound here (e.g., arcade_play_sound("crash.wav")) */
+                    /* Note: Could add explosion sound here (e.g., arcade_play_sound("explode.wav")) */
                     break; /* Stop checking after first hit */
                 }
             }
-            break;
+        }
 
-        case GameOver:
-            /* Deactivate all asteroids to clear the screen */
-            for (int i = 0; i < MAX_ASTEROIDS; i++)
+        /* Collision detection: Player vs. Asteroids */
+        for (int i = 0; i < MAX_ASTEROIDS; i++)
+        {
+            if (arcade_check_collision(&game.player, &game.asteroids[i].sprite))
             {
-                asteroids[i].sprite.active = 0; /* Remove asteroid from rendering and updates */
+                game.player.active = 0; /* Disable player */
+                game.state = GameOver;  /* End game */
+                crash_flash = 224.0f;   /* Flash the screen red */
+                /* Note: Could add crash sound here (e.g., arcade_play_sound("crash.wav")) */
+                break; /* Stop checking after first hit */
             }
+        }
+        break;
 
-            /* Show game over message with current score, high score, and restart prompt */
-            snprintf(textGameOver, sizeof(textGameOver), "Game Over! Score: %d", score);
-            snprintf(textHighScore, sizeof(textHighScore), "High Score: %d", high_score);
-            snprintf(textRestart, sizeof(textRestart), "Press R to restart");
-            arcade_render_text_centered(textGameOver, WINDOW_HEIGHT / 2.7f, 0xFFFFFF);  /* Slightly higher for spacing */
-            arcade_render_text_centered(textHighScore, WINDOW_HEIGHT / 2.2f, 0xFFFFFF); /* Adjusted for even spacing */
-            arcade_render_text_centered(textRestart, WINDOW_HEIGHT / 1.7f, 0xFFFFFF);   /* Lower for better separation */
-
-            /* Handle restart input */
-            if (arcade_key_pressed_once(a_r) == 2)
-            {
-                arcade_clear_keys(); /* Clear input to prevent immediate actions */
-
-                /* Reset player */
-                player.x = WINDOW_WIDTH / 2 - 10.0f; /* Center horizontally */
-                player.y = WINDOW_HEIGHT - 50.0f;    /* Near bottom */
-                player.vx = 0.0f;
-                player.vy = 0.0f;
-                player.active = 1; /* Re-enable player */
-
-                /* Reset bullet */
-                bullet.active = 0;
-                bullet.vy = 0.0f;
+    case GameOver:
+        /* Deactivate all asteroids to clear the screen */
+        for (int i = 0; i < MAX_ASTEROIDS; i++)
+        {
+            game.asteroids[i].sprite.active = 0; /* Remove asteroid from rendering and updates */
+        }
 
-                /* Reset asteroids */
-                for (int i = 0; i < MAX_ASTEROIDS; i++)
-                {
-                    asteroids[i].sprite.x = rand() % (WINDOW_WIDTH - 30) + 15;
-                    asteroids[i].sprite.y = rand() % (WINDOW_HEIGHT / 2) - WINDOW_HEIGHT; /* Off-screen above */
-                    asteroids[i].sprite.vy = asteroid_speed;
-                    asteroids[i].sprite.active = 0; /* Inactive until spawned */
-                }
+        /* Show game over message with current score, high score, and restart prompt */
+        snprintf(textGameOver, sizeof(textGameOver), "Game Over! Score: %d", game.score);
+        snprintf(textHighScore, sizeof(textHighScore), "High Score: %d", high_score);
+        snprintf(textRestart, sizeof(textRestart), "Press R to restart");
+        arcade_render_text_centered(textGameOver, WINDOW_HEIGHT / 2.7f, 0xFFFFFF);  /* Slightly higher for spacing */
+        arcade_render_text_centered(textHighScore, WINDOW_HEIGHT / 2.2f, 0xFFFFFF); /* Adjusted for even spacing */
+        arcade_render_text_centered(textRestart, WINDOW_HEIGHT / 1.7f, 0xFFFFFF);   /* Lower for better separation */
 
-                /* Reset game state */
-                score = 0;             /* Reset score (high_score persists) */
-                asteroid_speed = 2.0f; /* Reset difficulty */
-                state = Playing;       /* Restart gameplay */
-            }
+        /* Hold Backspace to rewind back into the lost game */
+        if (arcade_key_pressed(a_backspace) == 2 && arcade_snapshot_pop(&history, &game) == 0)
+        {
             break;
         }
 
-        /* Sleep for ~16ms to target 60 FPS (optional) */
-        arcade_sleep(16);
+        /* Handle restart input */
+        if (arcade_key_pressed_once(a_r) == 2)
+        {
+            arcade_clear_keys(); /* Clear input to prevent immediate actions */
+
+            /* Reset to the start state (high_score persists) */
+            game = start_game;
+            arcade_rng_seed(&game.rng, ++seed);   /* New asteroids every game */
+            arcade_snapshot_ring_clear(&history); /* Nothing to rewind into */
+            game.state = Playing; /* Restart gameplay */
+        }
+        break;
     }
 
-    /* Clean up resources before exit */
-    arcade_free_group(&group); /* Free sprite group */
-    arcade_quit();             /* Close window and release Arcade resources */
+    return 1;
+}
 
-    /* Print final score and high score to console */
-    printf("Game Over! Final Score: %d, High Score: %d\n", score, high_score);
-    return 0;
-}
\ No newline at end of file
+/* =========================================================================
+ * asteroids_shutdown Function
+ * =========================================================================
+ * Frees the rewind history and prints the final score and high score.
+ * Parameters: None.
+ * Returns: None.
+ */
+static void asteroids_shutdown(void)
+{
+    arcade_snapshot_ring_free(&history); /* Free rewind history */
+    printf("Game Over! Final Score: %d, High Score: %d\n", game.score, high_score);
+}
+
+/* Entry points, for main and for the launcher (Launcher/launcher.c) */
+const ArcadeGame asteroids_game = {"ARCADE: Asteroids", WINDOW_WIDTH, WINDOW_HEIGHT, 0x000000,
+                                   asteroids_init, asteroids_update, asteroids_shutdown};
+
+/* =========================================================================
+ * main Function
+ * =========================================================================
+ * Entry point for the game on its own. arcade_run_game opens the window,
+ * calls asteroids_init, then asteroids_update once per frame until the
+ * window is closed, and cleans up with asteroids_shutdown.
+ * Parameters: None.
+ * Returns:
+ * - 0 on successful exit.
+ * - 1 if initialization fails (e.g., window creation).
+ * Example:
+ *   int main(void) {
+ *       return arcade_run_game(&asteroids_game);
+ *   }
+ * Notes:
+ * - Paces frames with arcade_wait_frame: 60 FPS unless the performance
+ *   section of arcade.config.json says otherwise.
+ * - Left out when built into the launcher (ARCADE_LAUNCHER).
+ */
+#ifndef ARCADE_LAUNCHER
+int main(void)
+{
+    return arcade_run_game(&asteroids_game);
+}
+#endif
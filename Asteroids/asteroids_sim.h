@@ -0,0 +1,219 @@
+/* =========================================================================
+ * Asteroids - Match Simulation
+ * =========================================================================
+ * Author: GeorgeET15
+ * Description:
+ * A two-ship Asteroids match for the headless match server (Server/). Both
+ * ships share the screen and the falling asteroids, each scores for the
+ * asteroids it shoots, and the match ends when both ships are hit. The rules
+ * and numbers are those of the single-player game, but everything advances in
+ * fixed 60 FPS steps with its own random stream, so a match is fully
+ * determined by its seed and inputs.
+ *
+ * Usage:
+ *   #include "arcade.h"
+ *   #include "asteroids_sim.h"
+ *   AsteroidsMatch match;
+ *   init_asteroids_match(&match, 1234);
+ *   uint8_t inputs[2] = {MATCH_FIRE, MATCH_LEFT};
+ *   step_asteroids_match(&match, inputs); // One 60 FPS frame
+ *
+ * Notes:
+ * - Only needs the arcade.h declarations (ArcadeSprite, ArcadeRng,
+ *   arcade_check_collision).
+ * - Functions are static so the header can be included by several programs
+ *   without a separate object file.
+ * ========================================================================= */
+
+#ifndef ASTEROIDS_SIM_H
+#define ASTEROIDS_SIM_H
+
+#include "arcade.h"
+
+/* =========================================================================
+ * Game Constants
+ * =========================================================================
+ * Play area and asteroid limit (shared with the single-player game) and the
+ * rules of a match.
+ */
+#define MAX_ASTEROIDS 5   /* Maximum number of active asteroids. Balances performance and challenge. */
+#define WINDOW_WIDTH 400  /* Window width (pixels). Narrow for focused gameplay. */
+#define WINDOW_HEIGHT 800 /* Window height (pixels). Tall to allow reaction time for falling asteroids. */
+#define MATCH_SHIP_SPEED 5.0f       /* Ship speed (pixels/frame). */
+#define MATCH_BULLET_SPEED 30.0f    /* Bullet speed (pixels/frame, upward). */
+#define MATCH_ASTEROID_SPEED 2.0f   /* Starting asteroid speed (pixels/frame). */
+#define MATCH_ASTEROID_MAX 5.0f     /* Asteroid speed cap. */
+#define MATCH_ASTEROID_INC 0.1f     /* Asteroid speed gained per asteroid destroyed. */
+#define MATCH_SPAWN_PERCENT 2       /* Chance per frame that a free asteroid slot spawns. */
+#define MATCH_LEFT 1                /* Input bit: move left. */
+#define MATCH_RIGHT 2               /* Input bit: move right. */
+#define MATCH_FIRE 4                /* Input bit: shoot (one bullet per ship at a time). */
+#define MATCH_RESTART 8             /* Input bit: start a new match once one is over. */
+#define MATCH_DRAW 2                /* AsteroidsMatch.winner when both scored the same. */
+
+/* =========================================================================
+ * AsteroidsMatch Structure
+ * =========================================================================
+ * Whole state of a two-ship match, flat and pointer-free so it can be
+ * snapshotted and sent as a delta.
+ * - ships, bullets: Player 0 (red) and player 1 (blue) and their bullets.
+ * - asteroids: Asteroid slots (active or waiting to spawn).
+ * - score: Asteroids destroyed per player.
+ * - asteroid_speed: Current downward speed; rises with every hit.
+ * - rng: Random stream for asteroid spawns.
+ * - frame: Frames played since the match started.
+ * - winner: -1 while either ship flies, else the winning player or MATCH_DRAW.
+ */
+typedef struct
+{
+    ArcadeSprite ships[2];                /* Player ships */
+    ArcadeSprite bullets[2];              /* One bullet per ship */
+    ArcadeSprite asteroids[MAX_ASTEROIDS]; /* Asteroid slots */
+    int score[2];                         /* Asteroids destroyed per player */
+    float asteroid_speed;                 /* Current asteroid downward speed */
+    ArcadeRng rng;                        /* Spawn random stream */
+    uint32_t frame;                       /* Frames since the match started */
+    int winner;                           /* -1, player number or MATCH_DRAW */
+} AsteroidsMatch;
+
+/* =========================================================================
+ * init_asteroids_match Function
+ * =========================================================================
+ * Builds the start of a match: both ships near the bottom, no bullets, all
+ * asteroids waiting above the screen.
+ * Parameters:
+ * - m: AsteroidsMatch to fill.
+ * - seed: Seed for asteroid spawns (any value).
+ * Returns: None.
+ */
+static void init_asteroids_match(AsteroidsMatch *m, uint32_t seed)
+{
+    memset(m, 0, sizeof(*m));
+    arcade_rng_seed(&m->rng, seed);
+    m->asteroid_speed = MATCH_ASTEROID_SPEED;
+    m->winner = -1;
+    for (int p = 0; p < 2; p++)
+    {
+        m->ships[p] = (ArcadeSprite){
+            .x = WINDOW_WIDTH * (p + 1) / 3.0f - 10.0f, /* Thirds of the screen */
+            .y = WINDOW_HEIGHT - 50.0f,
+            .width = 20.0f,
+            .height = 20.0f,
+            .color = p == 0 ? 0xFF0000 : 0x0080FF, /* Red and blue */
+            .active = 1};
+        m->bullets[p] = (ArcadeSprite){
+            .width = 5.0f,
+            .height = 5.0f,
+            .color = 0xFFFF00, /* Yellow */
+            .active = 0};
+    }
+    for (int i = 0; i < MAX_ASTEROIDS; i++)
+    {
+        m->asteroids[i] = (ArcadeSprite){
+            .width = 30.0f,
+            .height = 30.0f,
+            .color = 0x808080, /* Gray */
+            .active = 0};
+    }
+}
+
+/* =========================================================================
+ * step_asteroids_match Function
+ * =========================================================================
+ * Advances a match by one fixed 60 FPS frame (ArcadeStepFunc).
+ * Parameters:
+ * - state: AsteroidsMatch to advance.
+ * - inputs: Input bits (MATCH_LEFT, MATCH_RIGHT, MATCH_FIRE, MATCH_RESTART)
+ *   per player.
+ * Returns: None.
+ * Notes:
+ * - Deterministic: no delta time, rand() or clocks.
+ */
+static void step_asteroids_match(void *state, const uint8_t *inputs)
+{
+    AsteroidsMatch *m = state;
+
+    if (m->winner >= 0)
+    {
+        if ((inputs[0] | inputs[1]) & MATCH_RESTART)
+            init_asteroids_match(m, arcade_rng_next(&m->rng)); /* Next match continues the sequence */
+        return;
+    }
+    m->frame++;
+
+    /* Ships and shooting */
+    for (int p = 0; p < 2; p++)
+    {
+        ArcadeSprite *ship = &m->ships[p];
+        ArcadeSprite *bullet = &m->bullets[p];
+        if (ship->active)
+        {
+            ship->vx = ((inputs[p] & MATCH_RIGHT) ? MATCH_SHIP_SPEED : 0.0f) - ((inputs[p] & MATCH_LEFT) ? MATCH_SHIP_SPEED : 0.0f);
+            ship->x += ship->vx;
+            if (ship->x < 0)
+                ship->x = 0;
+            else if (ship->x + ship->width > WINDOW_WIDTH)
+                ship->x = WINDOW_WIDTH - ship->width;
+
+            if ((inputs[p] & MATCH_FIRE) && !bullet->active)
+            {
+                bullet->x = ship->x + ship->width / 2 - bullet->width / 2;
+                bullet->y = ship->y;
+                bullet->vy = -MATCH_BULLET_SPEED;
+                bullet->active = 1;
+            }
+        }
+        if (bullet->active)
+        {
+            bullet->y += bullet->vy;
+            if (bullet->y < 0)
+                bullet->active = 0;
+        }
+    }
+
+    /* Spawn and move asteroids */
+    for (int i = 0; i < MAX_ASTEROIDS; i++)
+    {
+        ArcadeSprite *asteroid = &m->asteroids[i];
+        if (!asteroid->active && arcade_rng_below(&m->rng, 100) < MATCH_SPAWN_PERCENT)
+        {
+            asteroid->x = (float)arcade_rng_range(&m->rng, 15, WINDOW_WIDTH - 16);
+            asteroid->y = -30.0f;
+            asteroid->vy = m->asteroid_speed;
+            asteroid->active = 1;
+        }
+        if (asteroid->active)
+        {
+            asteroid->y += asteroid->vy;
+            if (asteroid->y > WINDOW_HEIGHT)
+                asteroid->active = 0;
+        }
+    }
+
+    /* Bullets destroy asteroids; ships are destroyed by them */
+    for (int p = 0; p < 2; p++)
+    {
+        for (int i = 0; i < MAX_ASTEROIDS && m->bullets[p].active; i++)
+        {
+            if (arcade_check_collision(&m->bullets[p], &m->asteroids[i]))
+            {
+                m->asteroids[i].active = 0;
+                m->bullets[p].active = 0;
+                m->score[p]++;
+                m->asteroid_speed += MATCH_ASTEROID_INC;
+                if (m->asteroid_speed > MATCH_ASTEROID_MAX)
+                    m->asteroid_speed = MATCH_ASTEROID_MAX;
+            }
+        }
+        for (int i = 0; i < MAX_ASTEROIDS && m->ships[p].active; i++)
+        {
+            if (arcade_check_collision(&m->ships[p], &m->asteroids[i]))
+                m->ships[p].active = 0;
+        }
+    }
+
+    if (!m->ships[0].active && !m->ships[1].active)
+        m->winner = m->score[0] == m->score[1] ? MATCH_DRAW : (m->score[0] > m->score[1] ? 0 : 1);
+}
+
+#endif
@@ -18,25 +18,33 @@
  * - Space: Jump (Playing state), Start game (Start state)
  * - P: Pause/Unpause (Playing/Paused states)
  * - R: Restart game (GameOver state)
+ * - Backspace (hold): Rewind up to 3 seconds (Playing and GameOver states)
  * - ESC: Quit (closes the window)
  *
  * Compilation:
+ * With make (links ../arcade's libarcade, built once for all games):
+ *   make
  * Linux:
- *   gcc -D_POSIX_C_SOURCE=199309L -o flappy flappybird.c arcade.c -lX11 -lm
+ *   gcc -D_POSIX_C_SOURCE=199309L -o flappy flappybird.c -I../arcade ../arcade/arcade.c -lX11 -lm -lpthread
+ * Linux (XRender backend, or make XRENDER=1):
+ *   gcc -DARCADE_XRENDER -o flappy flappybird.c -I../arcade ../arcade/arcade.c -lX11 -lXrender -lm -lpthread
  * Windows (MinGW):
- *   gcc -o flappy flappybird.c arcade.c -lgdi32 -lwinmm
+ *   gcc -o flappy flappybird.c -I../arcade ../arcade/arcade.c -lgdi32 -lwinmm -lws2_32
  * Run:
  *   Linux: ./flappy
  *   Windows: flappy.exe
  * Ensure sprite files are in ./assets/sprites/ and audio files in ./assets/audio/.
  *
  * Sprite Files (relative to executable):
- * - background.png: ~800x600 PNG, game background
- * - bluebird.png: ~40x40 PNG, bird frame 1 (upflap)
- * - bluebird-midflap.png: ~40x40 PNG, bird frame 2 (midflap)
- * - bluebird-downflap.png: ~40x40 PNG, bird frame 3 (downflap)
- * - pipe-top.png: ~50xvariable PNG, top pipe
- * - pipe-bottom.png: ~50xvariable PNG, bottom pipe
+ * - background.qoi: ~288x512 QOI, game background (repeated as a slow parallax layer)
+ * - base.qoi: ~336x112 QOI, ground strip (scrolls with the pipes)
+ * - bluebird.qoi: ~40x40 QOI, bird frame 1 (upflap)
+ * - bluebird-midflap.qoi: ~40x40 QOI, bird frame 2 (midflap)
+ * - bluebird-downflap.qoi: ~40x40 QOI, bird frame 3 (downflap)
+ * - pipe-top.png: ~50x320 PNG, top pipe (cap at the bottom edge)
+ * - pipe-bottom.png: ~50x320 PNG, bottom pipe (cap at the top edge)
+ * Each .qoi is converted from the .png beside it (make qoi in ../arcade after editing one);
+ * the pipes stay PNG, which loads faster than QOI for them.
  *
  * Audio Files (relative to executable):
  * - sfx_wing.wav: Sound for bird jump
@@ -55,13 +63,19 @@
  * - Sprite paths are hardcoded; ensure files exist in ./assets/sprites/.
  * - Uses arcade_delta_time for frame-rate-independent movement, scaled to 60 FPS.
  * - High score persists in memory during a session but resets on exit.
- * - arcade_sleep(16) targets ~60 FPS; consider removing for full frame-rate
- *   independence.
+ * - arcade_wait_frame paces the loop (60 FPS by default; see the performance
+ *   section of arcade.config.json).
  * - Dynamic pipe speed increases difficulty; capped to maintain playability.
  * - Animation runs at ~6 FPS (10-frame interval) for smooth flapping.
+ * - All simulation state lives in one flat GameData struct (bird, pipe pairs,
+ *   timers, score). Sprites are loaded once and only positioned from that
+ *   state when rendering, so rewind (an ArcadeSnapshotRing of GameData) and
+ *   restart (a copy of the start state) never load or free images.
+ * - The game is split into init/update/shutdown entry points
+ *   (flappybird_game), so the launcher in ../Launcher can host it; built
+ *   with -DARCADE_LAUNCHER it has no main.
  * ========================================================================= */
 
-#define ARCADE_IMPLEMENTATION
 #include "arcade.h"
 
 /* =========================================================================
@@ -70,10 +84,29 @@
  * Define core game parameters, balancing gameplay difficulty and visuals.
  * Adjust these to tweak the game’s feel (e.g., pipe gap, spawn frequency).
  */
-#define MAX_PIPES 6      /* Maximum number of pipe pairs (top + bottom). Limits memory usage and rendering load. */
-#define PIPE_WIDTH 50.0f /* Width of each pipe sprite (pixels). Matches sprite dimensions for accurate collisions. */
-#define PIPE_GAP 135.0f  /* Vertical gap between top and bottom pipes (pixels). Adjust for difficulty. */
-#define SPAWN_FRAMES 120 /* Frames between pipe spawns (~2 seconds at 60 FPS). Controls pipe frequency. */
+#define WINDOW_WIDTH 800          /* Window width (pixels), filled by the repeating background layer. */
+#define WINDOW_HEIGHT 600         /* Window height (pixels), defines play area for bird and pipes. */
+#define MAX_PIPES 3               /* Maximum number of pipe pairs on screen. Limits memory usage and rendering load. */
+#define PIPE_WIDTH 50.0f          /* Width of each pipe sprite (pixels). Matches sprite dimensions for accurate collisions. */
+#define PIPE_GAP 135.0f           /* Vertical gap between top and bottom pipes (pixels). Adjust for difficulty. */
+#define SPAWN_MS 2000             /* Game time between pipe spawns (ms). Controls pipe frequency. */
+#define FIRST_SPAWN_MS 1000       /* Game time before the first pipe spawn (ms). */
+#define MAX_TIMERS 4              /* Timers running at once in one game. */
+#define EVENT_SPAWN_PIPE 1        /* Timer event: spawn a pipe pair. */
+#define PIPE_TOP_HEIGHT 350.0f    /* Loaded height of the top pipe sprite; covers the lowest gap (y = 349). */
+#define PIPE_BOTTOM_HEIGHT 265.0f /* Loaded height of the bottom pipe sprite; reaches the ground from the highest gap. */
+#define GROUND_HEIGHT 56          /* Height of the scrolling ground strip (pixels). The bird crashes on its top edge. */
+#define GROUND_IMAGE_WIDTH 168    /* base.png loaded at half size (336x112 -> 168x56), repeated across the window. */
+#define BACKGROUND_IMAGE_WIDTH 338 /* background.png (288x512) scaled to the window height, repeated across it. */
+#define BACKGROUND_PARALLAX 0.25f /* Background scroll per pixel the pipes move; far away, so slower. */
+#define BIRD_X 100.0f             /* Bird's fixed x-position (pixels, left side). */
+#define BIRD_START_Y 300.0f       /* Bird's starting y-position (pixels, vertical center). */
+#define BIRD_SIZE 40.0f           /* Bird width/height (pixels). */
+#define BIRD_FRAMES 3             /* Frames in the flapping animation. */
+#define BIRD_FRAME_INTERVAL 10    /* Ticks between animation frames (~6 FPS). */
+#define REWIND_FRAMES 180         /* Ticks kept for rewind (3 seconds at 60 FPS). */
+#define CRASH_FLASH_TICKS 8       /* Ticks the bird flashes white after crashing. */
+#define CRASH_FADE_TICKS 40       /* Ticks it then takes to fade out. */
 
 /* =========================================================================
  * GameState Enum
@@ -94,324 +127,521 @@ typedef enum
 } GameState;
 
 /* =========================================================================
- * Pipe Structure
+ * PipePair Structure
  * =========================================================================
- * Represents a single pipe (top or bottom) with its sprite and scoring state.
- * - sprite: ArcadeImageSprite for rendering and movement.
- * - scored: Flag (0 or 1) to track if the pipe pair has been scored, preventing
+ * Represents a pair of pipes (top and bottom) sharing one gap.
+ * - x: Left edge of both pipes (pixels).
+ * - gap_y: Top of the gap; the top pipe ends here and the bottom pipe starts
+ *          PIPE_GAP pixels below.
+ * - scored: Flag (0 or 1) to track if the pair has been scored, preventing
  *           multiple scores for the same pair.
+ * Note: Holds no pixels. Both pipes are drawn with two shared sprites loaded
+ * once at startup.
  */
 typedef struct
 {
-    ArcadeImageSprite sprite; /* Pipe’s sprite (position, velocity, pixels) */
-    int scored;              /* 1 if scored, 0 otherwise */
-} Pipe;
+    float x;     /* Left edge (pixels) */
+    float gap_y; /* Top of the gap (pixels) */
+    int scored;  /* 1 if scored, 0 otherwise */
+} PipePair;
+
+/* =========================================================================
+ * Bird Structure
+ * =========================================================================
+ * Simulation state of the bird. The animated sprite only mirrors it for
+ * rendering.
+ * - y, vy: Vertical position and velocity (pixels, pixels/frame at 60 FPS).
+ * - frame, frame_counter: Current animation frame and ticks spent on it.
+ * - active: 1 while alive, 0 once crashed.
+ * - crash_ticks: Ticks spent crashed; the bird flashes, then fades out.
+ */
+typedef struct
+{
+    float y, vy;       /* Vertical position and velocity */
+    int frame;         /* Current animation frame */
+    int frame_counter; /* Ticks since the last frame change */
+    int active;        /* 1 if alive, 0 once crashed */
+    int crash_ticks;   /* Ticks since the crash */
+} Bird;
+
+/* =========================================================================
+ * GameData Structure
+ * =========================================================================
+ * Holds the whole simulation state of one game in a single flat struct with
+ * no pointers, so it can be copied with memcpy into the rewind ring or over
+ * a freshly built start state.
+ * - state: Current GameState.
+ * - bird: Bird position, velocity and animation.
+ * - pipes, pipe_count: Active pipe pairs, oldest first.
+ * - clock_ms: Game time played (ms at 60 FPS speed), the clock of the timers.
+ * - timers, timer_storage: Timer wheel (pipe spawns) and its timers, kept
+ *   inside GameData so rewind and restart restore them too.
+ * - score: Pipe pairs passed.
+ * - distance: How far the pipes have scrolled (pixels); positions the
+ *   background and ground layers, so they rewind with the pipes.
+ * - rng: Random stream for pipe gaps, so rewinding replays the same pipes.
+ * Note: high_score is session state, not game state, and stays outside so
+ * rewinding or restarting never lowers it.
+ */
+typedef struct
+{
+    GameState state;          /* Start, Playing, Paused or GameOver */
+    Bird bird;                /* Player bird */
+    PipePair pipes[MAX_PIPES]; /* Active pipe pairs */
+    int pipe_count;           /* Number of active pipe pairs */
+    double clock_ms;          /* Game time played (ms) */
+    ArcadeTimerWheel timers;  /* Game timers */
+    ArcadeTimer timer_storage[MAX_TIMERS]; /* Timers of the wheel */
+    int score;                /* Pipe pairs passed */
+    float distance;           /* World scrolled so far (pixels) */
+    ArcadeRng rng;            /* Pipe gap random stream */
+} GameData;
 
 /* =========================================================================
  * add_pipe_pair Function
  * =========================================================================
- * Creates a pair of pipes (top and bottom) with a random vertical gap position
- * and adds them to the pipes array. Ensures proper cleanup if sprite loading
- * fails.
+ * Adds a pipe pair with a random vertical gap position just off the right
+ * edge of the window.
  * Parameters:
- * - pipes: Array of Pipe structs to store the new pipes.
- * - pipe_count: Pointer to the current number of pipes (updated on addition).
+ * - pipes: Array of PipePair structs to store the new pair.
+ * - pipe_count: Pointer to the current number of pairs (updated on addition).
  * - window_width: Window width (pixels), used for spawn position.
- * - window_height: Window height (pixels), used for pipe sizing.
- * - speed: Horizontal velocity (negative for leftward movement, pixels/frame at 60 FPS).
+ * - rng: Random stream the gap position is drawn from.
  * Returns: None.
  * Example:
- *   add_pipe_pair(pipes, &pipe_count, 800, 600, -3.0f); // Spawn pipe pair moving left
+ *   add_pipe_pair(game.pipes, &game.pipe_count, 800, &game.rng); // Spawn pipe pair at the right edge
  * Notes:
- * - Gap’s y-position is randomized between 200 and 350 pixels for variability.
- * - If either sprite fails to load, both are discarded to maintain pair integrity.
+ * - Gap’s y-position is randomized between 200 and 349 pixels for variability.
  * - Pipes spawn just off-screen (x = window_width) for smooth entry.
- * - Speed is scaled by delta time in the game loop for frame-rate independence.
+ * - Does nothing once MAX_PIPES pairs are active.
  */
-void add_pipe_pair(Pipe *pipes, int *pipe_count, float window_width, float window_height, float speed)
+void add_pipe_pair(PipePair *pipes, int *pipe_count, float window_width, ArcadeRng *rng)
 {
-    if (*pipe_count >= MAX_PIPES - 1) return; /* Prevent array overflow; reserve space for top and bottom pipes */
-    float gap_y = 200.0f + (rand() % 150);   /* Random gap y-position (200–350 pixels) for variability in pipe placement */
-
-    /* Create top pipe, extending from y=0 to gap_y */
-    ArcadeImageSprite top = arcade_create_image_sprite(window_width, 0.0f, PIPE_WIDTH, gap_y, "./assets/sprites/pipe-top.png");
-    if (!top.pixels) return; /* Skip if image fails to load (e.g., file missing or invalid format) */
-    top.vx = speed;          /* Set leftward velocity for pipe movement */
-    pipes[*pipe_count].sprite = top; /* Store top pipe in array */
-    pipes[*pipe_count].scored = 0;   /* Initialize as not scored */
-    (*pipe_count)++;                 /* Increment pipe count */
-
-    /* Create bottom pipe, starting at gap_y + PIPE_GAP to the window bottom */
-    ArcadeImageSprite bottom = arcade_create_image_sprite(window_width, gap_y + PIPE_GAP, PIPE_WIDTH, window_height - gap_y - PIPE_GAP, "./assets/sprites/pipe-bottom.png");
-    if (!bottom.pixels)
-    { /* If bottom fails, clean up top to maintain pair integrity */
-        arcade_free_image_sprite(&pipes[--(*pipe_count)].sprite); /* Free top pipe */
-        return;
+    if (*pipe_count >= MAX_PIPES) return; /* Prevent array overflow */
+    pipes[*pipe_count].x = window_width;
+    pipes[*pipe_count].gap_y = 200.0f + arcade_rng_below(rng, 150); /* Random gap y-position (200–349 pixels) for variability in pipe placement */
+    pipes[*pipe_count].scored = 0;                     /* Initialize as not scored */
+    (*pipe_count)++;
+}
+
+/* =========================================================================
+ * move_bird Function
+ * =========================================================================
+ * Applies gravity to the bird, clamps it to the window, and advances its
+ * flapping animation. Matches arcade_move_animated_sprite.
+ * Parameters:
+ * - bird: Bird to update.
+ * - gravity: Velocity added this tick (pixels/frame at 60 FPS).
+ * - ground_y: Top of the ground (pixels).
+ * Returns: None.
+ */
+void move_bird(Bird *bird, float gravity, int ground_y)
+{
+    if (!bird->active) return;
+    bird->vy += gravity;
+    bird->y += bird->vy;
+    if (bird->y < 0.0f)
+    {
+        bird->y = 0.0f; /* Hit the ceiling */
+        bird->vy = 0.0f;
+    }
+    if (bird->y > ground_y - BIRD_SIZE)
+    {
+        bird->y = ground_y - BIRD_SIZE; /* Rest on the ground */
+        bird->vy = 0.0f;
+    }
+    if (++bird->frame_counter >= BIRD_FRAME_INTERVAL)
+    {
+        bird->frame = (bird->frame + 1) % BIRD_FRAMES;
+        bird->frame_counter = 0;
     }
-    bottom.vx = speed;               /* Set same leftward velocity as top pipe */
-    pipes[*pipe_count].sprite = bottom; /* Store bottom pipe in array */
-    pipes[*pipe_count].scored = 0;   /* Initialize as not scored (shared with top for scoring) */
-    (*pipe_count)++;                 /* Increment pipe count */
 }
 
 /* =========================================================================
- * main Function
+ * bird_hits_pipe Function
+ * =========================================================================
+ * Checks whether the bird overlaps either pipe of a pair.
+ * Parameters:
+ * - bird: Bird to test.
+ * - pipe: Pipe pair to test against.
+ * Returns:
+ * - 1 if the bird touches the top or bottom pipe, 0 otherwise.
+ */
+int bird_hits_pipe(const Bird *bird, const PipePair *pipe)
+{
+    if (!bird->active) return 0;
+    if (BIRD_X >= pipe->x + PIPE_WIDTH || BIRD_X + BIRD_SIZE <= pipe->x) return 0; /* No horizontal overlap */
+    if (bird->y < pipe->gap_y) return 1; /* Top pipe spans y = 0 to gap_y */
+    return bird->y + BIRD_SIZE > pipe->gap_y + PIPE_GAP; /* Bottom pipe spans gap_y + PIPE_GAP to the ground */
+}
+
+/* =========================================================================
+ * bird_look Function
  * =========================================================================
- * Entry point for the game. Initializes the Arcade environment, sets up
- * sprites, manages the game loop, and handles cleanup. The game loop processes
- * input, updates game state, and renders the scene at ~60 FPS using
- * arcade_delta_time for frame-rate-independent movement.
+ * Picks the color modulation of the bird sprite: none while alive, a white
+ * flash right after a crash, then a reddish fade to nothing.
+ * Parameters:
+ * - bird: Bird to draw.
+ * - tint, flash: Set to the sprite's tint and flash colors.
+ * Returns:
+ * - 1 if the bird is visible, 0 once it has faded out.
+ * Notes:
+ * - The same bird images serve every look; nothing is recolored on load.
+ */
+int bird_look(const Bird *bird, uint32_t *tint, uint32_t *flash)
+{
+    *tint = 0;
+    *flash = 0;
+    if (bird->active) return 1;
+    if (bird->crash_ticks < CRASH_FLASH_TICKS)
+    {
+        *flash = 0xFFFFFF; /* Full white */
+        return 1;
+    }
+    int fading = bird->crash_ticks - CRASH_FLASH_TICKS;
+    if (fading >= CRASH_FADE_TICKS) return 0;
+    uint32_t alpha = 255 - 255 * fading / CRASH_FADE_TICKS; /* 255 down to just above 0 */
+    *tint = (alpha << 24) | 0xFF8080;
+    return 1;
+}
+
+/* =========================================================================
+ * init_game Function
+ * =========================================================================
+ * Builds the start state: bird at its starting height, no pipes, and the
+ * periodic pipe spawn timer.
+ * Parameters:
+ * - g: GameData to fill.
+ * - seed: Seed of the pipe gap random stream.
+ * Returns: None.
+ * Notes:
+ * - Called once at startup; restarts copy the result instead of rebuilding.
+ */
+void init_game(GameData *g, uint64_t seed)
+{
+    memset(g, 0, sizeof(*g));
+    arcade_rng_seed(&g->rng, seed);
+    g->state = Start;          /* Start in Start state (shows instructions and waits for input) */
+    g->bird.y = BIRD_START_Y;  /* Vertical center */
+    g->bird.active = 1;
+    arcade_timers_init(&g->timers, g->timer_storage, MAX_TIMERS, 0);
+    arcade_timer_start(&g->timers, FIRST_SPAWN_MS, SPAWN_MS, EVENT_SPAWN_PIPE, 0); /* Pipes every 2s */
+}
+
+/* =========================================================================
+ * Session State
+ * =========================================================================
+ * What lives while the game is open: the running game, the start state
+ * restarts copy, the loaded sprites, the sprite group and the rewind history.
+ * - seed: Seed of the current game's pipe gaps; every restart uses the next.
+ * - high_score: Highest score since the program started (kept when the
+ *   launcher leaves and re-enters the game).
+ */
+static uint64_t seed;                        /* Seed for pipe gap randomization; restarts count up from it */
+static int high_score = 0;                   /* Highest score in session, persists across restarts */
+static GameData game, start_game;            /* Live game and the state every restart copies */
+static ArcadeScrollLayer background, ground; /* Parallax background and the ground strip */
+static ArcadeAnimatedSprite player;          /* Bird animation */
+static ArcadeImageSprite pipe_top, pipe_bottom; /* Pipe sprites shared by every pair */
+static ArcadeSnapshotRing history;           /* Rewind history: one snapshot per Playing tick */
+static SpriteGroup group;                    /* Sprites drawn each frame */
+
+/* =========================================================================
+ * flappybird_init Function
+ * =========================================================================
+ * Builds the start state and loads the layers, bird and pipe sprites.
  * Parameters: None.
  * Returns:
- * - 0 on successful exit.
- * - 1 if initialization fails (e.g., window creation, sprite loading).
- * Example:
- *   int main(void) {
- *       arcade_init(800, 600, "Flappy Bird", 0x00B7EB);
- *       while (arcade_running() && arcade_update()) {
- *           float dt = arcade_delta_time();
- *           arcade_move_animated_sprite(&player, gravity * dt * 60.0f, window_height); // Apply gravity
- *           arcade_render_group(&group);
- *       }
- *       arcade_quit();
- *       return 0;
- *   }
+ * - 0 on success.
+ * - 1 if a sprite or the rewind history cannot be loaded (flappybird_shutdown
+ *   frees the rest).
  * Notes:
- * - Initializes random seed for pipe gap randomization.
- * - Uses arcade_sleep(16) for approximate 60 FPS; consider removing for full
- *   frame-rate independence.
- * - Cleans up all sprites and Arcade resources on exit.
- * - Dynamic pipe speed increases with score, capped for balance.
- * - Animation runs at ~6 FPS (10-frame interval) for smooth flapping.
- * - Prints score updates and final score to console for debugging.
+ * - Seeds pipe gaps from the clock.
  */
-int main(void)
+static int flappybird_init(void)
 {
-    /* Seed random number generator for pipe gap randomization */
-    srand(time(NULL));
-
-    /* Window and physics parameters */
-    int window_width = 800;      /* Window width (pixels), matches background sprite dimensions */
-    int window_height = 600;     /* Window height (pixels), defines play area for bird and pipes */
-    float gravity = 0.2f;        /* Gravity acceleration (pixels/frame^2 at 60 FPS), pulls bird downward */
-    float jump_vy = -6.0f;       /* Upward velocity on jump (pixels/frame at 60 FPS, negative = up) */
-
-    /* Game state variables */
-    GameState state = Start;     /* Start in Start state (shows instructions and waits for input) */
-    int score = 0;               /* Current player score (number of pipe pairs passed) */
-    int high_score = 0;          /* Highest score in session, persists across restarts */
-    int pipe_count = 0;          /* Number of active pipes (top + bottom, stored in pairs) */
-    int next_pipe = 60;          /* Frames until next pipe spawn (initial delay, ~1s at 60 FPS) */
-    char text[64];               /* Buffer for rendering score and game messages */
-
-    /* Initialize background sprite (static, covers entire window) */
-    ArcadeImageSprite background = arcade_create_image_sprite(0.0f, 0.0f, window_width, window_height, "./assets/sprites/background.png");
+    seed = (uint64_t)time(NULL);
+
+    /* Build the start state once; the game and every restart copy it */
+    init_game(&start_game, seed);
+    game = start_game;
+
+    /* Initialize the scrolling layers: the background fills the window and drifts
+     * slowly behind the pipes, the ground strip moves with them */
+    background = arcade_create_scroll_layer(0.0f, 0.0f, WINDOW_WIDTH, WINDOW_HEIGHT, "./assets/sprites/background.qoi",
+                                            BACKGROUND_IMAGE_WIDTH, WINDOW_HEIGHT, BACKGROUND_PARALLAX, 0.0f);
+    ground = arcade_create_scroll_layer(0.0f, WINDOW_HEIGHT - GROUND_HEIGHT, WINDOW_WIDTH, GROUND_HEIGHT, "./assets/sprites/base.qoi",
+                                        GROUND_IMAGE_WIDTH, GROUND_HEIGHT, 1.0f, 0.0f);
 
     /* Initialize animated bird sprite with three frames for flapping animation */
     const char *bird_frames[] = {
-        "./assets/sprites/bluebird.png",          /* Frame 1: Upflap */
-        "./assets/sprites/bluebird-midflap.png",  /* Frame 2: Midflap */
-        "./assets/sprites/bluebird-downflap.png"  /* Frame 3: Downflap */
+        "./assets/sprites/bluebird.qoi",          /* Frame 1: Upflap */
+        "./assets/sprites/bluebird-midflap.qoi",  /* Frame 2: Midflap */
+        "./assets/sprites/bluebird-downflap.qoi"  /* Frame 3: Downflap */
     };
-    ArcadeAnimatedSprite player = arcade_create_animated_sprite(
-        100.0f, 300.0f, 40.0f, 40.0f, bird_frames, 3, 10
+    player = arcade_create_animated_sprite(
+        BIRD_X, BIRD_START_Y, BIRD_SIZE, BIRD_SIZE, bird_frames, BIRD_FRAMES, BIRD_FRAME_INTERVAL
     ); /* x=100 (left side), y=300 (vertical center), 40x40 pixels, 3 frames, 10-frame interval (~6 FPS animation) */
 
-    /* Initialize pipe array and sprite group for rendering */
-    Pipe pipes[MAX_PIPES] = {0}; /* Array to store up to MAX_PIPES pipes (top and bottom) */
-    SpriteGroup group;
-    arcade_init_group(&group, MAX_PIPES + 2); /* Capacity for background, player, and all pipes */
+    /* Initialize the two pipe sprites shared by every pair. They are loaded
+     * taller than any pipe needs and placed so the window clips the excess,
+     * keeping the caps next to the gap. */
+    pipe_top = arcade_create_image_sprite(0.0f, 0.0f, PIPE_WIDTH, PIPE_TOP_HEIGHT, "./assets/sprites/pipe-top.png");
+    pipe_bottom = arcade_create_image_sprite(0.0f, 0.0f, PIPE_WIDTH, PIPE_BOTTOM_HEIGHT, "./assets/sprites/pipe-bottom.png");
 
-    /* Initialize Arcade environment (window, rendering, input) */
-    if (!background.pixels || !player.frames || arcade_init(window_width, window_height, "Flappy Bird", 0x00B7EB))
+    /* Rewind history and sprite group */
+    arcade_snapshot_ring_init(&history, sizeof(GameData), REWIND_FRAMES);
+    arcade_init_group(&group, MAX_PIPES * 2 + 3); /* Capacity for background, player, all pipes and the ground */
+
+    if (!background.pixels || !ground.pixels || !player.frames || !pipe_top.pixels || !pipe_bottom.pixels || !history.data)
     {
         fprintf(stderr, "Initialization failed: background=%p, player.frames=%p\n", background.pixels, player.frames);
-        arcade_free_image_sprite(&background); /* Free background if initialization fails */
-        arcade_free_animated_sprite(&player);  /* Free bird animation if initialization fails */
-        arcade_free_group(&group);             /* Free sprite group */
-        return 1; /* Exit if window creation or sprite loading fails */
+        return 1;
     }
+    return 0;
+}
 
-    /* Main game loop: runs until window is closed or ESC is pressed */
-    while (arcade_running() && arcade_update())
+/* =========================================================================
+ * flappybird_update Function
+ * =========================================================================
+ * Runs one frame: renders the scene, then handles input and game logic for
+ * the current state, using arcade_delta_time for frame-rate-independent
+ * movement.
+ * Parameters: None.
+ * Returns: 1 (the game only ends when its window closes).
+ */
+static int flappybird_update(void)
+{
+    float gravity = 0.2f;                        /* Gravity acceleration (pixels/frame^2 at 60 FPS), pulls bird downward */
+    float jump_vy = -6.0f;                       /* Upward velocity on jump (pixels/frame at 60 FPS, negative = up) */
+    int ground_y = WINDOW_HEIGHT - GROUND_HEIGHT; /* Top of the ground, where the bird crashes */
+    char text[64];                               /* Buffer for rendering score and game messages */
+
+    /* Get delta time for frame-rate-independent movement */
+    float delta_time = arcade_delta_time();
+    float scale = delta_time * 60.0f; /* Normalize to 60 FPS for consistent speed */
+
+    /* Update score display (rendered every frame) */
+    snprintf(text, sizeof(text), "Score: %d", game.score);
+
+    /* Reset sprite group to rebuild with current sprites (needed for animated player) */
+    group.count = 0; /* Clear previous frame’s sprites for fresh rendering */
+
+    /* Mirror the bird state into the animated sprite */
+    player.current_frame = game.bird.frame;
+    uint32_t tint, flash;
+    player.frames[0].active = bird_look(&game.bird, &tint, &flash);
+    player.frames[game.bird.frame].y = game.bird.y;
+    player.frames[game.bird.frame].tint = tint;   /* Crash flash and fade */
+    player.frames[game.bird.frame].flash = flash;
+
+    /* Scroll the layers to the distance travelled */
+    arcade_scroll_layer(&background, game.distance, 0.0f);
+    arcade_scroll_layer(&ground, game.distance, 0.0f);
+
+    /* Add background, player, pipes and ground to render group */
+    arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.layer = background}, SPRITE_LAYER); /* Parallax background */
+    arcade_add_animated_to_group(&group, &player); /* Adds current bird frame based on animation state */
+    for (int i = 0; i < game.pipe_count; i++)
     {
-        /* Get delta time for frame-rate-independent movement */
-        float delta_time = arcade_delta_time();
-        float scale = delta_time * 60.0f; /* Normalize to 60 FPS for consistent speed */
+        pipe_top.x = pipe_bottom.x = game.pipes[i].x;
+        pipe_top.y = game.pipes[i].gap_y - PIPE_TOP_HEIGHT; /* Bottom edge (cap) on the gap */
+        pipe_bottom.y = game.pipes[i].gap_y + PIPE_GAP;     /* Top edge (cap) on the gap */
+        arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.image_sprite = pipe_top}, SPRITE_IMAGE);
+        arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.image_sprite = pipe_bottom}, SPRITE_IMAGE);
+    }
+    arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.layer = ground}, SPRITE_LAYER); /* Ground in front of the pipes */
 
-        /* Update score display (rendered every frame) */
-        snprintf(text, sizeof(text), "Score: %d", score);
+    /* Render the scene (clears screen, draws sprites, updates window) */
+    arcade_render_group(&group);
+    arcade_render_text(text, 10.0f, 30.0f, 0xFFFFFF); /* Score in top-left (white) */
 
-        /* Reset sprite group to rebuild with current sprites (needed for animated player) */
-        group.count = 0; /* Clear previous frame’s sprites for fresh rendering */
+    /* Calculate dynamic pipe speed (increases with score, capped for balance) */
+    float pipe_speed = -3.0f - (game.score / 10) * 0.5f; /* Base -3.0, increases by 0.5 per 10 points, pixels/frame at 60 FPS */
+    if (pipe_speed < -6.0f) pipe_speed = -6.0f;          /* Cap at -6.0 to prevent unplayable difficulty */
 
-        /* Add background, player, and pipes to render group */
-        arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.image_sprite = background}, SPRITE_IMAGE); /* Static background */
-        arcade_add_animated_to_group(&group, &player); /* Adds current bird frame based on animation state */
-        for (int i = 0; i < pipe_count; i++)
+    /* Handle game logic based on current state */
+    switch (game.state)
+    {
+    case Start:
+        /* Show blinking start prompt and high score */
+        arcade_render_text_centered_blink("Press Space to Start", 300.0f, 0xFFFFFF, 30); /* Blinks every 0.5s at 60 FPS */
+        snprintf(text, sizeof(text), "High Score: %d", high_score);
+        arcade_render_text_centered(text, 350.0f, 0xFFFFFF); /* High score below prompt */
+        if (arcade_key_pressed_once(a_space) == 2)
         {
-            arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.image_sprite = pipes[i].sprite}, SPRITE_IMAGE); /* Add active pipes */
+            arcade_clear_keys(); /* Clear input to prevent immediate jump in Playing state */
+            game.state = Playing; /* Transition to gameplay */
         }
+        break;
 
-        /* Render the scene (clears screen, draws sprites, updates window) */
-        arcade_render_group(&group);
-        arcade_render_text(text, 10.0f, 30.0f, 0xFFFFFF); /* Score in top-left (white) */
-
-        /* Calculate dynamic pipe speed (increases with score, capped for balance) */
-        float pipe_speed = -3.0f - (score / 10) * 0.5f; /* Base -3.0, increases by 0.5 per 10 points, pixels/frame at 60 FPS */
-        if (pipe_speed < -6.0f) pipe_speed = -6.0f;     /* Cap at -6.0 to prevent unplayable difficulty */
-
-        /* Handle game logic based on current state */
-        switch (state)
+    case Playing:
+        /* Hold Backspace to rewind: step back one tick per frame instead of simulating */
+        if (arcade_key_pressed(a_backspace) == 2 && arcade_snapshot_pop(&history, &game) == 0)
         {
-        case Start:
-            /* Show blinking start prompt and high score */
-            arcade_render_text_centered_blink("Press Space to Start", 300.0f, 0xFFFFFF, 30); /* Blinks every 0.5s at 60 FPS */
-            snprintf(text, sizeof(text), "High Score: %d", high_score);
-            arcade_render_text_centered(text, 350.0f, 0xFFFFFF); /* High score below prompt */
-            if (arcade_key_pressed_once(a_space) == 2)
-            {
-                arcade_clear_keys(); /* Clear input to prevent immediate jump in Playing state */
-                state = Playing;     /* Transition to gameplay */
-            }
             break;
+        }
+        arcade_snapshot_push(&history, &game); /* Record the state this tick starts from */
 
-        case Playing:
-            /* Handle pause toggle */
-            if (arcade_key_pressed_once(a_p) == 2)
-            {
-                arcade_play_sound("./assets/audio/pause.wav"); /* Play pause sound effect */
-                state = Paused; /* Freeze gameplay, no movement or updates */
-            }
+        /* Handle pause toggle */
+        if (arcade_key_pressed_once(a_p) == 2)
+        {
+            arcade_play_sound("./assets/audio/pause.wav"); /* Play pause sound effect */
+            game.state = Paused; /* Freeze gameplay, no movement or updates */
+        }
 
-            /* Handle jump input (Space key) */
-            if (arcade_key_pressed_once(a_space) == 2)
-            {
-                player.frames[player.current_frame].vy = jump_vy; /* Apply upward velocity to current frame */
-                arcade_play_sound("./assets/audio/sfx_wing.wav"); /* Play wing flap sound */
-            }
+        /* Handle jump input (Space key) */
+        if (arcade_key_pressed_once(a_space) == 2)
+        {
+            game.bird.vy = jump_vy; /* Apply upward velocity */
+            arcade_play_sound("./assets/audio/sfx_wing.wav"); /* Play wing flap sound */
+        }
+
+        /* Update bird position (applies gravity, clamps to window) and animation */
+        move_bird(&game.bird, gravity * scale, ground_y); /* Apply gravity scaled by delta time, clamp to the ground */
 
-            /* Update player position (applies gravity, clamps to window) and animation */
-            arcade_move_animated_sprite(&player, gravity * scale, window_height); /* Apply gravity scaled by delta time, clamp to window height */
+        /* Update pipes and check scoring/collisions */
+        game.distance -= pipe_speed; /* The layers scroll with the pipes */
+        for (int i = 0; i < game.pipe_count; i++)
+        {
+            PipePair *pipe = &game.pipes[i];
+            pipe->x += pipe_speed; /* Move pipe pair left at the current dynamic speed */
 
-            /* Update pipes and check scoring/collisions */
-            for (int i = 0; i < pipe_count; i++)
+            /* Score when the bird has passed the pair */
+            if (!pipe->scored && pipe->x + PIPE_WIDTH < BIRD_X)
             {
-                pipes[i].sprite.vx = pipe_speed; /* Update velocity to current dynamic speed */
-                arcade_move_image_sprite(&pipes[i].sprite, 0.0f, window_height); /* Move pipe left, scaled by delta time inside arcade_move_image_sprite */
-
-                /* Score when bird passes bottom pipe (odd index, i % 2 == 1) */
-                if (i % 2 == 1 && !pipes[i].scored && pipes[i].sprite.x + PIPE_WIDTH < player.frames[0].x)
-                {
-                    score++; /* Increment score for passing pipe pair */
-                    if (score > high_score) high_score = score; /* Update high score if current score exceeds it */
-                    pipes[i].scored = 1;     /* Mark bottom pipe as scored */
-                    pipes[i - 1].scored = 1; /* Mark corresponding top pipe as scored */
-                    arcade_play_sound("./assets/audio/sfx_point.wav"); /* Play score sound effect */
-                    printf("Score incremented: %d\n", score); /* Debug output to console */
-                }
-
-                /* Check collision with active pipes */
-                if (pipes[i].sprite.active && arcade_check_animated_collision(&player, &pipes[i].sprite))
-                {
-                    arcade_play_sound("./assets/audio/sfx_die.wav"); /* Play crash sound effect */
-                    state = GameOver;                        /* Transition to GameOver state */
-                    player.frames[0].active = 0;             /* Disable player rendering */
-                }
+                game.score++; /* Increment score for passing pipe pair */
+                if (game.score > high_score) high_score = game.score; /* Update high score if current score exceeds it */
+                pipe->scored = 1; /* Mark pair as scored */
+                arcade_play_sound("./assets/audio/sfx_point.wav"); /* Play score sound effect */
+                arcade_log(ARCADE_LOG_DEBUG, "flappybird", "Score incremented: %d", game.score); /* Shown with log_level debug */
             }
 
-            /* Check for ground collision (hardcoded ground at window_height) */
-            if (player.frames[0].y + player.frames[0].height >= window_height)
+            /* Check collision with both pipes of the pair */
+            if (bird_hits_pipe(&game.bird, pipe))
             {
                 arcade_play_sound("./assets/audio/sfx_die.wav"); /* Play crash sound effect */
-                state = GameOver; /* Transition to GameOver state */
-                player.frames[0].active = 0; /* Disable player rendering */
+                game.state = GameOver;                   /* Transition to GameOver state */
+                game.bird.active = 0;                    /* Crashed: flashes, then fades out */
             }
+        }
 
-            /* Spawn new pipe pair after countdown (adjusted for delta time) */
-            next_pipe -= scale; /* Decrease spawn timer, scaled by delta time */
-            if (next_pipe <= 0)
-            {
-                add_pipe_pair(pipes, &pipe_count, window_width, window_height, pipe_speed); /* Spawn new pipe pair */
-                next_pipe = SPAWN_FRAMES; /* Reset spawn timer (~2s at 60 FPS) */
-            }
+        /* Check for ground collision (top of the ground strip) */
+        if (game.bird.y + BIRD_SIZE >= ground_y)
+        {
+            arcade_play_sound("./assets/audio/sfx_die.wav"); /* Play crash sound effect */
+            game.state = GameOver; /* Transition to GameOver state */
+            game.bird.active = 0;  /* Crashed: flashes, then fades out */
+        }
 
-            /* Remove off-screen pipes to free memory and make room for new ones */
-            if (pipe_count && pipes[0].sprite.x + PIPE_WIDTH < 0)
-            {
-                arcade_free_image_sprite(&pipes[0].sprite); /* Free top pipe’s sprite memory */
-                arcade_free_image_sprite(&pipes[1].sprite); /* Free bottom pipe’s sprite memory */
-                for (int i = 0; i < pipe_count - 2; i++) pipes[i] = pipes[i + 2]; /* Shift array to remove first pair */
-                pipe_count -= 2; /* Reduce count by 2 (one pipe pair) */
-            }
-            break;
+        /* Run the timers on game time (scaled by delta time) and handle what expired */
+        game.clock_ms += scale * (1000.0 / 60.0);
+        arcade_timers_advance(&game.timers, (uint64_t)game.clock_ms, NULL, NULL);
+        int event;
+        while (arcade_timers_poll(&game.timers, &event, NULL))
+        {
+            if (event == EVENT_SPAWN_PIPE)
+                add_pipe_pair(game.pipes, &game.pipe_count, WINDOW_WIDTH, &game.rng); /* Spawn new pipe pair */
+        }
 
-        case Paused:
-            /* Show pause message (no movement or spawning occurs) */
-            arcade_render_text_centered("Paused - Press P", 300.0f, 0xFFFFFF); /* Display pause prompt */
-            if (arcade_key_pressed_once(a_p) == 2)
-            {
-                arcade_play_sound("./assets/audio/pause.wav"); /* Play unpause sound effect */
-                state = Playing; /* Resume gameplay */
-            }
-            break;
+        /* Remove the oldest pair once it leaves the screen to make room for new ones */
+        if (game.pipe_count && game.pipes[0].x + PIPE_WIDTH < 0)
+        {
+            for (int i = 0; i < game.pipe_count - 1; i++) game.pipes[i] = game.pipes[i + 1]; /* Shift array to remove first pair */
+            game.pipe_count--;
+        }
+        break;
+
+    case Paused:
+        /* Show pause message (no movement or spawning occurs) */
+        arcade_render_text_centered("Paused - Press P", 300.0f, 0xFFFFFF); /* Display pause prompt */
+        if (arcade_key_pressed_once(a_p) == 2)
+        {
+            arcade_play_sound("./assets/audio/pause.wav"); /* Play unpause sound effect */
+            game.state = Playing; /* Resume gameplay */
+        }
+        break;
 
-        case GameOver:
-            /* Show game over message with current score and high score */
-            snprintf(text, sizeof(text), "Game Over! Score: %d. High Score: %d. Press R", score, high_score);
-            arcade_render_text_centered(text, 300.0f, 0xFFFFFF); /* Display game over message */
+    case GameOver:
+        /* Run the crash flash and fade (stops once the bird is gone) */
+        if (game.bird.crash_ticks < CRASH_FLASH_TICKS + CRASH_FADE_TICKS) game.bird.crash_ticks++;
 
-            /* Handle restart input */
-            if (arcade_key_pressed_once(a_r) == 2)
-            {
-                arcade_clear_keys(); /* Clear input to prevent immediate actions in Playing state */
-
-                /* Reset player state */
-                player.frames[0].x = 100.0f; /* Reset to starting x-position (left side) */
-                player.frames[0].y = 300.0f; /* Reset to starting y-position (vertical center) */
-                player.frames[0].vy = 0.0f;  /* Clear vertical velocity */
-                player.frames[0].active = 1;  /* Re-enable player rendering */
-                player.current_frame = 0;     /* Reset animation to first frame (upflap) */
-                player.frame_counter = 0;     /* Reset animation timer */
-
-                /* Sync other animation frames to first frame’s position and state */
-                for (int i = 1; i < player.frame_count; i++)
-                {
-                    player.frames[i].x = 100.0f; /* Match first frame’s x */
-                    player.frames[i].y = 300.0f; /* Match first frame’s y */
-                    player.frames[i].vy = 0.0f;  /* Clear velocity */
-                }
-
-                /* Clear all pipes */
-                for (int i = 0; i < pipe_count; i++)
-                {
-                    arcade_free_image_sprite(&pipes[i].sprite); /* Free each pipe’s sprite memory */
-                }
-                pipe_count = 0; /* Reset pipe count to 0 */
-
-                /* Reset game state */
-                score = 0;        /* Reset score (high_score persists) */
-                next_pipe = 60;   /* Reset initial delay for first pipe (~1s at 60 FPS) */
-                state = Playing;  /* Restart gameplay */
-            }
+        /* Show game over message with current score and high score */
+        snprintf(text, sizeof(text), "Game Over! Score: %d. High Score: %d. Press R", game.score, high_score);
+        arcade_render_text_centered(text, 300.0f, 0xFFFFFF); /* Display game over message */
+
+        /* Hold Backspace to rewind back into the lost game */
+        if (arcade_key_pressed(a_backspace) == 2 && arcade_snapshot_pop(&history, &game) == 0)
+        {
             break;
         }
 
-        /* Sleep for ~16ms to target 60 FPS (optional) */
-        arcade_sleep(16);
-    }
+        /* Handle restart input */
+        if (arcade_key_pressed_once(a_r) == 2)
+        {
+            arcade_clear_keys(); /* Clear input to prevent immediate actions in Playing state */
 
-    /* Clean up all resources before exit */
-    arcade_free_image_sprite(&background); /* Free background sprite memory */
-    arcade_free_animated_sprite(&player);  /* Free bird animation frames */
-    for (int i = 0; i < pipe_count; i++)
-    {
-        arcade_free_image_sprite(&pipes[i].sprite); /* Free any remaining pipe sprites */
+            /* Reset to the start state (high_score persists) */
+            game = start_game;
+            arcade_rng_seed(&game.rng, ++seed);   /* New pipes every game */
+            arcade_snapshot_ring_clear(&history); /* Nothing to rewind into */
+            game.state = Playing; /* Restart gameplay */
+        }
+        break;
     }
-    arcade_free_group(&group); /* Free sprite group memory */
-    arcade_quit();            /* Close window and release Arcade resources */
 
-    /* Print final score and high score to console */
-    printf("Game Over! Final Score: %d, High Score: %d\n", score, high_score);
-    return 0;
-}
\ No newline at end of file
+    return 1;
+}
+
+/* =========================================================================
+ * flappybird_shutdown Function
+ * =========================================================================
+ * Frees the sprites, rewind history and sprite group, and prints the final
+ * score and high score.
+ * Parameters: None.
+ * Returns: None.
+ */
+static void flappybird_shutdown(void)
+{
+    arcade_free_scroll_layer(&background);  /* Free layer images */
+    arcade_free_scroll_layer(&ground);
+    arcade_free_animated_sprite(&player);   /* Free bird animation frames */
+    arcade_free_image_sprite(&pipe_top);    /* Free shared pipe sprites */
+    arcade_free_image_sprite(&pipe_bottom);
+    arcade_snapshot_ring_free(&history);    /* Free rewind history */
+    arcade_free_group(&group);              /* Free sprite group memory */
+    printf("Game Over! Final Score: %d, High Score: %d\n", game.score, high_score);
+}
+
+/* Entry points, for main and for the launcher (Launcher/launcher.c) */
+const ArcadeGame flappybird_game = {"Flappy Bird", WINDOW_WIDTH, WINDOW_HEIGHT, 0x00B7EB,
+                                    flappybird_init, flappybird_update, flappybird_shutdown};
+
+/* =========================================================================
+ * main Function
+ * =========================================================================
+ * Entry point for the game on its own. arcade_run_game opens the window,
+ * calls flappybird_init, then flappybird_update once per frame until the
+ * window is closed, and cleans up with flappybird_shutdown.
+ * Parameters: None.
+ * Returns:
+ * - 0 on successful exit.
+ * - 1 if initialization fails (e.g., window creation, sprite loading).
+ * Example:
+ *   int main(void) {
+ *       arcade_set_backend(ARCADE_BACKEND_XRENDER);
+ *       return arcade_run_game(&flappybird_game);
+ *   }
+ * Notes:
+ * - With XRender built in, the images are composited on the X server.
+ * - Paces frames with arcade_wait_frame: 60 FPS unless the performance
+ *   section of arcade.config.json says otherwise.
+ * - Left out when built into the launcher (ARCADE_LAUNCHER).
+ */
+#ifndef ARCADE_LAUNCHER
+int main(void)
+{
+    arcade_set_backend(ARCADE_BACKEND_XRENDER);
+    return arcade_run_game(&flappybird_game);
+}
+#endif
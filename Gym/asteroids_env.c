@@ -0,0 +1,89 @@
+/* =========================================================================
+ * Arcade Gym - Asteroids
+ * =========================================================================
+ * The agent flies the red ship of the match from Asteroids/asteroids_sim.h
+ * alone: the second ship is removed at the start of every episode.
+ *
+ * Actions: 0 = stay, 1 = left, 2 = right, 3 = fire, 4 = left + fire,
+ * 5 = right + fire.
+ * Reward: +1 for every asteroid destroyed.
+ * Episode: ends when the ship is hit.
+ * State observation (4 + 4 * MAX_ASTEROIDS floats): ship position, bullet
+ * position and activity, then position, speed and activity of every
+ * asteroid slot.
+ * ========================================================================= */
+
+#include "envs.h"
+#include "asteroids_sim.h"
+
+#define ASTEROIDS_ENV_DIMS (4 + 4 * MAX_ASTEROIDS) /* Floats in a state observation. */
+
+static const uint8_t action_inputs[6] = {
+    0, MATCH_LEFT, MATCH_RIGHT, MATCH_FIRE, MATCH_LEFT | MATCH_FIRE, MATCH_RIGHT | MATCH_FIRE};
+
+static void reset_asteroids(void *state, uint32_t seed)
+{
+    AsteroidsMatch *m = state;
+    init_asteroids_match(m, seed);
+    m->ships[1].active = 0; /* Single-player episode */
+}
+
+static float step_asteroids(void *state, int action, int *done)
+{
+    AsteroidsMatch *m = state;
+    uint8_t inputs[2] = {action_inputs[action], 0};
+    int score = m->score[0];
+    step_asteroids_match(m, inputs);
+    *done = m->winner >= 0;
+    return (float)(m->score[0] - score);
+}
+
+static void observe_asteroids(const void *state, float *out)
+{
+    const AsteroidsMatch *m = state;
+    out[0] = m->ships[0].x / WINDOW_WIDTH * 2.0f - 1.0f;
+    out[1] = m->bullets[0].active ? m->bullets[0].x / WINDOW_WIDTH * 2.0f - 1.0f : 0.0f;
+    out[2] = m->bullets[0].active ? m->bullets[0].y / WINDOW_HEIGHT * 2.0f - 1.0f : 0.0f;
+    out[3] = m->bullets[0].active ? 1.0f : 0.0f;
+    for (int i = 0; i < MAX_ASTEROIDS; i++)
+    {
+        const ArcadeSprite *a = &m->asteroids[i];
+        float *slot = out + 4 + 4 * i;
+        slot[0] = a->active ? a->x / WINDOW_WIDTH * 2.0f - 1.0f : 0.0f;
+        slot[1] = a->active ? a->y / WINDOW_HEIGHT * 2.0f - 1.0f : 0.0f;
+        slot[2] = a->active ? a->vy / MATCH_ASTEROID_MAX : 0.0f;
+        slot[3] = a->active ? 1.0f : 0.0f;
+    }
+}
+
+static int draw_asteroids(const void *state, ArcadeAnySprite *sprites, int *types)
+{
+    const AsteroidsMatch *m = state;
+    int count = 0;
+    if (m->ships[0].active)
+        sprites[count++].sprite = m->ships[0];
+    if (m->bullets[0].active)
+        sprites[count++].sprite = m->bullets[0];
+    for (int i = 0; i < MAX_ASTEROIDS; i++)
+    {
+        if (m->asteroids[i].active)
+            sprites[count++].sprite = m->asteroids[i];
+    }
+    for (int i = 0; i < count; i++)
+        types[i] = SPRITE_COLOR;
+    return count;
+}
+
+const ArcadeEnvDef asteroids_env = {
+    .name = "asteroids",
+    .state_size = sizeof(AsteroidsMatch),
+    .world_width = WINDOW_WIDTH,
+    .world_height = WINDOW_HEIGHT,
+    .bg_color = 0x000000,
+    .action_count = 6,
+    .state_dims = ASTEROIDS_ENV_DIMS,
+    .max_sprites = 2 + MAX_ASTEROIDS,
+    .reset = reset_asteroids,
+    .step = step_asteroids,
+    .observe = observe_asteroids,
+    .draw = draw_asteroids};
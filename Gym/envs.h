@@ -0,0 +1,19 @@
+/* =========================================================================
+ * Arcade Gym - Environments
+ * =========================================================================
+ * Author: GeorgeET15
+ * Description:
+ * The games that can be trained against, as ArcadeEnvDef definitions. Each
+ * lives in its own file (paddleball_env.c, asteroids_env.c) so their
+ * simulation headers never meet in one translation unit.
+ * ========================================================================= */
+
+#ifndef ENVS_H
+#define ENVS_H
+
+#include "arcade.h"
+
+extern const ArcadeEnvDef paddleball_env; /* Paddle Ball against a scripted top paddle */
+extern const ArcadeEnvDef asteroids_env;  /* Single-ship Asteroids */
+
+#endif
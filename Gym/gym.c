@@ -0,0 +1,232 @@
+/* =========================================================================
+ * Arcade Gym - Documentation
+ * =========================================================================
+ * Author: GeorgeET15
+ * Description:
+ * Benchmarks the Gym-style environments (arcade_env_*, arcade_vec_env_*) with
+ * a random agent: a batch of environments is reset, then stepped together
+ * on a worker pool for a number of steps, with observations written into
+ * one caller-owned buffer. Nothing opens a window, reads a clock inside an
+ * environment or sleeps, so the games run as fast as the CPU allows. It is
+ * also the smallest example of driving the environments from a training
+ * program.
+ *
+ * Usage:
+ *   ./gym [--game paddleball|asteroids] [--envs 64] [--threads N]
+ *         [--obs state|gray|rgb] [--size 84] [--steps 2000] [--seed N]
+ *         [--dump obs.png]
+ *
+ * Compilation:
+ * With make (links ../arcade's headless libarcade, built once for all games):
+ *   make
+ * Linux:
+ *   gcc -O2 -DARCADE_HEADLESS -I../arcade -I../PaddleBall -I../Asteroids \
+ *       -o gym gym.c paddleball_env.c asteroids_env.c ../arcade/arcade.c -lm -lpthread
+ * Windows (MinGW):
+ *   gcc -O2 -DARCADE_HEADLESS -I../arcade -I../PaddleBall -I../Asteroids \
+ *       -o gym gym.c paddleball_env.c asteroids_env.c ../arcade/arcade.c -lws2_32
+ *
+ * Output:
+ * - Steps per second over the batch, steps per second per CPU core, and the
+ *   episodes finished with their mean reward.
+ * - With --dump, the first environment's last frame observation as a PNG.
+ *
+ * Notes:
+ * - --steps counts batch steps; every batch step advances all environments.
+ * - Frame observations are rendered directly at --size x --size, so their
+ *   cost depends on the observation size, not on the game's screen size.
+ * ========================================================================= */
+
+#include "arcade.h"
+#include "envs.h"
+#include "stb_image_write.h"
+
+/* =========================================================================
+ * Gym Constants
+ * ========================================================================= */
+#define GYM_ENVS 64     /* Default number of environments. */
+#define GYM_STEPS 2000  /* Default batch steps. */
+#define GYM_OBS_SIZE 84 /* Default frame observation width and height. */
+
+static const ArcadeEnvDef *envs[] = {&paddleball_env, &asteroids_env};
+#define ENV_COUNT (int)(sizeof(envs) / sizeof(envs[0]))
+
+/* =========================================================================
+ * find_env Function
+ * =========================================================================
+ * Looks up an environment by its command-line name.
+ * Returns: The definition, or NULL if unknown (message printed).
+ */
+static const ArcadeEnvDef *find_env(const char *name)
+{
+    for (int i = 0; i < ENV_COUNT; i++)
+    {
+        if (strcmp(envs[i]->name, name) == 0)
+            return envs[i];
+    }
+    fprintf(stderr, "Unknown game '%s' (paddleball or asteroids)\n", name);
+    return NULL;
+}
+
+/* =========================================================================
+ * dump_observation Function
+ * =========================================================================
+ * Writes one frame observation (gray or RGB bytes) to a PNG file.
+ * Returns: 0 on success, 1 on failure (message printed).
+ */
+static int dump_observation(const char *path, const ArcadeEnv *env, const unsigned char *obs)
+{
+    if (env->obs_type == ARCADE_OBS_STATE)
+    {
+        fprintf(stderr, "--dump needs a frame observation (--obs gray or rgb)\n");
+        return 1;
+    }
+    int channels = env->obs_type == ARCADE_OBS_GRAY ? 1 : 3;
+    if (!stbi_write_png(path, env->obs_width, env->obs_height, channels, obs, env->obs_width * channels))
+    {
+        fprintf(stderr, "Failed to write %s\n", path);
+        return 1;
+    }
+    printf("Wrote %s (%dx%d)\n", path, env->obs_width, env->obs_height);
+    return 0;
+}
+
+/* =========================================================================
+ * run_benchmark Function
+ * =========================================================================
+ * Steps env_count environments with random actions and reports throughput.
+ * Returns: 0 on success, 1 on failure (message printed).
+ */
+static int run_benchmark(const ArcadeEnvDef *def, int env_count, int threads, int obs_type, int size,
+                         int steps, uint32_t seed, const char *dump_path)
+{
+    ArcadeVecEnv vec;
+    if (arcade_vec_env_init(&vec, def, env_count, obs_type, size, size, threads) != 0)
+    {
+        fprintf(stderr, "Failed to create %d environments\n", env_count);
+        return 1;
+    }
+
+    size_t obs_size = arcade_env_obs_size(&vec.envs[0]);
+    unsigned char *obs = malloc(obs_size * env_count);
+    int *actions = malloc(sizeof(int) * env_count);
+    float *rewards = malloc(sizeof(float) * env_count);
+    int *dones = malloc(sizeof(int) * env_count);
+    float *returns = calloc((size_t)env_count, sizeof(float));
+    if (!obs || !actions || !rewards || !dones || !returns)
+    {
+        fprintf(stderr, "Out of memory\n");
+        free(obs);
+        free(actions);
+        free(rewards);
+        free(dones);
+        free(returns);
+        arcade_vec_env_free(&vec);
+        return 1;
+    }
+
+    printf("Stepping %d %s environments (%s observations, %zu bytes each) on %d threads\n", env_count, def->name,
+           obs_type == ARCADE_OBS_STATE ? "state" : (obs_type == ARCADE_OBS_GRAY ? "gray" : "rgb"), obs_size,
+           vec.pool.thread_count);
+
+    arcade_vec_env_reset(&vec, seed, obs);
+    ArcadeRng agent_rng; /* The random agent's own stream */
+    arcade_rng_seed_stream(&agent_rng, seed, 1);
+    int episodes = 0;
+    double returns_sum = 0.0;
+
+    clock_t cpu_start = clock();
+    double start = arcade_time();
+    for (int step = 0; step < steps; step++)
+    {
+        for (int i = 0; i < env_count; i++)
+            actions[i] = (int)arcade_rng_below(&agent_rng, (uint32_t)def->action_count);
+        arcade_vec_env_step(&vec, actions, obs, rewards, dones);
+        for (int i = 0; i < env_count; i++)
+        {
+            returns[i] += rewards[i];
+            if (dones[i])
+            {
+                episodes++;
+                returns_sum += returns[i];
+                returns[i] = 0.0f;
+            }
+        }
+    }
+    double seconds = arcade_time() - start;
+    double cpu_seconds = (double)(clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    double total_steps = (double)steps * env_count;
+    printf("%.0f steps in %.2f s: %.0f steps/s, %.0f steps/s per core (%.2f s CPU)\n", total_steps, seconds,
+           seconds > 0 ? total_steps / seconds : 0.0, cpu_seconds > 0 ? total_steps / cpu_seconds : 0.0,
+           cpu_seconds);
+    printf("%d episodes finished, mean reward %.2f\n", episodes, episodes ? returns_sum / episodes : 0.0);
+
+    int result = dump_path ? dump_observation(dump_path, &vec.envs[0], obs) : 0;
+
+    free(obs);
+    free(actions);
+    free(rewards);
+    free(dones);
+    free(returns);
+    arcade_vec_env_free(&vec);
+    return result;
+}
+
+/* =========================================================================
+ * main Function
+ * =========================================================================
+ * Parses the command line (see Usage above) and runs the benchmark.
+ */
+int main(int argc, char **argv)
+{
+    const ArcadeEnvDef *def = &paddleball_env;
+    int env_count = GYM_ENVS;
+    int threads = 0;
+    int obs_type = ARCADE_OBS_STATE;
+    int size = GYM_OBS_SIZE;
+    int steps = GYM_STEPS;
+    uint32_t seed = 1;
+    const char *dump_path = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        int has_value = i + 1 < argc;
+        if (strcmp(arg, "--game") == 0 && has_value)
+        {
+            if (!(def = find_env(argv[++i])))
+                return 1;
+        }
+        else if (strcmp(arg, "--envs") == 0 && has_value)
+            env_count = atoi(argv[++i]);
+        else if (strcmp(arg, "--threads") == 0 && has_value)
+            threads = atoi(argv[++i]);
+        else if (strcmp(arg, "--obs") == 0 && has_value)
+        {
+            const char *name = argv[++i];
+            obs_type = strcmp(name, "gray") == 0 ? ARCADE_OBS_GRAY : (strcmp(name, "rgb") == 0 ? ARCADE_OBS_RGB : ARCADE_OBS_STATE);
+        }
+        else if (strcmp(arg, "--size") == 0 && has_value)
+            size = atoi(argv[++i]);
+        else if (strcmp(arg, "--steps") == 0 && has_value)
+            steps = atoi(argv[++i]);
+        else if (strcmp(arg, "--seed") == 0 && has_value)
+            seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(arg, "--dump") == 0 && has_value)
+            dump_path = argv[++i];
+        else
+        {
+            fprintf(stderr, "Usage: %s [--game paddleball|asteroids] [--envs N] [--threads N]\n"
+                            "          [--obs state|gray|rgb] [--size N] [--steps N] [--seed N] [--dump FILE]\n",
+                    argv[0]);
+            return 1;
+        }
+    }
+    if (env_count <= 0 || steps <= 0 || size <= 0)
+    {
+        fprintf(stderr, "--envs, --steps and --size must be positive\n");
+        return 1;
+    }
+    return run_benchmark(def, env_count, threads, obs_type, size, steps, seed, dump_path);
+}
@@ -0,0 +1,100 @@
+/* =========================================================================
+ * Arcade Gym - Paddle Ball
+ * =========================================================================
+ * The agent plays the bottom paddle of the versus match from
+ * PaddleBall/paddleball_sim.h against a scripted top paddle that tracks the
+ * ball with an aiming error, so it can be beaten.
+ *
+ * Actions: 0 = stay, 1 = left, 2 = right.
+ * Reward: +1 for every point won, -1 for every point lost.
+ * Episode: ends when either side reaches VERSUS_POINTS, or after
+ * PADDLEBALL_ENV_FRAMES frames.
+ * State observation (7 floats): both paddle centers, ball position and
+ * velocity, and whether the ball is waiting to be served.
+ * ========================================================================= */
+
+#include "envs.h"
+#include "paddleball_sim.h"
+
+#define PADDLEBALL_ENV_FRAMES 36000 /* Episode time limit (10 minutes at 60 FPS). */
+#define OPPONENT_ERROR 60           /* Largest aiming error of the scripted paddle (pixels). */
+
+/* Episode state: the match plus the scripted opponent's random stream */
+typedef struct
+{
+    VersusData match;  /* Versus match; the agent is player 0 */
+    ArcadeRng rng;     /* Opponent aiming errors and serve direction */
+    float aim_offset;  /* Opponent's aiming error for the current rally */
+    int frames;        /* Frames played this episode */
+} PaddleballEnv;
+
+static void reset_paddleball(void *state, uint32_t seed)
+{
+    PaddleballEnv *env = state;
+    init_versus(&env->match);
+    arcade_rng_seed(&env->rng, seed);
+    env->match.serve_dir = arcade_rng_below(&env->rng, 2) ? 1 : -1; /* First serve toward either side */
+    env->aim_offset = 0.0f;
+    env->frames = 0;
+}
+
+static float step_paddleball(void *state, int action, int *done)
+{
+    PaddleballEnv *env = state;
+    VersusData *v = &env->match;
+    uint8_t inputs[2] = {action == 1 ? VERSUS_LEFT : (action == 2 ? VERSUS_RIGHT : 0), 0};
+
+    /* Scripted opponent: follows the ball while it comes up, with a new error each rally */
+    const ArcadeSprite *top = &v->paddles[1];
+    if (v->ball.vy >= 0)
+        env->aim_offset = (float)arcade_rng_range(&env->rng, -OPPONENT_ERROR, OPPONENT_ERROR);
+    float target = v->ball.vy < 0 ? v->ball.x + v->ball.width / 2 + env->aim_offset : WINDOW_WIDTH / 2;
+    float center = top->x + top->width / 2;
+    if (target < center - 8.0f)
+        inputs[1] = VERSUS_LEFT;
+    else if (target > center + 8.0f)
+        inputs[1] = VERSUS_RIGHT;
+
+    int score[2] = {v->score[0], v->score[1]};
+    step_versus(v, inputs);
+    env->frames++;
+
+    *done = v->winner >= 0 || env->frames >= PADDLEBALL_ENV_FRAMES;
+    return (float)(v->score[0] - score[0]) - (float)(v->score[1] - score[1]);
+}
+
+static void observe_paddleball(const void *state, float *out)
+{
+    const VersusData *v = &((const PaddleballEnv *)state)->match;
+    out[0] = (v->paddles[0].x + PADDLE_WIDTH / 2) / WINDOW_WIDTH * 2.0f - 1.0f;
+    out[1] = (v->paddles[1].x + PADDLE_WIDTH / 2) / WINDOW_WIDTH * 2.0f - 1.0f;
+    out[2] = (v->ball.x + BALL_SIZE / 2) / WINDOW_WIDTH * 2.0f - 1.0f;
+    out[3] = (v->ball.y + BALL_SIZE / 2) / WINDOW_HEIGHT * 2.0f - 1.0f;
+    out[4] = v->ball.vx / VERSUS_BALL_SPEED;
+    out[5] = v->ball.vy / VERSUS_BALL_SPEED;
+    out[6] = v->serve_timer > 0 ? 1.0f : 0.0f;
+}
+
+static int draw_paddleball(const void *state, ArcadeAnySprite *sprites, int *types)
+{
+    const VersusData *v = &((const PaddleballEnv *)state)->match;
+    sprites[0].sprite = v->paddles[0];
+    sprites[1].sprite = v->paddles[1];
+    sprites[2].sprite = v->ball;
+    types[0] = types[1] = types[2] = SPRITE_COLOR;
+    return 3;
+}
+
+const ArcadeEnvDef paddleball_env = {
+    .name = "paddleball",
+    .state_size = sizeof(PaddleballEnv),
+    .world_width = WINDOW_WIDTH,
+    .world_height = WINDOW_HEIGHT,
+    .bg_color = 0x000000,
+    .action_count = 3,
+    .state_dims = 7,
+    .max_sprites = 3,
+    .reset = reset_paddleball,
+    .step = step_paddleball,
+    .observe = observe_paddleball,
+    .draw = draw_paddleball};
@@ -0,0 +1,202 @@
+/* =========================================================================
+ * Arcade Launcher - Documentation
+ * =========================================================================
+ * Author: GeorgeET15
+ * Description:
+ * One program hosting all four games. A menu lists Asteroids, Flappy Bird,
+ * Paddle Ball and Super Jump Adventure; picking one runs it in the same
+ * window through the ArcadeGame entry points each game exports, and leaving
+ * it comes back to the menu. Switching games does not start a new process
+ * or reopen the window: the window is resized and retitled in place
+ * (arcade_resize), and images stay decoded in the library's shared asset
+ * cache, so a game picked again starts without loading anything from disk.
+ *
+ * Controls:
+ * - Up/Down: Choose a game (menu)
+ * - Enter or Space: Play the chosen game (menu)
+ * - ESC: Back to the menu (in a game), Quit (menu)
+ * - Each game keeps its own controls otherwise
+ *
+ * Compilation:
+ * With make (builds the four games' sources in, with -DARCADE_LAUNCHER,
+ * and links ../arcade's libarcade):
+ *   make
+ * Linux (XRender backend, or make XRENDER=1; make XCB=1 for XCB):
+ *   make XRENDER=1
+ * Run from this directory (games load assets relative to their own
+ * directories, which the launcher switches to):
+ *   Linux: ./game
+ *   Windows: game.exe
+ *
+ * Notes:
+ * - The games' own Makefiles still build each one on its own; with
+ *   ARCADE_LAUNCHER defined a game leaves out its main.
+ * - Each switch prints how long the game took to start (init to first frame).
+ * - arcade.config.json here applies to every hosted game.
+ * ========================================================================= */
+
+#include "arcade.h"
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define chdir _chdir
+#else
+#include <unistd.h>
+#endif
+
+/* =========================================================================
+ * Launcher Constants
+ * =========================================================================
+ * Menu window size and colors.
+ */
+#define MENU_WIDTH 800
+#define MENU_HEIGHT 600
+#define MENU_BG 0x101020
+#define MENU_HIGHLIGHT 0x303060
+
+/* =========================================================================
+ * Hosted Games
+ * =========================================================================
+ * Each game's entry points and the directory its assets are relative to
+ * (entered while it runs, left when it returns to the menu).
+ */
+extern const ArcadeGame asteroids_game;
+extern const ArcadeGame flappybird_game;
+extern const ArcadeGame paddleball_game;
+extern const ArcadeGame superjump_game;
+
+typedef struct
+{
+    const ArcadeGame *game;
+    const char *dir;
+} HostedGame;
+
+static const HostedGame games[] = {
+    {&asteroids_game, "../Asteroids"},
+    {&flappybird_game, "../FlappyBird"},
+    {&paddleball_game, "../PaddleBall"},
+    {&superjump_game, "../SuperJumpAdventure"},
+};
+#define GAME_COUNT (int)(sizeof(games) / sizeof(games[0]))
+
+/* =========================================================================
+ * Menu
+ * ========================================================================= */
+
+/**
+ * draw_menu: Draws the game list with the chosen entry highlighted.
+ * Parameters:
+ * - selected: Index of the chosen game.
+ * - status: Line shown under the list (last start time), or NULL.
+ * Notes:
+ * - Text goes on after arcade_present, as in the games.
+ */
+static void draw_menu(int selected, const char *status)
+{
+    ArcadeFramebuffer screen = arcade_screen();
+    arcade_fill_rect(&screen, 0, 0, MENU_WIDTH, MENU_HEIGHT, MENU_BG);
+    arcade_fill_rect(&screen, 200, 180 + selected * 60, 400, 44, MENU_HIGHLIGHT);
+    arcade_present();
+
+    arcade_render_text_centered("ARCADE", 100.0f, 0xFFFFFF);
+    for (int i = 0; i < GAME_COUNT; i++)
+        arcade_render_text_centered(games[i].game->name, 210.0f + i * 60,
+                                    i == selected ? 0xFFFF00 : 0xC0C0C0);
+    arcade_render_text_centered("Up/Down: Choose  Enter: Play  ESC: Quit", 480.0f, 0x808080);
+    if (status)
+        arcade_render_text_centered(status, 530.0f, 0x808080);
+}
+
+/**
+ * play: Runs one game in the launcher's window until it ends or ESC.
+ * Parameters:
+ * - hosted: The game to run.
+ * - status: Buffer for the "started in" line shown back in the menu.
+ * - status_size: Size of status.
+ * Returns:
+ * - 1 to go back to the menu, 0 if the window was closed.
+ */
+static int play(const HostedGame *hosted, char *status, size_t status_size)
+{
+    const ArcadeGame *game = hosted->game;
+    double start = arcade_time();
+    int running = 1;
+
+    if (chdir(hosted->dir) != 0)
+    {
+        snprintf(status, status_size, "Cannot enter %s", hosted->dir);
+        return 1;
+    }
+    arcade_clear_keys();
+    if (arcade_resize(game->width, game->height, game->name, game->bg_color) != 0 || game->init() != 0)
+    {
+        snprintf(status, status_size, "%s failed to start", game->name);
+    }
+    else
+    {
+        int first = 1;
+        while ((running = arcade_running()) && arcade_update())
+        {
+            if (!game->update() || arcade_key_pressed(a_esc) == 2)
+                break;
+            if (first)
+            {
+                snprintf(status, status_size, "%s started in %.1f ms", game->name,
+                         (arcade_time() - start) * 1000.0);
+                printf("%s\n", status);
+                first = 0;
+            }
+            arcade_wait_frame();
+        }
+    }
+    game->shutdown();
+
+    if (chdir("../Launcher") != 0)
+        fprintf(stderr, "Cannot return to ../Launcher\n");
+    arcade_clear_keys();
+    if (running)
+        arcade_resize(MENU_WIDTH, MENU_HEIGHT, "ARCADE", MENU_BG);
+    return running;
+}
+
+/* =========================================================================
+ * Main Function
+ * =========================================================================
+ * Keeps images decoded across games (the asset cache, which
+ * arcade.config.json may still turn off) and runs the menu.
+ */
+int main(void)
+{
+    char status[128] = "";
+    int selected = 0;
+
+    arcade_set_backend(ARCADE_BACKEND_XRENDER);
+    arcade_set_asset_cache(1);
+    if (arcade_init(MENU_WIDTH, MENU_HEIGHT, "ARCADE", MENU_BG) != 0)
+    {
+        printf("Initialization failed\n");
+        return 1;
+    }
+
+    while (arcade_running() && arcade_update())
+    {
+        if (arcade_key_pressed_once(a_esc))
+            break;
+        if (arcade_key_pressed_once(a_up))
+            selected = (selected + GAME_COUNT - 1) % GAME_COUNT;
+        if (arcade_key_pressed_once(a_down))
+            selected = (selected + 1) % GAME_COUNT;
+        if (arcade_key_pressed_once(a_enter) || arcade_key_pressed_once(a_space))
+        {
+            if (!play(&games[selected], status, sizeof(status)))
+                break;
+            continue;
+        }
+        draw_menu(selected, status[0] ? status : NULL);
+        arcade_wait_frame();
+    }
+
+    arcade_quit();
+    return 0;
+}
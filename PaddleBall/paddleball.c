@@ -18,18 +18,28 @@
  * Controls:
  * - Left Arrow: Move paddle left (Playing state)
  * - Right Arrow: Move paddle right (Playing state)
- * - Space: Start game (Start state), Release ball (Playing state, if stuck)
+ * - Space: Start game (Start state), Release ball (Playing state, if stuck),
+ *          Launch a volley of balls (Playing state, multiball mode)
+ * - M: Start game in multiball mode (Start state)
  * - R: Restart game (GameOver state)
+ * - Backspace (hold): Rewind up to 2 seconds (Playing and GameOver states)
+ * - Versus mode: Left/Right move your paddle, R starts a rematch
  * - ESC: Quit (closes the window)
  *
  * Compilation:
+ * With make (links ../arcade's libarcade, built once for all games):
+ *   make
  * Linux:
- *   gcc -D_POSIX_C_SOURCE=199309L -o paddleball paddleball.c arcade.c -lX11 -lm
+ *   gcc -D_POSIX_C_SOURCE=199309L -o paddleball paddleball.c -I../arcade ../arcade/arcade.c -lX11 -lm -lpthread
  * Windows (MinGW):
- *   gcc -o paddleball paddleball.c arcade.c -lgdi32 -lwinmm
+ *   gcc -o paddleball paddleball.c -I../arcade ../arcade/arcade.c -lgdi32 -lwinmm -lws2_32
  * Run:
  *   Linux: ./paddleball
  *   Windows: paddleball.exe
+ * Versus over the network (one command per player; add --latency 50 --loss 5
+ * to both to test over loopback with simulated lag and packet loss):
+ *   ./paddleball --versus 7000 127.0.0.1 7001 0 [--delay 2]
+ *   ./paddleball --versus 7001 127.0.0.1 7000 1 [--delay 2]
  *
  * Optional Assets:
  * - Audio files (relative to executable, PCM 16-bit WAV):
@@ -42,6 +52,7 @@
  *
  * Dependencies:
  * - Arcade Library (arcade.h, arcade.c)
+ * - paddleball_sim.h: Versus match rules, shared with the match server
  * - STB libraries (included via arcade.c, used only if image sprites are added)
  * - Linux: libX11, libm, aplay (for audio, if used)
  * - Windows: gdi32, winmm
@@ -55,28 +66,46 @@
  * - Uses arcade_delta_time for frame-rate-independent movement, scaled to 60 FPS.
  * - Optional audio support for hit and break sounds; assets not required.
  * - Ball physics use simple vector reflection; could add spin or variable speed.
- * - arcade_sleep(16) targets ~60 FPS; consider removing for full frame-rate
- *   independence.
+ * - arcade_wait_frame paces the loop (60 FPS by default; see the performance
+ *   section of arcade.config.json).
+ * - Multiball mode keeps up to MAX_BALLS balls in a structure-of-arrays pool.
+ *   Bricks are found through their fixed grid instead of a linear scan, paddle
+ *   hits are resolved in one batch pass, and sounds play at most once per frame.
+ * - All simulation state lives in one flat GameData struct. Rewind copies it
+ *   into an ArcadeSnapshotRing every tick, and restart copies a start state
+ *   built once at startup instead of rebuilding the brick grid.
+ * - Versus mode uses rollback netcode (ArcadeRollback): each side plays its
+ *   own input at once, predicts the other's, and on a late input restores a
+ *   snapshot and resimulates up to 8 frames with the fixed-step step_versus.
+ * - The single-machine game is split into init/update/shutdown entry points
+ *   (paddleball_game), so the launcher in ../Launcher can host it; built
+ *   with -DARCADE_LAUNCHER it has no main.
  * ========================================================================= */
 
-#define ARCADE_IMPLEMENTATION
 #include "arcade.h"
+#include "paddleball_sim.h"
 #include <math.h>
 
 /* =========================================================================
  * Game Constants
  * =========================================================================
  * Define core game parameters, controlling the play area, objects, and
- * difficulty. Adjust these to tweak gameplay feel or challenge.
+ * difficulty. Adjust these to tweak gameplay feel or challenge. The play area,
+ * paddle and ball sizes, and versus rules live in paddleball_sim.h, shared
+ * with the match server.
  */
-#define WINDOW_WIDTH 800       /* Window width (pixels). Wide for paddle movement and brick grid. */
-#define WINDOW_HEIGHT 600      /* Window height (pixels). Tall for brick grid and play area. */
 #define MAX_BRICKS 50          /* Maximum number of bricks (5 rows x 10 columns). */
-#define PADDLE_WIDTH 100.0f    /* Paddle width (pixels). Wide for easier catching. */
-#define PADDLE_HEIGHT 20.0f    /* Paddle height (pixels). Thin for aesthetics. */
-#define BALL_SIZE 10.0f        /* Ball width/height (pixels). Small for precision. */
 #define BRICK_WIDTH 76.0f      /* Brick width (pixels). Fits 10 per row with spacing. */
 #define BRICK_HEIGHT 20.0f     /* Brick height (pixels). Short for compact grid. */
+#define BRICK_ROWS 5           /* Rows in the brick grid. */
+#define BRICK_COLS 10          /* Columns in the brick grid. */
+#define BRICK_GAP 4.0f         /* Gap between neighbouring bricks (pixels). */
+#define BRICK_LEFT 20.0f       /* Left margin of the brick grid (pixels). */
+#define BRICK_TOP 50.0f        /* Top margin of the brick grid (pixels). */
+#define MAX_BALLS 5000         /* Ball pool size in multiball mode. */
+#define MULTIBALL_VOLLEY 250   /* Balls launched per Space press in multiball mode. */
+#define MULTIBALL_SPLIT 2      /* Extra balls spawned by each broken brick in multiball mode. */
+#define REWIND_FRAMES 120      /* Ticks kept for rewind (2 seconds at 60 FPS). */
 
 /* =========================================================================
  * GameState Enum
@@ -108,57 +137,238 @@ typedef struct
 } Brick;
 
 /* =========================================================================
- * main Function
+ * BallPool Structure
  * =========================================================================
- * Entry point for the game. Initializes the Arcade environment, sets up
- * sprites, manages the game loop, and handles cleanup. The game loop processes
- * input, updates game state, and renders the scene at ~60 FPS using
- * arcade_delta_time for frame-rate-independent movement.
- * Parameters: None.
+ * Holds every ball of multiball mode as a structure of arrays so the
+ * movement, wall and paddle passes stream through contiguous floats.
+ * - x, y: Top-left position of each ball (pixels).
+ * - vx, vy: Velocity of each ball (pixels/frame at 60 FPS).
+ * - count: Number of live balls; live balls occupy indices [0, count).
+ * Note: Balls are removed by swapping the last live ball into the hole, so
+ * order is not preserved.
+ */
+typedef struct
+{
+    float x[MAX_BALLS];  /* Horizontal positions */
+    float y[MAX_BALLS];  /* Vertical positions */
+    float vx[MAX_BALLS]; /* Horizontal velocities */
+    float vy[MAX_BALLS]; /* Vertical velocities */
+    int count;           /* Live ball count */
+} BallPool;
+
+/* =========================================================================
+ * GameData Structure
+ * =========================================================================
+ * Holds the whole simulation state of one game in a single flat struct with
+ * no pointers, so it can be copied with memcpy into the rewind ring or over
+ * a freshly built start state.
+ * - state: Current GameState.
+ * - paddle, ball: Paddle sprite and the ball waiting on (or, in classic
+ *   mode, bouncing off) the paddle.
+ * - bricks, brick_count: Brick grid.
+ * - lives, score: Remaining lives and current score.
+ * - ball_stuck: 1 if the ball is stuck to the paddle, 0 if moving.
+ * - multiball: 1 in multiball mode, 0 for the classic single ball.
+ * - balls: Multiball pool.
+ * - rng: Random stream for launch angles, so rewinding replays the same
+ *   launches.
+ * Note: high_score is session state, not game state, and stays outside so
+ * rewinding or restarting never lowers it.
+ */
+typedef struct
+{
+    GameState state;         /* Start, Playing or GameOver */
+    ArcadeSprite paddle;     /* Player paddle */
+    ArcadeSprite ball;       /* Classic ball / multiball launch marker */
+    Brick bricks[MAX_BRICKS]; /* Brick grid */
+    int brick_count;         /* Number of bricks in the grid */
+    int lives;               /* Lives left; lose one per ball drop */
+    int score;               /* Bricks broken, 10 points each */
+    int ball_stuck;          /* 1 if ball is stuck to paddle, 0 if moving */
+    int multiball;           /* 1 in multiball mode, 0 for the classic single ball */
+    BallPool balls;          /* Multiball pool (~80 KB) */
+    ArcadeRng rng;           /* Launch angle random stream */
+} GameData;
+
+static GameData game;       /* Live game state (kept static, ~82 KB) */
+static GameData start_game; /* Start state, built once and copied on restart */
+static uint64_t seed;       /* Seed for the ball’s launch angles; restarts count up from it */
+static int high_score = 0;  /* Highest score in session, persists across restarts (and launcher visits) */
+static ArcadeSnapshotRing history; /* Rewind history: one snapshot per Playing tick */
+static SpriteGroup group;   /* Sprites drawn each frame */
+
+/* =========================================================================
+ * spawn_ball Function
+ * =========================================================================
+ * Appends a ball to the pool with the given position, speed and launch angle.
+ * Parameters:
+ * - pool: Ball pool to append to.
+ * - x, y: Top-left position of the new ball (pixels).
+ * - speed: Total speed (pixels/frame at 60 FPS).
+ * - degrees: Launch angle (90 = straight up).
+ * Returns: None.
+ * Notes:
+ * - Does nothing once the pool holds MAX_BALLS balls.
+ */
+static void spawn_ball(BallPool *pool, float x, float y, float speed, float degrees)
+{
+    if (pool->count >= MAX_BALLS)
+        return;
+    float angle = degrees * 3.14159f / 180.0f;
+    int i = pool->count++;
+    pool->x[i] = x;
+    pool->y[i] = y;
+    pool->vx[i] = speed * cosf(angle);
+    pool->vy[i] = -speed * sinf(angle);
+}
+
+/* =========================================================================
+ * find_brick_hit Function
+ * =========================================================================
+ * Finds an active brick overlapping a box by looking only at the grid cells
+ * the box covers, instead of scanning every brick.
+ * Parameters:
+ * - bricks: Brick array laid out row-major (BRICK_ROWS x BRICK_COLS).
+ * - x, y, w, h: Box to test (pixels).
  * Returns:
- * - 0 on successful exit.
- * - 1 if initialization fails (e.g., window creation).
- * Example:
- *   int main(void) {
- *       arcade_init(WINDOW_WIDTH, WINDOW_HEIGHT, "Paddle Ball", 0x000000);
- *       while (arcade_running() && arcade_update()) {
- *           float dt = arcade_delta_time();
- *           paddle.x += paddle.vx * dt * 60.0f; // Move paddle
- *           arcade_render_group(&group);
- *       }
- *       arcade_quit();
- *       return 0;
- *   }
+ * - Index of the first overlapping active brick in row-major order.
+ * - -1 if the box touches no active brick.
  * Notes:
- * - Initializes random seed for ball’s initial direction.
- * - Uses arcade_sleep(16) for approximate 60 FPS; consider removing for full
- *   frame-rate independence.
- * - Cleans up sprite group and Arcade resources on exit.
- * - Prints final score and high score to console on exit.
- * - Ball physics are simplified (reflection-based); could add spin or speed
- *   variation.
- * - Optional audio assets enhance feedback but are not required.
+ * - Row-major order matches the old linear scan, so the same brick wins when
+ *   a ball overlaps two bricks at once.
  */
-int main(void)
+static int find_brick_hit(const Brick *bricks, float x, float y, float w, float h)
 {
-    /* Seed random number generator for ball’s initial direction */
-    srand(time(NULL));
+    int col_min = (int)floorf((x - BRICK_LEFT) / (BRICK_WIDTH + BRICK_GAP));
+    int col_max = (int)floorf((x + w - BRICK_LEFT) / (BRICK_WIDTH + BRICK_GAP));
+    int row_min = (int)floorf((y - BRICK_TOP) / (BRICK_HEIGHT + BRICK_GAP));
+    int row_max = (int)floorf((y + h - BRICK_TOP) / (BRICK_HEIGHT + BRICK_GAP));
+    if (col_max < 0 || row_max < 0 || col_min >= BRICK_COLS || row_min >= BRICK_ROWS)
+        return -1; /* Box lies outside the grid */
+    if (col_min < 0)
+        col_min = 0;
+    if (row_min < 0)
+        row_min = 0;
+    if (col_max >= BRICK_COLS)
+        col_max = BRICK_COLS - 1;
+    if (row_max >= BRICK_ROWS)
+        row_max = BRICK_ROWS - 1;
+    for (int row = row_min; row <= row_max; row++)
+    {
+        for (int col = col_min; col <= col_max; col++)
+        {
+            const ArcadeSprite *b = &bricks[row * BRICK_COLS + col].sprite;
+            if (b->active && x < b->x + b->width && x + w > b->x && y < b->y + b->height && y + h > b->y)
+                return row * BRICK_COLS + col;
+        }
+    }
+    return -1;
+}
 
-    /* Game parameters */
-    float paddle_speed = 8.0f;       /* Paddle’s horizontal speed (pixels/frame at 60 FPS) */
-    float ball_speed = 6.0f;         /* Ball’s total speed (pixels/frame at 60 FPS, split into vx/vy) */
-    int lives = 3;                   /* Starting lives; lose one per ball drop */
-    int score = 0;                   /* Current player score (bricks broken, 10 points each) */
-    int high_score = 0;              /* Highest score in session, persists across restarts */
-    char text[64];                   /* Buffer for rendering score and lives */
-    char textGameOver[64];           /* Buffer for game over message */
-    char textHighScore[64];          /* Buffer for high score message */
-    char textRestart[64];            /* Buffer for restart prompt */
-    GameState state = Start;         /* Start in Start state (shows instructions) */
-    int ball_stuck = 1;              /* 1 if ball is stuck to paddle, 0 if moving */
+/* =========================================================================
+ * move_balls Function
+ * =========================================================================
+ * Advances every ball and reflects it off the left, right and top walls.
+ * Parameters:
+ * - pool: Ball pool to update.
+ * - scale: Delta time normalized to 60 FPS.
+ * Returns:
+ * - Number of wall bounces this frame (used to trigger one sound).
+ */
+static int move_balls(BallPool *pool, float scale)
+{
+    int bounces = 0;
+    for (int i = 0; i < pool->count; i++)
+    {
+        float x = pool->x[i] + pool->vx[i] * scale;
+        float y = pool->y[i] + pool->vy[i] * scale;
+        int hit_left = x <= 0.0f;
+        int hit_right = x + BALL_SIZE >= WINDOW_WIDTH;
+        int hit_top = y <= 0.0f;
+        pool->x[i] = hit_left ? 0.0f : (hit_right ? WINDOW_WIDTH - BALL_SIZE : x);
+        pool->y[i] = hit_top ? 0.0f : y;
+        pool->vx[i] = (hit_left | hit_right) ? -pool->vx[i] : pool->vx[i];
+        pool->vy[i] = hit_top ? -pool->vy[i] : pool->vy[i];
+        bounces += hit_left | hit_right | hit_top;
+    }
+    return bounces;
+}
+
+/* =========================================================================
+ * bounce_balls_off_paddle Function
+ * =========================================================================
+ * Tests every ball against the paddle in one branch-free pass and bounces the
+ * ones that overlap it, steering them by where they struck the paddle.
+ * Parameters:
+ * - pool: Ball pool to update.
+ * - paddle: Paddle sprite.
+ * - ball_speed: Maximum horizontal speed after a bounce.
+ * Returns:
+ * - Number of balls that hit the paddle this frame.
+ */
+static int bounce_balls_off_paddle(BallPool *pool, const ArcadeSprite *paddle, float ball_speed)
+{
+    float left = paddle->x, right = paddle->x + paddle->width;
+    float top = paddle->y, bottom = paddle->y + paddle->height;
+    int hits = 0;
+    for (int i = 0; i < pool->count; i++)
+    {
+        int hit = pool->x[i] < right && pool->x[i] + BALL_SIZE > left &&
+                  pool->y[i] < bottom && pool->y[i] + BALL_SIZE > top;
+        float hit_pos = (pool->x[i] + BALL_SIZE / 2 - left) / paddle->width; /* 0 to 1 across the paddle */
+        pool->vx[i] = hit ? ball_speed * (hit_pos - 0.5f) * 2.0f : pool->vx[i];
+        pool->vy[i] = hit ? -fabsf(pool->vy[i]) : pool->vy[i];
+        pool->y[i] = hit ? top - BALL_SIZE : pool->y[i];
+        hits += hit;
+    }
+    return hits;
+}
+
+/* =========================================================================
+ * remove_lost_balls Function
+ * =========================================================================
+ * Removes balls that fell off the bottom of the window.
+ * Parameters:
+ * - pool: Ball pool to compact.
+ * Returns: None.
+ */
+static void remove_lost_balls(BallPool *pool)
+{
+    for (int i = pool->count - 1; i >= 0; i--)
+    {
+        if (pool->y[i] + BALL_SIZE > WINDOW_HEIGHT)
+        {
+            int last = --pool->count; /* Swap the last live ball into the hole */
+            pool->x[i] = pool->x[last];
+            pool->y[i] = pool->y[last];
+            pool->vx[i] = pool->vx[last];
+            pool->vy[i] = pool->vy[last];
+        }
+    }
+}
+
+/* =========================================================================
+ * init_game Function
+ * =========================================================================
+ * Builds the start state: paddle centred near the bottom, ball stuck on it,
+ * the full brick grid, 3 lives and no score.
+ * Parameters:
+ * - g: GameData to fill.
+ * - seed: Seed of the launch angle random stream.
+ * Returns: None.
+ * Notes:
+ * - Called once at startup; restarts copy the result instead of rebuilding.
+ */
+static void init_game(GameData *g, uint64_t seed)
+{
+    memset(g, 0, sizeof(*g));
+    arcade_rng_seed(&g->rng, seed);
+    g->state = Start; /* Start in Start state (shows instructions) */
+    g->lives = 3;     /* Starting lives; lose one per ball drop */
+    g->ball_stuck = 1;
 
     /* Initialize paddle sprite (blue rectangle, near bottom-center) */
-    ArcadeSprite paddle = {
+    g->paddle = (ArcadeSprite){
         .x = WINDOW_WIDTH / 2 - PADDLE_WIDTH / 2, /* Center horizontally */
         .y = WINDOW_HEIGHT - 50.0f,               /* Near bottom of screen */
         .width = PADDLE_WIDTH,
@@ -171,9 +381,9 @@ int main(void)
     /* Note: For image sprite, could use: ArcadeImageSprite paddle = arcade_create_image_sprite(x, y, PADDLE_WIDTH, PADDLE_HEIGHT, "./assets/paddle.png"); */
 
     /* Initialize ball sprite (white square, starts on paddle) */
-    ArcadeSprite ball = {
-        .x = paddle.x + PADDLE_WIDTH / 2 - BALL_SIZE / 2, /* Center on paddle */
-        .y = paddle.y - BALL_SIZE,                        /* Just above paddle */
+    g->ball = (ArcadeSprite){
+        .x = g->paddle.x + PADDLE_WIDTH / 2 - BALL_SIZE / 2, /* Center on paddle */
+        .y = g->paddle.y - BALL_SIZE,                        /* Just above paddle */
         .width = BALL_SIZE,
         .height = BALL_SIZE, /* 10x10 square */
         .vx = 0.0f,
@@ -184,287 +394,540 @@ int main(void)
     /* Note: For image sprite, could use: ArcadeImageSprite ball = arcade_create_image_sprite(x, y, BALL_SIZE, BALL_SIZE, "./assets/ball.png"); */
 
     /* Initialize bricks array (colored rectangles, 5 rows x 10 columns) */
-    Brick bricks[MAX_BRICKS];
-    int brick_count = 0;
     unsigned int row_colors[] = {0xFF0000, 0xFF9900, 0xFFFF00, 0x00FF00, 0x00FFFF}; /* Red, Orange, Yellow, Green, Cyan */
-    for (int row = 0; row < 5; row++)
+    for (int row = 0; row < BRICK_ROWS; row++)
     {
-        for (int col = 0; col < 10; col++)
+        for (int col = 0; col < BRICK_COLS; col++)
         {
-            bricks[brick_count].sprite.x = col * (BRICK_WIDTH + 4.0f) + 20.0f; /* 4-pixel gap between bricks, 20-pixel left margin */
-            bricks[brick_count].sprite.y = row * (BRICK_HEIGHT + 4.0f) + 50.0f; /* 4-pixel gap between rows, 50-pixel top margin */
-            bricks[brick_count].sprite.width = BRICK_WIDTH;   /* 76x20 rectangle */
-            bricks[brick_count].sprite.height = BRICK_HEIGHT;
-            bricks[brick_count].sprite.vx = 0.0f;            /* Static, no movement */
-            bricks[brick_count].sprite.vy = 0.0f;
-            bricks[brick_count].sprite.color = row_colors[row]; /* Assign color based on row */
-            bricks[brick_count].sprite.active = 1;            /* Visible and collidable */
-            brick_count++;
+            ArcadeSprite *brick = &g->bricks[g->brick_count].sprite;
+            brick->x = col * (BRICK_WIDTH + BRICK_GAP) + BRICK_LEFT; /* 4-pixel gap between bricks, 20-pixel left margin */
+            brick->y = row * (BRICK_HEIGHT + BRICK_GAP) + BRICK_TOP; /* 4-pixel gap between rows, 50-pixel top margin */
+            brick->width = BRICK_WIDTH;   /* 76x20 rectangle */
+            brick->height = BRICK_HEIGHT;
+            brick->vx = 0.0f;             /* Static, no movement */
+            brick->vy = 0.0f;
+            brick->color = row_colors[row]; /* Assign color based on row */
+            brick->active = 1;            /* Visible and collidable */
+            g->brick_count++;
         }
     }
     /* Note: For image sprites, could use: ArcadeImageSprite brick = arcade_create_image_sprite(x, y, BRICK_WIDTH, BRICK_HEIGHT, "./assets/brick.png"); */
+}
 
-    /* Initialize sprite group for rendering */
-    SpriteGroup group;
-    arcade_init_group(&group, MAX_BRICKS + 2); /* Capacity for paddle, ball, and all bricks */
-
-    /* Initialize Arcade environment (window, rendering, input) */
-    if (arcade_init(WINDOW_WIDTH, WINDOW_HEIGHT, "Paddle Ball", 0x000000) != 0)
+/* =========================================================================
+ * run_versus Function
+ * =========================================================================
+ * Plays a two-player match against a peer over UDP using rollback netcode.
+ * Parameters:
+ * - local_port: UDP port to listen on.
+ * - peer_host, peer_port: Address of the other player.
+ * - player: This machine's player (0 = blue bottom, 1 = red top).
+ * - input_delay: Frames of local input delay (both players must agree).
+ * - latency_ms, loss_percent: Simulated network conditions for testing.
+ * Returns:
+ * - 0 on normal exit, 1 if the connection or window cannot be set up.
+ * Example (two windows on one machine, 50 ms each way, 5% loss):
+ *   ./game --versus 7000 127.0.0.1 7001 0 --latency 50 --loss 5
+ *   ./game --versus 7001 127.0.0.1 7000 1 --latency 50 --loss 5
+ */
+static int run_versus(int local_port, const char *peer_host, int peer_port, int player,
+                      int input_delay, int latency_ms, int loss_percent)
+{
+    static VersusData match; /* Live match state */
+    ArcadeNet net;
+    ArcadeRollback session;
+    char text[128];
+
+    init_versus(&match);
+    if (arcade_net_open(&net, local_port, peer_host, peer_port) != 0)
+        return 1;
+    arcade_net_simulate(&net, latency_ms, loss_percent);
+    if (arcade_rollback_init(&session, &net, &match, sizeof(match), step_versus, player, input_delay) != 0)
+    {
+        fprintf(stderr, "Invalid versus settings (player must be 0 or 1, delay 0-%d)\n", ARCADE_ROLLBACK_FRAMES);
+        arcade_net_close(&net);
+        return 1;
+    }
+    if (arcade_init(WINDOW_WIDTH, WINDOW_HEIGHT, "Paddle Ball - Versus", 0x000000) != 0)
     {
-        arcade_free_group(&group); /* Free sprite group if initialization fails */
         fprintf(stderr, "Initialization failed\n");
-        return 1; /* Exit if window creation fails */
+        arcade_rollback_free(&session);
+        arcade_net_close(&net);
+        return 1;
     }
 
-    /* Main game loop: runs until window is closed or ESC is pressed */
+    SpriteGroup group;
+    arcade_init_group(&group, 3); /* Two paddles and the ball */
+    int total_points = 0;         /* Points heard so far, to play one sound per point */
+
     while (arcade_running() && arcade_update())
     {
-        /* Get delta time for frame-rate-independent movement */
-        float delta_time = arcade_delta_time();
-        float scale = delta_time * 60.0f; /* Normalize to 60 FPS for consistent speed */
+        /* Sample this machine's input and advance the match (rolling back if needed) */
+        uint8_t input = 0;
+        if (arcade_key_pressed(a_left) == 2)
+            input |= VERSUS_LEFT;
+        if (arcade_key_pressed(a_right) == 2)
+            input |= VERSUS_RIGHT;
+        if (arcade_key_pressed(a_r) == 2)
+            input |= VERSUS_RESTART;
+        int advanced = arcade_rollback_update(&session, input);
+
+        /* Render the current (possibly predicted) frame */
+        group.count = 0;
+        arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = match.paddles[0]}, SPRITE_COLOR);
+        arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = match.paddles[1]}, SPRITE_COLOR);
+        if (match.winner < 0)
+            arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = match.ball}, SPRITE_COLOR);
+        arcade_render_group(&group);
+
+        snprintf(text, sizeof(text), "Blue %d - %d Red   (you are %s)", match.score[0], match.score[1], player == 0 ? "Blue, bottom" : "Red, top");
+        arcade_render_text(text, 10.0f, WINDOW_HEIGHT / 2.0f - 20.0f, 0xFFFFFF);
+        snprintf(text, sizeof(text), "RTT %.0f ms  delay %d (suggested %d)  rollback %d",
+                 session.rtt_ms, input_delay, arcade_rollback_suggest_delay(&session, 1000.0f / 60.0f), session.last_rollback);
+        arcade_render_text(text, 10.0f, WINDOW_HEIGHT / 2.0f + 10.0f, 0x808080);
+        if (!advanced)
+            arcade_render_text_centered("Waiting for peer...", WINDOW_HEIGHT / 2.0f + 50.0f, 0xFFFFFF);
+        if (match.winner >= 0)
+        {
+            snprintf(text, sizeof(text), "%s wins! Press R for a rematch", match.winner == 0 ? "Blue" : "Red");
+            arcade_render_text_centered(text, WINDOW_HEIGHT / 2.0f + 50.0f, 0xFFFFFF);
+        }
+
+        /* Sounds stay out of step_versus so resimulated frames never replay them */
+        if (match.score[0] + match.score[1] > total_points)
+            arcade_play_sound("./assets/break.wav");
+        total_points = match.score[0] + match.score[1];
+
+        arcade_wait_frame();
+    }
+
+    printf("Versus: Blue %d - %d Red, %d packets sent, %d received, %d dropped, %d stalls\n",
+           match.score[0], match.score[1], net.sent, net.received, net.dropped, session.stalls);
+    arcade_free_group(&group);
+    arcade_rollback_free(&session);
+    arcade_net_close(&net);
+    arcade_quit();
+    return 0;
+}
+
+/* =========================================================================
+ * paddleball_init Function
+ * =========================================================================
+ * Builds the start state, the rewind history and the sprite group.
+ * Parameters: None.
+ * Returns:
+ * - 0 on success.
+ * - 1 if the rewind history cannot be allocated.
+ * Notes:
+ * - Seeds launch angles from the clock.
+ */
+static int paddleball_init(void)
+{
+    seed = (uint64_t)time(NULL);
+
+    /* Build the start state once; the game and every restart copy it */
+    init_game(&start_game, seed);
+    game = start_game;
+
+    if (arcade_snapshot_ring_init(&history, sizeof(GameData), REWIND_FRAMES) != 0)
+    {
+        fprintf(stderr, "Rewind history allocation failed\n");
+        return 1;
+    }
+    arcade_init_group(&group, MAX_BRICKS + 2 + MAX_BALLS); /* Capacity for paddle, ball, all bricks and the multiball pool */
+    return 0;
+}
+
+/* =========================================================================
+ * paddleball_update Function
+ * =========================================================================
+ * Runs one frame: renders the scene, then handles input and game logic for
+ * the current state, using arcade_delta_time for frame-rate-independent
+ * movement.
+ * Parameters: None.
+ * Returns: 1 (the game only ends when its window closes).
+ */
+static int paddleball_update(void)
+{
+    /* Game parameters */
+    float paddle_speed = 8.0f;       /* Paddle’s horizontal speed (pixels/frame at 60 FPS) */
+    float ball_speed = 6.0f;         /* Ball’s total speed (pixels/frame at 60 FPS, split into vx/vy) */
+    char text[64];                   /* Buffer for rendering score and lives */
+    char textGameOver[64];           /* Buffer for game over message */
+    char textHighScore[64];          /* Buffer for high score message */
+    char textRestart[64];            /* Buffer for restart prompt */
 
-        /* Update score and lives display (rendered every frame) */
-        snprintf(text, sizeof(text), "Score: %d  Lives: %d", score, lives);
+    /* Get delta time for frame-rate-independent movement */
+    float delta_time = arcade_delta_time();
+    float scale = delta_time * 60.0f; /* Normalize to 60 FPS for consistent speed */
 
-        /* Reset sprite group to rebuild with active sprites */
-        group.count = 0; /* Clear previous frame’s sprites for fresh rendering */
+    /* Update score and lives display (rendered every frame) */
+    if (game.multiball)
+        snprintf(text, sizeof(text), "Score: %d  Lives: %d  Balls: %d", game.score, game.lives, game.balls.count);
+    else
+        snprintf(text, sizeof(text), "Score: %d  Lives: %d", game.score, game.lives);
 
-        /* Add active sprites to render group (paddle, ball, bricks) */
-        if (paddle.active)
+    /* Sounds requested this frame; each plays at most once no matter how many balls collide */
+    int play_hit = 0, play_break = 0;
+
+    /* Reset sprite group to rebuild with active sprites */
+    group.count = 0; /* Clear previous frame’s sprites for fresh rendering */
+
+    /* Add active sprites to render group (paddle, ball, bricks) */
+    if (game.paddle.active)
+    {
+        arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = game.paddle}, SPRITE_COLOR); /* Add paddle if active */
+    }
+    if (game.ball.active && (!game.multiball || game.ball_stuck))
+    {
+        arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = game.ball}, SPRITE_COLOR); /* Add ball if active (multiball shows it only while waiting to launch) */
+    }
+    for (int i = 0; i < game.balls.count; i++)
+    {
+        ArcadeSprite s = {.x = game.balls.x[i], .y = game.balls.y[i], .width = BALL_SIZE, .height = BALL_SIZE, .color = 0xFFFFFF, .active = 1};
+        arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = s}, SPRITE_COLOR); /* Add pooled multiball balls */
+    }
+    for (int i = 0; i < game.brick_count; i++)
+    {
+        if (game.bricks[i].sprite.active)
         {
-            arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = paddle}, SPRITE_COLOR); /* Add paddle if active */
+            arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = game.bricks[i].sprite}, SPRITE_COLOR); /* Add active bricks */
         }
-        if (ball.active)
+    }
+
+    /* Render the scene (clears screen, draws sprites, updates window) */
+    arcade_render_group(&group);
+    arcade_render_text(text, 10.0f, 30.0f, 0xFFFFFF); /* Score and lives in top-left (white) */
+
+    /* Handle game logic based on current state */
+    switch (game.state)
+    {
+    case Start:
+        /* Show blinking start prompt and high score */
+        arcade_render_text_centered_blink("Press Space to Start", WINDOW_HEIGHT / 2.0f, 0xFFFFFF, 30); /* Blinks every 0.5s at 60 FPS */
+        snprintf(text, sizeof(text), "High Score: %d", high_score);
+        arcade_render_text_centered(text, WINDOW_HEIGHT / 2.0f + 50.0f, 0xFFFFFF); /* High score below prompt */
+        arcade_render_text_centered("Press M for Multiball", WINDOW_HEIGHT / 2.0f + 80.0f, 0xFFFFFF);
+        if (arcade_key_pressed_once(a_space) == 2)
         {
-            arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = ball}, SPRITE_COLOR); /* Add ball if active */
+            arcade_clear_keys(); /* Clear input to prevent immediate ball release in Playing state */
+            game.multiball = 0;
+            game.state = Playing;     /* Transition to gameplay */
         }
-        for (int i = 0; i < brick_count; i++)
+        else if (arcade_key_pressed_once(a_m) == 2)
         {
-            if (bricks[i].sprite.active)
-            {
-                arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = bricks[i].sprite}, SPRITE_COLOR); /* Add active bricks */
-            }
+            arcade_clear_keys(); /* Clear input to prevent an immediate volley in Playing state */
+            game.multiball = 1;
+            game.state = Playing;     /* Transition to multiball gameplay */
         }
+        break;
 
-        /* Render the scene (clears screen, draws sprites, updates window) */
-        arcade_render_group(&group);
-        arcade_render_text(text, 10.0f, 30.0f, 0xFFFFFF); /* Score and lives in top-left (white) */
-
-        /* Handle game logic based on current state */
-        switch (state)
+    case Playing:
+        /* Hold Backspace to rewind: step back one tick per frame instead of simulating */
+        if (arcade_key_pressed(a_backspace) == 2 && arcade_snapshot_pop(&history, &game) == 0)
         {
-        case Start:
-            /* Show blinking start prompt and high score */
-            arcade_render_text_centered_blink("Press Space to Start", WINDOW_HEIGHT / 2.0f, 0xFFFFFF, 30); /* Blinks every 0.5s at 60 FPS */
-            snprintf(text, sizeof(text), "High Score: %d", high_score);
-            arcade_render_text_centered(text, WINDOW_HEIGHT / 2.0f + 50.0f, 0xFFFFFF); /* High score below prompt */
-            if (arcade_key_pressed_once(a_space) == 2)
-            {
-                arcade_clear_keys(); /* Clear input to prevent immediate ball release in Playing state */
-                state = Playing;     /* Transition to gameplay */
-            }
             break;
+        }
+        arcade_snapshot_push(&history, &game); /* Record the state this tick starts from */
 
-        case Playing:
-            /* Handle paddle movement (left/right arrow keys) */
-            if (arcade_key_pressed(a_right) == 2 && paddle.active)
-            {
-                paddle.vx = paddle_speed; /* Set rightward velocity */
-            }
-            else if (arcade_key_pressed(a_left) == 2 && paddle.active)
+        /* Handle paddle movement (left/right arrow keys) */
+        if (arcade_key_pressed(a_right) == 2 && game.paddle.active)
+        {
+            game.paddle.vx = paddle_speed; /* Set rightward velocity */
+        }
+        else if (arcade_key_pressed(a_left) == 2 && game.paddle.active)
+        {
+            game.paddle.vx = -paddle_speed; /* Set leftward velocity */
+        }
+        else
+        {
+            game.paddle.vx = 0.0f; /* Stop movement if no keys pressed */
+        }
+
+        /* Update paddle position and clamp to window bounds */
+        if (game.paddle.active)
+        {
+            game.paddle.x += game.paddle.vx * scale; /* Scale movement by delta time */
+            if (game.paddle.x < 0)
             {
-                paddle.vx = -paddle_speed; /* Set leftward velocity */
+                game.paddle.x = 0; /* Prevent moving off left edge */
             }
-            else
+            else if (game.paddle.x + game.paddle.width > WINDOW_WIDTH)
             {
-                paddle.vx = 0.0f; /* Stop movement if no keys pressed */
+                game.paddle.x = WINDOW_WIDTH - game.paddle.width; /* Prevent moving off right edge */
             }
+        }
+
+        /* Handle ball release (Space key, if stuck) */
+        if (!game.multiball && arcade_key_pressed_once(a_space) == 2 && game.ball_stuck)
+        {
+            game.ball_stuck = 0; /* Release ball from paddle */
+            /* Set initial velocity with random horizontal direction (60–120 degrees) */
+            float angle = arcade_rng_range(&game.rng, 60, 119) * 3.14159f / 180.0f; /* Convert degrees to radians */
+            game.ball.vx = ball_speed * cosf(angle); /* Horizontal component */
+            game.ball.vy = -ball_speed * sinf(angle); /* Vertical component (upward) */
+            arcade_play_sound("./assets/hit.wav"); /* Play optional launch sound */
+        }
 
-            /* Update paddle position and clamp to window bounds */
-            if (paddle.active)
+        /* Multiball: launch volleys, then run each pass over the whole pool */
+        if (game.multiball)
+        {
+            if (arcade_key_pressed_once(a_space) == 2 && game.balls.count < MAX_BALLS)
             {
-                paddle.x += paddle.vx * scale; /* Scale movement by delta time */
-                if (paddle.x < 0)
-                {
-                    paddle.x = 0; /* Prevent moving off left edge */
-                }
-                else if (paddle.x + paddle.width > WINDOW_WIDTH)
+                /* Fan the volley out between 30 and 150 degrees from the paddle centre */
+                for (int i = 0; i < MULTIBALL_VOLLEY; i++)
                 {
-                    paddle.x = WINDOW_WIDTH - paddle.width; /* Prevent moving off right edge */
+                    float degrees = 30.0f + 120.0f * (i + 0.5f) / MULTIBALL_VOLLEY + arcade_rng_float(&game.rng);
+                    spawn_ball(&game.balls, game.ball.x, game.ball.y, ball_speed, degrees);
                 }
+                game.ball_stuck = 0;
+                play_hit = 1;
             }
 
-            /* Handle ball release (Space key, if stuck) */
-            if (arcade_key_pressed_once(a_space) == 2 && ball_stuck)
+            if (!game.ball_stuck)
             {
-                ball_stuck = 0; /* Release ball from paddle */
-                /* Set initial velocity with random horizontal direction (60–120 degrees) */
-                float angle = (rand() % 60 + 60) * 3.14159f / 180.0f; /* Convert degrees to radians */
-                ball.vx = ball_speed * cosf(angle); /* Horizontal component */
-                ball.vy = -ball_speed * sinf(angle); /* Vertical component (upward) */
-                arcade_play_sound("./assets/hit.wav"); /* Play optional launch sound */
-            }
-
-            /* Update ball position */
-            if (!ball_stuck)
-            {
-                ball.x += ball.vx * scale; /* Scale horizontal movement by delta time */
-                ball.y += ball.vy * scale; /* Scale vertical movement by delta time */
-
-                /* Handle wall collisions */
-                if (ball.x <= 0)
-                { /* Left wall collision */
-                    ball.x = 0; /* Clamp to edge */
-                    ball.vx = -ball.vx; /* Reflect horizontally */
-                    arcade_play_sound("./assets/hit.wav"); /* Play optional collision sound */
-                }
-                else if (ball.x + ball.width >= WINDOW_WIDTH)
-                { /* Right wall collision */
-                    ball.x = WINDOW_WIDTH - ball.width; /* Clamp to edge */
-                    ball.vx = -ball.vx; /* Reflect horizontally */
-                    arcade_play_sound("./assets/hit.wav");
-                }
-                if (ball.y <= 0)
-                { /* Top wall collision */
-                    ball.y = 0; /* Clamp to edge */
-                    ball.vy = -ball.vy; /* Reflect vertically */
-                    arcade_play_sound("./assets/hit.wav");
-                }
-
-                /* Handle paddle collision */
-                if (arcade_check_collision(&ball, &paddle))
-                {
-                    ball.y = paddle.y - ball.height; /* Move ball above paddle to prevent sticking */
-                    ball.vy = -ball.vy; /* Reflect vertically */
-                    /* Adjust horizontal velocity based on hit position on paddle */
-                    float hit_pos = (ball.x + ball.width / 2 - paddle.x) / paddle.width; /* 0 to 1, normalized hit position */
-                    ball.vx = ball_speed * (hit_pos - 0.5f) * 2.0f; /* Scale from -ball_speed to +ball_speed */
-                    arcade_play_sound("./assets/hit.wav"); /* Play optional collision sound */
-                }
-
-                /* Handle brick collisions */
-                for (int i = 0; i < brick_count; i++)
+                if (move_balls(&game.balls, scale) > 0)
+                    play_hit = 1;
+                if (bounce_balls_off_paddle(&game.balls, &game.paddle, ball_speed) > 0)
+                    play_hit = 1;
+
+                /* Brick collisions: each ball looks up only the grid cells it overlaps */
+                int live = game.balls.count; /* Balls split off this frame start moving next frame */
+                for (int i = 0; i < live; i++)
                 {
-                    if (bricks[i].sprite.active && arcade_check_collision(&ball, &bricks[i].sprite))
-                    {
-                        bricks[i].sprite.active = 0; /* Destroy brick */
-                        score += 10; /* Award 10 points per brick */
-                        if (score > high_score)
-                            high_score = score; /* Update high score if current score exceeds it */
-                        /* Simple reflection: reverse vertical velocity (assumes top/bottom hit) */
-                        ball.vy = -ball.vy;
-                        arcade_play_sound("./assets/break.wav"); /* Play optional brick break sound */
-                        break; /* Handle one collision per frame to avoid multiple hits */
-                    }
+                    int hit = find_brick_hit(game.bricks, game.balls.x[i], game.balls.y[i], BALL_SIZE, BALL_SIZE);
+                    if (hit < 0)
+                        continue;
+                    game.bricks[hit].sprite.active = 0; /* Destroy brick */
+                    game.score += 10;                   /* Award 10 points per brick */
+                    if (game.score > high_score)
+                        high_score = game.score;
+                    game.balls.vy[i] = -game.balls.vy[i];
+                    for (int s = 0; s < MULTIBALL_SPLIT; s++)
+                        spawn_ball(&game.balls, game.balls.x[i], game.balls.y[i], ball_speed, arcade_rng_float_range(&game.rng, 0.0f, 360.0f));
+                    play_break = 1;
                 }
 
-                /* Check if ball falls off bottom */
-                if (ball.y + ball.height > WINDOW_HEIGHT)
+                remove_lost_balls(&game.balls);
+                if (game.balls.count == 0)
                 {
-                    lives--; /* Lose one life */
-                    if (lives <= 0)
+                    game.lives--; /* The whole pool was lost */
+                    if (game.lives <= 0)
                     {
-                        state = GameOver; /* End game if no lives remain */
-                        paddle.active = 0; /* Hide paddle */
-                        ball.active = 0; /* Hide ball */
+                        game.state = GameOver;
+                        game.paddle.active = 0;
+                        game.ball.active = 0;
                     }
                     else
                     {
-                        /* Reset ball to paddle for next attempt */
-                        ball_stuck = 1;
-                        ball.x = paddle.x + PADDLE_WIDTH / 2 - BALL_SIZE / 2; /* Center on paddle */
-                        ball.y = paddle.y - BALL_SIZE; /* Position above paddle */
-                        ball.vx = 0.0f; /* Reset velocity */
-                        ball.vy = 0.0f;
+                        game.ball_stuck = 1; /* Next volley waits on the paddle */
                     }
                 }
             }
-            else
+            if (game.ball_stuck)
             {
-                /* Keep ball stuck to paddle, updating position to follow paddle */
-                ball.x = paddle.x + PADDLE_WIDTH / 2 - BALL_SIZE / 2;
-                ball.y = paddle.y - BALL_SIZE;
+                game.ball.x = game.paddle.x + PADDLE_WIDTH / 2 - BALL_SIZE / 2;
+                game.ball.y = game.paddle.y - BALL_SIZE;
+            }
+        }
+        /* Update ball position */
+        else if (!game.ball_stuck)
+        {
+            game.ball.x += game.ball.vx * scale; /* Scale horizontal movement by delta time */
+            game.ball.y += game.ball.vy * scale; /* Scale vertical movement by delta time */
+
+            /* Handle wall collisions */
+            if (game.ball.x <= 0)
+            { /* Left wall collision */
+                game.ball.x = 0; /* Clamp to edge */
+                game.ball.vx = -game.ball.vx; /* Reflect horizontally */
+                arcade_play_sound("./assets/hit.wav"); /* Play optional collision sound */
+            }
+            else if (game.ball.x + game.ball.width >= WINDOW_WIDTH)
+            { /* Right wall collision */
+                game.ball.x = WINDOW_WIDTH - game.ball.width; /* Clamp to edge */
+                game.ball.vx = -game.ball.vx; /* Reflect horizontally */
+                arcade_play_sound("./assets/hit.wav");
+            }
+            if (game.ball.y <= 0)
+            { /* Top wall collision */
+                game.ball.y = 0; /* Clamp to edge */
+                game.ball.vy = -game.ball.vy; /* Reflect vertically */
+                arcade_play_sound("./assets/hit.wav");
             }
 
-            /* Check for win condition (all bricks destroyed) */
-            int active_bricks = 0;
-            for (int i = 0; i < brick_count; i++)
+            /* Handle paddle collision */
+            if (arcade_check_collision(&game.ball, &game.paddle))
             {
-                if (bricks[i].sprite.active)
-                    active_bricks++; /* Count remaining bricks */
+                game.ball.y = game.paddle.y - game.ball.height; /* Move ball above paddle to prevent sticking */
+                game.ball.vy = -game.ball.vy; /* Reflect vertically */
+                /* Adjust horizontal velocity based on hit position on paddle */
+                float hit_pos = (game.ball.x + game.ball.width / 2 - game.paddle.x) / game.paddle.width; /* 0 to 1, normalized hit position */
+                game.ball.vx = ball_speed * (hit_pos - 0.5f) * 2.0f; /* Scale from -ball_speed to +ball_speed */
+                arcade_play_sound("./assets/hit.wav"); /* Play optional collision sound */
             }
-            if (active_bricks == 0)
+
+            /* Handle brick collisions (one per frame, found through the brick grid) */
+            int hit = find_brick_hit(game.bricks, game.ball.x, game.ball.y, game.ball.width, game.ball.height);
+            if (hit >= 0)
             {
-                state = GameOver; /* End game (win condition) */
-                paddle.active = 0; /* Hide paddle */
-                ball.active = 0; /* Hide ball */
+                game.bricks[hit].sprite.active = 0; /* Destroy brick */
+                game.score += 10; /* Award 10 points per brick */
+                if (game.score > high_score)
+                    high_score = game.score; /* Update high score if current score exceeds it */
+                /* Simple reflection: reverse vertical velocity (assumes top/bottom hit) */
+                game.ball.vy = -game.ball.vy;
+                arcade_play_sound("./assets/break.wav"); /* Play optional brick break sound */
             }
-            break;
 
-        case GameOver:
-            /* Show game over message with score, high score, and restart prompt */
-            snprintf(textGameOver, sizeof(textGameOver), "Game Over! Score: %d", score);
-            snprintf(textHighScore, sizeof(textHighScore), "High Score: %d", high_score);
-            snprintf(textRestart, sizeof(textRestart), "Press R to restart");
-            arcade_render_text_centered(textGameOver, WINDOW_HEIGHT / 2.7f, 0xFFFFFF);  /* Positioned higher for spacing */
-            arcade_render_text_centered(textHighScore, WINDOW_HEIGHT / 2.2f, 0xFFFFFF); /* Even spacing for high score */
-            arcade_render_text_centered(textRestart, WINDOW_HEIGHT / 1.7f, 0xFFFFFF);   /* Lower for restart prompt */
-
-            /* Handle restart input */
-            if (arcade_key_pressed_once(a_r) == 2)
+            /* Check if ball falls off bottom */
+            if (game.ball.y + game.ball.height > WINDOW_HEIGHT)
             {
-                arcade_clear_keys(); /* Clear input to prevent immediate actions in Playing state */
-
-                /* Reset paddle */
-                paddle.x = WINDOW_WIDTH / 2 - PADDLE_WIDTH / 2; /* Center horizontally */
-                paddle.y = WINDOW_HEIGHT - 50.0f;               /* Near bottom */
-                paddle.vx = 0.0f;
-                paddle.vy = 0.0f;
-                paddle.active = 1; /* Re-enable paddle */
-
-                /* Reset ball */
-                ball.x = paddle.x + PADDLE_WIDTH / 2 - BALL_SIZE / 2; /* Center on paddle */
-                ball.y = paddle.y - BALL_SIZE;                        /* Above paddle */
-                ball.vx = 0.0f;
-                ball.vy = 0.0f;
-                ball.active = 1; /* Re-enable ball */
-                ball_stuck = 1;  /* Ball starts stuck to paddle */
-
-                /* Reset bricks */
-                brick_count = 0;
-                for (int row = 0; row < 5; row++)
+                game.lives--; /* Lose one life */
+                if (game.lives <= 0)
                 {
-                    for (int col = 0; col < 10; col++)
-                    {
-                        bricks[brick_count].sprite.x = col * (BRICK_WIDTH + 4.0f) + 20.0f; /* Rebuild grid */
-                        bricks[brick_count].sprite.y = row * (BRICK_HEIGHT + 4.0f) + 50.0f;
-                        bricks[brick_count].sprite.width = BRICK_WIDTH;
-                        bricks[brick_count].sprite.height = BRICK_HEIGHT;
-                        bricks[brick_count].sprite.vx = 0.0f;
-                        bricks[brick_count].sprite.vy = 0.0f;
-                        bricks[brick_count].sprite.color = row_colors[row]; /* Reassign row colors */
-                        bricks[brick_count].sprite.active = 1; /* Reactivate all bricks */
-                        brick_count++;
-                    }
+                    game.state = GameOver; /* End game if no lives remain */
+                    game.paddle.active = 0; /* Hide paddle */
+                    game.ball.active = 0; /* Hide ball */
+                }
+                else
+                {
+                    /* Reset ball to paddle for next attempt */
+                    game.ball_stuck = 1;
+                    game.ball.x = game.paddle.x + PADDLE_WIDTH / 2 - BALL_SIZE / 2; /* Center on paddle */
+                    game.ball.y = game.paddle.y - BALL_SIZE; /* Position above paddle */
+                    game.ball.vx = 0.0f; /* Reset velocity */
+                    game.ball.vy = 0.0f;
                 }
-
-                /* Reset game state */
-                score = 0;        /* Reset score (high_score persists) */
-                lives = 3;        /* Reset to 3 lives */
-                state = Playing;  /* Restart gameplay */
             }
+        }
+        else
+        {
+            /* Keep ball stuck to paddle, updating position to follow paddle */
+            game.ball.x = game.paddle.x + PADDLE_WIDTH / 2 - BALL_SIZE / 2;
+            game.ball.y = game.paddle.y - BALL_SIZE;
+        }
+
+        /* Check for win condition (all bricks destroyed) */
+        int active_bricks = 0;
+        for (int i = 0; i < game.brick_count; i++)
+        {
+            if (game.bricks[i].sprite.active)
+                active_bricks++; /* Count remaining bricks */
+        }
+        if (active_bricks == 0)
+        {
+            game.state = GameOver; /* End game (win condition) */
+            game.paddle.active = 0; /* Hide paddle */
+            game.ball.active = 0; /* Hide ball */
+        }
+        break;
+
+    case GameOver:
+        /* Show game over message with score, high score, and restart prompt */
+        snprintf(textGameOver, sizeof(textGameOver), "Game Over! Score: %d", game.score);
+        snprintf(textHighScore, sizeof(textHighScore), "High Score: %d", high_score);
+        snprintf(textRestart, sizeof(textRestart), "Press R to restart");
+        arcade_render_text_centered(textGameOver, WINDOW_HEIGHT / 2.7f, 0xFFFFFF);  /* Positioned higher for spacing */
+        arcade_render_text_centered(textHighScore, WINDOW_HEIGHT / 2.2f, 0xFFFFFF); /* Even spacing for high score */
+        arcade_render_text_centered(textRestart, WINDOW_HEIGHT / 1.7f, 0xFFFFFF);   /* Lower for restart prompt */
+
+        /* Hold Backspace to rewind back into the lost game */
+        if (arcade_key_pressed(a_backspace) == 2 && arcade_snapshot_pop(&history, &game) == 0)
+        {
             break;
         }
 
-        /* Sleep for ~16ms to target 60 FPS (optional) */
-        arcade_sleep(16);
+        /* Handle restart input */
+        if (arcade_key_pressed_once(a_r) == 2)
+        {
+            arcade_clear_keys(); /* Clear input to prevent immediate actions in Playing state */
+
+            /* Reset to the start state, keeping the chosen mode (high_score persists) */
+            int multiball = game.multiball;
+            game = start_game;
+            game.multiball = multiball;
+            arcade_rng_seed(&game.rng, ++seed); /* New launch angles every game */
+            arcade_snapshot_ring_clear(&history); /* Nothing to rewind into */
+            game.state = Playing;  /* Restart gameplay */
+        }
+        break;
     }
 
-    /* Clean up resources before exit */
+    /* Play the sounds requested by multiball collisions, once each */
+    if (play_hit)
+        arcade_play_sound("./assets/hit.wav");
+    if (play_break)
+        arcade_play_sound("./assets/break.wav");
+
+    return 1;
+}
+
+/* =========================================================================
+ * paddleball_shutdown Function
+ * =========================================================================
+ * Frees the sprite group and rewind history, and prints the final score
+ * and high score.
+ * Parameters: None.
+ * Returns: None.
+ */
+static void paddleball_shutdown(void)
+{
     arcade_free_group(&group); /* Free sprite group memory */
-    arcade_quit();            /* Close window and release Arcade resources */
+    arcade_snapshot_ring_free(&history); /* Free rewind history */
+    printf("Game Over! Final Score: %d, High Score: %d\n", game.score, high_score);
+}
 
-    /* Print final score and high score to console */
-    printf("Game Over! Final Score: %d, High Score: %d\n", score, high_score);
-    return 0;
-}
\ No newline at end of file
+/* Entry points, for main and for the launcher (Launcher/launcher.c) */
+const ArcadeGame paddleball_game = {"Paddle Ball", WINDOW_WIDTH, WINDOW_HEIGHT, 0x000000,
+                                    paddleball_init, paddleball_update, paddleball_shutdown};
+
+/* =========================================================================
+ * main Function
+ * =========================================================================
+ * Entry point for the game on its own. Starts a versus match if asked to;
+ * otherwise arcade_run_game opens the window, calls paddleball_init, then
+ * paddleball_update once per frame until the window is closed, and cleans
+ * up with paddleball_shutdown.
+ * Parameters:
+ * - argc, argv: Command line. "--versus LOCAL_PORT PEER_HOST PEER_PORT PLAYER"
+ *   starts a network match instead (see run_versus), optionally followed by
+ *   "--delay N", "--latency MS" and "--loss PCT".
+ * Returns:
+ * - 0 on successful exit.
+ * - 1 if initialization fails (e.g., window creation).
+ * Example:
+ *   int main(void) {
+ *       return arcade_run_game(&paddleball_game);
+ *   }
+ * Notes:
+ * - Paces frames with arcade_wait_frame: 60 FPS unless the performance
+ *   section of arcade.config.json says otherwise.
+ * - Ball physics are simplified (reflection-based); could add spin or speed
+ *   variation.
+ * - Optional audio assets enhance feedback but are not required.
+ * - Left out when built into the launcher (ARCADE_LAUNCHER), which offers
+ *   the single-machine game only.
+ */
+#ifndef ARCADE_LAUNCHER
+int main(int argc, char **argv)
+{
+    /* Versus mode over the network: --versus LOCAL_PORT PEER_HOST PEER_PORT PLAYER [--delay N] [--latency MS] [--loss PCT] */
+    if (argc >= 6 && strcmp(argv[1], "--versus") == 0)
+    {
+        int input_delay = 2, latency_ms = 0, loss_percent = 0;
+        for (int i = 6; i + 1 < argc; i += 2)
+        {
+            if (strcmp(argv[i], "--delay") == 0)
+                input_delay = atoi(argv[i + 1]);
+            else if (strcmp(argv[i], "--latency") == 0)
+                latency_ms = atoi(argv[i + 1]);
+            else if (strcmp(argv[i], "--loss") == 0)
+                loss_percent = atoi(argv[i + 1]);
+        }
+        return run_versus(atoi(argv[2]), argv[3], atoi(argv[4]), atoi(argv[5]), input_delay, latency_ms, loss_percent);
+    }
+
+    return arcade_run_game(&paddleball_game);
+}
+#endif
@@ -0,0 +1,195 @@
+/* =========================================================================
+ * Paddle Ball - Versus Simulation
+ * =========================================================================
+ * Author: GeorgeET15
+ * Description:
+ * The two-player versus match of Paddle Ball, without any window, input or
+ * sound code: a flat VersusData struct and a deterministic fixed-step
+ * step_versus. Shared by the game (rollback netplay) and the headless match
+ * server (Server/), so both run exactly the same rules.
+ *
+ * Usage:
+ *   #include "arcade.h"
+ *   #include "paddleball_sim.h"
+ *   VersusData match;
+ *   init_versus(&match);
+ *   uint8_t inputs[2] = {VERSUS_LEFT, 0};
+ *   step_versus(&match, inputs); // One 60 FPS frame
+ *
+ * Notes:
+ * - Only needs the arcade.h declarations (ArcadeSprite, arcade_check_collision).
+ * - Functions are static so the header can be included by several programs
+ *   without a separate object file.
+ * ========================================================================= */
+
+#ifndef PADDLEBALL_SIM_H
+#define PADDLEBALL_SIM_H
+
+#include "arcade.h"
+
+/* =========================================================================
+ * Versus Constants
+ * =========================================================================
+ * Play area and object sizes (shared with the single-player game) and the
+ * rules of a versus match.
+ */
+#define WINDOW_WIDTH 800       /* Window width (pixels). Wide for paddle movement and brick grid. */
+#define WINDOW_HEIGHT 600      /* Window height (pixels). Tall for brick grid and play area. */
+#define PADDLE_WIDTH 100.0f    /* Paddle width (pixels). Wide for easier catching. */
+#define PADDLE_HEIGHT 20.0f    /* Paddle height (pixels). Thin for aesthetics. */
+#define BALL_SIZE 10.0f        /* Ball width/height (pixels). Small for precision. */
+#define VERSUS_POINTS 5        /* Points needed to win a versus match. */
+#define VERSUS_SERVE_FRAMES 60 /* Frames the ball waits before each serve in versus mode. */
+#define VERSUS_TOP_Y 30.0f     /* Y position of player 1's paddle (top of the screen). */
+#define VERSUS_BALL_SPEED 6.0f /* Ball speed in versus mode (pixels per frame); serves and returns scale it. */
+#define VERSUS_LEFT 1          /* Versus input bit: move left. */
+#define VERSUS_RIGHT 2         /* Versus input bit: move right. */
+#define VERSUS_RESTART 4       /* Versus input bit: start a new match once one is won. */
+
+/* =========================================================================
+ * VersusData Structure
+ * =========================================================================
+ * Whole state of a two-player network match. Flat and pointer-free so the
+ * rollback session can snapshot it, and advanced only by step_versus so both
+ * machines compute exactly the same frames.
+ * - paddles: Player 0 (blue, bottom) and player 1 (red, top).
+ * - ball: The ball (inactive once the match is won).
+ * - score: Points per player.
+ * - serve_timer: Frames until the ball is served; 0 while in play.
+ * - serve_dir: Vertical direction of the next serve (1 = down, -1 = up).
+ * - winner: Winning player, or -1 while the match runs.
+ */
+typedef struct
+{
+    ArcadeSprite paddles[2]; /* Bottom and top paddles */
+    ArcadeSprite ball;       /* Ball */
+    int score[2];            /* Points per player */
+    int serve_timer;         /* Frames until the next serve */
+    int serve_dir;           /* 1 = serve toward player 0, -1 = toward player 1 */
+    int winner;              /* Winning player or -1 */
+} VersusData;
+
+/* =========================================================================
+ * init_versus Function
+ * =========================================================================
+ * Builds the start of a versus match: both paddles centered, ball waiting in
+ * the middle for its first serve toward player 0.
+ * Parameters:
+ * - v: VersusData to fill.
+ * Returns: None.
+ */
+static void init_versus(VersusData *v)
+{
+    memset(v, 0, sizeof(*v));
+    for (int p = 0; p < 2; p++)
+    {
+        v->paddles[p] = (ArcadeSprite){
+            .x = WINDOW_WIDTH / 2 - PADDLE_WIDTH / 2,
+            .y = p == 0 ? WINDOW_HEIGHT - 50.0f : VERSUS_TOP_Y,
+            .width = PADDLE_WIDTH,
+            .height = PADDLE_HEIGHT,
+            .color = p == 0 ? 0x0000FF : 0xFF0000, /* Blue bottom, red top */
+            .active = 1};
+    }
+    v->ball = (ArcadeSprite){
+        .x = WINDOW_WIDTH / 2 - BALL_SIZE / 2,
+        .y = WINDOW_HEIGHT / 2 - BALL_SIZE / 2,
+        .width = BALL_SIZE,
+        .height = BALL_SIZE,
+        .color = 0xFFFFFF,
+        .active = 1};
+    v->serve_timer = VERSUS_SERVE_FRAMES;
+    v->serve_dir = 1;
+    v->winner = -1;
+}
+
+/* =========================================================================
+ * step_versus Function
+ * =========================================================================
+ * Advances a versus match by one fixed 60 FPS frame (ArcadeStepFunc).
+ * Parameters:
+ * - state: VersusData to advance.
+ * - inputs: Input bits (VERSUS_LEFT, VERSUS_RIGHT, VERSUS_RESTART) per player.
+ * Returns: None.
+ * Notes:
+ * - Deterministic: no delta time, rand() or sounds, because the rollback
+ *   session may run the same frame several times.
+ * - Cheap enough to resimulate ARCADE_ROLLBACK_FRAMES frames many times over
+ *   within one frame.
+ */
+static void step_versus(void *state, const uint8_t *inputs)
+{
+    VersusData *v = state;
+    const float paddle_speed = 8.0f; /* Same feel as the single-player game */
+    const float ball_speed = VERSUS_BALL_SPEED;
+
+    if (v->winner >= 0)
+    {
+        if ((inputs[0] | inputs[1]) & VERSUS_RESTART)
+            init_versus(v);
+        return;
+    }
+
+    /* Paddles */
+    for (int p = 0; p < 2; p++)
+    {
+        ArcadeSprite *paddle = &v->paddles[p];
+        paddle->vx = ((inputs[p] & VERSUS_RIGHT) ? paddle_speed : 0.0f) - ((inputs[p] & VERSUS_LEFT) ? paddle_speed : 0.0f);
+        paddle->x += paddle->vx;
+        if (paddle->x < 0)
+            paddle->x = 0;
+        else if (paddle->x + paddle->width > WINDOW_WIDTH)
+            paddle->x = WINDOW_WIDTH - paddle->width;
+    }
+
+    /* Serve after a short pause, alternating left and right */
+    ArcadeSprite *ball = &v->ball;
+    if (v->serve_timer > 0)
+    {
+        if (--v->serve_timer == 0)
+        {
+            ball->vx = ((v->score[0] + v->score[1]) % 2 ? 0.5f : -0.5f) * ball_speed;
+            ball->vy = v->serve_dir * ball_speed * 0.75f;
+        }
+        return;
+    }
+
+    /* Ball movement and side walls */
+    ball->x += ball->vx;
+    ball->y += ball->vy;
+    if (ball->x <= 0 || ball->x + ball->width >= WINDOW_WIDTH)
+    {
+        ball->x = ball->x <= 0 ? 0 : WINDOW_WIDTH - ball->width;
+        ball->vx = -ball->vx;
+    }
+
+    /* Paddles send the ball back toward the other player, steered by hit position */
+    for (int p = 0; p < 2; p++)
+    {
+        ArcadeSprite *paddle = &v->paddles[p];
+        int toward = p == 0 ? ball->vy > 0 : ball->vy < 0;
+        if (toward && arcade_check_collision(ball, paddle))
+        {
+            float hit_pos = (ball->x + ball->width / 2 - paddle->x) / paddle->width; /* 0 to 1 across the paddle */
+            ball->vx = ball_speed * (hit_pos - 0.5f) * 2.0f;
+            ball->vy = -ball->vy;
+            ball->y = p == 0 ? paddle->y - ball->height : paddle->y + paddle->height;
+        }
+    }
+
+    /* Scoring: the ball left past a paddle */
+    int scorer = ball->y > WINDOW_HEIGHT ? 1 : (ball->y + ball->height < 0 ? 0 : -1);
+    if (scorer >= 0)
+    {
+        v->score[scorer]++;
+        v->serve_dir = scorer == 1 ? 1 : -1; /* Serve toward the player who lost the point */
+        v->serve_timer = VERSUS_SERVE_FRAMES;
+        ball->x = WINDOW_WIDTH / 2 - BALL_SIZE / 2;
+        ball->y = WINDOW_HEIGHT / 2 - BALL_SIZE / 2;
+        ball->vx = ball->vy = 0.0f;
+        if (v->score[scorer] >= VERSUS_POINTS)
+            v->winner = scorer;
+    }
+}
+
+#endif
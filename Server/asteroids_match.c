@@ -0,0 +1,20 @@
+/* =========================================================================
+ * Arcade Match Server - Asteroids
+ * =========================================================================
+ * Hosts the two-ship Asteroids match from Asteroids/asteroids_sim.h.
+ * ========================================================================= */
+
+#include "match.h"
+#include "asteroids_sim.h"
+
+static void init_asteroids(void *state, uint32_t seed)
+{
+    init_asteroids_match(state, seed);
+}
+
+const MatchGame asteroids_match = {
+    .name = "asteroids",
+    .state_size = sizeof(AsteroidsMatch),
+    .input_mask = MATCH_LEFT | MATCH_RIGHT | MATCH_FIRE | MATCH_RESTART,
+    .init = init_asteroids,
+    .step = step_asteroids_match};
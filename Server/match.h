@@ -0,0 +1,39 @@
+/* =========================================================================
+ * Arcade Match Server - Match Games
+ * =========================================================================
+ * Author: GeorgeET15
+ * Description:
+ * Describes a game the match server can host: the size of its flat state
+ * struct, how to build a fresh match, and its deterministic fixed-step
+ * function. Each game lives in its own file (paddleball_match.c,
+ * asteroids_match.c) so their simulation headers never meet in one
+ * translation unit.
+ * ========================================================================= */
+
+#ifndef MATCH_H
+#define MATCH_H
+
+#include "arcade.h"
+
+/* =========================================================================
+ * MatchGame Structure
+ * =========================================================================
+ * - name: Name used with --game on the command line.
+ * - state_size: Size of the game's state struct (bytes).
+ * - input_mask: Input bits the game reads; synthetic clients press only these.
+ * - init: Builds the start of a match from a seed.
+ * - step: Advances a match by one fixed frame with one input byte per player.
+ */
+typedef struct
+{
+    const char *name;                         /* Command-line name */
+    size_t state_size;                        /* sizeof the state struct */
+    uint8_t input_mask;                       /* Input bits the game reads */
+    void (*init)(void *state, uint32_t seed); /* Start of a match */
+    ArcadeStepFunc step;                      /* One fixed frame */
+} MatchGame;
+
+extern const MatchGame paddleball_match; /* Paddle Ball versus (PaddleBall/paddleball_sim.h) */
+extern const MatchGame asteroids_match;  /* Two-ship Asteroids (Asteroids/asteroids_sim.h) */
+
+#endif
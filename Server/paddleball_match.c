@@ -0,0 +1,23 @@
+/* =========================================================================
+ * Arcade Match Server - Paddle Ball
+ * =========================================================================
+ * Hosts the Paddle Ball versus match from PaddleBall/paddleball_sim.h, the
+ * same rules the game plays over rollback netplay.
+ * ========================================================================= */
+
+#include "match.h"
+#include "paddleball_sim.h"
+
+/* Versus matches always start the same way; the seed is unused */
+static void init_paddleball(void *state, uint32_t seed)
+{
+    (void)seed;
+    init_versus(state);
+}
+
+const MatchGame paddleball_match = {
+    .name = "paddleball",
+    .state_size = sizeof(VersusData),
+    .input_mask = VERSUS_LEFT | VERSUS_RIGHT | VERSUS_RESTART,
+    .init = init_paddleball,
+    .step = step_versus};
@@ -0,0 +1,711 @@
+/* =========================================================================
+ * Arcade Match Server - Documentation
+ * =========================================================================
+ * Author: GeorgeET15
+ * Description:
+ * A headless, authoritative server that hosts many concurrent two-player
+ * matches of Paddle Ball or Asteroids in one process. Every match is a flat
+ * game-state struct stepped at a fixed tick rate by a worker pool. Clients
+ * send their input over UDP; after every tick the server sends each client
+ * the new state as a delta against the newest state that client confirmed.
+ * The same binary also runs synthetic clients for load testing over loopback.
+ *
+ * Usage:
+ *   Server:
+ *     ./server [--game paddleball|asteroids] [--port 9000] [--matches 200]
+ *              [--threads N] [--tick 60] [--seconds S] [--seed N]
+ *   Synthetic clients (two per match, random inputs):
+ *     ./server --bots HOST PORT [--game ...] [--matches 200] [--seconds 10]
+ *   Loopback test (see the Makefile's loadtest target):
+ *     ./server --seconds 12 &
+ *     ./server --bots 127.0.0.1 9000 --seconds 10
+ *
+ * Protocol (UDP, integers big-endian):
+ * - Client to server, every frame:
+ *     'I', player (u8), match (u16), ack tick (u32), input bits (u8)
+ *   The first packet for a match and player binds that slot to the sender.
+ *   The ack is the newest tick the client has decoded (0xFFFFFFFF for none).
+ * - Server to client, every tick:
+ *     'S', game (u8), match (u16), tick (u32), base tick (u32), delta
+ *   The delta (arcade_delta_encode) is against the state of the base tick,
+ *   or against nothing when the base tick is 0xFFFFFFFF.
+ *
+ * Compilation:
+ * With make (links ../arcade's headless libarcade, built once for all games):
+ *   make
+ * Linux:
+ *   gcc -DARCADE_HEADLESS -I../arcade -I../PaddleBall -I../Asteroids \
+ *       -o server server.c paddleball_match.c asteroids_match.c ../arcade/arcade.c -lm -lpthread
+ *
+ * Output:
+ * - Every 5 seconds: tick time percentiles, packet rates and connected clients.
+ * - On exit: tick time percentiles over the whole run, CPU time per match and
+ *   tick, and the number of matches one core could run at the tick rate.
+ *
+ * Notes:
+ * - Linux only (epoll); the games themselves stay cross-platform.
+ * - States travel as raw struct bytes, so clients must be built from the same
+ *   simulation headers on a machine with the same byte order and layout.
+ * - The server keeps the last MATCH_HISTORY broadcast states of every match,
+ *   so a client that misses packets still gets small deltas as long as its
+ *   ack is recent, and a full state otherwise.
+ * - Matches-per-core counts the receive, step, encode and send work of a
+ *   tick, so it reflects what one core spends per match including I/O.
+ * ========================================================================= */
+
+#include "arcade.h"
+#include "match.h"
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/epoll.h>
+
+/* =========================================================================
+ * Server Constants
+ * ========================================================================= */
+#define SERVER_PORT 9000       /* Default UDP port. */
+#define SERVER_MATCHES 200     /* Default number of matches hosted. */
+#define SERVER_TICK_HZ 60      /* Default simulation ticks per second. */
+#define MATCH_HISTORY 32       /* Broadcast states kept per match as delta bases. */
+#define MAX_STATE_SIZE 1024    /* Largest game-state struct the server can host (bytes). */
+#define INPUT_SIZE 9           /* Bytes in a client input packet. */
+#define STATE_HEADER 12        /* Bytes before the delta in a state packet. */
+#define STATE_PACKET (STATE_HEADER + MAX_STATE_SIZE + 2 * (MAX_STATE_SIZE / 255 + 1)) /* Largest state packet. */
+#define NO_TICK 0xFFFFFFFFu    /* Ack or base tick meaning "none". */
+#define CLIENT_TIMEOUT 5.0     /* Seconds without input before a client stops receiving states. */
+#define REPORT_SECONDS 5.0     /* Seconds between progress reports. */
+
+static const MatchGame *games[] = {&paddleball_match, &asteroids_match}; /* Index = game byte in state packets */
+#define GAME_COUNT (int)(sizeof(games) / sizeof(games[0]))
+
+static volatile sig_atomic_t stop_requested = 0; /* Set by SIGINT/SIGTERM */
+
+/* =========================================================================
+ * MatchClient Structure
+ * =========================================================================
+ * One player's connection to a match.
+ * - addr: Address that states are sent to (from the client's last packet).
+ * - joined: 1 once any packet arrived for this slot.
+ * - ack: Newest tick the client has decoded, or NO_TICK.
+ * - last_seen: arcade_time() of the client's last packet.
+ * - input: The client's newest input bits, used every tick until replaced.
+ */
+typedef struct
+{
+    struct sockaddr_in addr; /* Where states go */
+    int joined;              /* Slot bound to a client */
+    uint32_t ack;            /* Newest decoded tick */
+    double last_seen;        /* Time of the last packet */
+    uint8_t input;           /* Newest input bits */
+} MatchClient;
+
+/* =========================================================================
+ * Match Structure
+ * =========================================================================
+ * One hosted match.
+ * - state: The game's state struct (state_size bytes used).
+ * - sent: States after each of the last MATCH_HISTORY ticks (delta bases).
+ * - clients: Both players.
+ * - tick: Ticks simulated so far.
+ * - cpu_seconds, packets_out, bytes_out: Work done on the last tick, written
+ *   by the worker that ran it and summed by the main thread.
+ */
+typedef struct
+{
+    uint64_t state[MAX_STATE_SIZE / sizeof(uint64_t)]; /* Game state (8-byte aligned) */
+    ArcadeSnapshotRing sent;                           /* Recent broadcast states */
+    MatchClient clients[2];                            /* Players 0 and 1 */
+    uint32_t tick;                                     /* Ticks simulated */
+    double cpu_seconds;                                /* Last tick's work */
+    int packets_out, bytes_out;                        /* Last tick's traffic */
+} Match;
+
+/* =========================================================================
+ * Server Structure
+ * =========================================================================
+ * Everything the server loop needs, shared read-only with the workers
+ * during a tick (each worker writes only to its own matches).
+ */
+typedef struct
+{
+    const MatchGame *game;    /* Hosted game */
+    int game_index;           /* Index into games[] */
+    Match *matches;           /* Hosted matches */
+    int match_count;          /* Number of matches */
+    int sock;                 /* UDP socket */
+    double now;               /* Time the current tick started */
+    float *tick_ms;           /* Wall time of every tick (ms) */
+    int tick_count, tick_capacity;
+    double cpu_seconds;       /* Receive + match work over the run */
+    long packets_in, packets_out, bytes_out, bad_packets;
+    int overruns;             /* Ticks that ended after the next was due */
+} Server;
+
+/* =========================================================================
+ * Byte Helpers
+ * ========================================================================= */
+static void put_u16(unsigned char *p, uint16_t v)
+{
+    p[0] = (unsigned char)(v >> 8);
+    p[1] = (unsigned char)v;
+}
+
+static void put_u32(unsigned char *p, uint32_t v)
+{
+    p[0] = (unsigned char)(v >> 24);
+    p[1] = (unsigned char)(v >> 16);
+    p[2] = (unsigned char)(v >> 8);
+    p[3] = (unsigned char)v;
+}
+
+static uint16_t get_u16(const unsigned char *p)
+{
+    return (uint16_t)(p[0] << 8 | p[1]);
+}
+
+static uint32_t get_u32(const unsigned char *p)
+{
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+/* =========================================================================
+ * open_socket Function
+ * =========================================================================
+ * Opens a non-blocking UDP socket bound to a local port (0 = any port).
+ * Returns: The socket, or -1 on failure (message printed).
+ */
+static int open_socket(int port)
+{
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0)
+    {
+        perror("socket");
+        return -1;
+    }
+    int buffer = 4 * 1024 * 1024; /* Room for a whole tick of packets */
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &buffer, sizeof(buffer));
+    setsockopt(sock, SOL_SOCKET, SO_SNDBUF, &buffer, sizeof(buffer));
+
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port);
+    if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) != 0)
+    {
+        perror("bind");
+        close(sock);
+        return -1;
+    }
+    fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+    return sock;
+}
+
+/* =========================================================================
+ * find_game Function
+ * =========================================================================
+ * Looks up a hosted game by its command-line name.
+ * Returns: Index into games[], or -1 if unknown (message printed).
+ */
+static int find_game(const char *name)
+{
+    for (int i = 0; i < GAME_COUNT; i++)
+    {
+        if (strcmp(games[i]->name, name) == 0)
+            return i;
+    }
+    fprintf(stderr, "Unknown game '%s' (paddleball or asteroids)\n", name);
+    return -1;
+}
+
+/* =========================================================================
+ * print_percentiles Function
+ * =========================================================================
+ * Prints p50/p90/p99/max of a set of tick times. Sorts the values in place.
+ */
+static int compare_floats(const void *a, const void *b)
+{
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+static void print_percentiles(const char *label, float *values, int count)
+{
+    if (count <= 0)
+        return;
+    qsort(values, (size_t)count, sizeof(float), compare_floats);
+    printf("%s p50 %.3f ms, p90 %.3f ms, p99 %.3f ms, max %.3f ms\n", label,
+           values[count / 2], values[count * 90 / 100], values[count * 99 / 100], values[count - 1]);
+}
+
+/* =========================================================================
+ * receive_inputs Function
+ * =========================================================================
+ * Reads every waiting input packet and stores the input and ack in the
+ * client's slot, binding the slot to the sender's address.
+ */
+static void receive_inputs(Server *server)
+{
+    for (;;)
+    {
+        unsigned char packet[64];
+        struct sockaddr_in from;
+        socklen_t from_size = sizeof(from);
+        ssize_t size = recvfrom(server->sock, packet, sizeof(packet), 0, (struct sockaddr *)&from, &from_size);
+        if (size < 0)
+            return; /* EAGAIN: nothing left */
+
+        if (size < INPUT_SIZE)
+        {
+            server->bad_packets++;
+            continue;
+        }
+        int player = packet[1];
+        int match = get_u16(packet + 2);
+        if (packet[0] != 'I' || player > 1 || match >= server->match_count)
+        {
+            server->bad_packets++;
+            continue;
+        }
+        MatchClient *client = &server->matches[match].clients[player];
+        if (!client->joined || client->addr.sin_addr.s_addr != from.sin_addr.s_addr || client->addr.sin_port != from.sin_port)
+        {
+            client->addr = from; /* New client or reconnect: start over with full states */
+            client->joined = 1;
+            client->ack = NO_TICK;
+        }
+        uint32_t ack = get_u32(packet + 4);
+        if (ack != NO_TICK && (client->ack == NO_TICK || (int32_t)(ack - client->ack) > 0))
+            client->ack = ack;
+        client->input = packet[8];
+        client->last_seen = server->now;
+        server->packets_in++;
+    }
+}
+
+/* =========================================================================
+ * tick_match Function
+ * =========================================================================
+ * Worker job (ArcadeJobFunc): steps one match by a tick and sends the new
+ * state to both of its clients.
+ */
+static void tick_match(void *context, int index, int worker)
+{
+    (void)worker;
+    Server *server = context;
+    Match *match = &server->matches[index];
+    double start = arcade_time();
+
+    uint8_t inputs[2] = {match->clients[0].input, match->clients[1].input};
+    server->game->step(match->state, inputs);
+    match->tick++;
+    arcade_snapshot_push(&match->sent, match->state);
+
+    match->packets_out = 0;
+    match->bytes_out = 0;
+    unsigned char packet[STATE_PACKET];
+    for (int p = 0; p < 2; p++)
+    {
+        MatchClient *client = &match->clients[p];
+        if (!client->joined || server->now - client->last_seen > CLIENT_TIMEOUT)
+            continue;
+
+        /* Delta against the newest state the client confirmed, if still kept */
+        const void *base = NULL;
+        uint32_t base_tick = NO_TICK;
+        if (client->ack != NO_TICK && match->tick - client->ack < MATCH_HISTORY)
+        {
+            base = arcade_snapshot_peek(&match->sent, (int)(match->tick - client->ack));
+            if (base)
+                base_tick = client->ack;
+        }
+        int size = arcade_delta_encode(base, match->state, server->game->state_size,
+                                       packet + STATE_HEADER, (int)sizeof(packet) - STATE_HEADER);
+        if (size < 0)
+            continue;
+
+        packet[0] = 'S';
+        packet[1] = (unsigned char)server->game_index;
+        put_u16(packet + 2, (uint16_t)index);
+        put_u32(packet + 4, match->tick);
+        put_u32(packet + 8, base_tick);
+        if (sendto(server->sock, packet, (size_t)(STATE_HEADER + size), 0,
+                   (struct sockaddr *)&client->addr, sizeof(client->addr)) > 0)
+        {
+            match->packets_out++;
+            match->bytes_out += STATE_HEADER + size;
+        }
+    }
+    match->cpu_seconds = arcade_time() - start;
+}
+
+/* =========================================================================
+ * run_server Function
+ * =========================================================================
+ * Hosts match_count matches until the time limit or Ctrl+C, then prints
+ * the run's statistics.
+ * Returns: 0 on a clean exit, 1 on setup failure.
+ */
+static int run_server(int game_index, int port, int match_count, int threads, int tick_hz, double seconds, uint32_t seed)
+{
+    Server server = {0};
+    server.game = games[game_index];
+    server.game_index = game_index;
+    server.match_count = match_count;
+    if (server.game->state_size > MAX_STATE_SIZE || match_count <= 0 || match_count > 65535 || tick_hz <= 0)
+    {
+        fprintf(stderr, "Invalid server settings\n");
+        return 1;
+    }
+
+    server.matches = calloc((size_t)match_count, sizeof(Match));
+    if (!server.matches)
+    {
+        fprintf(stderr, "Cannot allocate %d matches\n", match_count);
+        return 1;
+    }
+    for (int i = 0; i < match_count; i++)
+    {
+        Match *match = &server.matches[i];
+        server.game->init(match->state, seed + (uint32_t)i);
+        match->clients[0].ack = match->clients[1].ack = NO_TICK;
+        if (arcade_snapshot_ring_init(&match->sent, server.game->state_size, MATCH_HISTORY) != 0)
+            return 1;
+    }
+
+    ArcadeWorkerPool pool;
+    server.sock = open_socket(port);
+    int epoll_fd = epoll_create1(0);
+    struct epoll_event event = {.events = EPOLLIN};
+    if (server.sock < 0 || epoll_fd < 0 || epoll_ctl(epoll_fd, EPOLL_CTL_ADD, server.sock, &event) != 0 ||
+        arcade_pool_init(&pool, threads) != 0)
+    {
+        fprintf(stderr, "Cannot start server\n");
+        return 1;
+    }
+    printf("Hosting %d %s matches on UDP port %d: %d Hz, %d threads\n",
+           match_count, server.game->name, port, tick_hz, pool.thread_count);
+
+    double tick_seconds = 1.0 / tick_hz;
+    double start = arcade_time();
+    double next_tick = start;
+    double next_report = start + REPORT_SECONDS;
+    int report_from = 0;
+    long report_in = 0, report_out = 0, report_bytes = 0;
+
+    while (!stop_requested && (seconds <= 0 || arcade_time() - start < seconds))
+    {
+        /* Wait for input until the next tick is due */
+        double now = arcade_time();
+        if (now < next_tick)
+        {
+            struct epoll_event ready;
+            if (epoll_wait(epoll_fd, &ready, 1, (int)((next_tick - now) * 1000.0) + 1) > 0)
+            {
+                server.now = now;
+                receive_inputs(&server);
+            }
+            continue;
+        }
+
+        /* Tick: latest inputs, then every match in parallel */
+        double tick_start = arcade_time();
+        server.now = tick_start;
+        receive_inputs(&server);
+        double receive_seconds = arcade_time() - tick_start;
+        arcade_pool_run(&pool, match_count, tick_match, &server);
+        double tick_end = arcade_time();
+
+        server.cpu_seconds += receive_seconds;
+        for (int i = 0; i < match_count; i++)
+        {
+            server.cpu_seconds += server.matches[i].cpu_seconds;
+            server.packets_out += server.matches[i].packets_out;
+            server.bytes_out += server.matches[i].bytes_out;
+        }
+        if (server.tick_count == server.tick_capacity)
+        {
+            int capacity = server.tick_capacity ? server.tick_capacity * 2 : 4096;
+            float *grown = realloc(server.tick_ms, (size_t)capacity * sizeof(float));
+            if (!grown)
+                break;
+            server.tick_ms = grown;
+            server.tick_capacity = capacity;
+        }
+        server.tick_ms[server.tick_count++] = (float)((tick_end - tick_start) * 1000.0);
+
+        next_tick += tick_seconds;
+        if (tick_end > next_tick)
+        {
+            server.overruns++;
+            if (tick_end - next_tick > 5 * tick_seconds)
+                next_tick = tick_end; /* Too far behind: drop ticks instead of bursting */
+        }
+
+        /* Progress report */
+        if (tick_end >= next_report)
+        {
+            int clients = 0;
+            for (int i = 0; i < match_count; i++)
+            {
+                for (int p = 0; p < 2; p++)
+                    clients += server.matches[i].clients[p].joined && tick_end - server.matches[i].clients[p].last_seen <= CLIENT_TIMEOUT;
+            }
+            int count = server.tick_count - report_from;
+            float *window = malloc((size_t)count * sizeof(float));
+            if (window)
+            {
+                memcpy(window, server.tick_ms + report_from, (size_t)count * sizeof(float));
+                char label[64];
+                snprintf(label, sizeof(label), "[%5.0f s] %d ticks, %d clients, tick", tick_end - start, count, clients);
+                print_percentiles(label, window, count);
+                free(window);
+            }
+            printf("          in %.0f pkt/s, out %.0f pkt/s, %.1f KB/s\n",
+                   (server.packets_in - report_in) / REPORT_SECONDS, (server.packets_out - report_out) / REPORT_SECONDS,
+                   (server.bytes_out - report_bytes) / REPORT_SECONDS / 1024.0);
+            report_from = server.tick_count;
+            report_in = server.packets_in;
+            report_out = server.packets_out;
+            report_bytes = server.bytes_out;
+            next_report += REPORT_SECONDS;
+        }
+    }
+
+    /* Summary */
+    printf("\n%d ticks of %d %s matches, %d overruns, %ld packets in (%ld bad), %ld out (%.1f bytes avg)\n",
+           server.tick_count, match_count, server.game->name, server.overruns, server.packets_in,
+           server.bad_packets, server.packets_out, server.packets_out ? (double)server.bytes_out / server.packets_out : 0.0);
+    if (server.tick_count > 0)
+    {
+        double cpu_per_tick = server.cpu_seconds / server.tick_count;
+        double cpu_per_match = cpu_per_tick / match_count;
+        print_percentiles("Tick time", server.tick_ms, server.tick_count);
+        printf("CPU per tick %.3f ms, per match %.2f us -> %.0f matches per core at %d Hz\n",
+               cpu_per_tick * 1000.0, cpu_per_match * 1e6, cpu_per_match > 0 ? tick_seconds / cpu_per_match : 0.0, tick_hz);
+    }
+
+    arcade_pool_free(&pool);
+    close(epoll_fd);
+    close(server.sock);
+    for (int i = 0; i < match_count; i++)
+        arcade_snapshot_ring_free(&server.matches[i].sent);
+    free(server.matches);
+    free(server.tick_ms);
+    return 0;
+}
+
+/* =========================================================================
+ * Bot Structure
+ * =========================================================================
+ * One synthetic client: its socket, the states it has decoded (kept as delta
+ * bases by tick), and its current random input.
+ */
+typedef struct
+{
+    int sock;                      /* Socket connected to the server */
+    uint32_t ticks[MATCH_HISTORY]; /* Tick held by each state slot (NO_TICK = empty) */
+    unsigned char *states;         /* MATCH_HISTORY decoded states */
+    uint32_t latest;               /* Newest decoded tick (the ack), or NO_TICK */
+    uint8_t input;                 /* Input held for hold more frames */
+    int hold;
+    ArcadeRng rng;                 /* Input random stream */
+} Bot;
+
+/* =========================================================================
+ * run_bots Function
+ * =========================================================================
+ * Plays every match of a server with two synthetic clients each, sending
+ * random inputs at 60 FPS and decoding every state received, then prints
+ * what arrived.
+ * Returns: 0 on a clean exit, 1 on setup failure.
+ */
+static int run_bots(const char *host, int port, int game_index, int match_count, double seconds)
+{
+    const MatchGame *game = games[game_index];
+    int bot_count = match_count * 2;
+    Bot *bots = calloc((size_t)bot_count, sizeof(Bot));
+    unsigned char *storage = malloc((size_t)bot_count * MATCH_HISTORY * game->state_size);
+    int epoll_fd = epoll_create1(0);
+    struct sockaddr_in server_addr = {0};
+    server_addr.sin_family = AF_INET;
+    server_addr.sin_port = htons((uint16_t)port);
+    if (!bots || !storage || epoll_fd < 0 || inet_pton(AF_INET, host, &server_addr.sin_addr) != 1)
+    {
+        fprintf(stderr, "Cannot start %d bots (host must be an IPv4 address)\n", bot_count);
+        return 1;
+    }
+
+    for (int i = 0; i < bot_count; i++)
+    {
+        Bot *bot = &bots[i];
+        bot->sock = open_socket(0);
+        if (bot->sock < 0 || connect(bot->sock, (struct sockaddr *)&server_addr, sizeof(server_addr)) != 0)
+        {
+            fprintf(stderr, "Cannot open bot socket %d (raise ulimit -n?)\n", i);
+            return 1;
+        }
+        struct epoll_event event = {.events = EPOLLIN, .data.u32 = (uint32_t)i};
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, bot->sock, &event);
+        bot->states = storage + (size_t)i * MATCH_HISTORY * game->state_size;
+        for (int t = 0; t < MATCH_HISTORY; t++)
+            bot->ticks[t] = NO_TICK;
+        bot->latest = NO_TICK;
+        arcade_rng_seed_stream(&bot->rng, 0x9E3779B9u, (uint64_t)i);
+    }
+    printf("%d bots playing %d %s matches on %s:%d\n", bot_count, match_count, game->name, host, port);
+
+    long states = 0, full_states = 0, delta_bytes = 0, missing_base = 0, bad_states = 0;
+    double start = arcade_time();
+    double next_frame = start;
+    struct epoll_event ready[256];
+    while (!stop_requested && arcade_time() - start < seconds)
+    {
+        /* Send every bot's input once per frame */
+        double now = arcade_time();
+        if (now >= next_frame)
+        {
+            for (int i = 0; i < bot_count; i++)
+            {
+                Bot *bot = &bots[i];
+                if (--bot->hold <= 0)
+                {
+                    bot->input = (uint8_t)(arcade_rng_next(&bot->rng) & game->input_mask);
+                    bot->hold = arcade_rng_range(&bot->rng, 10, 39); /* Hold for 10-39 frames */
+                }
+                unsigned char packet[INPUT_SIZE];
+                packet[0] = 'I';
+                packet[1] = (unsigned char)(i % 2);
+                put_u16(packet + 2, (uint16_t)(i / 2));
+                put_u32(packet + 4, bot->latest);
+                packet[8] = bot->input;
+                send(bot->sock, packet, sizeof(packet), 0);
+            }
+            next_frame += 1.0 / 60.0;
+            if (now - next_frame > 0.1)
+                next_frame = now;
+            continue;
+        }
+
+        /* Decode states until the next frame is due */
+        int count = epoll_wait(epoll_fd, ready, 256, (int)((next_frame - now) * 1000.0) + 1);
+        for (int e = 0; e < count; e++)
+        {
+            Bot *bot = &bots[ready[e].data.u32];
+            unsigned char packet[STATE_PACKET];
+            ssize_t size;
+            while ((size = recv(bot->sock, packet, sizeof(packet), 0)) >= STATE_HEADER)
+            {
+                uint32_t tick = get_u32(packet + 4);
+                uint32_t base_tick = get_u32(packet + 8);
+                if (packet[0] != 'S' || packet[1] != game_index)
+                {
+                    bad_states++;
+                    continue;
+                }
+                const void *base = NULL;
+                if (base_tick != NO_TICK)
+                {
+                    int base_slot = (int)(base_tick % MATCH_HISTORY);
+                    if (bot->ticks[base_slot] != base_tick)
+                    {
+                        missing_base++; /* Base already overwritten; a newer packet will do */
+                        continue;
+                    }
+                    base = bot->states + (size_t)base_slot * game->state_size;
+                }
+                int slot = (int)(tick % MATCH_HISTORY);
+                if (arcade_delta_decode(base, packet + STATE_HEADER, (int)size - STATE_HEADER,
+                                        bot->states + (size_t)slot * game->state_size, game->state_size) != 0)
+                {
+                    bot->ticks[slot] = NO_TICK;
+                    bad_states++;
+                    continue;
+                }
+                bot->ticks[slot] = tick;
+                if (bot->latest == NO_TICK || (int32_t)(tick - bot->latest) > 0)
+                    bot->latest = tick;
+                states++;
+                full_states += base == NULL;
+                delta_bytes += size - STATE_HEADER;
+            }
+        }
+    }
+
+    double elapsed = arcade_time() - start;
+    printf("%ld states in %.1f s (%.1f per bot per second), %ld full, %.1f of %zu bytes avg, %ld missing base, %ld bad\n",
+           states, elapsed, states / elapsed / bot_count, full_states,
+           states ? (double)delta_bytes / states : 0.0, game->state_size, missing_base, bad_states);
+
+    for (int i = 0; i < bot_count; i++)
+        close(bots[i].sock);
+    close(epoll_fd);
+    free(storage);
+    free(bots);
+    return 0;
+}
+
+/* =========================================================================
+ * main Function
+ * =========================================================================
+ * Parses the command line (see Usage above) and runs the server or bots.
+ */
+static void request_stop(int signal_number)
+{
+    (void)signal_number;
+    stop_requested = 1;
+}
+
+int main(int argc, char **argv)
+{
+    int game_index = 0;
+    int port = SERVER_PORT;
+    int match_count = SERVER_MATCHES;
+    int threads = 0;
+    int tick_hz = SERVER_TICK_HZ;
+    double seconds = 0.0;
+    uint32_t seed = 1;
+    const char *bots_host = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        int has_value = i + 1 < argc;
+        if (strcmp(arg, "--game") == 0 && has_value)
+        {
+            if ((game_index = find_game(argv[++i])) < 0)
+                return 1;
+        }
+        else if (strcmp(arg, "--port") == 0 && has_value)
+            port = atoi(argv[++i]);
+        else if (strcmp(arg, "--matches") == 0 && has_value)
+            match_count = atoi(argv[++i]);
+        else if (strcmp(arg, "--threads") == 0 && has_value)
+            threads = atoi(argv[++i]);
+        else if (strcmp(arg, "--tick") == 0 && has_value)
+            tick_hz = atoi(argv[++i]);
+        else if (strcmp(arg, "--seconds") == 0 && has_value)
+            seconds = atof(argv[++i]);
+        else if (strcmp(arg, "--seed") == 0 && has_value)
+            seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        else if (strcmp(arg, "--bots") == 0 && i + 2 < argc)
+        {
+            bots_host = argv[++i];
+            port = atoi(argv[++i]);
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--game paddleball|asteroids] [--port N] [--matches N] [--threads N]\n"
+                            "          [--tick HZ] [--seconds S] [--seed N]\n"
+                            "       %s --bots HOST PORT [--game NAME] [--matches N] [--seconds S]\n",
+                    argv[0], argv[0]);
+            return 1;
+        }
+    }
+
+    signal(SIGINT, request_stop);
+    signal(SIGTERM, request_stop);
+    if (bots_host)
+        return run_bots(bots_host, port, game_index, match_count, seconds > 0 ? seconds : 10.0);
+    return run_server(game_index, port, match_count, threads, tick_hz, seconds, seed);
+}
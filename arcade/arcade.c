@@ -0,0 +1,15 @@
+/* =========================================================================
+ * Arcade Library - Implementation
+ * =========================================================================
+ * Compiles the implementation in arcade.h (and the STB libraries it uses)
+ * once, for libarcade. Games include arcade.h without defining
+ * ARCADE_IMPLEMENTATION and link the library built by the Makefile here.
+ *
+ * Notes:
+ * - The backend is chosen when this file is compiled (ARCADE_HEADLESS,
+ *   ARCADE_XCB, ARCADE_XRENDER); the Makefile builds one library per
+ *   backend.
+ * ========================================================================= */
+
+#define ARCADE_IMPLEMENTATION
+#include "arcade.h"
@@ -0,0 +1,10124 @@
+/* =========================================================================
+ * Arcade Library - Header File
+ * =========================================================================
+ * Author: GeorgeET15
+ * GitHub: https://github.com/GeorgeET15
+ * Repository: https://github.com/GeorgeET15/arcade-lib
+ *
+ * Description:
+ * A lightweight C library for creating 2D arcade-style games. It provides
+ * essential functionality for retro game development, including window
+ * management, color and image-based sprites, sprite animation, collision
+ * detection, sound playback, text rendering, and image manipulation. The library
+ * is designed to be minimal, with cross-platform support for Windows (Win32) and
+ * Linux (X11), making it ideal for simple games like Flappy Bird or Pong.
+ *
+ * Features:
+ * - Window creation and event handling.
+ * - Support for color-based and image-based sprites with animation, and a
+ *   per-draw tint, flash and fade for image sprites and layers.
+ * - Keyboard input processing with single-press detection.
+ * - Pixel buffer rendering for sprites and text, with vectorized rectangle
+ *   fills, translucent (alpha) color sprites, occlusion culling of
+ *   opaque sprites, wrapping parallax scroll layers, and image blits
+ *   specialized per alpha, tint and scale mode.
+ * - Vector shapes: plain and antialiased lines, filled and outlined polygons
+ *   and filled circles, drawn as spans straight into a framebuffer.
+ * - WAV audio playback.
+ * - Image flipping and rotation.
+ * - QOI images, decoded several times faster than PNG (recognized by their
+ *   header, whatever the file is called; arcade/qoiconv converts PNGs).
+ * - Image loads that decode and resize straight into the sprite's pixels
+ *   (no intermediate copies), with smooth, bilinear or point (pixel art)
+ *   resize filters.
+ * - Game-state snapshot rings for rewind and instant restart.
+ * - UDP networking with simulated latency/loss, and rollback netcode sessions.
+ * - Worker thread pool and snapshot delta encoding for servers and batch jobs.
+ * - Gym-style environments (reset/step with pixel or state observations) for
+ *   training agents, vectorized across threads.
+ * - Seedable random number streams with unbiased ranges, floats and bulk fills.
+ * - Hierarchical timer wheel for game timers, with callback or poll delivery.
+ * - Tear-free, vblank-paced presentation through the X Present extension
+ *   (XCB backend), with frame timing taken from the display.
+ * - Native 16-bit (RGB565) rendering on 16-bit X visuals: scenes are drawn
+ *   straight into a 16-bit frame from sprite copies dithered once at load,
+ *   so drawing and uploads move half the bytes.
+ * - Per-cabinet performance settings (frame rate, pacing, backend, pixel
+ *   format, threads, image cache budget, frame time report) read from the
+ *   game's arcade.config.json, with environment variable overrides.
+ * - Several games in one process: ArcadeGame entry points run by
+ *   arcade_run_game or a launcher, window resizing in place (arcade_resize),
+ *   and a shared cache of decoded images (arcade_set_asset_cache).
+ * - Full-screen pixel passes (fades, flashes, scanlines, color grading, or
+ *   a custom per-row kernel) run in row bands on a worker pool.
+ * - Leveled, categorized logging (arcade_log) formatted into per-thread
+ *   lock-free rings and written out by a background thread, so logging
+ *   never waits on the terminal or disk.
+ *
+ * Platforms:
+ * - Windows: Uses Win32 API (GDI for rendering, winmm for audio).
+ * - Linux: Uses X11 for rendering and aplay for audio.
+ * - Headless: Define ARCADE_HEADLESS before including the implementation to
+ *   build without a window system (no X11 or GDI). Sprites still render into
+ *   the pixel buffer, but nothing is shown, text and audio are skipped, and no
+ *   keys are ever pressed. Used by the match server.
+ * - XRender (Linux, optional): Define ARCADE_XRENDER before including the
+ *   implementation and link -lXrender to make ARCADE_BACKEND_XRENDER
+ *   available (see arcade_set_backend).
+ * - XCB (Linux, optional): Define ARCADE_XCB before including the
+ *   implementation and link -lxcb instead of -lX11 to talk to the X server
+ *   through XCB. Startup requests are pipelined instead of waiting on each
+ *   reply in turn, and no call ever waits on the server during a frame
+ *   (replies are picked up when they arrive; events are read in batches).
+ *   Assumes a 24/32-bit display with the client's byte order, as local
+ *   servers are. The XRender backend needs Xlib and is not available here.
+ *   Frames are shown at vblank through the Present extension when the
+ *   server has it (see arcade_set_vsync).
+ * - 16-bit displays (Linux): On a 16-bit (RGB565) visual, or one chosen with
+ *   arcade_set_pixel_format, arcade_render_scene draws into a 16-bit frame
+ *   with ordered dithering; frames drawn into arcade_screen are converted
+ *   as they are sent.
+ *
+ * Dependencies:
+ * Linux:
+ * - libX11: For window creation and rendering (libxcb with ARCADE_XCB).
+ * - libm: For mathematical functions (used by STB libraries).
+ * - STB libraries (stb_image.h, stb_image_write.h, stb_image_resize2.h): For
+ *   image loading, writing, and resizing.
+ * - aplay: For WAV audio playback (part of alsa-utils).
+ * - pthread: For the worker pool (arcade_pool_*).
+ * Windows:
+ * - gdi32: For window rendering.
+ * - winmm: For WAV audio playback.
+ * - ws2_32: For UDP networking (arcade_net_*).
+ * - STB libraries: Same as Linux.
+ *
+ * Compilation:
+ * The implementation is compiled once, from arcade.c, into libarcade (static
+ * and shared, -O3 with LTO), one build per backend:
+ *   make -C arcade BACKEND=x11      # or xrender, xcb, headless; ARCH=x86-64-v3
+ *   gcc -Iarcade -flto -o game game.c arcade/build/x11/libarcade.a -lX11 -lm -lpthread
+ * Games include arcade.h without ARCADE_IMPLEMENTATION. To use the header on
+ * its own instead, define ARCADE_IMPLEMENTATION before including it in one
+ * source file (arcade.c does just that), as in the commands below.
+ * Linux:
+ *   gcc -o game game.c arcade.c -lX11 -lm -lpthread
+ * Linux (headless):
+ *   gcc -DARCADE_HEADLESS -o server server.c arcade.c -lm -lpthread
+ * Linux (with the XRender backend):
+ *   gcc -DARCADE_XRENDER -o game game.c arcade.c -lX11 -lXrender -lm -lpthread
+ * Linux (XCB instead of Xlib):
+ *   gcc -DARCADE_XCB -o game game.c arcade.c -lxcb -lm -lpthread
+ * Windows:
+ *   gcc -o game game.c arcade.c -lgdi32 -lwinmm -lws2_32
+ *
+ * Usage Example:
+ *   #include "arcade.h"
+ *   int main() {
+ *       // Initialize window (800x600, black background)
+ *       arcade_init(800, 600, "My Game", 0x000000);
+ *       // Create an image sprite at (100,100) with size 50x50
+ *       ArcadeImageSprite sprite = arcade_create_image_sprite(100, 100, 50, 50, "sprite.png");
+ *       // Initialize sprite group
+ *       SpriteGroup group;
+ *       arcade_init_group(&group, 1);
+ *       arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.image_sprite = sprite}, SPRITE_IMAGE);
+ *       // Game loop (~60 FPS)
+ *       while (arcade_running() && arcade_update()) {
+ *           arcade_render_group(&group);
+ *           arcade_wait_frame(); // 60 FPS unless configured otherwise
+ *       }
+ *       // Clean up
+ *       arcade_free_image_sprite(&sprite);
+ *       arcade_free_group(&group);
+ *       arcade_quit();
+ *       return 0;
+ *   }
+ *
+ * Notes:
+ * - Ensure sprite image files (e.g., PNG) are in the correct directory.
+ * - WAV audio files must be PCM, 16-bit, mono/stereo for compatibility.
+ * - Use arcade_sleep to control frame rate (e.g., 16ms for ~60 FPS).
+ * - Check return values of initialization functions for error handling.
+ * - Free all sprites and groups before calling arcade_quit to avoid memory leaks.
+ * ========================================================================= */
+
+#ifndef ARCADE_H
+#define ARCADE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <time.h>
+#include <stdio.h>
+
+/* =========================================================================
+ * Enumerations
+ * ========================================================================= */
+
+/* Sprite type identifiers for rendering.
+ * Used to specify the type of sprite when adding to a SpriteGroup or rendering.
+ * Values:
+ * - SPRITE_COLOR (0): For ArcadeSprite (color-based, solid rectangle).
+ * - SPRITE_IMAGE (1): For ArcadeImageSprite (image-based, loaded from file).
+ * - SPRITE_LAYER (2): For ArcadeScrollLayer (scrolling, wrapping image).
+ * Example:
+ *   arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.sprite = my_sprite}, SPRITE_COLOR);
+ */
+enum
+{
+    SPRITE_COLOR = 0, /* Color-based sprite (ArcadeSprite) */
+    SPRITE_IMAGE = 1, /* Image-based sprite (ArcadeImageSprite) */
+    SPRITE_LAYER = 2  /* Scrolling layer (ArcadeScrollLayer) */
+};
+
+/* Rendering backends for arcade_set_backend.
+ * Values:
+ * - ARCADE_BACKEND_SOFTWARE (0): Sprites are drawn into the pixel buffer on
+ *   the CPU and every frame is sent to the window whole (default).
+ * - ARCADE_BACKEND_XRENDER (1): Linux, built with ARCADE_XRENDER: images are
+ *   uploaded to the X server once and scenes are composited there.
+ */
+enum
+{
+    ARCADE_BACKEND_SOFTWARE = 0, /* CPU rendering, full-frame upload */
+    ARCADE_BACKEND_XRENDER = 1   /* Server-side compositing with XRender */
+};
+
+/* Display pixel formats for arcade_set_pixel_format.
+ * Values:
+ * - ARCADE_FORMAT_AUTO (0): Whatever the screen's default visual uses (default).
+ * - ARCADE_FORMAT_XRGB8888 (1): 32 bits per pixel, 8 bits per channel.
+ * - ARCADE_FORMAT_RGB565 (2): 16 bits per pixel (5 red, 6 green, 5 blue).
+ */
+enum
+{
+    ARCADE_FORMAT_AUTO = 0,     /* Match the default visual */
+    ARCADE_FORMAT_XRGB8888 = 1, /* 0x00RRGGBB in a uint32_t */
+    ARCADE_FORMAT_RGB565 = 2    /* RRRRRGGGGGGBBBBB in a uint16_t */
+};
+
+/* Frame pacing modes for arcade_set_pacing.
+ * Values:
+ * - ARCADE_PACING_VSYNC (0): Frames are shown at vertical blanks where the
+ *   backend can (arcade_vsync); elsewhere arcade_wait_frame sleeps to the
+ *   target frame rate (default).
+ * - ARCADE_PACING_SLEEP (1): No vsync; arcade_wait_frame sleeps to the
+ *   target frame rate.
+ * - ARCADE_PACING_NONE (2): No vsync and no waiting.
+ */
+enum
+{
+    ARCADE_PACING_VSYNC = 0, /* Vertical blanks, else sleep */
+    ARCADE_PACING_SLEEP = 1, /* Sleep to the target frame rate */
+    ARCADE_PACING_NONE = 2   /* As fast as possible */
+};
+
+/* Image resize filters for arcade_set_image_filter.
+ * Values:
+ * - ARCADE_FILTER_SMOOTH (0): Gamma-correct (sRGB) filtering, for painted
+ *   art (default).
+ * - ARCADE_FILTER_LINEAR (1): Bilinear on the stored values: faster, with
+ *   slightly darker blends of contrasting colors.
+ * - ARCADE_FILTER_POINT (2): Nearest pixel: hard edges for pixel art, fastest.
+ */
+enum
+{
+    ARCADE_FILTER_SMOOTH = 0, /* sRGB-correct resampling */
+    ARCADE_FILTER_LINEAR = 1, /* Bilinear, no gamma */
+    ARCADE_FILTER_POINT = 2   /* Nearest pixel */
+};
+
+/* Log levels for arcade_log and arcade_set_log_level.
+ * Values:
+ * - ARCADE_LOG_DEBUG (0): Per-event detail (scores, hits); hidden by default.
+ * - ARCADE_LOG_INFO (1): Normal messages (the default level).
+ * - ARCADE_LOG_WARN (2): Something is missing or degraded.
+ * - ARCADE_LOG_ERROR (3): Something failed.
+ */
+enum
+{
+    ARCADE_LOG_DEBUG = 0, /* Per-event detail */
+    ARCADE_LOG_INFO = 1,  /* Normal messages */
+    ARCADE_LOG_WARN = 2,  /* Degraded */
+    ARCADE_LOG_ERROR = 3  /* Failed */
+};
+
+/* =========================================================================
+ * Key Definitions
+ * ========================================================================= */
+
+/* Predefined key codes for input handling.
+ * Used with arcade_key_pressed() and arcade_key_pressed_once() to detect key
+ * states. Codes are platform-specific (X11 keycodes for Linux, virtual key codes
+ * for Windows) but abstracted for portability.
+ * Usage:
+ *   if (arcade_key_pressed_once(a_space)) {
+ *       // Handle spacebar press (e.g., jump)
+ *   }
+ * Notes:
+ * - Key codes are defined as hexadecimal values.
+ * - Use arcade_key_pressed for continuous press detection (e.g., holding a key).
+ * - Use arcade_key_pressed_once for single-press events (e.g., triggering an action).
+ */
+#define a_a 0x0061 /* A key */
+#define a_b 0x0062 /* B key */
+#define a_c 0x0063 /* C key */
+#define a_d 0x0064 /* D key */
+#define a_e 0x0065 /* E key */
+#define a_f 0x0066 /* F key */
+#define a_g 0x0067 /* G key */
+#define a_h 0x0068 /* H key */
+#define a_i 0x0069 /* I key */
+#define a_j 0x006a /* J key */
+#define a_k 0x006b /* K key */
+#define a_l 0x006c /* L key */
+#define a_m 0x006d /* M key */
+#define a_n 0x006e /* N key */
+#define a_o 0x006f /* O key */
+#define a_p 0x0070 /* P key */
+#define a_q 0x0071 /* Q key */
+#define a_r 0x0072 /* R key */
+#define a_s 0x0073 /* S key */
+#define a_t 0x0074 /* T key */
+#define a_u 0x0075 /* U key */
+#define a_v 0x0076 /* V key */
+#define a_w 0x0077 /* W key */
+#define a_x 0x0078 /* X key */
+#define a_y 0x0079 /* Y key */
+#define a_z 0x007a /* Z key */
+
+#define a_0 0x0030 /* 0 key */
+#define a_1 0x0031 /* 1 key */
+#define a_2 0x0032 /* 2 key */
+#define a_3 0x0033 /* 3 key */
+#define a_4 0x0034 /* 4 key */
+#define a_5 0x0035 /* 5 key */
+#define a_6 0x0036 /* 6 key */
+#define a_7 0x0037 /* 7 key */
+#define a_8 0x0038 /* 8 key */
+#define a_9 0x0039 /* 9 key */
+
+#define a_space 0x0020      /* Spacebar */
+#define a_excl 0x0021       /* ! */
+#define a_quot 0x0022       /* " */
+#define a_hash 0x0023       /* # */
+#define a_dollar 0x0024     /* $ */
+#define a_percent 0x0025    /* % */
+#define a_amp 0x0026        /* & */
+#define a_squote 0x0027     /* ' */
+#define a_lparen 0x0028     /* ( */
+#define a_rparen 0x0029     /* ) */
+#define a_asterisk 0x002a   /* * */
+#define a_plus 0x002b       /* + */
+#define a_comma 0x002c      /* , */
+#define a_minus 0x002d      /* - */
+#define a_dot 0x002e        /* . */
+#define a_slash 0x002f      /* / */
+#define a_colon 0x003a      /* : */
+#define a_semicolon 0x003b  /* ; */
+#define a_less 0x003c       /* < */
+#define a_equal 0x003d      /* = */
+#define a_greater 0x003e    /* > */
+#define a_question 0x003f   /* ? */
+#define a_at 0x0040         /* @ */
+#define a_lbracket 0x005b   /* [ */
+#define a_backslash 0x005c  /* \ */
+#define a_rbracket 0x005d   /* ] */
+#define a_caret 0x005e      /* ^ */
+#define a_underscore 0x005f /* _ */
+#define a_backtick 0x0060   /* ` */
+#define a_lbrace 0x007b     /* { */
+#define a_pipe 0x007c       /* | */
+#define a_rbrace 0x007d     /* } */
+#define a_tilde 0x007e      /* ~ */
+
+#define a_up 0xff52    /* Up arrow */
+#define a_down 0xff54  /* Down arrow */
+#define a_left 0xff51  /* Left arrow */
+#define a_right 0xff53 /* Right arrow */
+
+#define a_enter 0xff0d     /* Enter/Return */
+#define a_esc 0xff1b       /* Escape */
+#define a_shift 0xffe1     /* Shift (Left Shift) */
+#define a_ctrl 0xffe3      /* Control (Left Ctrl) */
+#define a_alt 0xffe9       /* Alt (Left Alt) */
+#define a_tab 0xff09       /* Tab */
+#define a_capslock 0xffe5  /* Caps Lock */
+#define a_backspace 0xff08 /* Backspace */
+
+/* =========================================================================
+ * Data Structures
+ * ========================================================================= */
+
+/*
+ * ArcadeSprite: Represents a color-based sprite (solid rectangle).
+ * Used for simple shapes like platforms, walls, or placeholders.
+ * Fields:
+ * - x, y: Position (top-left corner) in window coordinates (pixels, float).
+ * - width, height: Size of the sprite (pixels, float).
+ * - vy, vx: Vertical and horizontal velocity (pixels per frame, float).
+ * - color: RGB color (0xRRGGBB), or 0xAARRGGBB with an alpha of 0x01-0xFE
+ *   to blend over what is below (e.g. 0x80000000 dims the screen by half).
+ * - active: State (1 = active, 0 = inactive, ignored in rendering/collisions).
+ * Example:
+ *   ArcadeSprite platform = {100.0f, 500.0f, 200.0f, 20.0f, 0.0f, 0.0f, 0x00FF00, 1};
+ *   arcade_move_sprite(&platform, 0.0f, 600);
+ */
+typedef struct
+{
+    float x, y;          /* Position (pixels, float) */
+    float width, height; /* Size (pixels, float) */
+    float vy, vx;        /* Velocity (pixels per frame, float) */
+    unsigned int color;  /* RGB color (0xRRGGBB, optional alpha byte) */
+    int active;          /* Active state (1 = active, 0 = inactive) */
+} ArcadeSprite;
+
+/*
+ * ArcadeImageSprite: Represents an image-based sprite loaded from a file.
+ * Used for detailed graphics like characters, enemies, or backgrounds.
+ * Fields:
+ * - x, y: Position (top-left corner) in window coordinates (pixels, float).
+ * - width, height: Size of the sprite (pixels, float, set from image dimensions).
+ * - vy, vx: Vertical and horizontal velocity (pixels per frame, float).
+ * - pixels: Pixel data (RGBA, 32-bit per pixel, dynamically allocated).
+ * - image_width, image_height: Pixel dimensions of the image (int).
+ * - active: State (1 = active, 0 = inactive, ignored in rendering/collisions).
+ * - opaque: 1 if no pixel is fully transparent (set when the image loads), so
+ *   the renderer can skip whatever the sprite hides. Must be 0 if any is.
+ * - tint: Color multiplied into every pixel when drawn (0xAARRGGBB, 0 = none).
+ *   Its alpha fades the sprite over what is behind it; alpha 0 counts as
+ *   0xFF, as for color sprites.
+ * - flash: Color added to every pixel after the tint, saturating (0xRRGGBB,
+ *   0 = none), e.g. 0xFFFFFF for a white hit flash.
+ * Example:
+ *   ArcadeImageSprite player = arcade_create_image_sprite(100.0f, 100.0f, 50.0f, 50.0f, "player.png");
+ *   arcade_move_image_sprite(&player, 0.1f, 600);
+ *   player.tint = 0x80FF8080; // Reddish and half faded
+ * Notes:
+ * - Pixel data must be freed with arcade_free_image_sprite to avoid memory leaks.
+ * - Supports PNG files (via STB libraries); other formats may work but are untested.
+ * - Tint and flash are applied while blitting, so one image serves any number
+ *   of colored variants; the stored pixels never change.
+ */
+typedef struct
+{
+    float x, y;                    /* Position (pixels, float) */
+    float width, height;           /* Size (pixels, float) */
+    float vy, vx;                  /* Velocity (pixels per frame, float) */
+    uint32_t *pixels;              /* Pixel data (RGBA, 32-bit) */
+    int image_width, image_height; /* Image dimensions (pixels, int) */
+    int active;                    /* Active state (1 = active, 0 = inactive) */
+    int opaque;                    /* 1 = every pixel has nonzero alpha */
+    uint32_t tint;                 /* Multiplied color (0xAARRGGBB, 0 = none) */
+    uint32_t flash;                /* Added color (0xRRGGBB, 0 = none) */
+} ArcadeImageSprite;
+
+/*
+ * ArcadeAnimatedSprite: Represents a sprite with multiple frames for animation.
+ * Used for animated characters or objects (e.g., a flapping bird).
+ * Fields:
+ * - frames: Array of ArcadeImageSprite for each animation frame.
+ * - frame_count: Number of frames in the animation.
+ * - current_frame: Index of the current frame (0 to frame_count-1).
+ * - frame_interval: Frames between animation updates (controls speed).
+ * - frame_counter: Internal counter for tracking animation progress.
+ * Example:
+ *   const char *frames[] = {"bird1.png", "bird2.png", "bird3.png"};
+ *   ArcadeAnimatedSprite bird = arcade_create_animated_sprite(100.0f, 100.0f, 50.0f, 50.0f, frames, 3, 5);
+ *   arcade_move_animated_sprite(&bird, 0.1f, 600);
+ * Notes:
+ * - All frames must have the same dimensions.
+ * - Free with arcade_free_animated_sprite to avoid memory leaks.
+ */
+typedef struct
+{
+    ArcadeImageSprite *frames; /* Array of frames */
+    int frame_count;           /* Number of frames */
+    int current_frame;         /* Current frame index */
+    int frame_interval;        /* Frames between animation updates */
+    int frame_counter;         /* Animation progress counter */
+} ArcadeAnimatedSprite;
+
+/*
+ * ArcadeScrollLayer: A repeating image that scrolls behind (or in front of)
+ * the sprites, for parallax backgrounds and ground strips.
+ * Fields:
+ * - x, y: Position of the layer's top-left corner on screen (pixels, float).
+ * - width, height: Area the layer covers on screen (pixels, float).
+ * - scroll_x, scroll_y: Image pixel shown at the top-left corner; the image
+ *   repeats in both directions (pixels, float, kept in [0, image size)).
+ * - speed_x, speed_y: Scroll per pixel of camera movement (1.0 = moves with
+ *   the world, 0.5 = a far-away layer, 0 = fixed).
+ * - pixels: Pixel data (RGBA, 32-bit per pixel, stored once).
+ * - image_width, image_height: Pixel dimensions of the image (int).
+ * - active: State (1 = active, 0 = inactive, ignored in rendering).
+ * - opaque: 1 if no pixel is fully transparent (set when the image loads).
+ * - tint, flash: Color modulation when drawn, as for ArcadeImageSprite.
+ * Example:
+ *   ArcadeScrollLayer hills = arcade_create_scroll_layer(0.0f, 0.0f, 800.0f, 600.0f, "hills.png", 400, 600, 0.5f, 0.0f);
+ *   arcade_scroll_layer(&hills, camera_x, 0.0f);
+ *   arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.layer = hills}, SPRITE_LAYER);
+ * Notes:
+ * - Each row is drawn as a few clipped spans of the image (two when the image
+ *   is at least as wide as the layer), so a layer costs about as much as an
+ *   image sprite of the same size.
+ * - Free with arcade_free_scroll_layer to avoid memory leaks.
+ */
+typedef struct
+{
+    float x, y;                    /* Screen position (pixels, float) */
+    float width, height;           /* Screen size (pixels, float) */
+    float scroll_x, scroll_y;      /* Image offset (pixels, float) */
+    float speed_x, speed_y;        /* Scroll per pixel of camera movement */
+    uint32_t *pixels;              /* Pixel data (RGBA, 32-bit) */
+    int image_width, image_height; /* Image dimensions (pixels, int) */
+    int active;                    /* Active state (1 = active, 0 = inactive) */
+    int opaque;                    /* 1 = every pixel has nonzero alpha */
+    uint32_t tint;                 /* Multiplied color (0xAARRGGBB, 0 = none) */
+    uint32_t flash;                /* Added color (0xRRGGBB, 0 = none) */
+} ArcadeScrollLayer;
+
+/*
+ * ArcadeAnySprite: Union to handle both color and image-based sprites.
+ * Allows SpriteGroup to store an ArcadeSprite, ArcadeImageSprite or
+ * ArcadeScrollLayer.
+ * Fields:
+ * - sprite: ArcadeSprite (color-based).
+ * - image_sprite: ArcadeImageSprite (image-based).
+ * - layer: ArcadeScrollLayer (scrolling image).
+ * Example:
+ *   ArcadeAnySprite any_sprite = {.image_sprite = player};
+ *   arcade_add_sprite_to_group(&group, any_sprite, SPRITE_IMAGE);
+ * Notesmong:
+ * - Use with SPRITE_COLOR, SPRITE_IMAGE or SPRITE_LAYER to specify the type.
+ * - Ensures type safety when rendering mixed sprite types.
+ */
+typedef union
+{
+    ArcadeSprite sprite;            /* Color-based sprite */
+    ArcadeImageSprite image_sprite; /* Image-based sprite */
+    ArcadeScrollLayer layer;        /* Scrolling layer */
+} ArcadeAnySprite;
+
+/*
+ * SpriteGroup: Manages a collection of sprites for batch rendering.
+ * Simplifies rendering multiple sprites in a single call.
+ * Fields:
+ * - sprites: Array of ArcadeAnySprite (color or image-based).
+ * - types: Array of sprite types (SPRITE_COLOR, SPRITE_IMAGE or SPRITE_LAYER).
+ * - count: Current number of sprites in the group.
+ * - capacity: Maximum number of sprites the group can hold.
+ * Example:
+ *   SpriteGroup group;
+ *   arcade_init_group(&group, 10);
+ *   arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.image_sprite = player}, SPRITE_IMAGE);
+ *   arcade_render_group(&group);
+ * Notes:
+ * - Initialize with arcade_init_group before use.
+ * - Free with arcade_free_group to avoid memory leaks.
+ */
+typedef struct
+{
+    ArcadeAnySprite *sprites; /* Array of sprites */
+    int *types;               /* Array of sprite types */
+    int count;                /* Current sprite count */
+    int capacity;             /* Maximum sprite count */
+} SpriteGroup;
+
+/*
+ * ArcadeFramebuffer: A pixel buffer that sprites can be rendered into.
+ * Used to render off-screen, e.g. observations for agents or thumbnails,
+ * without touching the window. Sprite coordinates are multiplied by the
+ * scale, so a scene can be rendered straight at a smaller size.
+ * Fields:
+ * - pixels: width * height pixels (0xAARRGGBB), owned by the caller.
+ * - width, height: Buffer dimensions in pixels.
+ * - bg_color: Color the buffer is cleared to before each scene.
+ * - scale_x, scale_y: Buffer pixels per scene pixel (1.0f for full size).
+ * Example:
+ *   uint32_t pixels[84 * 84];
+ *   ArcadeFramebuffer small = {pixels, 84, 84, 0x000000, 84.0f / 800, 84.0f / 600};
+ *   arcade_render_scene_to(&small, sprites, count, types);
+ * Notes:
+ * - At scale 1 the result matches arcade_render_scene exactly; other scales
+ *   sample images with nearest-neighbour and draw every visible sprite at
+ *   least one pixel wide and tall.
+ */
+typedef struct
+{
+    uint32_t *pixels;       /* Pixel storage (caller-owned) */
+    int width, height;      /* Dimensions in pixels */
+    uint32_t bg_color;      /* Clear color (0xRRGGBB) */
+    float scale_x, scale_y; /* Buffer pixels per scene pixel */
+} ArcadeFramebuffer;
+
+/*
+ * ArcadePoint: A point in framebuffer pixels, for vector shapes.
+ * Fields:
+ * - x, y: Position (pixels, float). Pixel (i, j) covers [i, i + 1) x [j, j + 1).
+ * Example:
+ *   ArcadePoint ship[3] = {{200, 750}, {215, 780}, {185, 780}};
+ *   arcade_fill_polygon(&screen, ship, 3, 0xFF0000);
+ */
+typedef struct
+{
+    float x, y; /* Position (pixels, float) */
+} ArcadePoint;
+
+/*
+ * ArcadePixelKernel: Effect run over a framebuffer by arcade_pixel_pass.
+ * Parameters:
+ * - pixels: First pixel of a row span (0xAARRGGBB), changed in place.
+ * - count: Pixels in the span.
+ * - x, y: Framebuffer position of pixels[0].
+ * - user: Pointer passed to arcade_pixel_pass.
+ * Notes:
+ * - Called for different rows at the same time from the pool's threads:
+ *   read user, do not write it.
+ */
+typedef void (*ArcadePixelKernel)(uint32_t *pixels, int count, int x, int y, void *user);
+
+/*
+ * ArcadeMix: Settings of arcade_effect_mix (fades and flashes).
+ * Fields:
+ * - color: Color mixed in (0xRRGGBB).
+ * - amount: How much of it, from 0 (none) to 255 (solid color).
+ * Example:
+ *   ArcadeMix fade = {0x000000, 128}; // Half way to black
+ */
+typedef struct
+{
+    uint32_t color; /* Color mixed in (0xRRGGBB) */
+    int amount;     /* 0-255 */
+} ArcadeMix;
+
+/*
+ * ArcadeScanlines: Settings of arcade_effect_scanlines (CRT look).
+ * Fields:
+ * - spacing: One row in every spacing rows is darkened (2 = every other row).
+ * - level: Brightness those rows keep, from 0 (black) to 255 (unchanged).
+ * Example:
+ *   ArcadeScanlines crt = {2, 170};
+ */
+typedef struct
+{
+    int spacing; /* Rows per darkened row */
+    int level;   /* 0-255 */
+} ArcadeScanlines;
+
+/*
+ * ArcadeColorGrade: Per-channel lookup tables of arcade_effect_grade.
+ * Fields:
+ * - r, g, b: New value of each channel value.
+ * Example:
+ *   ArcadeColorGrade grade;
+ *   arcade_color_grade_init(&grade, 0.0f, 1.2f, 1.0f);
+ *   for (int i = 0; i < 256; i++) grade.b[i] = (uint8_t)(i * 3 / 4); // Warmer
+ */
+typedef struct
+{
+    uint8_t r[256], g[256], b[256]; /* Channel value -> graded value */
+} ArcadeColorGrade;
+
+/*
+ * ArcadeSnapshotRing: Preallocated ring of fixed-size game-state snapshots.
+ * Used for rewind, instant restart, and save states. The game keeps all of its
+ * simulation state in one flat struct without pointers, and the ring copies
+ * that struct in and out with memcpy.
+ * Fields:
+ * - data: Storage for capacity snapshots of size bytes each.
+ * - size: Size of one snapshot (bytes, usually sizeof the game-state struct).
+ * - capacity: Maximum number of snapshots kept; older ones are overwritten.
+ * - head: Slot that the next push writes to.
+ * - count: Number of snapshots currently stored (0 to capacity).
+ * Example:
+ *   ArcadeSnapshotRing history;
+ *   arcade_snapshot_ring_init(&history, sizeof(GameData), 180); // 3 seconds at 60 FPS
+ *   arcade_snapshot_push(&history, &game);                      // Once per tick
+ *   if (arcade_key_pressed(a_backspace))
+ *       arcade_snapshot_pop(&history, &game);                   // Step back one tick
+ * Notes:
+ * - All memory is allocated by arcade_snapshot_ring_init; pushes never allocate.
+ * - Free with arcade_snapshot_ring_free.
+ */
+typedef struct
+{
+    unsigned char *data; /* Snapshot storage (capacity * size bytes) */
+    size_t size;         /* Bytes per snapshot */
+    int capacity;        /* Maximum snapshots kept */
+    int head;            /* Next slot to write */
+    int count;           /* Snapshots stored */
+} ArcadeSnapshotRing;
+
+#define ARCADE_NET_MAX_PACKET 512 /* Largest UDP payload sent or received (bytes) */
+#define ARCADE_NET_QUEUE 64       /* Packets held back by simulated latency */
+
+/*
+ * ArcadeNetPacket: One outgoing packet held back by simulated latency.
+ * Fields:
+ * - release_time: arcade_time() at which the packet is actually sent.
+ * - size: Payload size (bytes).
+ * - data: Payload.
+ */
+typedef struct
+{
+    double release_time;                      /* When to send (seconds) */
+    int size;                                 /* Payload size (bytes) */
+    unsigned char data[ARCADE_NET_MAX_PACKET]; /* Payload */
+} ArcadeNetPacket;
+
+/*
+ * ArcadeNet: Non-blocking UDP connection to a single peer.
+ * Used for two-player network games. Can simulate latency and packet loss
+ * so netcode can be tested over loopback on one machine.
+ * Fields:
+ * - socket: Platform socket handle (-1 when closed).
+ * - remote_ip, remote_port: Peer address (IPv4, network byte order).
+ * - latency_ms: Simulated one-way latency added to outgoing packets.
+ * - loss_percent: Simulated outgoing packet loss (0-100).
+ * - loss_seed: State of the generator deciding which packets are lost.
+ * - queue, queue_head, queue_count: Packets waiting for their release time.
+ * - sent, received, dropped: Packet counters (dropped = simulated loss).
+ * Example:
+ *   ArcadeNet net;
+ *   arcade_net_open(&net, 7000, "127.0.0.1", 7001);
+ *   arcade_net_simulate(&net, 50, 5); // 50 ms each way, 5% loss
+ * Notes:
+ * - Close with arcade_net_close.
+ */
+typedef struct
+{
+    intptr_t socket;                         /* Socket handle, -1 if closed */
+    uint32_t remote_ip;                      /* Peer IPv4 address (network byte order) */
+    uint16_t remote_port;                    /* Peer port (network byte order) */
+    int latency_ms;                          /* Simulated one-way latency (ms) */
+    int loss_percent;                        /* Simulated packet loss (%) */
+    uint32_t loss_seed;                      /* Simulated loss generator state */
+    ArcadeNetPacket queue[ARCADE_NET_QUEUE]; /* Delayed outgoing packets */
+    int queue_head;                          /* Oldest delayed packet */
+    int queue_count;                         /* Delayed packets waiting */
+    int sent, received, dropped;             /* Packet counters */
+} ArcadeNet;
+
+#define ARCADE_ROLLBACK_PLAYERS 2  /* Players in a rollback session */
+#define ARCADE_ROLLBACK_FRAMES 8   /* Most frames predicted ahead of the peer (and resimulated) */
+#define ARCADE_ROLLBACK_HISTORY 64 /* Frames of input kept per player (power of two) */
+#define ARCADE_ROLLBACK_SEND 32    /* Most inputs carried by one packet */
+
+/*
+ * ArcadeStepFunc: Advances a game state by exactly one fixed frame.
+ * Must be deterministic: the same state and inputs always give the same
+ * result on both machines (no delta time, rand() or clocks inside).
+ * Parameters:
+ * - state: Game state to advance in place.
+ * - inputs: One input byte per player, indexed by player number.
+ */
+typedef void (*ArcadeStepFunc)(void *state, const uint8_t *inputs);
+
+/*
+ * ArcadeRollback: Two-player rollback netcode session over an ArcadeNet.
+ * Each frame the local input is sent to the peer and the game advances at
+ * once, predicting that the peer repeats its last known input. When the real
+ * input arrives and differs, the session restores the snapshot of the first
+ * mispredicted frame and resimulates up to the present.
+ * Fields:
+ * - net: Connection to the peer.
+ * - history: Snapshots of the state before each of the last frames.
+ * - step: Deterministic one-frame step function.
+ * - state: Live game state (owned by the game).
+ * - local_player: This machine's player number (0 or 1).
+ * - input_delay: Frames between sampling a local input and using it.
+ * - frame: Next frame to simulate.
+ * - local_frame: Newest frame with a local input.
+ * - remote_frame: Newest frame with a confirmed peer input.
+ * - remote_ack: Newest local frame the peer has confirmed.
+ * - inputs: Input history per player (predicted or confirmed).
+ * - peer_ping: Newest timestamp received from the peer, echoed back.
+ * - rtt_ms: Smoothed round-trip time (milliseconds).
+ * - last_rollback: Frames resimulated by the last update.
+ * - stalls: Updates that waited because the peer fell too far behind.
+ * Example:
+ *   ArcadeRollback session;
+ *   arcade_rollback_init(&session, &net, &game, sizeof(GameData), step_game, player, 2);
+ *   while (arcade_running() && arcade_update()) {
+ *       arcade_rollback_update(&session, read_local_input());
+ *       render(&game);
+ *   }
+ *   arcade_rollback_free(&session);
+ * Notes:
+ * - Both peers must use the same input delay and start from the same state.
+ * - Never predicts more than ARCADE_ROLLBACK_FRAMES ahead of the peer; the
+ *   game waits instead, so one rollback resimulates at most that many frames.
+ */
+typedef struct
+{
+    ArcadeNet *net;                                                 /* Connection to the peer */
+    ArcadeSnapshotRing history;                                     /* States before recent frames */
+    ArcadeStepFunc step;                                            /* One-frame step function */
+    void *state;                                                    /* Live game state */
+    int local_player;                                               /* This machine's player number */
+    int input_delay;                                                /* Local input delay (frames) */
+    int frame;                                                      /* Next frame to simulate */
+    int local_frame;                                                /* Newest local input frame */
+    int remote_frame;                                               /* Newest confirmed peer input frame */
+    int remote_ack;                                                 /* Newest local frame the peer confirmed */
+    uint8_t inputs[ARCADE_ROLLBACK_PLAYERS][ARCADE_ROLLBACK_HISTORY]; /* Input history per player */
+    uint32_t peer_ping;                                             /* Peer timestamp to echo */
+    float rtt_ms;                                                   /* Smoothed round-trip time (ms) */
+    int last_rollback;                                              /* Frames resimulated last update */
+    int stalls;                                                     /* Updates spent waiting for the peer */
+} ArcadeRollback;
+
+/*
+ * ArcadeJobFunc: One item of work run by an ArcadeWorkerPool.
+ * Parameters:
+ * - context: Pointer passed to arcade_pool_run.
+ * - index: Item number, from 0 to count - 1.
+ * - worker: Number of the thread running the item (0 = the calling thread),
+ *   for per-thread scratch memory or counters.
+ */
+typedef void (*ArcadeJobFunc)(void *context, int index, int worker);
+
+/*
+ * ArcadeWorkerPool: Fixed set of threads that run batches of independent items.
+ * Used to step many game simulations (matches, environments) in parallel.
+ * Fields:
+ * - thread_count: Threads working on each batch, including the calling thread.
+ * - internal: Platform threads and synchronization (owned by the pool).
+ * Example:
+ *   ArcadeWorkerPool pool;
+ *   arcade_pool_init(&pool, 0);                       // One thread per CPU
+ *   arcade_pool_run(&pool, match_count, step_match, matches);
+ *   arcade_pool_free(&pool);
+ * Notes:
+ * - Threads sleep between batches and are created only once, by arcade_pool_init.
+ */
+typedef struct
+{
+    int thread_count; /* Threads per batch, caller included */
+    void *internal;   /* Platform-specific pool state */
+} ArcadeWorkerPool;
+
+/* Observation formats for ArcadeEnv */
+enum
+{
+    ARCADE_OBS_STATE = 0, /* float[state_dims]: compact game-state vector */
+    ARCADE_OBS_GRAY = 1,  /* uint8_t[height][width]: grayscale frame */
+    ARCADE_OBS_RGB = 2    /* uint8_t[height][width][3]: color frame */
+};
+
+/*
+ * ArcadeEnvDef: Describes a game as an environment for training agents.
+ * A game provides one of these (usually as a static const) on top of its
+ * flat, deterministic simulation struct.
+ * Fields:
+ * - name: Short name, e.g. "asteroids".
+ * - state_size: Size of the game-state struct (bytes).
+ * - world_width, world_height: Size of the game's screen in pixels.
+ * - bg_color: Screen background color.
+ * - action_count: Number of discrete actions (0 to action_count - 1).
+ * - state_dims: Floats written by observe.
+ * - max_sprites: Most sprites draw ever emits.
+ * - reset: Builds the start of an episode from a seed.
+ * - step: Applies an action for one frame; returns the reward and sets
+ *   *done when the episode has ended.
+ * - observe: Writes the compact state vector (values roughly in -1..1).
+ * - draw: Lists the sprites to show; returns how many were written.
+ * Notes:
+ * - All callbacks must be thread-safe across different states (no globals,
+ *   rand() or clocks), so vectorized environments can step in parallel.
+ */
+typedef struct
+{
+    const char *name;                                   /* Environment name */
+    size_t state_size;                                  /* Bytes of game state */
+    int world_width, world_height;                      /* Game screen size (pixels) */
+    uint32_t bg_color;                                  /* Screen background */
+    int action_count;                                   /* Discrete actions */
+    int state_dims;                                     /* Floats in a state observation */
+    int max_sprites;                                    /* Sprite list capacity needed by draw */
+    void (*reset)(void *state, uint32_t seed);          /* Start an episode */
+    float (*step)(void *state, int action, int *done);  /* One frame; returns reward */
+    void (*observe)(const void *state, float *out);     /* Compact state vector */
+    int (*draw)(const void *state, ArcadeAnySprite *sprites, int *types); /* Sprites to render */
+} ArcadeEnvDef;
+
+/*
+ * ArcadeEnv: One running environment (gym-style reset/step).
+ * Fields:
+ * - def: The game's definition.
+ * - state: The game state (owned by the environment).
+ * - obs_type: ARCADE_OBS_STATE, ARCADE_OBS_GRAY or ARCADE_OBS_RGB.
+ * - obs_width, obs_height: Observation frame size (frame observations only).
+ * - frame: Scratch framebuffer the scene is rendered into at observation size.
+ * - sprites, types: Scratch sprite list filled by def->draw.
+ * - seed: Seed of the current episode.
+ * - steps: Steps taken in the current episode.
+ * - episode_reward: Reward collected in the current episode.
+ * Example:
+ *   ArcadeEnv env;
+ *   arcade_env_init(&env, &asteroids_env, ARCADE_OBS_GRAY, 84, 84);
+ *   uint8_t obs[84 * 84];
+ *   int done = 0;
+ *   arcade_env_reset(&env, 42, obs);
+ *   while (!done)
+ *       reward = arcade_env_step(&env, choose_action(obs), obs, &done);
+ *   arcade_env_free(&env);
+ * Notes:
+ * - Runs as fast as the CPU allows: no window, input, sleeps or clocks.
+ */
+typedef struct
+{
+    const ArcadeEnvDef *def;   /* Game definition */
+    void *state;               /* Game state */
+    int obs_type;              /* Observation format */
+    int obs_width, obs_height; /* Frame observation size */
+    ArcadeFramebuffer frame;   /* Scene rendered at observation size */
+    ArcadeAnySprite *sprites;  /* Scratch sprite list */
+    int *types;                /* Scratch sprite types */
+    uint32_t seed;             /* Current episode's seed */
+    int steps;                 /* Steps this episode */
+    float episode_reward;      /* Reward this episode */
+} ArcadeEnv;
+
+/*
+ * ArcadeVecEnv: A batch of environments stepped together on a worker pool.
+ * Fields:
+ * - envs: The environments.
+ * - count: Number of environments.
+ * - pool: Threads that step them.
+ * - actions, obs, rewards, dones: Buffers of the batch being stepped.
+ * Notes:
+ * - An environment whose episode ends is reset at once (with the next seed
+ *   of its stream) and the observation returned is the new episode's first.
+ */
+typedef struct
+{
+    ArcadeEnv *envs;          /* Environments */
+    int count;                /* Number of environments */
+    ArcadeWorkerPool pool;    /* Stepping threads */
+    const int *actions;       /* Batch being stepped */
+    unsigned char *obs;
+    float *rewards;
+    int *dones;
+} ArcadeVecEnv;
+
+/*
+ * ArcadeRng: A seedable random number stream (xoshiro128**).
+ * Each game, system or simulation owns its own stream instead of sharing the
+ * hidden global state of rand(), so runs can be replayed from a seed and
+ * streams can be used from different threads.
+ * Fields:
+ * - s: Generator state (never all zero once seeded).
+ * Example:
+ *   ArcadeRng rng;
+ *   arcade_rng_seed(&rng, 1234);
+ *   float x = arcade_rng_float_range(&rng, 15.0f, 385.0f);
+ * Notes:
+ * - Plain data (16 bytes): keep it inside a game-state struct and snapshots,
+ *   rewind and rollback restore the random sequence with everything else.
+ */
+typedef struct
+{
+    uint32_t s[4]; /* Generator state */
+} ArcadeRng;
+
+#define ARCADE_TIMER_BITS 6                          /* Slot index bits per wheel level */
+#define ARCADE_TIMER_SLOTS (1 << ARCADE_TIMER_BITS)  /* Slots per wheel level */
+#define ARCADE_TIMER_LEVELS 4                        /* Wheel levels (2^24 ticks before timers wrap around) */
+#define ARCADE_TIMER_MAX ((1 << 20) - 1)             /* Largest timer capacity of one wheel */
+
+/* Handle of a started timer; 0 is never a valid handle */
+typedef uint32_t ArcadeTimerId;
+
+/*
+ * ArcadeTimerFunc: Receives an expired timer from arcade_timers_advance.
+ * Parameters:
+ * - context: Pointer passed to arcade_timers_advance.
+ * - event, param: Values the timer was started with.
+ */
+typedef void (*ArcadeTimerFunc)(void *context, int event, int param);
+
+/*
+ * ArcadeTimer: One timer slot of an ArcadeTimerWheel (internal; the caller
+ * only provides the array).
+ */
+typedef struct
+{
+    uint64_t expires;       /* Tick the timer fires on */
+    uint32_t period;        /* Ticks between repeats, 0 = one-shot */
+    int32_t next, prev;     /* Links in a wheel slot or the free list */
+    int32_t queue_next;     /* Links in the poll queue */
+    int32_t queue_prev;
+    int32_t list;           /* Wheel slot, or a free/firing/fired marker */
+    uint16_t generation;    /* Bumped on reuse so stale handles fail */
+    uint16_t queued;        /* Expiries waiting for arcade_timers_poll */
+    int event, param;       /* Values delivered on expiry */
+} ArcadeTimer;
+
+/*
+ * ArcadeTimerWheel: Hierarchical timing wheel (4 levels of 64 slots).
+ * Timers are scheduled in ticks of any unit the caller chooses (frames,
+ * milliseconds of real or game time) and are started, cancelled and
+ * delivered in O(1), so tens of thousands can run at once.
+ * Fields:
+ * - now: Current tick (set by arcade_timers_advance).
+ * - storage: Byte offset from the wheel to its ArcadeTimer array.
+ * - capacity: Timers the array holds.
+ * - active: Timers waiting in the wheel.
+ * - free_head: First unused timer.
+ * - queue_head, queue_tail: Expired timers waiting for arcade_timers_poll.
+ * - heads: First timer of every wheel slot, plus the list being delivered.
+ * Example:
+ *   typedef struct {
+ *       ArcadeTimerWheel timers;
+ *       ArcadeTimer timer_storage[16];
+ *   } GameData;
+ *   arcade_timers_init(&game.timers, game.timer_storage, 16, 0);
+ *   arcade_timer_start(&game.timers, 120, 120, EVENT_SPAWN, 0); // Every 2 s at 60 FPS
+ * Notes:
+ * - Holds no pointers: with its ArcadeTimer array in the same struct (as
+ *   above), a game state containing the wheel can be copied with memcpy for
+ *   snapshots, rewind and restart.
+ */
+typedef struct
+{
+    uint64_t now;          /* Current tick */
+    ptrdiff_t storage;     /* Offset of the ArcadeTimer array from the wheel */
+    int capacity;          /* Timers in the array */
+    int active;            /* Timers waiting in the wheel */
+    int32_t free_head;     /* First unused timer */
+    int32_t queue_head;    /* Oldest expiry waiting to be polled */
+    int32_t queue_tail;    /* Newest expiry waiting to be polled */
+    int32_t heads[ARCADE_TIMER_LEVELS * ARCADE_TIMER_SLOTS + 1]; /* Slot lists + delivery list */
+} ArcadeTimerWheel;
+
+#define ARCADE_SIMD_ALIGN 64 /* Alignment of pixel buffers (a cache line, the widest vector) */
+
+/*
+ * ArcadeAllocator: Where the library gets its memory (see arcade_set_allocator).
+ * Fields:
+ * - alloc: Returns size bytes aligned to align (a power of two, 16 or more),
+ *   or NULL if there is no memory.
+ * - free: Releases a block alloc returned (never called with NULL).
+ * - user: Passed to both (the pool, heap or arena they work on).
+ * Example:
+ *   static void *pool_alloc(void *user, size_t size, size_t align) { return my_pool_get(user, size, align); }
+ *   static void pool_free(void *user, void *block) { my_pool_put(user, block); }
+ *   ArcadeAllocator allocator = {pool_alloc, pool_free, &my_pool};
+ *   arcade_set_allocator(&allocator);
+ * Notes:
+ * - Every block remembers the allocator that made it and is freed there, so
+ *   the allocator can be changed at any time.
+ */
+typedef struct
+{
+    void *(*alloc)(void *user, size_t size, size_t align); /* Returns an aligned block or NULL */
+    void (*free)(void *user, void *block);                 /* Releases a block from alloc */
+    void *user;                                            /* Passed to alloc and free */
+} ArcadeAllocator;
+
+/*
+ * ArcadeArena: Bump allocator whose memory is all released at once.
+ * Allocating is a pointer increment; nothing is freed individually.
+ * Fields:
+ * - base, size: Main block and its size in bytes.
+ * - used: Bytes of base handed out.
+ * - spills: Extra blocks taken when base was full (newest first).
+ * - spilled: Bytes in spills since the arena last grew.
+ * - parent: Allocator the blocks come from (the current one at init).
+ * Example:
+ *   ArcadeArena level;
+ *   arcade_arena_init(&level, 4 << 20);
+ *   void *tiles = arcade_arena_alloc(&level, tile_bytes, 0);
+ *   arcade_arena_free(&level); // Everything at once
+ * Notes:
+ * - When an allocation does not fit, it gets a block of its own, and base
+ *   grows by that much the next time the arena is emptied. An arena used
+ *   the same way every frame stops allocating after the first frames.
+ * - Not thread-safe: one arena per thread (see arcade_frame_arena).
+ */
+typedef struct
+{
+    unsigned char *base;    /* Main block */
+    size_t size;            /* Bytes in base */
+    size_t used;            /* Bytes of base handed out */
+    void *spills;           /* Overflow blocks, newest first */
+    size_t spilled;         /* Overflow bytes since base last grew */
+    ArcadeAllocator parent; /* Source of base and spills */
+} ArcadeArena;
+
+/*
+ * ArcadeArenaMark: A point in an arena's allocations to go back to
+ * (arcade_arena_mark / arcade_arena_release).
+ */
+typedef struct
+{
+    size_t used;  /* ArcadeArena.used at the mark */
+    void *spills; /* ArcadeArena.spills at the mark */
+} ArcadeArenaMark;
+
+/*
+ * ArcadeGame: A game split into entry points, so one program can run it on
+ * its own (arcade_run_game) or host it next to other games in one window.
+ * - name: Window title (e.g., "ARCADE: Asteroids").
+ * - width, height: Window size the game is laid out for (pixels).
+ * - bg_color: Background color (0xRRGGBB).
+ * - init: Loads assets and builds the start state once the window exists;
+ *   returns 0 on success. May be NULL.
+ * - update: Runs one frame (input, simulation, drawing) after arcade_update;
+ *   returns 1 to keep playing, 0 to leave the game.
+ * - shutdown: Frees what init allocated. May be NULL.
+ * Example:
+ *   static const ArcadeGame pong = {"Pong", 800, 600, 0x000000, pong_init, pong_update, pong_shutdown};
+ *   int main(void) { return arcade_run_game(&pong); }
+ * Notes:
+ * - A hosted game can be entered again after shutdown, so init must reset
+ *   everything update reads.
+ */
+typedef struct
+{
+    const char *name;       /* Window title */
+    int width, height;      /* Window size (pixels) */
+    uint32_t bg_color;      /* Background color (0xRRGGBB) */
+    int (*init)(void);      /* Load and reset; 0 = ready */
+    int (*update)(void);    /* One frame; 0 = leave the game */
+    void (*shutdown)(void); /* Free what init loaded */
+} ArcadeGame;
+
+/* =========================================================================
+ * Core Functions
+ * ========================================================================= */
+
+/*
+ * arcade_init: Initializes the arcade environment, creating a window.
+ * Sets up the rendering context, input handling, and pixel buffer.
+ * Parameters:
+ * - window_width: Width of the window (pixels, e.g., 800).
+ * - window_height: Height of the window (pixels, e.g., 600).
+ * - window_title: Title of the window (e.g., "My Game").
+ * - bg_color: Background color (0xRRGGBB, e.g., 0x000000 for black).
+ * Returns:
+ * - 0 on success.
+ * - Non-zero on failure (e.g., window creation failed).
+ * Example:
+ *   if (arcade_init(800, 600, "My Game", 0x000000)) {
+ *       fprintf(stderr, "Initialization failed\n");
+ *       return 1;
+ *   }
+ * Notes:
+ * - Call once at program start.
+ * - Check return value for error handling.
+ * - Window is non-resizable and centered on the screen.
+ */
+int arcade_init(int window_width, int window_height, const char *window_title, uint32_t bg_color);
+
+/*
+ * arcade_resize: Gives the open window a new size, title and background color.
+ * Parameters:
+ * - window_width, window_height: New size (pixels).
+ * - window_title: New title.
+ * - bg_color: New background color (0xRRGGBB); the pixel buffer is cleared
+ *   to it.
+ * Returns:
+ * - 0 on success.
+ * - Non-zero if the new pixel buffer cannot be allocated (the window keeps
+ *   its old size).
+ * Example:
+ *   arcade_resize(400, 800, "ARCADE: Asteroids", 0x000000); // Switch games
+ * Notes:
+ * - Keeps the display connection, backend, font and uploaded images, so
+ *   switching games costs one buffer allocation instead of a new window.
+ * - Pointers from an earlier arcade_screen are no longer valid.
+ */
+int arcade_resize(int window_width, int window_height, const char *window_title, uint32_t bg_color);
+
+/*
+ * arcade_set_backend: Chooses how arcade_init sets up rendering.
+ * Parameters:
+ * - backend: ARCADE_BACKEND_SOFTWARE or ARCADE_BACKEND_XRENDER.
+ * Returns: None.
+ * Example:
+ *   arcade_set_backend(ARCADE_BACKEND_XRENDER);
+ *   arcade_init(800, 600, "My Game", 0x000000);
+ *   printf("XRender: %s\n", arcade_backend() == ARCADE_BACKEND_XRENDER ? "yes" : "no");
+ * Notes:
+ * - Call before arcade_init. If the backend is not built in (ARCADE_XRENDER)
+ *   or the X server lacks the extension, arcade_init falls back to software.
+ * - With XRender, arcade_render_scene (and so arcade_render_group) uploads
+ *   each image once, keyed by its pixel pointer, and then only sends draw
+ *   requests: a few dozen bytes per sprite instead of the whole frame. Pixels
+ *   changed after their first draw are not seen.
+ * - arcade_screen and arcade_present keep working as before (the frame is
+ *   drawn on the CPU and sent whole).
+ * - XRender output can differ from software rendering by a rounding step in
+ *   translucent colors, tints and fades.
+ */
+void arcade_set_backend(int backend);
+
+/*
+ * arcade_backend: Returns the rendering backend in use.
+ * Parameters: None.
+ * Returns: ARCADE_BACKEND_SOFTWARE or ARCADE_BACKEND_XRENDER.
+ * Example:
+ *   if (arcade_backend() == ARCADE_BACKEND_SOFTWARE) printf("CPU rendering\n");
+ * Notes:
+ * - Software until arcade_init has set up another backend.
+ */
+int arcade_backend(void);
+
+/*
+ * arcade_set_vsync: Chooses whether frames are shown in step with the display.
+ * Parameters:
+ * - enable: 1 = show each frame at a vertical blank (default), 0 = as soon
+ *   as it is sent.
+ * Returns: None.
+ * Example:
+ *   arcade_set_vsync(0); // Lowest latency, may tear
+ *   arcade_init(800, 600, "My Game", 0x000000);
+ * Notes:
+ * - Call before arcade_init. Only the XCB backend (ARCADE_XCB) can sync: it
+ *   shows frames with PresentPixmap when the X server has the Present
+ *   extension (real or Xvfb's fake vblank), so they never tear.
+ * - While syncing, arcade_delta_time measures between the times frames
+ *   reached the screen, and arcade_present waits for a free buffer if the
+ *   game sends frames faster than the display shows them.
+ */
+void arcade_set_vsync(int enable);
+
+/*
+ * arcade_vsync: Returns whether frames are being shown at vertical blanks.
+ * Parameters: None.
+ * Returns: 1 if frames go through the Present extension, 0 otherwise.
+ * Example:
+ *   if (!arcade_vsync()) arcade_sleep(16);
+ * Notes:
+ * - Decided by the first arcade_present (it checks for the extension).
+ */
+int arcade_vsync(void);
+
+/*
+ * arcade_present_time: Returns when the last frame reached the screen.
+ * Parameters: None.
+ * Returns: The vblank time of the most recently completed frame, on the same
+ *   clock as arcade_time (seconds), or 0 if not known.
+ * Example:
+ *   double shown = arcade_present_time();
+ *   if (shown > 0) printf("frame on screen %.1f ms ago\n", (arcade_time() - shown) * 1000.0);
+ * Notes:
+ * - Only known while arcade_vsync is 1; updated by arcade_update as the
+ *   server reports completed frames.
+ */
+double arcade_present_time(void);
+
+/*
+ * arcade_set_pixel_format: Chooses the pixel format frames are shown in.
+ * Parameters:
+ * - format: ARCADE_FORMAT_AUTO (default), ARCADE_FORMAT_XRGB8888 or
+ *   ARCADE_FORMAT_RGB565.
+ * Returns: None.
+ * Example:
+ *   arcade_set_pixel_format(ARCADE_FORMAT_RGB565); // Half the bytes per upload
+ *   arcade_init(800, 600, "My Game", 0x000000);
+ * Notes:
+ * - Call before arcade_init. Linux only: the window is created with a
+ *   TrueColor visual of that depth when the screen has one, otherwise the
+ *   default visual is used.
+ * - At RGB565, arcade_render_scene (software backend) draws straight into
+ *   the window's 16-bit frame: colors are filled and blended at 16 bits,
+ *   and images are copied from RGB565 versions made when they load. Tinted
+ *   and faded sprites are drawn at 32 bits a row at a time. About 5x faster
+ *   than drawing at 32 bits and converting (800x600, 170 sprites, x86).
+ * - Sprites, arcade_screen and arcade_present still work in 0xRRGGBB: a
+ *   frame drawn into arcade_screen is converted with arcade_convert_rgb565
+ *   as arcade_present sends it. The scene itself is not in arcade_screen's
+ *   pixels.
+ * - The dither follows each image, so a sprite's pixels match a converted
+ *   32-bit frame exactly only at positions that are multiples of 4.
+ */
+void arcade_set_pixel_format(int format);
+
+/*
+ * arcade_pixel_format: Returns the pixel format frames are shown in.
+ * Parameters: None.
+ * Returns: ARCADE_FORMAT_XRGB8888 or ARCADE_FORMAT_RGB565 (always
+ *   ARCADE_FORMAT_XRGB8888 on Windows and in headless builds).
+ * Example:
+ *   if (arcade_pixel_format() == ARCADE_FORMAT_RGB565) printf("16-bit display\n");
+ * Notes:
+ * - Known after arcade_init.
+ */
+int arcade_pixel_format(void);
+
+/*
+ * arcade_convert_rgb565: Converts a row of pixels to RGB565.
+ * Parameters:
+ * - dst: count 16-bit output pixels.
+ * - src: count 0xRRGGBB input pixels (the top byte is ignored).
+ * - count: Number of pixels.
+ * - x, y: Position of the first pixel in the image, which picks the
+ *   dither pattern so rows converted separately line up.
+ * Returns: None.
+ * Example:
+ *   for (int y = 0; y < height; y++)
+ *       arcade_convert_rgb565(out + y * width, pixels + y * width, width, 0, y);
+ * Notes:
+ * - Uses a 4x4 ordered (Bayer) dither, so gradients band less than with
+ *   plain truncation and the result is the same from frame to frame.
+ * - Vectorized with SSE2 where available.
+ */
+void arcade_convert_rgb565(uint16_t *dst, const uint32_t *src, int count, int x, int y);
+
+/*
+ * arcade_quit: Cleans up the arcade environment, freeing resources.
+ * Closes the window, releases fonts, and frees pixel buffers.
+ * Parameters: None.
+ * Returns: None.
+ * Example:
+ *   arcade_quit();
+ * Notes:
+ * - Call before program exit to ensure proper cleanup.
+ * - Free all sprites and groups before calling to avoid memory leaks.
+ */
+void arcade_quit(void);
+
+/*
+ * arcade_update: Processes events (e.g., key presses, window close).
+ * Updates input states and checks for window closure.
+ * Parameters: None.
+ * Returns:
+ * - 1 if the game should continue running.
+ * - 0 if the game should stop (e.g., window closed).
+ * Example:
+ *   while (arcade_running() && arcade_update()) {
+ *       // Update game state
+ *   }
+ * Notes:
+ * - Call once per frame in the game loop.
+ * - Handles platform-specific events (Win32 messages, X11 events).
+ */
+int arcade_update(void);
+
+/*
+ * arcade_running: Checks if the game is running.
+ * Reflects whether the window is open and the game loop should continue.
+ * Parameters: None.
+ * Returns:
+ * - 1 if the game is running.
+ * - 0 if the game should stop (e.g., window closed or arcade_set_running(0)).
+ * Example:
+ *   while (arcade_running()) {
+ *       arcade_update();
+ *   }
+ * Notes:
+ * - Use in conjunction with arcade_update for the game loop.
+ * - Modified by arcade_set_running or window close events.
+ */
+int arcade_running(void);
+
+/*
+ * arcade_set_running: Sets the running state of the game.
+ * Allows manual control over the game loop (e.g., to exit programmatically).
+ * Parameters:
+ * - value: New running state (1 = running, 0 = stopped).
+ * Returns: None.
+ * Example:
+ *   if (arcade_key_pressed_once(a_esc)) {
+ *       arcade_set_running(0); // Exit on ESC
+ *   }
+ * Notes:
+ * - Typically used for user-initiated exit (e.g., pressing ESC).
+ * - Does not close the window; call arcade_quit for cleanup.
+ */
+void arcade_set_running(int value);
+
+/*
+ * arcade_sleep: Pauses execution for a specified number of milliseconds.
+ * Used to control frame rate by limiting how often the game loop runs.
+ * Parameters:
+ * - milliseconds: Duration to sleep (e.g., 16 for ~60 FPS).
+ * Returns: None.
+ * Example:
+ *   while (arcade_running() && arcade_update()) {
+ *       arcade_render_group(&group);
+ *       arcade_sleep(16); // ~60 FPS
+ *   }
+ * Notes:
+ * - Uses Sleep (Windows) or usleep (Linux).
+ * - Approximate; actual frame rate depends on system scheduling.
+ * - Common values: 16ms (~60 FPS), 33ms (~30 FPS).
+ * - For a game loop, arcade_wait_frame keeps a steadier frame rate.
+ */
+void arcade_sleep(unsigned int milliseconds);
+
+/*
+ * arcade_delta_time: Calculates the time elapsed since the last frame in seconds.
+ * Used to scale movement and updates for frame-rate-independent gameplay.
+ * Parameters: None.
+ * Returns: Time difference in seconds (float) since the last call.
+ * Example:
+ *   while (arcade_running() && arcade_update()) {
+ *       float dt = arcade_delta_time();
+ *       player.x += player.vx * dt * 60.0f; // Normalize to 60 FPS
+ *       arcade_render_group(&group);
+ *   }
+ * Notes:
+ * - Uses QueryPerformanceCounter (Windows) or clock_gettime (Linux).
+ * - Clamps delta time to 0.1s max to prevent large jumps during lag.
+ * - First call returns 0.0f to avoid initial movement spikes.
+ * - Typical values: ~0.0167s (60 FPS), ~0.0333s (30 FPS).
+ */
+float arcade_delta_time(void);
+
+/*
+ * arcade_time: Returns a monotonic clock reading in seconds.
+ * Used for measuring intervals such as network round trips.
+ * Parameters: None.
+ * Returns: Seconds since an arbitrary fixed point (double).
+ * Example:
+ *   double start = arcade_time();
+ *   simulate();
+ *   printf("took %.2f ms\n", (arcade_time() - start) * 1000.0);
+ * Notes:
+ * - Only differences between two readings are meaningful.
+ */
+double arcade_time(void);
+
+/*
+ * arcade_run_game: Runs a game on its own, from window to exit.
+ * Opens the window, calls init, then update once per frame (paced by
+ * arcade_wait_frame) until the window closes or update returns 0, and
+ * finally shutdown and arcade_quit.
+ * Parameters:
+ * - game: Game to run.
+ * Returns:
+ * - 0 on a normal exit.
+ * - 1 if the window cannot be opened or init fails.
+ * Example:
+ *   int main(void) { return arcade_run_game(&asteroids_game); }
+ * Notes:
+ * - Settings made before the call (arcade_set_backend, ...) apply as usual.
+ */
+int arcade_run_game(const ArcadeGame *game);
+
+/* =========================================================================
+ * Input Handling
+ * ========================================================================= */
+
+/*
+ * arcade_key_pressed: Checks if a specific key is currently pressed.
+ * Detects continuous key presses (e.g., holding a key for movement).
+ * Parameters:
+ * - key_val: Key code (e.g., a_space, a_w, defined above).
+ * Returns:
+ * - 2 if the key is pressed.
+ * - 0 if the key is not pressed.
+ * Example:
+ *   if (arcade_key_pressed(a_right)) {
+ *       player.vx = 5.0f; // Move right
+ *   } else {
+ *       player.vx = 0.0f;
+ *   }
+ * Notes:
+ * - Suitable for actions requiring sustained input (e.g., movement).
+ * - Uses platform-specific key mappings (Win32 virtual keys, X11 keycodes).
+ */
+int arcade_key_pressed(unsigned int key_val);
+
+/*
+ * arcade_key_pressed_once: Checks if a key was pressed in the current frame.
+ * Detects single-press events (e.g., for triggering actions like jumping).
+ * Parameters:
+ * - key_val: Key code (e.g., a_space, a_p).
+ * Returns:
+ * - 2 if the key was pressed this frame (and not last frame).
+ * - 0 otherwise.
+ * Example:
+ *   if (arcade_key_pressed_once(a_space)) {
+ *       player.vy = -10.0f; // Jump
+ *   }
+ * Notes:
+ * - Ideal for one-time actions (e.g., jump, pause, restart).
+ * - Tracks key state changes to ensure single detection per press.
+ */
+int arcade_key_pressed_once(unsigned int key_val);
+
+/*
+ * arcade_clear_keys: Resets all key states to unpressed.
+ * Clears the input state, useful for state transitions (e.g., pausing).
+ * Parameters: None.
+ * Returns: None.
+ * Example:
+ *   if (arcade_key_pressed_once(a_p)) {
+ *       game_paused = !game_paused;
+ *       arcade_clear_keys(); // Reset inputs on pause
+ *   }
+ * Notes:
+ * - Affects all keys tracked by arcade_key_pressed and arcade_key_pressed_once.
+ * - Call sparingly to avoid missing input events.
+ */
+void arcade_clear_keys(void);
+
+/* =========================================================================
+ * Sprite Management
+ * ========================================================================= */
+
+/*
+ * arcade_move_sprite: Updates the position of a color-based sprite.
+ * Applies gravity and velocity, with boundary checks to keep the sprite in the window.
+ * Parameters:
+ * - sprite: Pointer to ArcadeSprite to update.
+ * - gravity: Gravity acceleration (pixels per frame^2, e.g., 0.1f).
+ * - window_height: Height of the window (for boundary checks).
+ * Returns: None.
+ * Example:
+ *   ArcadeSprite player = {100.0f, 100.0f, 50.0f, 50.0f, 0.0f, 0.0f, 0xFF0000, 1};
+ *   arcade_move_sprite(&player, 0.1f, 600);
+ * Notes:
+ * - Updates sprite->x, sprite->y, sprite->vy based on sprite->vx, gravity.
+ * - Clamps y-position to [0, window_height - sprite->height].
+ * - Ignores inactive sprites (sprite->active == 0).
+ */
+void arcade_move_sprite(ArcadeSprite *sprite, float gravity, int window_height);
+
+/*
+ * arcade_move_image_sprite: Updates the position of an image-based sprite.
+ * Similar to arcade_move_sprite but for ArcadeImageSprite.
+ * Parameters:
+ * - sprite: Pointer to ArcadeImageSprite to update.
+ * - gravity: Gravity acceleration (pixels per frame^2).
+ * - window_height: Height of the window.
+ * Returns: None.
+ * Example:
+ *   ArcadeImageSprite player = arcade_create_image_sprite(100.0f, 100.0f, 50.0f, 50.0f, "player.png");
+ *   arcade_move_image_sprite(&player, 0.1f, 600);
+ * Notes:
+ * - Same movement logic as arcade_move_sprite.
+ * - Ignores inactive sprites or null pointers.
+ */
+void arcade_move_image_sprite(ArcadeImageSprite *sprite, float gravity, int window_height);
+
+/*
+ * arcade_check_collision: Checks for collision between two color-based sprites.
+ * Uses axis-aligned bounding box (AABB) collision detection.
+ * Parameters:
+ * - a: Pointer to first ArcadeSprite.
+ * - b: Pointer to second ArcadeSprite.
+ * Returns:
+ * - 1 if the sprites collide.
+ * - 0 if no collision, or if either sprite is null or inactive.
+ * Example:
+ *   if (arcade_check_collision(&player, &platform)) {
+ *       player.vy = 0.0f; // Stop falling
+ *   }
+ * Notes:
+ * - Checks if rectangles overlap based on x, y, width, height.
+ * - Only active sprites (active == 1) are considered.
+ */
+int arcade_check_collision(ArcadeSprite *a, ArcadeSprite *b);
+
+/*
+ * arcade_check_image_collision: Checks for collision between two image-based sprites.
+ * Uses AABB collision detection.
+ * Parameters:
+ * - a: Pointer to first ArcadeImageSprite.
+ * - b: Pointer to second ArcadeImageSprite.
+ * Returns:
+ * - 1 if the sprites collide.
+ * - 0 if no collision, or if either sprite is null or inactive.
+ * Example:
+ *   ArcadeImageSprite player = arcade_create_image_sprite(100.0f, 100.0f, 50.0f, 50.0f, "player.png");
+ *   ArcadeImageSprite enemy = arcade_create_image_sprite(150.0f, 100.0f, 50.0f, 50.0f, "enemy.png");
+ *   if (arcade_check_image_collision(&player, &enemy)) {
+ *       // Handle collision
+ *   }
+ * Notes:
+ * - Same logic as arcade_check_collision but for image sprites.
+ * - Does not check pixel-level collision (only bounding boxes).
+ */
+int arcade_check_image_collision(ArcadeImageSprite *a, ArcadeImageSprite *b);
+
+/*
+ * arcade_create_image_sprite: Creates an image-based sprite from a file.
+ * Loads and resizes an image (QOI, PNG, ...) to the specified dimensions.
+ * Parameters:
+ * - x, y: Initial position (pixels, float).
+ * - w, h: Desired width and height (pixels, float).
+ * - filename: Path to the image file (e.g., "sprites/player.png").
+ * Returns:
+ * - ArcadeImageSprite with loaded pixel data, or an empty sprite if loading fails.
+ * Example:
+ *   ArcadeImageSprite player = arcade_create_image_sprite(100.0f, 100.0f, 50.0f, 50.0f, "player.png");
+ *   if (!player.pixels) {
+ *       fprintf(stderr, "Failed to load player sprite\n");
+ *   }
+ * Notes:
+ * - QOI files are decoded by the library, other formats by stb_image; the
+ *   format is taken from the file's header, not its name. QOI loads several
+ *   times faster than PNG (make -C arcade qoi converts the games' sprites).
+ * - Pixel data is dynamically allocated; free with arcade_free_image_sprite.
+ * - Sets active = 1 on success, 0 on failure.
+ */
+ArcadeImageSprite arcade_create_image_sprite(float x, float y, float w, float h, const char *filename);
+
+/*
+ * arcade_free_image_sprite: Frees the pixel data of an image-based sprite.
+ * Releases memory allocated for the sprite’s pixels.
+ * Parameters:
+ * - sprite: Pointer to ArcadeImageSprite to free.
+ * Returns: None.
+ * Example:
+ *   ArcadeImageSprite player = arcade_create_image_sprite(100.0f, 100.0f, 50.0f, 50.0f, "player.png");
+ *   arcade_free_image_sprite(&player);
+ * Notes:
+ * - Safe to call on null or already-freed sprites.
+ * - Sets pixels = NULL, image_width = 0, image_height = 0, active = 0.
+ */
+void arcade_free_image_sprite(ArcadeImageSprite *sprite);
+
+/*
+ * arcade_create_animated_sprite: Creates an animated sprite with multiple frames.
+ * Loads a sequence of images for animation (e.g., walking cycle).
+ * Parameters:
+ * - x, y: Initial position (pixels, float).
+ * - w, h: Desired width and height for each frame (pixels, float).
+ * - filenames: Array of image file paths (e.g., {"frame1.png", "frame2.png"}).
+ * - frame_count: Number of frames.
+ * - frame_interval: Frames between animation updates (e.g., 5 for 12 FPS at 60 FPS).
+ * Returns:
+ * - ArcadeAnimatedSprite with loaded frames, or an empty sprite if loading fails.
+ * Example:
+ *   const char *frames[] = {"bird1.png", "bird2.png", "bird3.png"};
+ *   ArcadeAnimatedSprite bird = arcade_create_animated_sprite(100.0f, 100.0f, 50.0f, 50.0f, frames, 3, 5);
+ * Notes:
+ * - All frames are resized to w x h.
+ * - Free with arcade_free_animated_sprite to avoid memory leaks.
+ * - Sets first frame’s active = 1, others = 0.
+ */
+ArcadeAnimatedSprite arcade_create_animated_sprite(float x, float y, float w, float h, const char **filenames, int frame_count, int frame_interval);
+
+/*
+ * arcade_free_animated_sprite: Frees all frames of an animated sprite.
+ * Releases memory for all frame pixel data.
+ * Parameters:
+ * - anim: Pointer to ArcadeAnimatedSprite to free.
+ * Returns: None.
+ * Example:
+ *   ArcadeAnimatedSprite bird = arcade_create_animated_sprite(100.0f, 100.0f, 50.0f, 50.0f, frames, 3, 5);
+ *   arcade_free_animated_sprite(&bird);
+ * Notes:
+ * - Safe to call on null or already-freed sprites.
+ * - Sets frames = NULL, frame_count = 0.
+ */
+void arcade_free_animated_sprite(ArcadeAnimatedSprite *anim);
+
+/*
+ * arcade_move_animated_sprite: Updates the position and animation of an animated sprite.
+ * Applies gravity and velocity to the current frame and syncs other frames’ positions.
+ * Parameters:
+ * - anim: Pointer to ArcadeAnimatedSprite to update.
+ * - gravity: Gravity acceleration (pixels per frame^2).
+ * - window_height: Height of the window.
+ * Returns: None.
+ * Example:
+ *   arcade_move_animated_sprite(&bird, 0.1f, 600);
+ * Notes:
+ * - Updates current frame’s position and velocity, then copies to other frames.
+ * - Advances animation based on frame_interval.
+ * - Ignores inactive or null sprites.
+ */
+void arcade_move_animated_sprite(ArcadeAnimatedSprite *anim, float gravity, int window_height);
+
+/*
+ * arcade_check_animated_collision: Checks for collision between an animated sprite and an image-based sprite.
+ * Uses AABB collision detection on the current frame.
+ * Parameters:
+ * - anim: Pointer to ArcadeAnimatedSprite.
+ * - other: Pointer to ArcadeImageSprite.
+ * Returns:
+ * - 1 if the sprites collide.
+ * - 0 if no collision, or if either sprite is null or inactive.
+ * Example:
+ *   if (arcade_check_animated_collision(&bird, &pipe)) {
+ *       // Handle collision (e.g., game over)
+ *   }
+ * Notes:
+ * - Checks only the current frame’s bounding box.
+ * - Same logic as arcade_check_image_collision.
+ */
+int arcade_check_animated_collision(ArcadeAnimatedSprite *anim, ArcadeImageSprite *other);
+
+/*
+ * arcade_create_scroll_layer: Creates a scrolling layer from an image file.
+ * Parameters:
+ * - x, y: Screen position of the layer (pixels, float).
+ * - w, h: Screen area the layer covers (pixels, float).
+ * - filename: Path to the image file (e.g., "background.png").
+ * - image_width, image_height: Size the image is resized to once at load;
+ *   it repeats to fill w x h.
+ * - speed_x, speed_y: Parallax speeds (see ArcadeScrollLayer).
+ * Returns:
+ * - ArcadeScrollLayer with loaded pixel data, or pixels = NULL if loading fails.
+ * Example:
+ *   ArcadeScrollLayer ground = arcade_create_scroll_layer(0.0f, 544.0f, 800.0f, 56.0f, "base.png", 168, 56, 1.0f, 0.0f);
+ * Notes:
+ * - Pixel data is dynamically allocated; free with arcade_free_scroll_layer.
+ * - Sizing the image to the layer's aspect (rather than w x h) keeps the art
+ *   unstretched and stores fewer pixels.
+ */
+ArcadeScrollLayer arcade_create_scroll_layer(float x, float y, float w, float h, const char *filename, int image_width, int image_height, float speed_x, float speed_y);
+
+/*
+ * arcade_scroll_layer: Scrolls a layer to follow a camera.
+ * Sets scroll_x and scroll_y to the camera position times the layer's speeds,
+ * wrapped to the image size.
+ * Parameters:
+ * - layer: Pointer to ArcadeScrollLayer.
+ * - camera_x, camera_y: Distance the world has scrolled (pixels).
+ * Returns: None.
+ * Example:
+ *   arcade_scroll_layer(&ground, game.distance, 0.0f);
+ * Notes:
+ * - Depends only on the camera position, so layers follow rewinds and
+ *   restarts of the game state without keeping state of their own.
+ */
+void arcade_scroll_layer(ArcadeScrollLayer *layer, float camera_x, float camera_y);
+
+/*
+ * arcade_free_scroll_layer: Frees the pixel data of a scrolling layer.
+ * Parameters:
+ * - layer: Pointer to ArcadeScrollLayer to free.
+ * Returns: None.
+ * Example:
+ *   arcade_free_scroll_layer(&ground);
+ * Notes:
+ * - Safe to call on null or already-freed layers.
+ */
+void arcade_free_scroll_layer(ArcadeScrollLayer *layer);
+
+/*
+ * arcade_set_asset_cache: Turns sharing of loaded images on or off.
+ * Parameters:
+ * - enable: 1 = image sprites, animation frames and layers loaded from the
+ *   same file at the same size share one copy of the pixels, which stays
+ *   loaded after the last of them is freed; 0 = every load decodes its own
+ *   copy (default). Turning it off empties the cache.
+ * Returns: None.
+ * Example:
+ *   arcade_set_asset_cache(1);
+ *   ArcadeImageSprite a = arcade_create_image_sprite(0, 0, 40, 40, "coin.png");
+ *   ArcadeImageSprite b = arcade_create_image_sprite(50, 0, 40, 40, "coin.png"); // Same pixels, no decode
+ * Notes:
+ * - Files are told apart by their absolute path, so a program that changes
+ *   directory still finds them.
+ * - Cached pixels must not be written to; they may be drawn by other sprites.
+ * - Cached pixels come from the allocator current at the first load (see
+ *   arcade_set_allocator), so do not cache while loading into an arena.
+ * - Also set by "asset_cache" in the performance section of
+ *   arcade.config.json.
+ */
+void arcade_set_asset_cache(int enable);
+
+/*
+ * arcade_clear_asset_cache: Frees the cached images no sprite uses.
+ * Parameters: None.
+ * Returns: None.
+ * Example:
+ *   free_level_sprites();
+ *   arcade_clear_asset_cache(); // Next level has other art
+ * Notes:
+ * - Images still in use stay cached until the next clear after they are freed.
+ */
+void arcade_clear_asset_cache(void);
+
+/*
+ * arcade_set_image_filter: Chooses how images are resized when loaded.
+ * Parameters:
+ * - filter: ARCADE_FILTER_SMOOTH (default), ARCADE_FILTER_LINEAR or
+ *   ARCADE_FILTER_POINT.
+ * Returns: None.
+ * Example:
+ *   arcade_set_image_filter(ARCADE_FILTER_POINT); // Pixel art stays crisp
+ *   ArcadeImageSprite hero = arcade_create_image_sprite(0, 0, 64, 64, "hero-16x16.png");
+ * Notes:
+ * - Applies to sprites, animation frames and scroll layers loaded after it.
+ *   Images loaded at their own size are copied as they are, whatever the filter.
+ * - Also set by "image_filter" ("smooth", "linear" or "point") in the
+ *   performance section of arcade.config.json.
+ */
+void arcade_set_image_filter(int filter);
+
+/* =========================================================================
+ * Rendering
+ * ========================================================================= */
+
+/*
+ * arcade_render_scene: Renders a scene with multiple sprites.
+ * Draws all sprites to the pixel buffer and updates the window.
+ * Parameters:
+ * - sprites: Array of ArcadeAnySprite (color or image-based).
+ * - count: Number of sprites to render.
+ * - types: Array of sprite types (SPRITE_COLOR, SPRITE_IMAGE or SPRITE_LAYER).
+ * Returns: None.
+ * Example:
+ *   ArcadeAnySprite sprites[2] = {{.sprite = platform}, {.image_sprite = player}};
+ *   int types[2] = {SPRITE_COLOR, SPRITE_IMAGE};
+ *   arcade_render_scene(sprites, 2, types);
+ * Notes:
+ * - Clears the screen to the background color before rendering.
+ * - Uses double buffering (Windows: GDI bitmap, Linux: XImage, or a server
+ *   pixmap with ARCADE_BACKEND_XRENDER).
+ * - At ARCADE_FORMAT_RGB565 it draws into the 16-bit frame, not arcade_screen
+ *   (see arcade_set_pixel_format).
+ * - Ignores inactive or null sprites.
+ */
+void arcade_render_scene(ArcadeAnySprite *sprites, int count, int *types);
+
+/*
+ * arcade_render_scene_to: Renders sprites into an off-screen framebuffer.
+ * Parameters:
+ * - target: Framebuffer to clear and draw into.
+ * - sprites: Array of ArcadeAnySprite (color or image-based).
+ * - count: Number of sprites to render.
+ * - types: Array of sprite types (SPRITE_COLOR, SPRITE_IMAGE or SPRITE_LAYER).
+ * Returns: None.
+ * Example:
+ *   ArcadeFramebuffer frame = {pixels, 400, 800, 0x000000, 1.0f, 1.0f};
+ *   arcade_render_scene_to(&frame, group.sprites, group.count, group.types);
+ * Notes:
+ * - Does not need arcade_init and touches no global state, so several
+ *   threads may render into different framebuffers at once.
+ * - Opaque sprites (solid colors, images and layers with opaque set) are
+ *   drawn front-to-back against a coverage bitmask, so pixels hidden by
+ *   sprites in front are never written; see-through sprites are then drawn
+ *   back-to-front. The result is the same as drawing every sprite in order.
+ */
+void arcade_render_scene_to(ArcadeFramebuffer *target, const ArcadeAnySprite *sprites, int count, const int *types);
+
+/*
+ * arcade_fill_rect: Fills a rectangle of a framebuffer with a color.
+ * The path color sprites are drawn with: clipped once, then filled with
+ * wide vector stores, or blended source-over for translucent colors.
+ * Parameters:
+ * - target: Framebuffer to draw into (its scale is not applied).
+ * - x, y: Top-left corner in buffer pixels (may lie outside the buffer).
+ * - width, height: Size in pixels.
+ * - color: 0xRRGGBB (opaque), or 0xAARRGGBB with alpha 0x01-0xFE to blend.
+ * Returns: None.
+ * Example:
+ *   arcade_fill_rect(&frame, 0, 0, frame.width, frame.height, 0x80000000); // Dim by half
+ * Notes:
+ * - Large opaque fills (full-screen clears) use non-temporal stores so they
+ *   do not evict the sprites being drawn from the cache.
+ */
+void arcade_fill_rect(ArcadeFramebuffer *target, int x, int y, int width, int height, uint32_t color);
+
+/*
+ * arcade_screen: Returns a framebuffer for the window's pixel buffer.
+ * Lets a frame be built with arcade_render_scene_to and the vector drawing
+ * functions before arcade_present shows it.
+ * Parameters: None.
+ * Returns:
+ * - ArcadeFramebuffer at scale 1 with the window's size and background color.
+ * Example:
+ *   ArcadeFramebuffer screen = arcade_screen();
+ *   arcade_render_scene_to(&screen, group.sprites, group.count, group.types);
+ *   arcade_fill_circle(&screen, 200.0f, 300.0f, 10.0f, 0xFFFF00);
+ *   arcade_present();
+ * Notes:
+ * - Only valid between arcade_init and arcade_quit.
+ */
+ArcadeFramebuffer arcade_screen(void);
+
+/*
+ * arcade_present: Shows the window's pixel buffer.
+ * The last step of arcade_render_scene, for frames drawn through arcade_screen.
+ * Parameters: None.
+ * Returns: None.
+ * Example:
+ *   arcade_present();
+ *   arcade_render_text("Score: 10", 10.0f, 30.0f, 0xFFFFFF); // Text goes on top
+ * Notes:
+ * - Does nothing in headless builds.
+ * - With vsync (XCB and Present), text drawn afterwards goes into the same
+ *   frame, which is queued for the next vblank by arcade_wait_frame (or the
+ *   next arcade_update or arcade_present).
+ */
+void arcade_present(void);
+
+/*
+ * arcade_render_text: Renders text at a specified position.
+ * Draws text using a fixed font (Courier New on Windows, 9x15 on Linux).
+ * Parameters:
+ * - text: Null-terminated string to render.
+ * - x, y: Position of the text’s top-left corner (pixels, float).
+ * - color: Text color (0xRRGGBB, e.g., 0xFFFFFF for white).
+ * Returns: None.
+ * Example:
+ *   arcade_render_text("Score: 10", 10.0f, 10.0f, 0xFFFFFF);
+ * Notes:
+ * - Text is rendered with a transparent background.
+ * - Skips rendering if text is null or font is unavailable.
+ */
+void arcade_render_text(const char *text, float x, float y, unsigned int color);
+
+/*
+ * arcade_render_text_centered: Renders text centered horizontally.
+ * Calculates the x-position to center the text based on its width.
+ * Parameters:
+ * - text: Null-terminated string to render.
+ * - y: Vertical position of the text’s top edge (pixels, float).
+ * - color: Text color (0xRRGGBB).
+ * Returns: None.
+ * Example:
+ *   arcade_render_text_centered("Game Over", 300.0f, 0xFF0000);
+ * Notes:
+ * - Uses the same font as arcade_render_text.
+ * - Skips rendering if text is null or font is unavailable.
+ */
+void arcade_render_text_centered(const char *text, float y, unsigned int color);
+
+/*
+ * arcade_render_text_centered_blink: Renders centered text that blinks.
+ * Toggles visibility based on a frame interval.
+ * Parameters:
+ * - text: Null-terminated string to render.
+ * - y: Vertical position of the text’s top edge (pixels, float).
+ * - color: Text color (0xRRGGBB).
+ * - blink_interval: Frames for each on/off cycle (e.g., 30 for 1-second blink at 60 FPS).
+ * Returns: None.
+ * Example:
+ *   arcade_render_text_centered_blink("Press Space", 300.0f, 0xFFFFFF, 30);
+ * Notes:
+ * - Blinks by rendering only when frame_counter % (2 * blink_interval) < blink_interval.
+ * - Useful for start screens or alerts.
+ */
+void arcade_render_text_centered_blink(const char *text, float y, unsigned int color, int blink_interval);
+
+/* =========================================================================
+ * Vector Shapes
+ * ========================================================================= */
+
+/*
+ * arcade_draw_line: Draws a one-pixel line (Bresenham).
+ * Parameters:
+ * - target: Framebuffer to draw into (its scale is not applied).
+ * - x0, y0, x1, y1: End points in buffer pixels; both end pixels are drawn.
+ * - color: 0xRRGGBB (opaque), or 0xAARRGGBB with alpha 0x01-0xFE to blend.
+ * Returns: None.
+ * Example:
+ *   arcade_draw_line(&screen, 0.0f, 0.0f, 399.0f, 799.0f, 0xFFFFFF);
+ * Notes:
+ * - Clipped to the buffer first, so long lines off-screen cost nothing.
+ * - Pixels on the same row are written as one span.
+ */
+void arcade_draw_line(ArcadeFramebuffer *target, float x0, float y0, float x1, float y1, uint32_t color);
+
+/*
+ * arcade_draw_line_aa: Draws an antialiased line (Xiaolin Wu).
+ * Each step blends the two pixels straddling the line by how close they are.
+ * Parameters:
+ * - target: Framebuffer to draw into (its scale is not applied).
+ * - x0, y0, x1, y1: End points in buffer pixels (sub-pixel positions count).
+ * - color: Line color; alpha as for arcade_draw_line, scaled by coverage.
+ * Returns: None.
+ * Example:
+ *   arcade_draw_line_aa(&screen, 10.5f, 10.0f, 200.25f, 90.0f, 0xC0C0C0);
+ */
+void arcade_draw_line_aa(ArcadeFramebuffer *target, float x0, float y0, float x1, float y1, uint32_t color);
+
+/*
+ * arcade_fill_polygon: Fills a polygon (convex or concave) by scanlines.
+ * Parameters:
+ * - target: Framebuffer to draw into (its scale is not applied).
+ * - points: Vertices in order (the last connects back to the first).
+ * - count: Number of vertices (at least 3).
+ * - color: 0xRRGGBB (opaque), or 0xAARRGGBB with alpha 0x01-0xFE to blend.
+ * Returns: None.
+ * Example:
+ *   ArcadePoint rock[5] = {{100, 100}, {130, 95}, {140, 125}, {115, 115}, {95, 130}};
+ *   arcade_fill_polygon(&screen, rock, 5, 0x404040);
+ * Notes:
+ * - Draws the pixels whose centers are inside (even-odd rule), so polygons
+ *   sharing an edge never overlap or leave a gap.
+ * - Each row is written as spans with the same vector stores as
+ *   arcade_fill_rect.
+ */
+void arcade_fill_polygon(ArcadeFramebuffer *target, const ArcadePoint *points, int count, uint32_t color);
+
+/*
+ * arcade_draw_polygon: Draws the outline of a polygon with arcade_draw_line.
+ * Parameters:
+ * - target, points, count, color: As for arcade_fill_polygon.
+ * Returns: None.
+ * Example:
+ *   arcade_draw_polygon(&screen, rock, 5, 0xFFFFFF);
+ * Notes:
+ * - Translucent outlines blend twice where edges meet.
+ */
+void arcade_draw_polygon(ArcadeFramebuffer *target, const ArcadePoint *points, int count, uint32_t color);
+
+/*
+ * arcade_draw_polygon_aa: Draws the outline of a polygon with arcade_draw_line_aa.
+ * Parameters:
+ * - target, points, count, color: As for arcade_fill_polygon.
+ * Returns: None.
+ * Example:
+ *   arcade_fill_polygon(&screen, rock, 5, 0x404040);
+ *   arcade_draw_polygon_aa(&screen, rock, 5, 0xC0C0C0); // Smooth edge over the fill
+ */
+void arcade_draw_polygon_aa(ArcadeFramebuffer *target, const ArcadePoint *points, int count, uint32_t color);
+
+/*
+ * arcade_fill_circle: Fills a circle, one span per row.
+ * Parameters:
+ * - target: Framebuffer to draw into (its scale is not applied).
+ * - cx, cy: Center in buffer pixels.
+ * - radius: Radius in pixels.
+ * - color: 0xRRGGBB (opaque), or 0xAARRGGBB with alpha 0x01-0xFE to blend.
+ * Returns: None.
+ * Example:
+ *   arcade_fill_circle(&screen, 200.0f, 400.0f, 2.5f, 0xFFFF00);
+ * Notes:
+ * - Draws the pixels whose centers are inside, like arcade_fill_polygon.
+ */
+void arcade_fill_circle(ArcadeFramebuffer *target, float cx, float cy, float radius, uint32_t color);
+
+/* =========================================================================
+ * Pixel Passes
+ * ========================================================================= */
+
+/*
+ * arcade_pixel_pass: Runs an effect over the window's whole frame.
+ * Used for fades, flashes, scanline filters and color grading, between
+ * drawing a frame and arcade_present.
+ * Parameters:
+ * - kernel: Called once per row (x 0, count the width): one of the
+ *   arcade_effect_* functions, or the game's own.
+ * - user: Passed to kernel (the effect's settings).
+ * Returns:
+ * - 0 on success.
+ * - 1 if the frame is not in the window's pixels (arcade_render_scene
+ *   composited it on the X server with the XRender backend, or drew it
+ *   into the 16-bit frame at ARCADE_FORMAT_RGB565, this frame) or there is
+ *   no window.
+ * Example:
+ *   ArcadeFramebuffer screen = arcade_screen();
+ *   draw_game(&screen, &game);
+ *   arcade_pixel_pass(arcade_effect_mix, &(ArcadeMix){0xFF0000, flash});
+ *   arcade_present();
+ * Notes:
+ * - Same as arcade_pixel_pass_to(&screen, kernel, user).
+ */
+int arcade_pixel_pass(ArcadePixelKernel kernel, void *user);
+
+/*
+ * arcade_pixel_pass_to: Runs an effect over a framebuffer, in row bands
+ * on the library's worker pool.
+ * Parameters:
+ * - target: Framebuffer to change.
+ * - kernel, user: As for arcade_pixel_pass.
+ * Returns: None.
+ * Example:
+ *   arcade_pixel_pass_to(&thumbnail, arcade_effect_grade, &sepia);
+ * Notes:
+ * - Frames under 64K pixels run on the calling thread; larger ones are
+ *   split across the pool (arcade_set_worker_threads threads, started on
+ *   the first large pass and stopped by arcade_quit).
+ * - Call from one thread, and not from inside a worker pool job.
+ */
+void arcade_pixel_pass_to(ArcadeFramebuffer *target, ArcadePixelKernel kernel, void *user);
+
+/*
+ * arcade_effect_mix: Kernel mixing a color into every pixel (user: ArcadeMix).
+ * Fades to black, flashes to white or red, tints.
+ * Example:
+ *   arcade_pixel_pass(arcade_effect_mix, &(ArcadeMix){0x000000, fade});
+ * Notes:
+ * - Vectorized; alpha is kept.
+ */
+void arcade_effect_mix(uint32_t *pixels, int count, int x, int y, void *user);
+
+/*
+ * arcade_effect_scanlines: Kernel darkening every spacing-th row (user:
+ * ArcadeScanlines), for a CRT look.
+ * Example:
+ *   arcade_pixel_pass(arcade_effect_scanlines, &(ArcadeScanlines){2, 170});
+ * Notes:
+ * - Vectorized; the other rows are not touched.
+ */
+void arcade_effect_scanlines(uint32_t *pixels, int count, int x, int y, void *user);
+
+/*
+ * arcade_effect_grade: Kernel mapping each channel through a lookup table
+ * (user: ArcadeColorGrade), for brightness, contrast, gamma and tints.
+ * Example:
+ *   arcade_pixel_pass(arcade_effect_grade, &grade);
+ */
+void arcade_effect_grade(uint32_t *pixels, int count, int x, int y, void *user);
+
+/*
+ * arcade_color_grade_init: Fills a grade with one curve for all channels.
+ * Parameters:
+ * - grade: Pointer to ArcadeColorGrade.
+ * - brightness: Added to every value, from -1 to 1 (0 = unchanged).
+ * - contrast: Scale around mid gray (1 = unchanged).
+ * - gamma: Exponent applied first (1 = unchanged, < 1 brightens darks).
+ * Returns: None.
+ * Example:
+ *   arcade_color_grade_init(&grade, -0.1f, 1.3f, 1.0f); // Darker, punchier
+ */
+void arcade_color_grade_init(ArcadeColorGrade *grade, float brightness, float contrast, float gamma);
+
+/* =========================================================================
+ * Sprite Groups
+ * ========================================================================= */
+
+/*
+ * arcade_init_group: Initializes a sprite group with a specified capacity.
+ * Allocates memory for sprites and their types.
+ * Parameters:
+ * - group: Pointer to SpriteGroup to initialize.
+ * - capacity: Maximum number of sprites the group can hold.
+ * Returns: None.
+ * Example:
+ *   SpriteGroup group;
+ *   arcade_init_group(&group, 10);
+ * Notes:
+ * - Must be called before adding sprites.
+ * - Sets count = 0, capacity = specified value.
+ * - Free with arcade_free_group to avoid memory leaks.
+ */
+void arcade_init_group(SpriteGroup *group, int capacity);
+
+/*
+ * arcade_add_sprite_to_group: Adds a sprite to a sprite group.
+ * Stores the sprite and its type for batch rendering.
+ * Parameters:
+ * - group: Pointer to SpriteGroup.
+ * - sprite: ArcadeAnySprite to add (color or image-based).
+ * - type: Sprite type (SPRITE_COLOR, SPRITE_IMAGE or SPRITE_LAYER).
+ * Returns: None.
+ * Example:
+ *   arcade_add_sprite_to_group(&group, (ArcadeAnySprite){.image_sprite = player}, SPRITE_IMAGE);
+ * Notes:
+ * - Ignores if group is full (count >= capacity).
+ * - Sprite is copied, so updates to the original sprite are not reflected unless re-added.
+ */
+void arcade_add_sprite_to_group(SpriteGroup *group, ArcadeAnySprite sprite, int type);
+
+/*
+ * arcade_add_animated_to_group: Adds an animated sprite’s current frame to a group.
+ * Adds the current frame of an ArcadeAnimatedSprite as an image-based sprite.
+ * Parameters:
+ * - group: Pointer to SpriteGroup.
+ * - anim: Pointer to ArcadeAnimatedSprite.
+ * Returns: None.
+ * Example:
+ *   arcade_add_animated_to_group(&group, &bird);
+ * Notes:
+ * - Only the current frame is added (type = SPRITE_IMAGE).
+ * - Call each frame to update the animation in the group.
+ * - Ignores inactive or null animated sprites.
+ */
+void arcade_add_animated_to_group(SpriteGroup *group, ArcadeAnimatedSprite *anim);
+
+/*
+ * arcade_render_group: Renders all sprites in a sprite group.
+ * Calls arcade_render_scene with the group’s sprites and types.
+ * Parameters:
+ * - group: Pointer to SpriteGroup.
+ * Returns: None.
+ * Example:
+ *   arcade_render_group(&group);
+ * Notes:
+ * - Clears the screen and renders all active sprites.
+ * - More efficient than rendering sprites individually.
+ */
+void arcade_render_group(SpriteGroup *group);
+
+/*
+ * arcade_free_group: Frees the memory allocated for a sprite group.
+ * Releases memory for sprites and types arrays.
+ * Parameters:
+ * - group: Pointer to SpriteGroup to free.
+ * Returns: None.
+ * Example:
+ *   arcade_free_group(&group);
+ * Notes:
+ * - Does not free individual sprite pixel data (use arcade_free_image_sprite or arcade_free_animated_sprite).
+ * - Sets count = 0, capacity = 0.
+ */
+void arcade_free_group(SpriteGroup *group);
+
+/* =========================================================================
+ * Audio
+ * ========================================================================= */
+
+/*
+ * arcade_play_sound: Plays a WAV audio file.
+ * Plays the file asynchronously (non-blocking).
+ * Parameters:
+ * - audio_file_path: Path to the WAV file (e.g., "audio/sfx.wav").
+ * Returns:
+ * - 0 on success.
+ * - Non-zero on failure (e.g., file not found, invalid format).
+ * Example:
+ *   if (arcade_key_pressed_once(a_space)) {
+ *       arcade_play_sound("audio/jump.wav");
+ *   }
+ * Notes:
+ * - Windows: Uses PlaySound with SND_FILENAME | SND_ASYNC.
+ * - Linux: Uses aplay (requires alsa-utils).
+ * - WAV files must be PCM, 16-bit, mono/stereo.
+ * - Frequent calls may cause delays on slow systems; consider preloading for Windows.
+ */
+int arcade_play_sound(const char *audio_file_path);
+
+/*
+ * arcade_stop_sound: Stops any currently playing WAV audio.
+ * Immediately halts sound playback started by arcade_play_sound.
+ *
+ * Returns:
+ * - 0 on success.
+ * - Non-zero on failure (e.g., no sound playing or command fails).
+ *
+ * Example:
+ *   if (arcade_key_pressed_once(a_s)) {
+ *       arcade_stop_sound();
+ *   }
+ *
+ * Notes:
+ * - Windows: Uses PlaySound(NULL, NULL, 0) to stop current async playback.
+ * - Linux: Uses pkill to terminate background `aplay` processes.
+ *   This assumes that only arcade_play_sound uses `aplay -q`.
+ * - This function stops all active sounds immediately. It does not pause.
+ * - If multiple arcade_play_sound calls were triggered quickly, this will halt them all.
+ */
+int arcade_stop_sound(void);
+
+/* =========================================================================
+ * Image Manipulation
+ * ========================================================================= */
+
+/*
+ * arcade_flip_image: Flips an image vertically or horizontally.
+ * Creates a new image file with the flipped content.
+ * Parameters:
+ * - input_path: Path to the input image (e.g., "sprites/player.png").
+ * - flip_type: 1 for vertical flip, 0 for horizontal flip.
+ * Returns:
+ * - Path to the flipped image (temporary file), or NULL on failure.
+ * Example:
+ *   char *flipped = arcade_flip_image("player.png", 0); // Horizontal flip
+ *   if (flipped) {
+ *       ArcadeImageSprite sprite = arcade_create_image_sprite(100.0f, 100.0f, 50.0f, 50.0f, flipped);
+ *       free(flipped);
+ *   }
+ * Notes:
+ * - Uses STB libraries for image processing.
+ * - Creates a temporary PNG file (Windows: current directory, Linux: /tmp).
+ * - Caller must free the returned path.
+ * - Ensure write permissions in the output directory.
+ */
+char *arcade_flip_image(const char *input_path, int flip_type);
+
+/*
+ * arcade_rotate_image: Rotates an image by 0, 90, 180, or 270 degrees.
+ * Creates a new image file with the rotated content.
+ * Parameters:
+ * - input_path: Path to the input image (e.g., "sprites/player.png").
+ * - degrees: Rotation angle (0, 90, 180, 270).
+ * Returns:
+ * - Path to the rotated image (temporary file), or NULL on failure.
+ * Example:
+ *   char *rotated = arcade_rotate_image("player.png", 90);
+ *   if (rotated) {
+ *       ArcadeImageSprite sprite = arcade_create_image_sprite(100.0f, 100.0f, 50.0f, 50.0f, rotated);
+ *       free(rotated);
+ *   }
+ * Notes:
+ * - Uses STB libraries for image processing.
+ * - Creates a temporary PNG file (Windows: current directory, Linux: /tmp).
+ * - Caller must free the returned path.
+ * - Rotations of 90/270 swap width and height.
+ */
+char *arcade_rotate_image(const char *input_path, int degrees);
+
+/* =========================================================================
+ * Snapshots
+ * ========================================================================= */
+
+/*
+ * arcade_snapshot_ring_init: Allocates a ring of game-state snapshots.
+ * Parameters:
+ * - ring: Pointer to ArcadeSnapshotRing to initialize.
+ * - state_size: Size of one snapshot in bytes (e.g., sizeof(GameData)).
+ * - capacity: Number of snapshots to keep (e.g., 180 for 3 seconds at 60 FPS).
+ * Returns:
+ * - 0 on success.
+ * - Non-zero on failure (invalid arguments or out of memory).
+ * Example:
+ *   ArcadeSnapshotRing history;
+ *   if (arcade_snapshot_ring_init(&history, sizeof(GameData), 180) != 0) {
+ *       fprintf(stderr, "Cannot allocate rewind buffer\n");
+ *   }
+ * Notes:
+ * - The state struct must be plain data (no pointers to owned memory), since
+ *   snapshots are taken and restored with memcpy.
+ */
+int arcade_snapshot_ring_init(ArcadeSnapshotRing *ring, size_t state_size, int capacity);
+
+/*
+ * arcade_snapshot_ring_free: Frees the storage of a snapshot ring.
+ * Parameters:
+ * - ring: Pointer to ArcadeSnapshotRing to free.
+ * Returns: None.
+ * Notes:
+ * - Safe to call on an already-freed or zero-initialized ring.
+ */
+void arcade_snapshot_ring_free(ArcadeSnapshotRing *ring);
+
+/*
+ * arcade_snapshot_ring_clear: Drops every stored snapshot without freeing memory.
+ * Parameters:
+ * - ring: Pointer to ArcadeSnapshotRing.
+ * Returns: None.
+ * Example:
+ *   arcade_snapshot_ring_clear(&history); // New round, nothing to rewind into
+ */
+void arcade_snapshot_ring_clear(ArcadeSnapshotRing *ring);
+
+/*
+ * arcade_snapshot_push: Copies a game state into the ring as the newest snapshot.
+ * Overwrites the oldest snapshot once the ring is full.
+ * Parameters:
+ * - ring: Pointer to ArcadeSnapshotRing.
+ * - state: Pointer to the game state (ring->size bytes are copied).
+ * Returns: None.
+ * Example:
+ *   arcade_snapshot_push(&history, &game); // Call once per simulation tick
+ */
+void arcade_snapshot_push(ArcadeSnapshotRing *ring, const void *state);
+
+/*
+ * arcade_snapshot_peek: Returns a stored snapshot without removing it.
+ * Parameters:
+ * - ring: Pointer to ArcadeSnapshotRing.
+ * - frames_back: 0 for the newest snapshot, 1 for the one before, and so on.
+ * Returns:
+ * - Pointer to the snapshot inside the ring, or NULL if frames_back is out of range.
+ * Notes:
+ * - The pointer stays valid until the slot is overwritten by a later push.
+ */
+const void *arcade_snapshot_peek(const ArcadeSnapshotRing *ring, int frames_back);
+
+/*
+ * arcade_snapshot_restore: Copies a stored snapshot back into a game state.
+ * Parameters:
+ * - ring: Pointer to ArcadeSnapshotRing.
+ * - frames_back: 0 for the newest snapshot, 1 for the one before, and so on.
+ * - state: Destination game state (ring->size bytes are written).
+ * Returns:
+ * - 0 on success.
+ * - Non-zero if no snapshot exists that far back.
+ * Notes:
+ * - The ring is left unchanged; use arcade_snapshot_pop to step backwards.
+ */
+int arcade_snapshot_restore(const ArcadeSnapshotRing *ring, int frames_back, void *state);
+
+/*
+ * arcade_snapshot_pop: Restores the newest snapshot and removes it from the ring.
+ * Calling it once per frame plays the game backwards (rewind).
+ * Parameters:
+ * - ring: Pointer to ArcadeSnapshotRing.
+ * - state: Destination game state.
+ * Returns:
+ * - 0 on success.
+ * - Non-zero if the ring is empty.
+ * Example:
+ *   if (arcade_key_pressed(a_backspace) == 2) {
+ *       arcade_snapshot_pop(&history, &game); // Rewind one tick
+ *   }
+ */
+int arcade_snapshot_pop(ArcadeSnapshotRing *ring, void *state);
+
+/*
+ * arcade_delta_encode: Encodes a game state as the bytes that differ from a base state.
+ * Used to send game states over the network: consecutive states of a flat
+ * game struct share most of their bytes, so the delta is usually a fraction
+ * of the full size.
+ * Parameters:
+ * - base: State the receiver already has, or NULL to encode the full state.
+ * - state: State to encode.
+ * - size: Size of both states in bytes.
+ * - out: Destination buffer.
+ * - out_size: Capacity of out in bytes.
+ * Returns:
+ * - Number of bytes written to out.
+ * - -1 if out is too small (size + 2 * (size / 255 + 1) bytes always suffice).
+ * Example:
+ *   const void *base = arcade_snapshot_peek(&sent, tick - client_ack);
+ *   int n = arcade_delta_encode(base, &game, sizeof(game), packet + 9, sizeof(packet) - 9);
+ * Notes:
+ * - Format: runs of [unchanged byte count][changed byte count][changed bytes],
+ *   each count 0-255.
+ */
+int arcade_delta_encode(const void *base, const void *state, size_t size, unsigned char *out, int out_size);
+
+/*
+ * arcade_delta_decode: Rebuilds a game state from a base state and a delta.
+ * Parameters:
+ * - base: The base state the delta was encoded against, or NULL for a full state.
+ * - delta: Bytes written by arcade_delta_encode.
+ * - delta_size: Number of delta bytes.
+ * - state: Destination (may be the same memory as base).
+ * - size: Size of the state in bytes.
+ * Returns:
+ * - 0 on success.
+ * - Non-zero if the delta is malformed or does not match size.
+ */
+int arcade_delta_decode(const void *base, const unsigned char *delta, int delta_size, void *state, size_t size);
+
+/* =========================================================================
+ * Networking
+ * ========================================================================= */
+
+/*
+ * arcade_net_open: Opens a non-blocking UDP socket talking to one peer.
+ * Parameters:
+ * - net: Pointer to ArcadeNet to initialize.
+ * - local_port: UDP port to listen on.
+ * - remote_host: Peer host name or IPv4 address (e.g., "127.0.0.1").
+ * - remote_port: Peer UDP port.
+ * Returns:
+ * - 0 on success.
+ * - Non-zero if the socket cannot be created or bound, or the host is unknown.
+ * Example:
+ *   ArcadeNet net;
+ *   if (arcade_net_open(&net, 7000, "127.0.0.1", 7001) != 0) {
+ *       return 1;
+ *   }
+ * Notes:
+ * - On Windows, link with ws2_32.
+ */
+int arcade_net_open(ArcadeNet *net, int local_port, const char *remote_host, int remote_port);
+
+/*
+ * arcade_net_simulate: Adds simulated latency and packet loss to outgoing packets.
+ * Parameters:
+ * - net: Pointer to ArcadeNet.
+ * - latency_ms: One-way delay added to every packet (0 to disable).
+ * - loss_percent: Chance of dropping each packet (0-100).
+ * Returns: None.
+ * Example:
+ *   arcade_net_simulate(&net, 60, 10); // Both peers doing this gives ~120 ms RTT
+ */
+void arcade_net_simulate(ArcadeNet *net, int latency_ms, int loss_percent);
+
+/*
+ * arcade_net_send: Sends one packet to the peer.
+ * Parameters:
+ * - net: Pointer to ArcadeNet.
+ * - data: Payload.
+ * - size: Payload size (at most ARCADE_NET_MAX_PACKET bytes).
+ * Returns:
+ * - 0 on success (including packets dropped or delayed by simulation).
+ * - Non-zero on error.
+ * Notes:
+ * - Also sends delayed packets whose release time has passed.
+ */
+int arcade_net_send(ArcadeNet *net, const void *data, int size);
+
+/*
+ * arcade_net_recv: Receives one waiting packet from the peer, if any.
+ * Parameters:
+ * - net: Pointer to ArcadeNet.
+ * - buffer: Destination for the payload.
+ * - size: Buffer size (bytes).
+ * Returns:
+ * - Payload size if a packet was received.
+ * - 0 if no packet is waiting.
+ * Example:
+ *   unsigned char packet[ARCADE_NET_MAX_PACKET];
+ *   int n;
+ *   while ((n = arcade_net_recv(&net, packet, sizeof(packet))) > 0) {
+ *       handle_packet(packet, n);
+ *   }
+ * Notes:
+ * - Never blocks. Packets from other addresses are ignored.
+ */
+int arcade_net_recv(ArcadeNet *net, void *buffer, int size);
+
+/*
+ * arcade_net_close: Closes the socket and drops delayed packets.
+ * Parameters:
+ * - net: Pointer to ArcadeNet.
+ * Returns: None.
+ */
+void arcade_net_close(ArcadeNet *net);
+
+/*
+ * arcade_rollback_init: Starts a two-player rollback session.
+ * Parameters:
+ * - session: Pointer to ArcadeRollback to initialize.
+ * - net: Open connection to the peer.
+ * - state: Live game state, identical on both machines at frame 0.
+ * - state_size: Size of the game state (bytes).
+ * - step: Deterministic one-frame step function.
+ * - local_player: This machine's player number (0 or 1).
+ * - input_delay: Frames of local input delay (0 to ARCADE_ROLLBACK_FRAMES).
+ * Returns:
+ * - 0 on success.
+ * - Non-zero if arguments are invalid or memory cannot be allocated.
+ * Notes:
+ * - Input delay hides that many frames of latency without any rollback;
+ *   larger delays mean fewer rollbacks but less responsive controls.
+ *   arcade_rollback_suggest_delay estimates one from the measured round trip.
+ */
+int arcade_rollback_init(ArcadeRollback *session, ArcadeNet *net, void *state, size_t state_size,
+                         ArcadeStepFunc step, int local_player, int input_delay);
+
+/*
+ * arcade_rollback_update: Exchanges inputs with the peer and advances one frame.
+ * Parameters:
+ * - session: Pointer to ArcadeRollback.
+ * - local_input: This frame's local input byte (game-defined bits).
+ * Returns:
+ * - 1 if the game advanced one frame.
+ * - 0 if it waited because the peer is more than ARCADE_ROLLBACK_FRAMES behind.
+ * Example:
+ *   uint8_t input = (arcade_key_pressed(a_left) == 2) | (arcade_key_pressed(a_right) == 2) << 1;
+ *   if (!arcade_rollback_update(&session, input))
+ *       arcade_render_text("Waiting for peer...", 10.0f, 60.0f, 0xFFFFFF);
+ * Notes:
+ * - Call once per fixed frame. Rollbacks happen inside this call.
+ */
+int arcade_rollback_update(ArcadeRollback *session, uint8_t local_input);
+
+/*
+ * arcade_rollback_suggest_delay: Estimates an input delay from the round trip.
+ * Parameters:
+ * - session: Pointer to ArcadeRollback.
+ * - frame_ms: Length of one frame (e.g., 16.67 at 60 FPS).
+ * Returns: Frames needed to cover half the round trip, capped at
+ *          ARCADE_ROLLBACK_FRAMES.
+ */
+int arcade_rollback_suggest_delay(const ArcadeRollback *session, float frame_ms);
+
+/*
+ * arcade_rollback_free: Frees the session's snapshot history.
+ * Parameters:
+ * - session: Pointer to ArcadeRollback.
+ * Returns: None.
+ * Notes:
+ * - Does not close the connection.
+ */
+void arcade_rollback_free(ArcadeRollback *session);
+
+/* =========================================================================
+ * Worker Pool
+ * ========================================================================= */
+
+/*
+ * arcade_cpu_count: Returns the number of CPUs available to the process.
+ * Parameters: None.
+ * Returns: CPU count (at least 1).
+ */
+int arcade_cpu_count(void);
+
+/*
+ * arcade_pool_init: Starts a worker pool.
+ * Parameters:
+ * - pool: Pointer to ArcadeWorkerPool to initialize.
+ * - thread_count: Threads per batch including the caller, or 0 for the
+ *   arcade_set_worker_threads count (arcade_cpu_count() by default).
+ * Returns:
+ * - 0 on success.
+ * - Non-zero if the threads cannot be created.
+ * Example:
+ *   ArcadeWorkerPool pool;
+ *   if (arcade_pool_init(&pool, 4) != 0) {
+ *       fprintf(stderr, "Cannot start worker threads\n");
+ *   }
+ * Notes:
+ * - A pool of 1 thread runs every batch on the calling thread.
+ */
+int arcade_pool_init(ArcadeWorkerPool *pool, int thread_count);
+
+/*
+ * arcade_pool_run: Runs func(context, i, worker) for every i from 0 to count - 1.
+ * Items are handed out in small chunks, so uneven items balance out across
+ * threads. Returns once every item has finished.
+ * Parameters:
+ * - pool: Pointer to a started ArcadeWorkerPool.
+ * - count: Number of items.
+ * - func: Function run for each item.
+ * - context: Pointer passed to every call.
+ * Returns: None.
+ * Example:
+ *   static void step_match(void *context, int index, int worker) {
+ *       Match *matches = context;
+ *       step_game(&matches[index].state, matches[index].inputs);
+ *   }
+ *   arcade_pool_run(&pool, match_count, step_match, matches);
+ * Notes:
+ * - Items run concurrently and in no particular order; each must only touch
+ *   its own data (or per-worker data).
+ * - Call from one thread at a time.
+ */
+void arcade_pool_run(ArcadeWorkerPool *pool, int count, ArcadeJobFunc func, void *context);
+
+/*
+ * arcade_pool_free: Stops and joins the pool's threads.
+ * Parameters:
+ * - pool: Pointer to ArcadeWorkerPool.
+ * Returns: None.
+ */
+void arcade_pool_free(ArcadeWorkerPool *pool);
+
+/* =========================================================================
+ * Environments
+ * ========================================================================= */
+
+/*
+ * arcade_env_init: Creates an environment for a game.
+ * Parameters:
+ * - env: Pointer to ArcadeEnv to initialize.
+ * - def: The game's ArcadeEnvDef.
+ * - obs_type: ARCADE_OBS_STATE, ARCADE_OBS_GRAY or ARCADE_OBS_RGB.
+ * - obs_width, obs_height: Frame observation size, or 0 for the game's screen
+ *   size (ignored for ARCADE_OBS_STATE).
+ * Returns:
+ * - 0 on success.
+ * - Non-zero on invalid arguments or out of memory.
+ * Notes:
+ * - Call arcade_env_reset before the first step.
+ */
+int arcade_env_init(ArcadeEnv *env, const ArcadeEnvDef *def, int obs_type, int obs_width, int obs_height);
+
+/*
+ * arcade_env_obs_size: Returns the size of one observation in bytes.
+ * Parameters:
+ * - env: Pointer to an initialized ArcadeEnv.
+ * Returns: Bytes written to obs by reset and step.
+ */
+size_t arcade_env_obs_size(const ArcadeEnv *env);
+
+/*
+ * arcade_env_observe: Writes the current observation.
+ * Parameters:
+ * - env: Pointer to ArcadeEnv.
+ * - obs: Destination (arcade_env_obs_size bytes).
+ * Returns: None.
+ */
+void arcade_env_observe(ArcadeEnv *env, void *obs);
+
+/*
+ * arcade_env_reset: Starts a new episode.
+ * Parameters:
+ * - env: Pointer to ArcadeEnv.
+ * - seed: Episode seed; the same seed and actions replay the same episode.
+ * - obs: Destination for the first observation, or NULL.
+ * Returns: None.
+ */
+void arcade_env_reset(ArcadeEnv *env, uint32_t seed, void *obs);
+
+/*
+ * arcade_env_step: Applies an action for one frame.
+ * Parameters:
+ * - env: Pointer to ArcadeEnv.
+ * - action: Discrete action (0 to def->action_count - 1; others act as 0).
+ * - obs: Destination for the next observation, or NULL to skip rendering.
+ * - done: Set to 1 if the episode ended, else 0 (may be NULL).
+ * Returns: Reward for the step.
+ * Example:
+ *   float reward = arcade_env_step(&env, action, obs, &done);
+ */
+float arcade_env_step(ArcadeEnv *env, int action, void *obs, int *done);
+
+/*
+ * arcade_env_free: Frees an environment's state and scratch buffers.
+ * Parameters:
+ * - env: Pointer to ArcadeEnv.
+ * Returns: None.
+ */
+void arcade_env_free(ArcadeEnv *env);
+
+/*
+ * arcade_vec_env_init: Creates count environments of one game and a pool to step them.
+ * Parameters:
+ * - vec: Pointer to ArcadeVecEnv to initialize.
+ * - def, obs_type, obs_width, obs_height: As for arcade_env_init.
+ * - count: Number of environments.
+ * - threads: Threads to step them with, or 0 as for arcade_pool_init.
+ * Returns:
+ * - 0 on success.
+ * - Non-zero on invalid arguments, out of memory, or if threads cannot start.
+ */
+int arcade_vec_env_init(ArcadeVecEnv *vec, const ArcadeEnvDef *def, int count, int obs_type,
+                        int obs_width, int obs_height, int threads);
+
+/*
+ * arcade_vec_env_reset: Resets every environment.
+ * Parameters:
+ * - vec: Pointer to ArcadeVecEnv.
+ * - seed: Environment i uses seed + i, and later episodes continue from there
+ *   in steps of count, so no two episodes share a seed.
+ * - obs: Destination for count observations back to back, or NULL.
+ * Returns: None.
+ */
+void arcade_vec_env_reset(ArcadeVecEnv *vec, uint32_t seed, void *obs);
+
+/*
+ * arcade_vec_env_step: Steps every environment by one frame in parallel.
+ * Parameters:
+ * - vec: Pointer to ArcadeVecEnv.
+ * - actions: One action per environment.
+ * - obs: Destination for count observations back to back, or NULL.
+ * - rewards: One reward per environment.
+ * - dones: Set to 1 for environments whose episode ended (and was reset).
+ * Returns: None.
+ * Example:
+ *   arcade_vec_env_step(&vec, actions, obs, rewards, dones);
+ */
+void arcade_vec_env_step(ArcadeVecEnv *vec, const int *actions, void *obs, float *rewards, int *dones);
+
+/*
+ * arcade_vec_env_free: Frees every environment and stops the pool.
+ * Parameters:
+ * - vec: Pointer to ArcadeVecEnv.
+ * Returns: None.
+ */
+void arcade_vec_env_free(ArcadeVecEnv *vec);
+
+/* =========================================================================
+ * Random Numbers
+ * ========================================================================= */
+
+/*
+ * arcade_rng_seed: Starts a random stream from a seed.
+ * Parameters:
+ * - rng: Pointer to ArcadeRng.
+ * - seed: Any value, including 0; equal seeds give equal sequences.
+ * Returns: None.
+ * Example:
+ *   arcade_rng_seed(&game.rng, (uint64_t)time(NULL));
+ */
+void arcade_rng_seed(ArcadeRng *rng, uint64_t seed);
+
+/*
+ * arcade_rng_seed_stream: Starts stream number `stream` of a seed.
+ * Different streams of one seed are independent, so parallel simulations
+ * (matches, environments, particle systems) can each take their own.
+ * Parameters:
+ * - rng: Pointer to ArcadeRng.
+ * - seed: Shared seed.
+ * - stream: Stream number; stream 0 equals arcade_rng_seed(rng, seed).
+ * Returns: None.
+ * Example:
+ *   for (int i = 0; i < match_count; i++)
+ *       arcade_rng_seed_stream(&matches[i].rng, seed, i);
+ */
+void arcade_rng_seed_stream(ArcadeRng *rng, uint64_t seed, uint64_t stream);
+
+/*
+ * arcade_rng_next: Returns the next 32 random bits of a stream.
+ * Parameters:
+ * - rng: Pointer to a seeded ArcadeRng.
+ * Returns: Uniform value from 0 to 0xFFFFFFFF.
+ */
+uint32_t arcade_rng_next(ArcadeRng *rng);
+
+/*
+ * arcade_rng_below: Returns a uniform integer from 0 to bound - 1.
+ * Parameters:
+ * - rng: Pointer to a seeded ArcadeRng.
+ * - bound: Number of possible values (0 returns 0).
+ * Returns: Value in [0, bound).
+ * Notes:
+ * - Unbiased, unlike rand() % bound, and usually without a division.
+ */
+uint32_t arcade_rng_below(ArcadeRng *rng, uint32_t bound);
+
+/*
+ * arcade_rng_range: Returns a uniform integer from min to max inclusive.
+ * Parameters:
+ * - rng: Pointer to a seeded ArcadeRng.
+ * - min, max: Bounds (max >= min).
+ * Returns: Value in [min, max].
+ * Example:
+ *   int degrees = arcade_rng_range(&rng, 60, 119);
+ */
+int arcade_rng_range(ArcadeRng *rng, int min, int max);
+
+/*
+ * arcade_rng_float: Returns a uniform float from 0 up to (not including) 1.
+ * Parameters:
+ * - rng: Pointer to a seeded ArcadeRng.
+ * Returns: Value in [0, 1) with 24 random bits.
+ */
+float arcade_rng_float(ArcadeRng *rng);
+
+/*
+ * arcade_rng_float_range: Returns a uniform float from min up to max.
+ * Parameters:
+ * - rng: Pointer to a seeded ArcadeRng.
+ * - min, max: Bounds.
+ * Returns: Value in [min, max).
+ */
+float arcade_rng_float_range(ArcadeRng *rng, float min, float max);
+
+/*
+ * arcade_rng_fill: Fills an array with random 32-bit values.
+ * Parameters:
+ * - rng: Pointer to a seeded ArcadeRng.
+ * - out: Array of count values.
+ * - count: Number of values.
+ * Returns: None.
+ * Notes:
+ * - Gives the same values as count calls to arcade_rng_next, faster.
+ */
+void arcade_rng_fill(ArcadeRng *rng, uint32_t *out, size_t count);
+
+/*
+ * arcade_rng_fill_floats: Fills an array with uniform floats from min up to max.
+ * Parameters:
+ * - rng: Pointer to a seeded ArcadeRng.
+ * - out: Array of count floats.
+ * - count: Number of floats.
+ * - min, max: Bounds.
+ * Returns: None.
+ * Example:
+ *   float angles[64];
+ *   arcade_rng_fill_floats(&rng, angles, 64, 0.0f, 6.2831853f);
+ */
+void arcade_rng_fill_floats(ArcadeRng *rng, float *out, size_t count, float min, float max);
+
+/* =========================================================================
+ * Timers
+ * ========================================================================= */
+
+/*
+ * arcade_timers_init: Prepares an empty timer wheel.
+ * Parameters:
+ * - wheel: Pointer to ArcadeTimerWheel.
+ * - timers: Array of capacity ArcadeTimer slots (caller-owned).
+ * - capacity: Most timers running at once (1 to ARCADE_TIMER_MAX).
+ * - now: Starting tick.
+ * Returns:
+ * - 0 on success.
+ * - Non-zero on invalid arguments.
+ * Example:
+ *   ArcadeTimer *storage = malloc(50000 * sizeof(ArcadeTimer));
+ *   arcade_timers_init(&wheel, storage, 50000, 0);
+ * Notes:
+ * - The wheel remembers where the array is relative to itself: keep both in
+ *   one struct, or never move (copy) the wheel when the array is separate.
+ */
+int arcade_timers_init(ArcadeTimerWheel *wheel, ArcadeTimer *timers, int capacity, uint64_t now);
+
+/*
+ * arcade_timer_start: Starts a timer.
+ * Parameters:
+ * - wheel: Pointer to an initialized ArcadeTimerWheel.
+ * - delay: Ticks from now until the first expiry (0 counts as 1).
+ * - period: Ticks between later expiries, or 0 for a one-shot timer.
+ * - event, param: Values delivered on expiry. Event 0 makes a silent timer
+ *   that is never delivered, only checked with arcade_timer_pending
+ *   (cooldowns, grace periods).
+ * Returns:
+ * - The timer's handle.
+ * - 0 if all capacity timers are in use.
+ * Example:
+ *   game.shot_timer = arcade_timer_start(&game.timers, BULLET_COOLDOWN, 0, 0, 0);
+ */
+ArcadeTimerId arcade_timer_start(ArcadeTimerWheel *wheel, uint64_t delay, uint32_t period, int event, int param);
+
+/*
+ * arcade_timer_cancel: Stops a timer, including expiries not yet polled.
+ * Parameters:
+ * - wheel: Pointer to ArcadeTimerWheel.
+ * - id: Handle from arcade_timer_start (stale handles and 0 are ignored).
+ * Returns:
+ * - 1 if the timer was stopped.
+ * - 0 if it had already finished.
+ */
+int arcade_timer_cancel(ArcadeTimerWheel *wheel, ArcadeTimerId id);
+
+/*
+ * arcade_timer_pending: Checks whether a timer has yet to expire.
+ * Parameters:
+ * - wheel: Pointer to ArcadeTimerWheel.
+ * - id: Handle from arcade_timer_start, or 0.
+ * Returns:
+ * - 1 while the timer waits (periodic timers wait until cancelled).
+ * - 0 once a one-shot timer has expired, or for a cancelled or 0 handle.
+ * Example:
+ *   if (!arcade_timer_pending(&game.timers, game.shot_timer))
+ *       shoot();
+ */
+int arcade_timer_pending(const ArcadeTimerWheel *wheel, ArcadeTimerId id);
+
+/*
+ * arcade_timer_remaining: Returns the ticks until a timer's next expiry.
+ * Parameters:
+ * - wheel: Pointer to ArcadeTimerWheel.
+ * - id: Handle from arcade_timer_start.
+ * Returns: Ticks left, or 0 if the timer is not pending.
+ */
+uint64_t arcade_timer_remaining(const ArcadeTimerWheel *wheel, ArcadeTimerId id);
+
+/*
+ * arcade_timers_advance: Moves the wheel's clock forward and delivers every
+ * timer that expires on the way, in tick order.
+ * Parameters:
+ * - wheel: Pointer to ArcadeTimerWheel.
+ * - now: New current tick (earlier ticks are ignored).
+ * - func: Called for each expiry, or NULL to queue them for arcade_timers_poll.
+ * - context: Pointer passed to func.
+ * Returns: Number of expiries delivered or queued (silent timers excluded).
+ * Example:
+ *   game.clock_ms += delta_time * 1000.0f;
+ *   arcade_timers_advance(&game.timers, (uint64_t)game.clock_ms, on_timer, &game);
+ * Notes:
+ * - func may start and cancel timers, including the one being delivered.
+ * - Costs one step per tick while timers are running (none while the wheel
+ *   is empty), plus one step per expiry.
+ */
+int arcade_timers_advance(ArcadeTimerWheel *wheel, uint64_t now, ArcadeTimerFunc func, void *context);
+
+/*
+ * arcade_timers_poll: Takes the oldest queued expiry.
+ * Parameters:
+ * - wheel: Pointer to ArcadeTimerWheel.
+ * - event, param: Receive the timer's values (either may be NULL).
+ * Returns:
+ * - 1 if an expiry was returned.
+ * - 0 if the queue is empty.
+ * Example:
+ *   arcade_timers_advance(&game.timers, game.frames, NULL, NULL);
+ *   int event;
+ *   while (arcade_timers_poll(&game.timers, &event, NULL))
+ *       handle_event(&game, event);
+ */
+int arcade_timers_poll(ArcadeTimerWheel *wheel, int *event, int *param);
+
+/* =========================================================================
+ * Logging
+ * ========================================================================= */
+
+/*
+ * arcade_log: Logs a message without waiting on output.
+ * The format and a copy of its arguments go into the calling thread's
+ * ring; the log thread formats them and writes them to stderr, so a call
+ * costs a cycle-counter read and a few copies, not a printf: about 50 ns
+ * within a burst of messages and 100 ns on average (two arguments, x86).
+ * Parameters:
+ * - level: ARCADE_LOG_DEBUG, ARCADE_LOG_INFO, ARCADE_LOG_WARN or ARCADE_LOG_ERROR.
+ * - category: Short name of the part logging (e.g., "flappybird"), kept by
+ *   pointer: pass a string literal. NULL logs as "arcade".
+ * - format: printf format, then its arguments. Also kept by pointer (a
+ *   string literal); strings in the arguments are copied.
+ * Returns: None.
+ * Example:
+ *   arcade_log(ARCADE_LOG_DEBUG, "flappybird", "Score incremented: %d", game.score);
+ *   // stderr: [    3.412] debug flappybird: Score incremented: 4
+ * Notes:
+ * - Messages below the arcade_set_log_level level cost only the compare.
+ * - Lines show seconds since the logger started; messages of one thread
+ *   come out in order, those of different threads may interleave late.
+ *   Times come from the CPU's cycle counter on x86 and 64-bit ARM; on
+ *   other CPUs they are only as fine as the kernel's tick (1-4 ms).
+ * - Arguments past 192 bytes (long strings) are left out, shown as "...",
+ *   and lines are cut at 255 characters.
+ * - If a thread logs faster than the log thread writes (256 waiting
+ *   messages), further messages are dropped and the count reported.
+ * - Safe from any thread. The log thread starts on the first message and
+ *   is stopped by arcade_quit (after writing everything) or at exit.
+ */
+void arcade_log(int level, const char *category, const char *format, ...);
+
+/*
+ * arcade_set_log_level: Sets the lowest level arcade_log writes.
+ * Parameters:
+ * - level: ARCADE_LOG_DEBUG to ARCADE_LOG_ERROR (default ARCADE_LOG_INFO).
+ * Returns: None.
+ * Example:
+ *   arcade_set_log_level(ARCADE_LOG_DEBUG); // Or "log_level": "debug" in arcade.config.json
+ */
+void arcade_set_log_level(int level);
+
+/*
+ * arcade_log_flush: Waits until every message logged so far is written.
+ * Parameters: None.
+ * Returns: None.
+ * Example:
+ *   arcade_log(ARCADE_LOG_ERROR, "server", "Shutting down: %s", reason);
+ *   arcade_log_flush();
+ *   abort();
+ * Notes:
+ * - Not needed before returning from main or calling arcade_quit.
+ */
+void arcade_log_flush(void);
+
+/* =========================================================================
+ * Memory
+ * ========================================================================= */
+
+/*
+ * arcade_set_allocator: Routes the library's memory through an allocator.
+ * Sprite pixels, groups, animation frames, snapshot rings, environments,
+ * pixel buffers and image loading scratch all come from it.
+ * Parameters:
+ * - allocator: Allocator to copy, or NULL for the default (the C heap, with
+ *   aligned allocation).
+ * Returns: None.
+ * Example:
+ *   ArcadeAllocator level = arcade_arena_allocator(&level_arena);
+ *   arcade_set_allocator(&level);
+ *   ArcadeImageSprite tiles = arcade_create_image_sprite(0, 0, 512, 512, "tiles.png");
+ *   arcade_set_allocator(NULL); // Later allocations use the heap again
+ * Notes:
+ * - Not thread-safe: set it while no other thread uses the library.
+ * - Paths returned by arcade_flip_image and arcade_rotate_image still come
+ *   from strdup, for free().
+ */
+void arcade_set_allocator(const ArcadeAllocator *allocator);
+
+/*
+ * arcade_alloc: Allocates memory from the current allocator.
+ * Parameters:
+ * - size: Bytes to allocate.
+ * - align: Alignment (a power of two), or 0 for 16 bytes.
+ * Returns: The memory, or NULL if there is none.
+ * Example:
+ *   uint32_t *pixels = arcade_alloc(w * h * sizeof(uint32_t), ARCADE_SIMD_ALIGN);
+ * Notes:
+ * - Free with arcade_free (not free), whatever allocator is current by then.
+ */
+void *arcade_alloc(size_t size, size_t align);
+
+/*
+ * arcade_realloc: Resizes memory from arcade_alloc, keeping its alignment.
+ * Parameters:
+ * - ptr: Memory from arcade_alloc, or NULL to allocate.
+ * - size: New size in bytes.
+ * Returns: The memory (moved if it grew), or NULL with ptr untouched.
+ * Example:
+ *   items = arcade_realloc(items, capacity * sizeof(*items));
+ */
+void *arcade_realloc(void *ptr, size_t size);
+
+/*
+ * arcade_free: Frees memory from arcade_alloc or arcade_realloc.
+ * Parameters:
+ * - ptr: The memory, or NULL (ignored).
+ * Returns: None.
+ * Example:
+ *   arcade_free(pixels);
+ */
+void arcade_free(void *ptr);
+
+/*
+ * arcade_arena_init: Prepares an arena.
+ * Parameters:
+ * - arena: Pointer to ArcadeArena.
+ * - size: Bytes to reserve up front (0 to grow on first use).
+ * Returns:
+ * - 0 on success.
+ * - Non-zero if the memory could not be allocated.
+ * Example:
+ *   ArcadeArena level;
+ *   if (arcade_arena_init(&level, 8 << 20) != 0) return 1;
+ * Notes:
+ * - Blocks come from the allocator current at this call.
+ */
+int arcade_arena_init(ArcadeArena *arena, size_t size);
+
+/*
+ * arcade_arena_alloc: Takes memory from an arena.
+ * Parameters:
+ * - arena: Pointer to ArcadeArena.
+ * - size: Bytes to allocate.
+ * - align: Alignment (a power of two), or 0 for 16 bytes.
+ * Returns: The memory, or NULL if there is none.
+ * Example:
+ *   float *weights = arcade_arena_alloc(arcade_frame_arena(), count * sizeof(float), ARCADE_SIMD_ALIGN);
+ */
+void *arcade_arena_alloc(ArcadeArena *arena, size_t size, size_t align);
+
+/*
+ * arcade_arena_mark: Records how much of an arena is in use.
+ * Parameters:
+ * - arena: Pointer to ArcadeArena.
+ * Returns: A mark for arcade_arena_release.
+ * Example:
+ *   ArcadeArenaMark mark = arcade_arena_mark(scratch);
+ *   // ... temporary allocations ...
+ *   arcade_arena_release(scratch, mark);
+ */
+ArcadeArenaMark arcade_arena_mark(const ArcadeArena *arena);
+
+/*
+ * arcade_arena_release: Frees everything allocated since a mark.
+ * Parameters:
+ * - arena: Pointer to ArcadeArena.
+ * - mark: From arcade_arena_mark on the same arena (marks are released
+ *   newest first).
+ * Returns: None.
+ * Example: See arcade_arena_mark.
+ * Notes:
+ * - Grows base when the arena ends up empty after spilling.
+ */
+void arcade_arena_release(ArcadeArena *arena, ArcadeArenaMark mark);
+
+/*
+ * arcade_arena_reset: Frees everything allocated from an arena, keeping its
+ * memory for reuse.
+ * Parameters:
+ * - arena: Pointer to ArcadeArena.
+ * Returns: None.
+ * Example:
+ *   arcade_arena_reset(&level); // Next level reuses the memory
+ */
+void arcade_arena_reset(ArcadeArena *arena);
+
+/*
+ * arcade_arena_free: Returns an arena's memory to its allocator.
+ * Parameters:
+ * - arena: Pointer to ArcadeArena.
+ * Returns: None.
+ * Example:
+ *   arcade_arena_free(&level);
+ */
+void arcade_arena_free(ArcadeArena *arena);
+
+/*
+ * arcade_arena_allocator: Wraps an arena as an allocator.
+ * Parameters:
+ * - arena: Arena to allocate from (must outlive the allocator's use).
+ * Returns: An ArcadeAllocator for arcade_set_allocator.
+ * Example: See arcade_set_allocator.
+ * Notes:
+ * - arcade_free of its memory does nothing; the memory goes back when the
+ *   arena is reset or freed, so free the sprites loaded into it (to drop
+ *   their server copies and pointers) before that.
+ */
+ArcadeAllocator arcade_arena_allocator(ArcadeArena *arena);
+
+/*
+ * arcade_frame_arena: Returns the calling thread's scratch arena.
+ * Parameters: None.
+ * Returns: The arena (never NULL).
+ * Example:
+ *   int *order = arcade_arena_alloc(arcade_frame_arena(), count * sizeof(int), 0);
+ *   // Valid until the next arcade_update
+ * Notes:
+ * - arcade_update resets the main thread's arena every tick. The library
+ *   takes its own per-call scratch (scene culling masks, polygon edges)
+ *   from it with a mark and release, so after the first frames rendering
+ *   allocates nothing, on any thread.
+ * - Worker pool threads free theirs when the pool is freed.
+ */
+ArcadeArena *arcade_frame_arena(void);
+
+/* =========================================================================
+ * Performance Configuration
+ * ========================================================================= */
+
+/*
+ * arcade_load_config: Applies the "performance" section of a game's config file.
+ * Parameters:
+ * - path: JSON file to read (e.g., "arcade.config.json").
+ * Returns:
+ * - 0 if the file was read (with or without a performance section).
+ * - 1 if it cannot be read, 2 if it is not valid JSON or nests deeper than
+ *   32 levels (settings before the error are kept); environment overrides
+ *   are applied either way.
+ * Example:
+ *   // arcade.config.json:
+ *   // { "gameName": "PaddleBall", ...,
+ *   //   "performance": { "target_fps": 120, "pacing": "sleep", "backend": "xrender",
+ *   //                    "pixel_format": "rgb565", "worker_threads": 2,
+ *   //                    "image_cache_mb": 64, "asset_cache": true, "profile": true,
+ *   //                    "log_level": "debug", "image_filter": "point" } }
+ *   arcade_load_config("cabinet3.json");
+ *   arcade_init(800, 600, "My Game", 0x000000);
+ * Notes:
+ * - arcade_init loads ARCADE_CONFIG, or arcade.config.json in the working
+ *   directory, unless arcade_load_config was called first. Settings apply
+ *   over the arcade_set_* calls made before it, so a cabinet can be tuned
+ *   without recompiling.
+ * - Settings: target_fps (arcade_set_target_fps), pacing ("vsync", "sleep"
+ *   or "none"), backend ("software", "xlib" or "xrender"), pixel_format
+ *   ("auto", "xrgb8888" or "rgb565"), worker_threads
+ *   (arcade_set_worker_threads), image_cache_mb
+ *   (arcade_set_image_cache_budget), asset_cache (arcade_set_asset_cache,
+ *   true or false), profile (true or false), log_level ("debug", "info",
+ *   "warn" or "error") and image_filter (arcade_set_image_filter: "smooth",
+ *   "linear" or "point").
+ * - Each setting can be overridden by an environment variable named after
+ *   it: ARCADE_TARGET_FPS=144, ARCADE_PACING=none, ARCADE_PROFILE=1, ...
+ * - Unknown settings and values are reported on stderr and ignored.
+ */
+int arcade_load_config(const char *path);
+
+/*
+ * arcade_set_target_fps: Sets the frame rate arcade_wait_frame paces to.
+ * Parameters:
+ * - fps: Frames per second (default 60); 0 = no limit.
+ * Returns: None.
+ * Example:
+ *   arcade_set_target_fps(30); // Battery-friendly
+ */
+void arcade_set_target_fps(int fps);
+
+/*
+ * arcade_target_fps: Returns the frame rate arcade_wait_frame paces to.
+ * Parameters: None.
+ * Returns: Frames per second, or 0 for no limit.
+ * Example:
+ *   float step = 1.0f / arcade_target_fps();
+ */
+int arcade_target_fps(void);
+
+/*
+ * arcade_set_pacing: Chooses how frames are paced.
+ * Parameters:
+ * - mode: ARCADE_PACING_VSYNC (default), ARCADE_PACING_SLEEP or
+ *   ARCADE_PACING_NONE.
+ * Returns: None.
+ * Example:
+ *   arcade_set_pacing(ARCADE_PACING_NONE); // Benchmark: as fast as possible
+ *   arcade_init(800, 600, "My Game", 0x000000);
+ * Notes:
+ * - Call before arcade_init; VSYNC and the others turn arcade_set_vsync on
+ *   and off.
+ */
+void arcade_set_pacing(int mode);
+
+/*
+ * arcade_wait_frame: Waits until the next frame is due.
+ * Call once per frame, after arcade_present, in place of a fixed sleep.
+ * Parameters: None.
+ * Returns: None.
+ * Example:
+ *   while (arcade_running() && arcade_update()) {
+ *       // Update, render, present
+ *       arcade_wait_frame();
+ *   }
+ * Notes:
+ * - Sleeps to a fixed schedule of 1 / arcade_target_fps seconds, so time
+ *   spent on the frame is not added to the wait. A frame more than one
+ *   period late starts a new schedule instead of rushing to catch up.
+ * - Returns at once while frames are shown at vertical blanks (arcade_vsync),
+ *   with ARCADE_PACING_NONE, or with a target of 0.
+ */
+void arcade_wait_frame(void);
+
+/*
+ * arcade_set_worker_threads: Sets the size of worker pools started with 0 threads.
+ * Parameters:
+ * - count: Threads per pool including the caller; 0 = one per CPU (default).
+ * Returns: None.
+ * Example:
+ *   arcade_set_worker_threads(2); // Leave the other cores to the rest of the cabinet
+ * Notes:
+ * - Applies to arcade_pool_init(pool, 0) and arcade_vec_env_init with 0
+ *   threads; explicit counts are kept.
+ */
+void arcade_set_worker_threads(int count);
+
+/*
+ * arcade_set_image_cache_budget: Limits the memory of images kept on the X server.
+ * Parameters:
+ * - bytes: Most bytes of uploaded images (0 = no limit, the default).
+ * Returns: None.
+ * Example:
+ *   arcade_set_image_cache_budget(64u << 20); // 64 MB
+ * Notes:
+ * - Only the XRender backend keeps images. When an upload would go over the
+ *   budget, every image is dropped and the ones still drawn are uploaded
+ *   again as they are used.
+ */
+void arcade_set_image_cache_budget(size_t bytes);
+
+/*
+ * arcade_set_profile: Turns the frame time report on or off.
+ * Parameters:
+ * - enable: 1 = time every arcade_update and print the frame count, average
+ *   and worst frame time to stderr at arcade_quit; 0 = off (default).
+ * Returns: None.
+ * Example:
+ *   arcade_set_profile(1);
+ *   // At exit: arcade: 3600 frames, 16.67 ms average (60.0 FPS), 18.02 ms worst
+ */
+void arcade_set_profile(int enable);
+
+#endif
+
+/* =========================================================================
+ * Implementation
+ * ========================================================================= */
+
+/* Emitted once per program even if arcade.h is included again afterwards */
+#if defined(ARCADE_IMPLEMENTATION) && !defined(ARCADE_IMPLEMENTATION_INCLUDED)
+#define ARCADE_IMPLEMENTATION_INCLUDED
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+#include <time.h>
+#include <sys/time.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ARCADE_SSE2 /* Vector rectangle fill and blend */
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h> /* __rdtsc */
+#endif
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <windows.h>
+#else
+#if defined(ARCADE_HEADLESS)
+#elif defined(ARCADE_XCB)
+#include <xcb/xcb.h>
+#include <xcb/xcbext.h>
+#include <X11/extensions/presenttokens.h>
+#else
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/keysym.h>
+#if defined(ARCADE_XRENDER)
+#define ARCADE_HAS_XRENDER /* Server-side compositing backend */
+#include <X11/extensions/Xrender.h>
+#endif
+#endif
+#include <pthread.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+/* Image loading, resizing and writing allocate through arcade_alloc */
+#define STBI_MALLOC(size) arcade_alloc(size, 0)
+#define STBI_REALLOC(ptr, size) arcade_realloc(ptr, size)
+#define STBI_FREE(ptr) arcade_free(ptr)
+#define STBIW_MALLOC(size) arcade_alloc(size, 0)
+#define STBIW_REALLOC(ptr, size) arcade_realloc(ptr, size)
+#define STBIW_FREE(ptr) arcade_free(ptr)
+#define STBIR_MALLOC(size, user_data) ((void)(user_data), arcade_alloc(size, 0))
+#define STBIR_FREE(ptr, user_data) ((void)(user_data), arcade_free(ptr))
+#define STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#define STB_IMAGE_RESIZE2_IMPLEMENTATION
+#include "stb_image.h"
+#include "stb_image_write.h"
+#include "stb_image_resize2.h"
+
+/* =========================================================================
+ * Internal State
+ * ========================================================================= */
+#if defined(ARCADE_HEADLESS)
+typedef struct
+{
+    uint32_t *pixels;  /* Pixel buffer that sprites render into (never shown) */
+    int width, height; /* Buffer dimensions in pixels */
+    uint32_t bg_color; /* Background color (0xRRGGBB) for clearing the buffer */
+    int running;       /* Game running state (1 = running, 0 = stopped) */
+} ArcadeState;
+#elif defined(_WIN32)
+typedef struct
+{
+    HWND hwnd;         /* Window handle for the game window */
+    HDC hdc;           /* Device context for rendering operations */
+    HBITMAP hbitmap;   /* Bitmap for double buffering to reduce flicker */
+    uint32_t *pixels;  /* Pixel buffer for storing rendered frame data */
+    int width, height; /* Window dimensions in pixels */
+    uint32_t bg_color; /* Background color (0xRRGGBB) for clearing the screen */
+    HFONT hfont;       /* Font handle for text rendering (Courier New) */
+    int running;       /* Game running state (1 = running, 0 = stopped) */
+} ArcadeState;
+#elif defined(ARCADE_XCB)
+typedef struct
+{
+    xcb_connection_t *connection; /* Connection to the X server */
+    xcb_window_t window;          /* Game window identifier */
+    xcb_gcontext_t gc;            /* Graphics context (9x15 font) for frames and text */
+    xcb_font_t font;              /* 9x15 core font */
+    xcb_colormap_t colormap;      /* Colormap of a non-default visual (0 = none) */
+    uint8_t depth;                /* Window depth, for frame uploads */
+    int format;                   /* ARCADE_FORMAT_* of the window's visual */
+    uint16_t *display_pixels;     /* Frame converted to RGB565 (NULL at 32 bits) */
+    size_t display_stride;        /* Bytes per row of display_pixels */
+    uint32_t max_request;         /* Largest request in bytes (0 until known) */
+    uint32_t *pixels;             /* Pixel buffer for storing rendered frame data */
+    int width, height;            /* Window dimensions in pixels */
+    uint32_t bg_color;            /* Background color (0xRRGGBB) for clearing the screen */
+    xcb_atom_t wm_delete;         /* WM_DELETE_WINDOW (0 until its reply arrives) */
+    unsigned int protocols_request, delete_request, keymap_request, font_request; /* Outstanding replies (0 = none) */
+    xcb_keysym_t *keysyms;        /* Keysyms per keycode (NULL until the mapping arrives) */
+    int keysyms_per_keycode;      /* Row length of keysyms */
+    uint8_t min_keycode, max_keycode; /* Keycodes covered by keysyms */
+    int char_width;               /* Advance of the fixed-width font (0 until known) */
+    int running;                  /* Game running state (1 = running, 0 = stopped) */
+    int vsync;                    /* 1 while frames go through Present */
+    int present_started;          /* 1 once Present events are selected */
+    xcb_pixmap_t present_pixmaps[3]; /* Frames handed to Present (PRESENT_BUFFERS) */
+    int present_busy[3];          /* 1 until the server reports a pixmap idle */
+    int present_pending;          /* Pixmap holding a frame not yet presented (-1 = none) */
+    uint32_t present_serial;      /* Serial of the last PresentPixmap */
+    uint64_t present_msc;         /* Vblank count of the last completed frame */
+    double present_time;          /* Its vblank time (seconds, arcade_time clock) */
+} ArcadeState;
+#else
+#if defined(ARCADE_HAS_XRENDER)
+/* An image uploaded to the X server, found again by its pixel pointer */
+typedef struct
+{
+    const uint32_t *pixels; /* Client pixels it was uploaded from */
+    Pixmap pixmap;          /* 32-bit server copy */
+    Picture picture;        /* XRender picture of pixmap (repeating) */
+    size_t bytes;           /* Size of the server copy */
+} ServerImage;
+#endif
+
+typedef struct
+{
+    Display *display;  /* X11 display connection for communicating with the X server */
+    Window window;     /* Game window identifier */
+    int screen;        /* Default screen number for the display */
+    Visual *visual;    /* Visual of the window */
+    int depth;         /* Depth of the window */
+    int format;        /* ARCADE_FORMAT_* of the visual */
+    Colormap colormap; /* Colormap of a non-default visual (0 = none) */
+    uint32_t *pixels;  /* Pixel buffer for storing rendered frame data */
+    int width, height; /* Window dimensions in pixels */
+    Atom wm_delete;    /* Atom for handling window close events */
+    XImage *image;     /* X11 image of pixels (or of its RGB565 copy) for the window */
+    GC gc;             /* Graphics context for drawing operations */
+    uint32_t bg_color; /* Background color (0xRRGGBB) for clearing the screen */
+    XFontStruct *font; /* Font structure for text rendering (9x15 font) */
+    int running;       /* Game running state (1 = running, 0 = stopped) */
+#if defined(ARCADE_HAS_XRENDER)
+    Pixmap back;                    /* Server-side frame scenes are composited into */
+    Picture back_picture;           /* XRender picture of back */
+    Picture window_picture;         /* XRender picture of the window */
+    XRenderPictFormat *argb;        /* Format of uploaded images */
+    ServerImage *images;            /* Uploaded images */
+    int image_count, image_capacity; /* Used and allocated entries of images */
+    size_t image_bytes;              /* Server memory of images (for image_cache_budget) */
+    int server_frame;                /* This frame was composited by xrender_scene */
+#endif
+} ArcadeState;
+#endif
+
+static ArcadeState state = {0};           /* Global state for the arcade environment */
+static int key_states[256] = {0};         /* Current key states (0 = up, 1 = down) for input tracking */
+static int last_key_states[256] = {0};    /* Previous key states for detecting single-press events */
+static int global_frame_counter = 0;      /* Global frame counter for animations and blinking effects */
+static int backend_requested = ARCADE_BACKEND_SOFTWARE; /* Backend arcade_init tries to set up */
+static int backend_active = ARCADE_BACKEND_SOFTWARE;    /* Backend in use */
+static int vsync_requested = 1;                         /* Whether arcade_init sets up Present */
+static int format_requested = ARCADE_FORMAT_AUTO;       /* Display format arcade_init looks for */
+static int pacing_requested = ARCADE_PACING_VSYNC;      /* How arcade_wait_frame paces */
+static int target_fps = 60;                             /* Frames per second arcade_wait_frame paces to */
+static int worker_threads = 0;                          /* Pool size for 0 threads (0 = one per CPU) */
+static size_t image_cache_budget = 0;                   /* Most bytes of uploaded images (0 = no limit) */
+static int config_loaded = 0;                           /* Whether arcade_load_config has run */
+static ArcadeWorkerPool pass_pool;                      /* Threads of arcade_pixel_pass_to */
+static int pass_pool_state = 0;                         /* 0 = not started, 1 = running, -1 = failed */
+
+/* An image loaded while the asset cache is on, shared by every sprite of it */
+typedef struct
+{
+    char *path;        /* Absolute path of the file (from realpath, for free) */
+    int width, height; /* Size it was resized to */
+    int filter;        /* ARCADE_FILTER_* it was resized with */
+    uint32_t *pixels;  /* Shared pixels */
+    int opaque;        /* Whether every pixel has alpha */
+    int users;         /* Sprites and layers holding pixels */
+} CachedAsset;
+
+static int asset_cache_enabled = 0;             /* Whether loads go through the asset cache */
+static int image_filter = ARCADE_FILTER_SMOOTH; /* How loaded images are resized */
+static CachedAsset *assets = NULL;              /* Cached images */
+static int asset_count = 0, asset_capacity = 0; /* Used and allocated entries of assets */
+
+/* Frame times measured by arcade_update for the arcade_set_profile report */
+static struct
+{
+    int enabled;  /* Whether frames are being timed */
+    double last;  /* arcade_time of the previous arcade_update (0 = none yet) */
+    long frames;  /* Frames timed */
+    double total; /* Sum of their times (seconds) */
+    double worst; /* Longest frame (seconds) */
+} frame_profile;
+
+/* =========================================================================
+ * Memory
+ * ========================================================================= */
+#if defined(_MSC_VER)
+#define ARCADE_THREAD_LOCAL __declspec(thread)
+#else
+#define ARCADE_THREAD_LOCAL __thread
+#endif
+
+/* Stored just before every arcade_alloc block */
+typedef struct
+{
+    void (*free)(void *user, void *block); /* Allocator that made it */
+    void *user;
+    void *block;  /* Start of the allocator's block */
+    size_t size;  /* Bytes requested */
+    size_t align; /* Alignment requested */
+} AllocHeader;
+
+static void *heap_alloc(void *user, size_t size, size_t align)
+{
+    (void)user;
+#ifdef _WIN32
+    return _aligned_malloc(size, align);
+#else
+    void *block;
+    return posix_memalign(&block, align, size) == 0 ? block : NULL;
+#endif
+}
+
+static void heap_free(void *user, void *block)
+{
+    (void)user;
+#ifdef _WIN32
+    _aligned_free(block);
+#else
+    free(block);
+#endif
+}
+
+static ArcadeAllocator allocator = {heap_alloc, heap_free, NULL}; /* Current allocator */
+static ARCADE_THREAD_LOCAL ArcadeArena frame_arena;              /* Per-thread scratch */
+
+void arcade_set_allocator(const ArcadeAllocator *new_allocator)
+{
+    allocator = new_allocator ? *new_allocator : (ArcadeAllocator){heap_alloc, heap_free, NULL};
+}
+
+void *arcade_alloc(size_t size, size_t align)
+{
+    align = align < 16 ? 16 : align;
+    size_t room = (sizeof(AllocHeader) + align - 1) & ~(align - 1); /* Header, padded to keep alignment */
+    unsigned char *block = allocator.alloc(allocator.user, room + size, align);
+    if (!block)
+        return NULL;
+    AllocHeader *header = (AllocHeader *)(block + room) - 1;
+    *header = (AllocHeader){allocator.free, allocator.user, block, size, align};
+    return block + room;
+}
+
+void *arcade_realloc(void *ptr, size_t size)
+{
+    if (!ptr)
+        return arcade_alloc(size, 0);
+    const AllocHeader *header = (const AllocHeader *)ptr - 1;
+    if (size <= header->size)
+        return ptr; /* Shrinking keeps the block */
+    void *grown = arcade_alloc(size, header->align);
+    if (!grown)
+        return NULL;
+    memcpy(grown, ptr, header->size);
+    arcade_free(ptr);
+    return grown;
+}
+
+void arcade_free(void *ptr)
+{
+    if (!ptr)
+        return;
+    const AllocHeader *header = (const AllocHeader *)ptr - 1;
+    header->free(header->user, header->block);
+}
+
+/* Zeroed arcade_alloc, for the calloc calls */
+static void *alloc_zeroed(size_t size)
+{
+    void *ptr = arcade_alloc(size, 0);
+    if (ptr)
+        memset(ptr, 0, size);
+    return ptr;
+}
+
+/* The arena's allocator; a zeroed arena (frame_arena) takes the current one */
+static ArcadeAllocator *arena_parent(ArcadeArena *arena)
+{
+    if (!arena->parent.alloc)
+        arena->parent = allocator;
+    return &arena->parent;
+}
+
+int arcade_arena_init(ArcadeArena *arena, size_t size)
+{
+    if (!arena)
+        return 1;
+    memset(arena, 0, sizeof(*arena));
+    ArcadeAllocator *parent = arena_parent(arena);
+    if (size)
+    {
+        arena->base = parent->alloc(parent->user, size, ARCADE_SIMD_ALIGN);
+        if (!arena->base)
+            return 1;
+        arena->size = size;
+    }
+    return 0;
+}
+
+void *arcade_arena_alloc(ArcadeArena *arena, size_t size, size_t align)
+{
+    align = align < 16 ? 16 : align;
+    if (arena->base)
+    {
+        uintptr_t start = ((uintptr_t)(arena->base + arena->used) + align - 1) & ~(uintptr_t)(align - 1);
+        size_t end = (size_t)(start - (uintptr_t)arena->base) + size;
+        if (end <= arena->size)
+        {
+            arena->used = end;
+            return (void *)start;
+        }
+    }
+    /* Full: a block of its own, linked through its first bytes */
+    ArcadeAllocator *parent = arena_parent(arena);
+    unsigned char *block = parent->alloc(parent->user, align + size, align);
+    if (!block)
+        return NULL;
+    *(void **)block = arena->spills;
+    arena->spills = block;
+    arena->spilled += size + align;
+    return block + align;
+}
+
+ArcadeArenaMark arcade_arena_mark(const ArcadeArena *arena)
+{
+    return (ArcadeArenaMark){arena->used, arena->spills};
+}
+
+void arcade_arena_release(ArcadeArena *arena, ArcadeArenaMark mark)
+{
+    ArcadeAllocator *parent = arena_parent(arena);
+    while (arena->spills && arena->spills != mark.spills)
+    {
+        void *next = *(void **)arena->spills;
+        parent->free(parent->user, arena->spills);
+        arena->spills = next;
+    }
+    arena->used = mark.used;
+    if (arena->used == 0 && arena->spilled)
+    {
+        /* Nothing lives in base: regrow it to hold what spilled */
+        size_t size = (arena->size + arena->spilled + 4095) & ~(size_t)4095;
+        unsigned char *base = parent->alloc(parent->user, size, ARCADE_SIMD_ALIGN);
+        if (base)
+        {
+            if (arena->base)
+                parent->free(parent->user, arena->base);
+            arena->base = base;
+            arena->size = size;
+        }
+        arena->spilled = 0;
+    }
+}
+
+void arcade_arena_reset(ArcadeArena *arena)
+{
+    arcade_arena_release(arena, (ArcadeArenaMark){0, NULL});
+}
+
+void arcade_arena_free(ArcadeArena *arena)
+{
+    if (!arena)
+        return;
+    arena->spilled = 0; /* No regrowing */
+    arcade_arena_reset(arena);
+    if (arena->base)
+        arena->parent.free(arena->parent.user, arena->base);
+    memset(arena, 0, sizeof(*arena));
+}
+
+static void *arena_hook_alloc(void *user, size_t size, size_t align)
+{
+    return arcade_arena_alloc(user, size, align);
+}
+
+static void arena_hook_free(void *user, void *block)
+{
+    (void)user;
+    (void)block; /* Returned with the whole arena */
+}
+
+ArcadeAllocator arcade_arena_allocator(ArcadeArena *arena)
+{
+    arena_parent(arena); /* Blocks keep coming from the allocator current now */
+    return (ArcadeAllocator){arena_hook_alloc, arena_hook_free, arena};
+}
+
+ArcadeArena *arcade_frame_arena(void)
+{
+    return &frame_arena;
+}
+
+/* =========================================================================
+ * Logging
+ * ========================================================================= */
+#define LOG_RING_SIZE 256 /* Messages a ring holds (a power of two) */
+#define LOG_ARGS_SIZE 192 /* Bytes of arguments a message keeps */
+#define LOG_TEXT_SIZE 256 /* Longest message written, with its terminator */
+
+/* Ring indexes and flags are shared between a writing thread and the log
+ * thread: loads acquire and stores release, so a message is complete
+ * before its index is seen */
+#if defined(_MSC_VER)
+#define LOG_LOAD(p) InterlockedCompareExchange((volatile LONG *)(p), 0, 0)
+#define LOG_STORE(p, v) InterlockedExchange((volatile LONG *)(p), (LONG)(v))
+#define LOG_CAS(p, expected, desired) \
+    (InterlockedCompareExchange((volatile LONG *)(p), (desired), (expected)) == (expected))
+#define LOG_FIRST_RING() ((LogRing *)InterlockedCompareExchangePointer((PVOID volatile *)&log_rings, NULL, NULL))
+#else
+#define LOG_LOAD(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define LOG_STORE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#define LOG_CAS(p, expected, desired) \
+    __atomic_compare_exchange_n(p, &(int){expected}, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define LOG_FIRST_RING() __atomic_load_n(&log_rings, __ATOMIC_ACQUIRE)
+#endif
+
+/* Message timestamps, read by the calling thread in about 20 ns: the
+ * CPU's constant-rate counter where there is one (x86 TSC, ARM generic
+ * timer), else the kernel's coarse clock (to its tick, 1-4 ms) or
+ * arcade_time. The log thread turns them into seconds */
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define LOG_STAMP() __rdtsc()
+#define LOG_STAMP_COUNTER 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define LOG_STAMP() __builtin_ia32_rdtsc()
+#define LOG_STAMP_COUNTER 1
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+static inline uint64_t log_counter(void)
+{
+    uint64_t ticks;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+}
+#define LOG_STAMP() log_counter()
+#define LOG_STAMP_COUNTER 1
+#else
+/* Nanoseconds */
+static inline uint64_t log_clock(void)
+{
+#if defined(CLOCK_MONOTONIC_COARSE)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#else
+    return (uint64_t)(arcade_time() * 1e9);
+#endif
+}
+#define LOG_STAMP() log_clock()
+#define LOG_STAMP_COUNTER 0
+#endif
+
+enum
+{
+    LOG_STOPPED,  /* No log thread; the next message starts it */
+    LOG_STARTING, /* Being started or stopped */
+    LOG_RUNNING,  /* The log thread writes the rings */
+    LOG_DIRECT    /* No thread could be started: messages are written at once */
+};
+
+/* A message as logged: the caller's format and a copy of its arguments,
+ * formatted by the log thread */
+typedef struct
+{
+    uint64_t stamp;       /* LOG_STAMP when logged */
+    const char *category; /* Caller's string */
+    const char *format;   /* Caller's string */
+    int level;
+    int size;             /* Bytes of args used */
+    unsigned char args[LOG_ARGS_SIZE];
+} LogEntry;
+
+/* One thread's messages; only that thread writes head and entries, only
+ * the log thread writes tail */
+typedef struct LogRing
+{
+    unsigned int head;     /* Entries written (next at head % LOG_RING_SIZE) */
+    unsigned int dropped;  /* Messages lost to a full ring */
+    int owned;             /* Whether a thread logs into it */
+    struct LogRing *next;  /* Every ring, newest first (set before it is listed) */
+    LogEntry entries[LOG_RING_SIZE];
+    unsigned int tail;     /* Entries written out, a page away from head */
+    unsigned int reported; /* dropped as last reported */
+} LogRing;
+
+static const char *const log_level_names[] = {"debug", "info", "warn", "error"};
+static int log_level = ARCADE_LOG_INFO;         /* Lowest level written */
+static LogRing *log_rings = NULL;               /* Every thread's ring, kept to exit for reuse */
+static ARCADE_THREAD_LOCAL LogRing *log_ring;   /* The calling thread's ring */
+static int log_thread_state = LOG_STOPPED;      /* LOG_STOPPED ... LOG_DIRECT */
+static int log_stopping = 0;                    /* Tells the log thread to finish */
+static double log_epoch = 0.0;                  /* arcade_time the logger started */
+static uint64_t log_epoch_stamp = 0;            /* LOG_STAMP at log_epoch */
+static double log_stamp_rate = 1e9;             /* LOG_STAMP ticks per second */
+#ifdef _WIN32
+static HANDLE log_thread;
+#else
+static pthread_t log_thread;
+#endif
+
+/* Argument types of printf conversions */
+enum
+{
+    LOG_ARG_NONE,    /* %% */
+    LOG_ARG_INT,     /* int and narrower (d, i, o, u, x, X, c) */
+    LOG_ARG_WIDE,    /* long, long long, intmax_t, size_t, ptrdiff_t: kept as long long */
+    LOG_ARG_DOUBLE,  /* f, F, e, E, g, G, a, A */
+    LOG_ARG_LDOUBLE, /* The same with L */
+    LOG_ARG_STRING,  /* s: the characters are copied */
+    LOG_ARG_POINTER, /* p, and n (never written through) */
+};
+
+/* One conversion of a format */
+typedef struct
+{
+    int type;      /* LOG_ARG_* */
+    int stars;     /* int arguments taken first by '*' width and precision */
+    char wide;     /* Length modifier of a LOG_ARG_WIDE: 'l', 'q' (ll), 'j', 'z' or 't' */
+    int is_signed; /* Whether a LOG_ARG_WIDE is d or i */
+    char spec[32]; /* The conversion for snprintf, LOG_ARG_WIDE as ll */
+} LogSpec;
+
+/* Reads the conversion after a '%' at p; returns the text after it */
+static const char *log_spec(const char *p, LogSpec *spec)
+{
+    size_t n = 0;
+    spec->spec[n++] = '%';
+    spec->stars = 0;
+    spec->wide = 0;
+    /* Character tests rather than strchr: this runs in every arcade_log */
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '.' || *p == '*' || ('0' <= *p && *p <= '9'))
+    {
+        spec->stars += *p == '*';
+        if (n < sizeof(spec->spec) - 5)
+            spec->spec[n++] = *p;
+        p++;
+    }
+    char length = 0;
+    for (; *p == 'h' || *p == 'l' || *p == 'L' || *p == 'j' || *p == 'z' || *p == 't'; p++)
+    {
+        if (*p == 'h' && n < sizeof(spec->spec) - 5)
+            spec->spec[n++] = 'h'; /* Still an int */
+        length = *p == 'l' && length == 'l' ? 'q' : *p;
+    }
+    char conversion = *p ? *p++ : '%';
+    spec->is_signed = conversion == 'd' || conversion == 'i';
+    switch (conversion)
+    {
+    case 'd':
+    case 'i':
+    case 'o':
+    case 'u':
+    case 'x':
+    case 'X':
+        spec->type = length && length != 'h' && length != 'L' ? LOG_ARG_WIDE : LOG_ARG_INT;
+        break;
+    case 'c':
+        spec->type = LOG_ARG_INT;
+        break;
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A':
+        spec->type = length == 'L' ? LOG_ARG_LDOUBLE : LOG_ARG_DOUBLE;
+        break;
+    case 's':
+        spec->type = LOG_ARG_STRING;
+        break;
+    case 'p':
+    case 'n':
+        spec->type = LOG_ARG_POINTER;
+        break;
+    default:
+        spec->type = LOG_ARG_NONE;
+    }
+    if (spec->type == LOG_ARG_WIDE)
+    {
+        spec->wide = length;
+        spec->spec[n++] = 'l';
+        spec->spec[n++] = 'l';
+    }
+    else if (spec->type == LOG_ARG_LDOUBLE)
+        spec->spec[n++] = 'L';
+    spec->spec[n++] = conversion == 'n' ? 'p' : conversion;
+    spec->spec[n] = '\0';
+    return p;
+}
+
+/* Appends value to out, if it fits */
+#define LOG_PACK(type, value)                 \
+    do                                        \
+    {                                         \
+        type packed_ = (value);               \
+        if (out + sizeof(packed_) > end)      \
+            goto full;                        \
+        memcpy(out, &packed_, sizeof(packed_)); \
+        out += sizeof(packed_);               \
+    } while (0)
+
+/* Copies the arguments of entry->format into entry->args; arguments that
+ * do not fit are left out (shown as "...") */
+static void log_pack(LogEntry *entry, va_list args)
+{
+    unsigned char *out = entry->args, *end = entry->args + LOG_ARGS_SIZE;
+    LogSpec spec;
+    for (const char *p = entry->format; (p = strchr(p, '%')) != NULL;)
+    {
+        p = log_spec(p + 1, &spec);
+        for (int i = 0; i < spec.stars; i++)
+            LOG_PACK(int, va_arg(args, int));
+        switch (spec.type)
+        {
+        case LOG_ARG_INT:
+            LOG_PACK(int, va_arg(args, int));
+            break;
+        case LOG_ARG_WIDE:
+            /* Read as the type passed, so narrower ones extend right */
+            if (spec.wide == 'l')
+                LOG_PACK(long long, spec.is_signed ? (long long)va_arg(args, long) : (long long)va_arg(args, unsigned long));
+            else if (spec.wide == 'j')
+                LOG_PACK(long long, spec.is_signed ? (long long)va_arg(args, intmax_t) : (long long)va_arg(args, uintmax_t));
+            else if (spec.wide == 'z')
+                LOG_PACK(long long, (long long)va_arg(args, size_t));
+            else if (spec.wide == 't')
+                LOG_PACK(long long, (long long)va_arg(args, ptrdiff_t));
+            else
+                LOG_PACK(long long, va_arg(args, long long));
+            break;
+        case LOG_ARG_DOUBLE:
+            LOG_PACK(double, va_arg(args, double));
+            break;
+        case LOG_ARG_LDOUBLE:
+            LOG_PACK(long double, va_arg(args, long double));
+            break;
+        case LOG_ARG_POINTER:
+            LOG_PACK(void *, va_arg(args, void *));
+            break;
+        case LOG_ARG_STRING:
+        {
+            const char *text = va_arg(args, const char *);
+            text = text ? text : "(null)";
+            size_t length = strlen(text);
+            if (out >= end)
+                goto full;
+            if (length >= (size_t)(end - out))
+                length = (size_t)(end - out) - 1; /* Cut; nothing after it fits */
+            memcpy(out, text, length);
+            out[length] = '\0';
+            out += length + 1;
+            break;
+        }
+        }
+    }
+full:
+    entry->size = (int)(out - entry->args);
+}
+
+#undef LOG_PACK
+
+/* Formats an entry's message from its format and arguments */
+static void log_render(const LogEntry *entry, char *text, size_t size)
+{
+    const unsigned char *arg = entry->args, *end = entry->args + entry->size;
+    size_t used = 0;
+    LogSpec spec;
+    for (const char *p = entry->format; *p && used < size - 1;)
+    {
+        if (*p != '%')
+        {
+            text[used++] = *p++;
+            continue;
+        }
+        p = log_spec(p + 1, &spec);
+        int star[2] = {0, 0};
+        size_t need = (size_t)spec.stars * sizeof(int);
+        need += spec.type == LOG_ARG_INT ? sizeof(int) : spec.type == LOG_ARG_WIDE ? sizeof(long long)
+              : spec.type == LOG_ARG_DOUBLE ? sizeof(double) : spec.type == LOG_ARG_LDOUBLE ? sizeof(long double)
+              : spec.type == LOG_ARG_POINTER ? sizeof(void *) : spec.type == LOG_ARG_STRING ? 1 : 0;
+        if (spec.stars > 2 || (size_t)(end - arg) < need)
+        {
+            snprintf(text + used, size - used, "...");
+            used += strlen(text + used);
+            break;
+        }
+        for (int i = 0; i < spec.stars; i++, arg += sizeof(int))
+            memcpy(&star[i], arg, sizeof(int));
+
+        char *out = text + used;
+        size_t room = size - used;
+        int written = 0;
+#define LOG_EMIT(value)                                                                     \
+    (spec.stars == 0   ? snprintf(out, room, spec.spec, value)                              \
+     : spec.stars == 1 ? snprintf(out, room, spec.spec, star[0], value)                     \
+                       : snprintf(out, room, spec.spec, star[0], star[1], value))
+        switch (spec.type)
+        {
+        case LOG_ARG_NONE:
+            written = snprintf(out, room, "%%");
+            break;
+        case LOG_ARG_INT:
+        {
+            int value;
+            memcpy(&value, arg, sizeof(value));
+            written = LOG_EMIT(value);
+            break;
+        }
+        case LOG_ARG_WIDE:
+        {
+            long long value;
+            memcpy(&value, arg, sizeof(value));
+            written = LOG_EMIT(value);
+            break;
+        }
+        case LOG_ARG_DOUBLE:
+        {
+            double value;
+            memcpy(&value, arg, sizeof(value));
+            written = LOG_EMIT(value);
+            break;
+        }
+        case LOG_ARG_LDOUBLE:
+        {
+            long double value;
+            memcpy(&value, arg, sizeof(value));
+            written = LOG_EMIT(value);
+            break;
+        }
+        case LOG_ARG_POINTER:
+        {
+            void *value;
+            memcpy(&value, arg, sizeof(value));
+            written = LOG_EMIT(value);
+            break;
+        }
+        case LOG_ARG_STRING:
+            written = LOG_EMIT((const char *)arg);
+            need = strlen((const char *)arg) + 1;
+            break;
+        }
+#undef LOG_EMIT
+        arg += need - (size_t)spec.stars * sizeof(int);
+        if (written > 0)
+            used += (size_t)written < room ? (size_t)written : room - 1;
+    }
+    text[used] = '\0';
+}
+
+/* Formats one message as a line; returns its length */
+static size_t log_format(char *line, size_t size, double seconds, int level, const char *category, const char *text)
+{
+    level = level < ARCADE_LOG_DEBUG ? ARCADE_LOG_DEBUG : level > ARCADE_LOG_ERROR ? ARCADE_LOG_ERROR : level;
+    size_t text_length = strlen(text);
+    if (text_length && text[text_length - 1] == '\n')
+        text_length--; /* printf-style messages keep their newline */
+    int length = snprintf(line, size, "[%9.3f] %-5s %s: %.*s\n", seconds > 0.0 ? seconds : 0.0,
+                          log_level_names[level], category, (int)text_length, text);
+    return length < 0 ? 0 : (size_t)length < size ? (size_t)length : size - 1;
+}
+
+/* Measures log_stamp_rate from the epoch to now, closer the longer the
+ * logger runs (counters only: the clocks count nanoseconds) */
+static void log_calibrate(void)
+{
+#if LOG_STAMP_COUNTER
+    uint64_t stamp = LOG_STAMP();
+    double elapsed = arcade_time() - log_epoch;
+    if (elapsed > 0.001)
+        log_stamp_rate = (double)(stamp - log_epoch_stamp) / elapsed;
+#endif
+}
+
+/* Writes out every waiting message; returns how many there were */
+static int log_drain(void)
+{
+    char buffer[8192], text[LOG_TEXT_SIZE], line[LOG_TEXT_SIZE + 64];
+    size_t used = 0;
+    int count = 0;
+    log_calibrate();
+    for (LogRing *ring = LOG_FIRST_RING(); ring; ring = ring->next)
+    {
+        unsigned int head = LOG_LOAD(&ring->head);
+        unsigned int dropped = LOG_LOAD(&ring->dropped);
+        for (unsigned int tail = ring->tail; tail != head; tail++, count++)
+        {
+            const LogEntry *entry = &ring->entries[tail & (LOG_RING_SIZE - 1)];
+            log_render(entry, text, sizeof(text));
+            double seconds = (double)(int64_t)(entry->stamp - log_epoch_stamp) / log_stamp_rate;
+            size_t length = log_format(line, sizeof(line), seconds, entry->level, entry->category, text);
+            if (used + length > sizeof(buffer))
+            {
+                fwrite(buffer, 1, used, stderr);
+                used = 0;
+            }
+            memcpy(buffer + used, line, length);
+            used += length;
+        }
+        LOG_STORE(&ring->tail, head); /* Frees the entries for the writer */
+        if (dropped != ring->reported)
+        {
+            /* Written with the buffer, after the messages that made it */
+            int length = snprintf(line, sizeof(line), "arcade: %u log messages dropped (ring full)\n", dropped - ring->reported);
+            if (used + (size_t)length > sizeof(buffer))
+            {
+                fwrite(buffer, 1, used, stderr);
+                used = 0;
+            }
+            memcpy(buffer + used, line, (size_t)length);
+            used += (size_t)length;
+            ring->reported = dropped;
+        }
+    }
+    if (used)
+    {
+        fwrite(buffer, 1, used, stderr);
+        fflush(stderr);
+    }
+    return count;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI log_thread_main(LPVOID arg)
+#else
+static void *log_thread_main(void *arg)
+#endif
+{
+    (void)arg;
+    arcade_sleep(2); /* Lets the stamps and the clock move apart, for log_calibrate */
+    while (!LOG_LOAD(&log_stopping))
+        if (!log_drain())
+            arcade_sleep(2); /* Idle: look again in 2 ms */
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+/* Stops the log thread after writing everything (arcade_quit, exit) */
+static void log_stop(void)
+{
+    if (!LOG_CAS(&log_thread_state, LOG_RUNNING, LOG_STARTING))
+        return;
+    LOG_STORE(&log_stopping, 1);
+#ifdef _WIN32
+    WaitForSingleObject(log_thread, INFINITE);
+    CloseHandle(log_thread);
+#else
+    pthread_join(log_thread, NULL);
+#endif
+    log_drain();
+    LOG_STORE(&log_thread_state, LOG_STOPPED);
+}
+
+/* Starts the log thread, unless another thread is */
+static void log_start(void)
+{
+    static int exit_hooked = 0;
+    if (!LOG_CAS(&log_thread_state, LOG_STOPPED, LOG_STARTING))
+        return;
+    if (log_epoch == 0.0)
+    {
+        log_epoch_stamp = LOG_STAMP();
+        log_epoch = arcade_time();
+    }
+    LOG_STORE(&log_stopping, 0);
+#ifdef _WIN32
+    int started = (log_thread = CreateThread(NULL, 0, log_thread_main, NULL, 0, NULL)) != NULL;
+#else
+    int started = pthread_create(&log_thread, NULL, log_thread_main, NULL) == 0;
+#endif
+    if (started && !exit_hooked)
+    {
+        exit_hooked = 1;
+        atexit(log_stop); /* Messages logged after arcade_quit still come out */
+    }
+    LOG_STORE(&log_thread_state, started ? LOG_RUNNING : LOG_DIRECT);
+}
+
+/* Gives the calling thread a ring: one a finished thread left, or a new one */
+static LogRing *log_attach(void)
+{
+    for (LogRing *ring = LOG_FIRST_RING(); ring; ring = ring->next)
+        if (!LOG_LOAD(&ring->owned) && LOG_CAS(&ring->owned, 0, 1))
+            return log_ring = ring;
+    /* From the heap, not the allocator hooks: rings outlive any arena */
+    LogRing *ring = heap_alloc(NULL, sizeof(LogRing), ARCADE_SIMD_ALIGN);
+    if (!ring)
+        return NULL;
+    memset(ring, 0, sizeof(*ring));
+    ring->owned = 1;
+#if defined(_MSC_VER)
+    do
+        ring->next = LOG_FIRST_RING();
+    while (InterlockedCompareExchangePointer((PVOID volatile *)&log_rings, ring, ring->next) != ring->next);
+#else
+    ring->next = LOG_FIRST_RING();
+    while (!__atomic_compare_exchange_n(&log_rings, &ring->next, ring, 0, __ATOMIC_RELEASE, __ATOMIC_ACQUIRE))
+        ;
+#endif
+    return log_ring = ring;
+}
+
+/* Hands the calling thread's ring on to the next thread that logs (its
+ * waiting messages are still written) */
+static void log_detach(void)
+{
+    if (log_ring)
+        LOG_STORE(&log_ring->owned, 0);
+    log_ring = NULL;
+}
+
+void arcade_log(int level, const char *category, const char *format, ...)
+{
+    if (level < log_level || !format)
+        return;
+    int thread_state = LOG_LOAD(&log_thread_state);
+    if (thread_state == LOG_STOPPED)
+    {
+        log_start();
+        thread_state = LOG_LOAD(&log_thread_state);
+    }
+    LogRing *ring = log_ring ? log_ring : log_attach();
+    category = category ? category : "arcade";
+    va_list args;
+    va_start(args, format);
+
+    if (ring && thread_state != LOG_DIRECT)
+    {
+        unsigned int head = ring->head;
+        if (head - LOG_LOAD(&ring->tail) >= LOG_RING_SIZE)
+            LOG_STORE(&ring->dropped, ring->dropped + 1); /* Full: never wait */
+        else
+        {
+            LogEntry *entry = &ring->entries[head & (LOG_RING_SIZE - 1)];
+            entry->stamp = LOG_STAMP();
+            entry->category = category;
+            entry->format = format;
+            entry->level = level;
+            log_pack(entry, args);
+            LOG_STORE(&ring->head, head + 1);
+        }
+    }
+    else
+    {
+        char text[LOG_TEXT_SIZE], line[LOG_TEXT_SIZE + 64];
+        vsnprintf(text, sizeof(text), format, args);
+        fwrite(line, 1, log_format(line, sizeof(line), arcade_time() - log_epoch, level, category, text), stderr);
+    }
+    va_end(args);
+}
+
+void arcade_set_log_level(int level)
+{
+    log_level = level;
+}
+
+void arcade_log_flush(void)
+{
+    while (LOG_LOAD(&log_thread_state) == LOG_RUNNING)
+    {
+        int waiting = 0;
+        for (LogRing *ring = LOG_FIRST_RING(); ring && !waiting; ring = ring->next)
+            waiting = LOG_LOAD(&ring->tail) != LOG_LOAD(&ring->head);
+        if (!waiting)
+            break;
+        arcade_sleep(1);
+    }
+}
+
+#undef LOG_LOAD
+#undef LOG_STORE
+#undef LOG_CAS
+#undef LOG_FIRST_RING
+#undef LOG_STAMP
+#undef LOG_STAMP_COUNTER
+
+/* =========================================================================
+ * Pixel Format Conversion
+ * ========================================================================= */
+/* 4x4 Bayer matrix: thresholds 0-15 spread evenly over every 2x2 and 4x4 block */
+static const uint8_t dither_matrix[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+
+/* One pixel to RGB565; d is its dither threshold (0-15) */
+static inline uint16_t rgb565_pixel(uint32_t color, int d)
+{
+    uint32_t r = ((color >> 16) & 0xFF) + (d >> 1); /* Red and blue lose 3 bits: offset 0-7 */
+    uint32_t g = ((color >> 8) & 0xFF) + (d >> 2);  /* Green loses 2 bits: offset 0-3 */
+    uint32_t b = (color & 0xFF) + (d >> 1);
+    r = r > 0xFF ? 0xFF : r;
+    g = g > 0xFF ? 0xFF : g;
+    b = b > 0xFF ? 0xFF : b;
+    return (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+}
+
+void arcade_convert_rgb565(uint16_t *dst, const uint32_t *src, int count, int x, int y)
+{
+    const uint8_t *row = dither_matrix[y & 3];
+    int i = 0;
+#if defined(ARCADE_SSE2)
+    /* The pattern repeats every 4 pixels, so one offset vector serves the row */
+    uint32_t offsets[4];
+    for (int k = 0; k < 4; k++)
+    {
+        int d = row[(x + k) & 3];
+        offsets[k] = (uint32_t)(d >> 1) << 16 | (uint32_t)(d >> 2) << 8 | (uint32_t)(d >> 1);
+    }
+    const __m128i dither = _mm_loadu_si128((const __m128i *)offsets);
+    const __m128i red = _mm_set1_epi32(0xF800), green = _mm_set1_epi32(0x07E0), blue = _mm_set1_epi32(0x001F);
+    const __m128i bias32 = _mm_set1_epi32(0x8000), bias16 = _mm_set1_epi16((short)0x8000);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i halves[2];
+        for (int h = 0; h < 2; h++)
+        {
+            __m128i p = _mm_adds_epu8(_mm_loadu_si128((const __m128i *)(src + i + h * 4)), dither);
+            __m128i v = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 8), red),
+                                     _mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 5), green),
+                                                  _mm_and_si128(_mm_srli_epi32(p, 3), blue)));
+            halves[h] = _mm_sub_epi32(v, bias32); /* Into signed range so packs does not saturate */
+        }
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_xor_si128(_mm_packs_epi32(halves[0], halves[1]), bias16));
+    }
+#endif
+    for (; i < count; i++)
+        dst[i] = rgb565_pixel(src[i], row[(x + i) & 3]);
+}
+
+#if !defined(ARCADE_HEADLESS) && !defined(_WIN32)
+/* 0xRRGGBB as a pixel value of the window's visual (text, backgrounds) */
+static uint32_t display_color(uint32_t color)
+{
+    return state.format == ARCADE_FORMAT_RGB565 ? rgb565_pixel(color, 0) : color & 0xFFFFFF;
+}
+
+#define RGB565_KEY 0xF81F /* Transparent pixels of 16-bit image copies (magenta) */
+
+/* A 16-bit copy of an image, found again by its pixel pointer */
+typedef struct
+{
+    const uint32_t *pixels; /* Client pixels it was converted from */
+    uint16_t *rgb;          /* RGB565, RGB565_KEY where the image is transparent */
+} Image565;
+
+static Image565 *images_565;                    /* Images converted for 16-bit scenes */
+static int image_565_count, image_565_capacity; /* Used and allocated entries of images_565 */
+static int frame_565;                           /* arcade_present sends the RGB565 frame as drawn */
+static int scene_565;                           /* This frame was drawn by render_scene_565, not in state.pixels */
+
+/*
+ * Returns the RGB565 copy of an image, converting it on first use with the
+ * ordered dither of arcade_convert_rgb565 (by image position, so the pattern
+ * moves with the sprite). Pixels with alpha 0 become RGB565_KEY; in images
+ * that have any, visible ones that would land on it move one step of blue.
+ * Returns NULL if out of memory.
+ */
+static const uint16_t *rgb565_image(const uint32_t *pixels, int width, int height)
+{
+    for (int i = 0; i < image_565_count; i++)
+    {
+        if (images_565[i].pixels == pixels)
+            return images_565[i].rgb;
+    }
+    if (image_565_count == image_565_capacity)
+    {
+        int capacity = image_565_capacity ? image_565_capacity * 2 : 16;
+        Image565 *images = arcade_realloc(images_565, capacity * sizeof(Image565));
+        if (!images)
+            return NULL;
+        images_565 = images;
+        image_565_capacity = capacity;
+    }
+    uint16_t *rgb = arcade_alloc((size_t)width * height * sizeof(uint16_t), ARCADE_SIMD_ALIGN);
+    if (!rgb)
+        return NULL;
+    int keyed = 0;
+    for (size_t i = 0; i < (size_t)width * height && !keyed; i++)
+        keyed = (pixels[i] >> 24) == 0;
+    for (int y = 0; y < height; y++)
+    {
+        const uint32_t *src = pixels + (size_t)y * width;
+        uint16_t *dst = rgb + (size_t)y * width;
+        arcade_convert_rgb565(dst, src, width, 0, y);
+        for (int x = 0; x < width && keyed; x++)
+        {
+            if ((src[x] >> 24) == 0)
+                dst[x] = RGB565_KEY;
+            else if (dst[x] == RGB565_KEY)
+                dst[x] = RGB565_KEY - 1;
+        }
+    }
+    images_565[image_565_count++] = (Image565){pixels, rgb};
+    return rgb;
+}
+
+/* Drops the 16-bit copy of pixels about to be freed (their address may be reused) */
+static void rgb565_forget(const uint32_t *pixels)
+{
+    for (int i = 0; i < image_565_count; i++)
+    {
+        if (images_565[i].pixels == pixels)
+        {
+            arcade_free(images_565[i].rgb);
+            images_565[i] = images_565[--image_565_count];
+            break;
+        }
+    }
+    if (!image_565_count)
+    {
+        arcade_free(images_565);
+        images_565 = NULL;
+        image_565_capacity = 0;
+    }
+}
+#endif
+
+
+/* =========================================================================
+ * Platform-Specific Input Handling (Windows Only)
+ * ========================================================================= */
+#if defined(_WIN32) && !defined(ARCADE_HEADLESS)
+static int arcade_to_vk(unsigned int arcade_key)
+{
+    /* Maps arcade key codes to Windows virtual key codes for input handling */
+    switch (arcade_key)
+    {
+    // Arrow keys
+    case a_up:
+        return VK_UP;    /* Maps to Windows virtual key for up arrow */
+    case a_down:
+        return VK_DOWN;  /* Maps to Windows virtual key for down arrow */
+    case a_left:
+        return VK_LEFT;  /* Maps to Windows virtual key for left arrow */
+    case a_right:
+        return VK_RIGHT; /* Maps to Windows virtual key for right arrow */
+
+    // Letters
+    case a_a:
+        return 'A';
+    case a_b:
+        return 'B';
+    case a_c:
+        return 'C';
+    case a_d:
+        return 'D';
+    case a_e:
+        return 'E';
+    case a_f:
+        return 'F';
+    case a_g:
+        return 'G';
+    case a_h:
+        return 'H';
+    case a_i:
+        return 'I';
+    case a_j:
+        return 'J';
+    case a_k:
+        return 'K';
+    case a_l:
+        return 'L';
+    case a_m:
+        return 'M';
+    case a_n:
+        return 'N';
+    case a_o:
+        return 'O';
+    case a_p:
+        return 'P';
+    case a_q:
+        return 'Q';
+    case a_r:
+        return 'R';
+    case a_s:
+        return 'S';
+    case a_t:
+        return 'T';
+    case a_u:
+        return 'U';
+    case a_v:
+        return 'V';
+    case a_w:
+        return 'W';
+    case a_x:
+        return 'X';
+    case a_y:
+        return 'Y';
+    case a_z:
+        return 'Z';
+
+    // Numbers
+    case a_0:
+        return '0';
+    case a_1:
+        return '1';
+    case a_2:
+        return '2';
+    case a_3:
+        return '3';
+    case a_4:
+        return '4';
+    case a_5:
+        return '5';
+    case a_6:
+        return '6';
+    case a_7:
+        return '7';
+    case a_8:
+        return '8';
+    case a_9:
+        return '9';
+
+    // Punctuation/special character keys (partial support; map to virtual key codes as appropriate)
+    case a_space:
+        return VK_SPACE;
+    case a_enter:
+        return VK_RETURN;
+    case a_tab:
+        return VK_TAB;
+    case a_esc:
+        return VK_ESCAPE;
+    case a_backspace:
+        return VK_BACK;
+    case a_shift:
+        return VK_SHIFT;
+    case a_ctrl:
+        return VK_CONTROL;
+    case a_alt:
+        return VK_MENU;
+    case a_capslock:
+        return VK_CAPITAL;
+
+    default:
+        return 0;
+    }
+}
+
+#endif
+
+/* =========================================================================
+ * Platform-Specific Window Procedure (Windows Only)
+ * ========================================================================= */
+#if defined(_WIN32) && !defined(ARCADE_HEADLESS)
+LRESULT CALLBACK WndProc(HWND hwnd, UINT msg, WPARAM wParam, LPARAM lParam)
+{
+    switch (msg)
+    {
+    case WM_KEYDOWN:
+    {
+        int vk = (int)wParam;
+        if (vk < 256)
+            key_states[vk] = 1;
+        break;
+    }
+    case WM_KEYUP:
+    {
+        int vk = (int)wParam;
+        if (vk < 256)
+            key_states[vk] = 0;
+        break;
+    }
+    case WM_PAINT:
+    {
+        PAINTSTRUCT ps;
+        HDC hdc = BeginPaint(hwnd, &ps);
+        HDC memDC = CreateCompatibleDC(hdc);
+        SelectObject(memDC, state.hbitmap);
+        BitBlt(hdc, 0, 0, state.width, state.height, memDC, 0, 0, SRCCOPY);
+        DeleteDC(memDC);
+        EndPaint(hwnd, &ps);
+        break;
+    }
+    case WM_DESTROY:
+        state.running = 0;
+        PostQuitMessage(0);
+        break;
+    default:
+        return DefWindowProc(hwnd, msg, wParam, lParam);
+    }
+    return 0;
+}
+#endif
+
+/* =========================================================================
+ * Platform-Specific Connection Handling (XCB Only)
+ * ========================================================================= */
+#if defined(ARCADE_XCB) && !defined(ARCADE_HEADLESS)
+/*
+ * Picks up the startup replies that have arrived, without waiting for the
+ * others: the window-close atom (then registered with the window manager),
+ * the keyboard mapping and the font metrics.
+ */
+static void collect_replies(void)
+{
+    xcb_connection_t *c = state.connection;
+    void *reply;
+    xcb_generic_error_t *error;
+
+    if (state.delete_request && xcb_poll_for_reply(c, state.delete_request, &reply, &error))
+    {
+        state.delete_request = 0;
+        if (reply)
+            state.wm_delete = ((xcb_intern_atom_reply_t *)reply)->atom;
+        free(reply);
+        free(error);
+    }
+    if (state.protocols_request && state.wm_delete && xcb_poll_for_reply(c, state.protocols_request, &reply, &error))
+    {
+        state.protocols_request = 0;
+        if (reply)
+            xcb_change_property(c, XCB_PROP_MODE_REPLACE, state.window, ((xcb_intern_atom_reply_t *)reply)->atom,
+                                XCB_ATOM_ATOM, 32, 1, &state.wm_delete);
+        free(reply);
+        free(error);
+    }
+    if (state.keymap_request && xcb_poll_for_reply(c, state.keymap_request, &reply, &error))
+    {
+        state.keymap_request = 0;
+        if (reply)
+        {
+            xcb_get_keyboard_mapping_reply_t *mapping = reply;
+            int count = xcb_get_keyboard_mapping_keysyms_length(mapping);
+            state.keysyms = arcade_alloc((size_t)count * sizeof(xcb_keysym_t), 0);
+            if (state.keysyms)
+            {
+                memcpy(state.keysyms, xcb_get_keyboard_mapping_keysyms(mapping), (size_t)count * sizeof(xcb_keysym_t));
+                state.keysyms_per_keycode = mapping->keysyms_per_keycode;
+            }
+        }
+        free(reply);
+        free(error);
+    }
+    if (state.font_request && xcb_poll_for_reply(c, state.font_request, &reply, &error))
+    {
+        state.font_request = 0;
+        if (reply)
+            state.char_width = ((xcb_query_font_reply_t *)reply)->max_bounds.character_width;
+        free(reply);
+        free(error);
+    }
+}
+
+#define PRESENT_BUFFERS 3 /* Pixmaps cycled through Present (shown, queued, drawing) */
+
+static xcb_extension_t present_extension = {PRESENT_NAME, 0}; /* Opcode looked up by XCB */
+
+/* Present requests, laid out as in presentproto.h (which redefines core X
+ * type names, so only presenttokens.h is included). XCB fills in the first
+ * four bytes. */
+typedef struct
+{
+    uint8_t major, minor;
+    uint16_t length;
+    uint32_t major_version, minor_version;
+} PresentQueryVersionRequest;
+
+typedef struct
+{
+    uint8_t major, minor;
+    uint16_t length;
+    uint32_t eid, window, event_mask;
+} PresentSelectInputRequest;
+
+typedef struct
+{
+    uint8_t major, minor;
+    uint16_t length;
+    uint32_t window, pixmap, serial;
+    uint32_t valid, update;  /* Regions; None = the whole pixmap */
+    int16_t x_off, y_off;
+    uint32_t target_crtc, wait_fence, idle_fence;
+    uint32_t options, pad;
+    uint64_t target_msc, divisor, remainder;
+} PresentPixmapRequest;
+
+/* Sends a Present request; returns its sequence number */
+static unsigned int present_request(void *request, size_t size, uint8_t opcode, int has_reply)
+{
+    struct iovec parts[3]; /* XCB uses the two entries before the request */
+    xcb_protocol_request_t protocol = {1, &present_extension, opcode, (uint8_t)!has_reply};
+    parts[2].iov_base = request;
+    parts[2].iov_len = size;
+    return xcb_send_request(state.connection, 0, parts + 2, &protocol);
+}
+
+/* Updates buffer and timing state from a Present event; others are ignored */
+static void present_event(const xcb_generic_event_t *event)
+{
+    const xcb_query_extension_reply_t *present = xcb_get_extension_data(state.connection, &present_extension);
+    const uint8_t *bytes = (const uint8_t *)event;
+    uint16_t type;
+    if (!present || bytes[1] != present->major_opcode)
+        return;
+    memcpy(&type, bytes + 8, sizeof(type));
+    if (type == PresentCompleteNotify && bytes[11] != PresentCompleteModeSkip)
+    {
+        /* XCB inserts full_sequence at byte 32, so msc moves from 32 to 36 */
+        uint64_t ust, msc;
+        memcpy(&ust, bytes + 24, sizeof(ust));
+        memcpy(&msc, bytes + 36, sizeof(msc));
+        state.present_time = ust / 1e6; /* Microseconds on the monotonic clock */
+        state.present_msc = msc;
+    }
+    else if (type == PresentIdleNotify)
+    {
+        uint32_t pixmap;
+        memcpy(&pixmap, bytes + 24, sizeof(pixmap));
+        for (int i = 0; i < PRESENT_BUFFERS; i++)
+        {
+            if (state.present_pixmaps[i] == pixmap)
+                state.present_busy[i] = 0;
+        }
+    }
+}
+
+/* Unshifted keysym of a keycode, or 0 if the mapping has not arrived */
+static xcb_keysym_t keycode_keysym(xcb_keycode_t keycode)
+{
+    if (!state.keysyms || keycode < state.min_keycode || keycode > state.max_keycode)
+        return 0;
+    return state.keysyms[(keycode - state.min_keycode) * state.keysyms_per_keycode];
+}
+
+/* Handles one event; returns 0 if it closes the window */
+static int handle_event(const xcb_generic_event_t *event)
+{
+    switch (event->response_type & 0x7F)
+    {
+    case XCB_CLIENT_MESSAGE:
+    {
+        const xcb_client_message_event_t *message = (const xcb_client_message_event_t *)event;
+        if (state.wm_delete && message->data.data32[0] == state.wm_delete)
+            return 0;
+        break;
+    }
+    case XCB_KEY_PRESS:
+        key_states[keycode_keysym(((const xcb_key_press_event_t *)event)->detail) & 0xFF] = 1;
+        break;
+    case XCB_KEY_RELEASE:
+        key_states[keycode_keysym(((const xcb_key_release_event_t *)event)->detail) & 0xFF] = 0;
+        break;
+    case XCB_GE_GENERIC:
+        present_event(event);
+        break;
+    }
+    return 1;
+}
+
+/* A TrueColor visual of the screen with that depth (and id, unless 0) */
+static xcb_visualtype_t *find_visual(const xcb_screen_t *screen, uint8_t depth, xcb_visualid_t id)
+{
+    for (xcb_depth_iterator_t d = xcb_screen_allowed_depths_iterator(screen); d.rem; xcb_depth_next(&d))
+    {
+        if (d.data->depth != depth)
+            continue;
+        for (xcb_visualtype_iterator_t v = xcb_depth_visuals_iterator(d.data); v.rem; xcb_visualtype_next(&v))
+        {
+            if (id ? v.data->visual_id == id : v.data->_class == XCB_VISUAL_CLASS_TRUE_COLOR)
+                return v.data;
+        }
+    }
+    return NULL;
+}
+
+/* Sends the frame to a window or pixmap in bands of rows that fit in one
+ * request. At RGB565 that is the 16-bit frame, converted from the pixel
+ * buffer band by band unless a 16-bit scene drew it (frame_565) */
+static void put_frame(xcb_drawable_t target)
+{
+    if (!state.max_request)
+        state.max_request = xcb_get_maximum_request_length(state.connection) * 4; /* Prefetched at init */
+    int rgb565 = state.format == ARCADE_FORMAT_RGB565;
+    size_t row_bytes = rgb565 ? state.display_stride : (size_t)state.width * sizeof(uint32_t);
+    int band = (int)((state.max_request - 64) / row_bytes); /* 64: request header with room to spare */
+    band = band < 1 ? 1 : band;
+    for (int y = 0; y < state.height; y += band)
+    {
+        int rows = state.height - y < band ? state.height - y : band;
+        const uint8_t *data = (const uint8_t *)(state.pixels + (size_t)y * state.width);
+        if (rgb565)
+        {
+            data = (const uint8_t *)state.display_pixels + y * row_bytes;
+            for (int row = y; row < y + rows && !frame_565; row++)
+                arcade_convert_rgb565((uint16_t *)((uint8_t *)state.display_pixels + row * row_bytes),
+                                      state.pixels + (size_t)row * state.width, state.width, 0, row);
+        }
+        xcb_put_image(state.connection, XCB_IMAGE_FORMAT_Z_PIXMAP, target, state.gc, state.width, rows, 0, y, 0,
+                      state.depth, (uint32_t)(rows * row_bytes), data);
+    }
+}
+
+/*
+ * Hands the pending frame to Present for the next vblank. Called once the
+ * frame is complete, text included (arcade_wait_frame, else the next
+ * arcade_update or arcade_present): the server may read or scan out a
+ * presented pixmap until it reports it idle, so nothing is drawn into it
+ * after this.
+ */
+static void present_send(void)
+{
+    if (state.present_pending < 0)
+        return;
+    PresentPixmapRequest request = {0};
+    request.window = state.window;
+    request.pixmap = state.present_pixmaps[state.present_pending];
+    request.serial = ++state.present_serial;
+    request.options = PresentOptionNone;                          /* Wait for vblank: no tearing */
+    request.target_msc = state.present_msc ? state.present_msc + 1 : 0; /* The vblank after the last shown frame */
+    present_request(&request, sizeof(request), X_PresentPixmap, 0);
+    state.present_pending = -1;
+    xcb_flush(state.connection);
+}
+
+/*
+ * Copies the pixel buffer into a free Present pixmap, where text drawn
+ * after arcade_present joins it; present_send shows it. The first
+ * call checks for the extension (prefetched at init) and selects its events.
+ * Returns 1 if Present cannot be used, so the caller draws to the window.
+ */
+static int present_frame(void)
+{
+    xcb_connection_t *c = state.connection;
+    present_send(); /* A frame presented twice without arcade_wait_frame */
+    if (!state.present_started)
+    {
+        const xcb_query_extension_reply_t *present = xcb_get_extension_data(c, &present_extension);
+        if (!present || !present->present)
+        {
+            state.vsync = 0;
+            return 1;
+        }
+        PresentQueryVersionRequest version = {0, 0, 0, PRESENT_MAJOR, PRESENT_MINOR};
+        xcb_discard_reply(c, present_request(&version, sizeof(version), X_PresentQueryVersion, 1));
+        PresentSelectInputRequest select = {0, 0, 0, xcb_generate_id(c), state.window, PresentCompleteNotifyMask | PresentIdleNotifyMask};
+        present_request(&select, sizeof(select), X_PresentSelectInput, 0);
+        state.present_started = 1;
+    }
+
+    /* A pixmap the server is done with; waiting here is the vblank throttle */
+    int buffer = -1;
+    while (buffer < 0)
+    {
+        for (int i = 0; i < PRESENT_BUFFERS && buffer < 0; i++)
+        {
+            if (!state.present_busy[i])
+                buffer = i;
+        }
+        if (buffer >= 0)
+            break;
+        xcb_flush(c);
+        xcb_generic_event_t *event = xcb_wait_for_event(c);
+        if (!event || !handle_event(event))
+            state.running = 0;
+        free(event);
+        if (!state.running)
+            return 0;
+    }
+
+    put_frame(state.present_pixmaps[buffer]);
+    state.present_busy[buffer] = 1;
+    state.present_pending = buffer;
+    xcb_flush(c);
+    return 0;
+}
+#endif
+
+/* =========================================================================
+ * Platform-Specific Rendering (XRender Only)
+ * ========================================================================= */
+#if defined(ARCADE_HAS_XRENDER)
+/* Sets up the server-side frame; returns 0 if XRender can be used */
+static int xrender_init(void)
+{
+    int event_base, error_base;
+    if (!XRenderQueryExtension(state.display, &event_base, &error_base))
+        return 1;
+    XRenderPictFormat *format = XRenderFindVisualFormat(state.display, state.visual);
+    state.argb = XRenderFindStandardFormat(state.display, PictStandardARGB32);
+    if (!format || !state.argb)
+        return 1;
+    state.back = XCreatePixmap(state.display, state.window, state.width, state.height, state.depth);
+    state.back_picture = XRenderCreatePicture(state.display, state.back, format, 0, NULL);
+    state.window_picture = XRenderCreatePicture(state.display, state.window, format, 0, NULL);
+    return 0;
+}
+
+/* Frees one uploaded image */
+static void xrender_free_image(ServerImage *image)
+{
+    state.image_bytes -= image->bytes;
+    XRenderFreePicture(state.display, image->picture);
+    XFreePixmap(state.display, image->pixmap);
+}
+
+/* Releases everything xrender_init and xrender_image created */
+static void xrender_quit(void)
+{
+    for (int i = 0; i < state.image_count; i++)
+        xrender_free_image(&state.images[i]);
+    arcade_free(state.images);
+    state.images = NULL;
+    state.image_count = state.image_capacity = 0;
+    if (state.window_picture)
+        XRenderFreePicture(state.display, state.window_picture);
+    if (state.back_picture)
+        XRenderFreePicture(state.display, state.back_picture);
+    if (state.back)
+        XFreePixmap(state.display, state.back);
+    state.window_picture = state.back_picture = 0;
+    state.back = 0;
+}
+
+/*
+ * Returns the server picture of an image, uploading it on first use. Pixels
+ * with alpha 0 become transparent and all others opaque, as in software
+ * rendering. Returns 0 if the upload fails.
+ */
+static Picture xrender_image(const uint32_t *pixels, int width, int height)
+{
+    for (int i = 0; i < state.image_count; i++)
+    {
+        if (state.images[i].pixels == pixels)
+            return state.images[i].picture;
+    }
+    size_t bytes = (size_t)width * height * sizeof(uint32_t);
+    if (image_cache_budget && state.image_bytes + bytes > image_cache_budget)
+    {
+        /* Over budget: start over, the images still drawn come back as used */
+        for (int i = 0; i < state.image_count; i++)
+            xrender_free_image(&state.images[i]);
+        state.image_count = 0;
+    }
+    if (state.image_count == state.image_capacity)
+    {
+        int capacity = state.image_capacity ? state.image_capacity * 2 : 16;
+        ServerImage *images = arcade_realloc(state.images, capacity * sizeof(ServerImage));
+        if (!images)
+            return 0;
+        state.images = images;
+        state.image_capacity = capacity;
+    }
+
+    /* Premultiplied ARGB with binary alpha */
+    uint32_t *data = arcade_alloc(bytes, ARCADE_SIMD_ALIGN);
+    if (!data)
+        return 0;
+    for (int i = 0; i < width * height; i++)
+        data[i] = (pixels[i] >> 24) ? pixels[i] | 0xFF000000 : 0;
+    XImage *upload = XCreateImage(state.display, NULL, 32, ZPixmap, 0, (char *)data, width, height, 32, 0);
+    if (!upload)
+    {
+        arcade_free(data);
+        return 0;
+    }
+    ServerImage *image = &state.images[state.image_count];
+    image->pixels = pixels;
+    image->bytes = bytes;
+    state.image_bytes += bytes;
+    image->pixmap = XCreatePixmap(state.display, state.window, width, height, 32);
+    GC gc = XCreateGC(state.display, image->pixmap, 0, NULL);
+    XPutImage(state.display, image->pixmap, gc, upload, 0, 0, 0, 0, width, height);
+    XFreeGC(state.display, gc);
+    upload->data = NULL; /* Ours to free, not XDestroyImage's */
+    XDestroyImage(upload);
+    arcade_free(data);
+
+    XRenderPictureAttributes attributes = {0};
+    attributes.repeat = RepeatNormal; /* Layers wrap; sprites never read past their image */
+    image->picture = XRenderCreatePicture(state.display, image->pixmap, state.argb, CPRepeat, &attributes);
+    state.image_count++;
+    return image->picture;
+}
+
+/* Drops the server copy of pixels about to be freed (their address may be reused) */
+static void xrender_forget(const uint32_t *pixels)
+{
+    if (!pixels || backend_active != ARCADE_BACKEND_XRENDER)
+        return;
+    for (int i = 0; i < state.image_count; i++)
+    {
+        if (state.images[i].pixels == pixels)
+        {
+            xrender_free_image(&state.images[i]);
+            state.images[i] = state.images[--state.image_count];
+            return;
+        }
+    }
+}
+#endif
+
+/* =========================================================================
+ * Core Functions
+ * ========================================================================= */
+
+int arcade_init(int window_width, int window_height, const char *window_title, uint32_t bg_color)
+{
+    if (!config_loaded)
+    {
+        /* Per-cabinet settings; a missing default file is fine */
+        const char *path = getenv("ARCADE_CONFIG");
+        if (arcade_load_config(path && *path ? path : "arcade.config.json") == 1 && path && *path)
+            fprintf(stderr, "Cannot read config %s\n", path);
+    }
+#if defined(ARCADE_HEADLESS)
+    (void)window_title; /* No window to name */
+    state.pixels = arcade_alloc((size_t)window_width * window_height * sizeof(uint32_t), ARCADE_SIMD_ALIGN);
+    if (!state.pixels)
+    {
+        fprintf(stderr, "Cannot allocate pixels\n");
+        return 1;
+    }
+    state.width = window_width;
+    state.height = window_height;
+    state.bg_color = bg_color;
+    state.running = 1;
+    for (int i = 0; i < window_width * window_height; i++)
+    {
+        state.pixels[i] = bg_color;
+    }
+#elif defined(_WIN32)
+    /* Set up Windows-specific window class for the game window */
+    WNDCLASS wc = {0};
+    wc.lpfnWndProc = WndProc;                    /* Assign window procedure for event handling */
+    wc.hInstance = GetModuleHandle(NULL);        /* Get current application instance */
+    wc.lpszClassName = "ArcadeWindow";           /* Name of the window class */
+    wc.hCursor = LoadCursor(NULL, IDC_ARROW);    /* Use standard arrow cursor */
+    wc.hbrBackground = (HBRUSH)(COLOR_WINDOW + 1); /* Default window background */
+    RegisterClass(&wc);
+
+    /* Create a non-resizable window with specified dimensions */
+    DWORD style = WS_OVERLAPPEDWINDOW & ~WS_MAXIMIZEBOX & ~WS_THICKFRAME;
+    RECT rect = {0, 0, window_width, window_height};
+    AdjustWindowRect(&rect, style, FALSE);        /* Adjust window size to account for borders */
+    state.hwnd = CreateWindow("ArcadeWindow", window_title, style,
+                              CW_USEDEFAULT, CW_USEDEFAULT,
+                              rect.right - rect.left, rect.bottom - rect.top,
+                              NULL, NULL, wc.hInstance, NULL);
+    if (!state.hwnd)
+    {
+        fprintf(stderr, "Cannot create window\n");
+        return 1;                                /* Return error code on failure */
+    }
+    ShowWindow(state.hwnd, SW_SHOW);             /* Display the window */
+    UpdateWindow(state.hwnd);                    /* Force initial window update */
+
+    state.hdc = GetDC(state.hwnd);
+    state.width = window_width;
+    state.height = window_height;
+    state.bg_color = bg_color;
+    state.running = 1;
+
+    BITMAPINFO bmi = {0};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = window_width;
+    bmi.bmiHeader.biHeight = -window_height;
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+    state.hbitmap = CreateDIBSection(state.hdc, &bmi, DIB_RGB_COLORS, (void **)&state.pixels, NULL, 0);
+    if (!state.hbitmap || !state.pixels)
+    {
+        ReleaseDC(state.hwnd, state.hdc);
+        DestroyWindow(state.hwnd);
+        fprintf(stderr, "Cannot create bitmap\n");
+        return 1;
+    }
+
+    for (int i = 0; i < window_width * window_height; i++)
+    {
+        state.pixels[i] = bg_color;
+    }
+
+    state.hfont = CreateFont(15, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
+                             ANSI_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
+                             DEFAULT_QUALITY, FIXED_PITCH | FF_MODERN, "Courier New");
+    if (!state.hfont)
+    {
+        DeleteObject(state.hbitmap);
+        ReleaseDC(state.hwnd, state.hdc);
+        DestroyWindow(state.hwnd);
+        fprintf(stderr, "Cannot create font\n");
+        return 1;
+    }
+#elif defined(ARCADE_XCB)
+    /* Every request below is queued and sent in one go; replies are picked
+     * up later by collect_replies as they arrive */
+    int screen_number;
+    xcb_connection_t *c = xcb_connect(NULL, &screen_number);
+    if (xcb_connection_has_error(c))
+    {
+        xcb_disconnect(c);
+        fprintf(stderr, "Cannot open display\n");
+        return 1;
+    }
+    const xcb_setup_t *setup = xcb_get_setup(c);
+    xcb_screen_iterator_t screens = xcb_setup_roots_iterator(setup);
+    for (; screen_number > 0 && screens.rem > 1; screen_number--)
+        xcb_screen_next(&screens);
+    xcb_screen_t *screen = screens.data;
+
+    state.pixels = arcade_alloc((size_t)window_width * window_height * sizeof(uint32_t), ARCADE_SIMD_ALIGN);
+    if (!state.pixels)
+    {
+        xcb_disconnect(c);
+        fprintf(stderr, "Cannot allocate pixels\n");
+        return 1;
+    }
+    /* The root visual, or one of the depth asked for */
+    xcb_visualtype_t *visual = find_visual(screen, screen->root_depth, screen->root_visual);
+    uint8_t depth = screen->root_depth;
+    uint8_t wanted = format_requested == ARCADE_FORMAT_RGB565 ? 16 : format_requested == ARCADE_FORMAT_XRGB8888 ? 24 : 0;
+    if (wanted && wanted != depth && find_visual(screen, wanted, 0))
+    {
+        visual = find_visual(screen, wanted, 0);
+        depth = wanted;
+    }
+    state.format = depth == 16 && visual && visual->red_mask == 0xF800 && visual->green_mask == 0x07E0 && visual->blue_mask == 0x001F
+                       ? ARCADE_FORMAT_RGB565
+                       : ARCADE_FORMAT_XRGB8888;
+    if (state.format == ARCADE_FORMAT_RGB565)
+    {
+        state.display_stride = ((size_t)window_width * sizeof(uint16_t) + 3) & ~(size_t)3; /* Rows pad to 32 bits */
+        state.display_pixels = arcade_alloc(state.display_stride * window_height, ARCADE_SIMD_ALIGN);
+        if (!state.display_pixels)
+        {
+            arcade_free(state.pixels);
+            state.pixels = NULL;
+            xcb_disconnect(c);
+            fprintf(stderr, "Cannot allocate pixels\n");
+            return 1;
+        }
+    }
+    state.connection = c;
+    state.width = window_width;
+    state.height = window_height;
+    state.bg_color = bg_color;
+    state.depth = depth;
+    state.min_keycode = setup->min_keycode;
+    state.max_keycode = setup->max_keycode;
+    state.running = 1;
+
+    xcb_prefetch_maximum_request_length(c);
+    state.protocols_request = xcb_intern_atom(c, 0, strlen("WM_PROTOCOLS"), "WM_PROTOCOLS").sequence;
+    state.delete_request = xcb_intern_atom(c, 0, strlen("WM_DELETE_WINDOW"), "WM_DELETE_WINDOW").sequence;
+    state.keymap_request = xcb_get_keyboard_mapping(c, setup->min_keycode, setup->max_keycode - setup->min_keycode + 1).sequence;
+
+    state.window = xcb_generate_id(c);
+    xcb_visualid_t visual_id = visual && depth != screen->root_depth ? visual->visual_id : screen->root_visual;
+    uint32_t window_values[] = {screen->white_pixel, screen->black_pixel,
+                                XCB_EVENT_MASK_EXPOSURE | XCB_EVENT_MASK_KEY_PRESS | XCB_EVENT_MASK_KEY_RELEASE | XCB_EVENT_MASK_STRUCTURE_NOTIFY, 0};
+    uint32_t window_mask = XCB_CW_BACK_PIXEL | XCB_CW_BORDER_PIXEL | XCB_CW_EVENT_MASK;
+    if (visual_id != screen->root_visual)
+    {
+        /* Another depth needs its own colormap, and the screen's pixel
+         * values do not apply */
+        state.colormap = xcb_generate_id(c);
+        xcb_create_colormap(c, XCB_COLORMAP_ALLOC_NONE, state.colormap, screen->root, visual_id);
+        window_values[0] = display_color(0xFFFFFF);
+        window_values[1] = 0;
+        window_values[3] = state.colormap;
+        window_mask |= XCB_CW_COLORMAP;
+    }
+    xcb_create_window(c, depth, state.window, screen->root, 100, 100, window_width, window_height, 1,
+                      XCB_WINDOW_CLASS_INPUT_OUTPUT, visual_id, window_mask, window_values);
+    xcb_change_property(c, XCB_PROP_MODE_REPLACE, state.window, XCB_ATOM_WM_NAME, XCB_ATOM_STRING, 8,
+                        strlen(window_title), window_title);
+
+    state.font = xcb_generate_id(c);
+    xcb_open_font(c, state.font, strlen("9x15"), "9x15");
+    state.font_request = xcb_query_font(c, state.font).sequence;
+    state.gc = xcb_generate_id(c);
+    uint32_t gc_values[] = {0xFFFFFF, state.font, 0}; /* White text, no exposure events from uploads */
+    xcb_create_gc(c, state.gc, state.window, XCB_GC_FOREGROUND | XCB_GC_FONT | XCB_GC_GRAPHICS_EXPOSURES, gc_values);
+    state.present_pending = -1;
+    if (vsync_requested)
+    {
+        xcb_prefetch_extension_data(c, &present_extension);
+        for (int i = 0; i < PRESENT_BUFFERS; i++)
+        {
+            state.present_pixmaps[i] = xcb_generate_id(c);
+            xcb_create_pixmap(c, state.depth, state.present_pixmaps[i], state.window, window_width, window_height);
+        }
+        state.vsync = 1; /* Until the first arcade_present finds no Present extension */
+    }
+    xcb_map_window(c, state.window);
+    xcb_flush(c);
+
+    for (int i = 0; i < state.width * state.height; i++)
+    {
+        state.pixels[i] = bg_color;
+    }
+#else
+    state.display = XOpenDisplay(NULL);
+    if (!state.display)
+    {
+        fprintf(stderr, "Cannot open display\n");
+        return 1;
+    }
+
+    state.screen = DefaultScreen(state.display);
+    state.visual = DefaultVisual(state.display, state.screen);
+    state.depth = DefaultDepth(state.display, state.screen);
+    int wanted = format_requested == ARCADE_FORMAT_RGB565 ? 16 : format_requested == ARCADE_FORMAT_XRGB8888 ? 24 : 0;
+    XVisualInfo info;
+    if (wanted && wanted != state.depth && XMatchVisualInfo(state.display, state.screen, wanted, TrueColor, &info))
+    {
+        state.visual = info.visual;
+        state.depth = wanted;
+    }
+    state.format = state.depth == 16 && state.visual->red_mask == 0xF800 && state.visual->green_mask == 0x07E0 &&
+                           state.visual->blue_mask == 0x001F
+                       ? ARCADE_FORMAT_RGB565
+                       : ARCADE_FORMAT_XRGB8888;
+    if (state.visual == DefaultVisual(state.display, state.screen))
+    {
+        state.window = XCreateSimpleWindow(state.display, RootWindow(state.display, state.screen),
+                                           100, 100, window_width, window_height, 1,
+                                           BlackPixel(state.display, state.screen),
+                                           WhitePixel(state.display, state.screen));
+    }
+    else
+    {
+        /* Another depth needs its own colormap, and the screen's pixel
+         * values do not apply */
+        XSetWindowAttributes attributes = {0};
+        state.colormap = XCreateColormap(state.display, RootWindow(state.display, state.screen), state.visual, AllocNone);
+        attributes.colormap = state.colormap;
+        attributes.background_pixel = display_color(0xFFFFFF);
+        attributes.border_pixel = 0;
+        state.window = XCreateWindow(state.display, RootWindow(state.display, state.screen), 100, 100,
+                                     window_width, window_height, 1, state.depth, InputOutput, state.visual,
+                                     CWColormap | CWBackPixel | CWBorderPixel, &attributes);
+    }
+    XStoreName(state.display, state.window, window_title);
+    XSelectInput(state.display, state.window, ExposureMask | KeyPressMask | KeyReleaseMask | StructureNotifyMask);
+    state.wm_delete = XInternAtom(state.display, "WM_DELETE_WINDOW", False);
+    XSetWMProtocols(state.display, state.window, &state.wm_delete, 1);
+    XMapWindow(state.display, state.window);
+
+    state.pixels = arcade_alloc((size_t)window_width * window_height * sizeof(uint32_t), ARCADE_SIMD_ALIGN);
+    if (!state.pixels)
+    {
+        XCloseDisplay(state.display);
+        fprintf(stderr, "Cannot allocate pixels\n");
+        return 1;
+    }
+    state.width = window_width;
+    state.height = window_height;
+    state.bg_color = bg_color;
+    state.running = 1;
+
+    state.font = XLoadQueryFont(state.display, "9x15");
+    if (!state.font)
+    {
+        fprintf(stderr, "Cannot load font 9x15\n");
+        XCloseDisplay(state.display);
+        arcade_free(state.pixels);
+        return 1;
+    }
+
+    if (state.format == ARCADE_FORMAT_RGB565)
+    {
+        /* The image holds the converted copy; arcade_present fills it */
+        int stride = (window_width * 2 + 3) & ~3; /* Rows pad to 32 bits */
+        char *data = arcade_alloc((size_t)stride * window_height, ARCADE_SIMD_ALIGN);
+        state.image = data ? XCreateImage(state.display, state.visual, 16, ZPixmap, 0, data, window_width, window_height, 32, stride)
+                           : NULL;
+        if (!state.image)
+            arcade_free(data);
+    }
+    else
+    {
+        state.image = XCreateImage(state.display, state.visual, state.depth, ZPixmap, 0,
+                                   (char *)state.pixels, window_width, window_height, 32, 0);
+    }
+    if (!state.image)
+    {
+        arcade_free(state.pixels);
+        XCloseDisplay(state.display);
+        fprintf(stderr, "Cannot create XImage\n");
+        return 1;
+    }
+
+    state.gc = XCreateGC(state.display, state.window, 0, NULL);
+    if (!state.gc)
+    {
+        if (state.image->data != (char *)state.pixels)
+            arcade_free(state.image->data);
+        state.image->data = NULL; /* Ours to free, not XDestroyImage's */
+        XDestroyImage(state.image);
+        arcade_free(state.pixels);
+        XCloseDisplay(state.display);
+        fprintf(stderr, "Cannot create GC\n");
+        return 1;
+    }
+
+    for (int i = 0; i < state.width * state.height; i++)
+    {
+        state.pixels[i] = bg_color;
+    }
+
+#if defined(ARCADE_HAS_XRENDER)
+    if (backend_requested == ARCADE_BACKEND_XRENDER)
+    {
+        if (xrender_init() == 0)
+            backend_active = ARCADE_BACKEND_XRENDER;
+        else
+        {
+            xrender_quit();
+            fprintf(stderr, "XRender not available, rendering in software\n");
+        }
+    }
+#endif
+#endif
+    return 0;
+}
+
+int arcade_resize(int window_width, int window_height, const char *window_title, uint32_t bg_color)
+{
+#if defined(ARCADE_HEADLESS)
+    (void)window_title;
+    uint32_t *pixels = arcade_alloc((size_t)window_width * window_height * sizeof(uint32_t), ARCADE_SIMD_ALIGN);
+    if (!pixels)
+        return 1;
+    arcade_free(state.pixels);
+    state.pixels = pixels;
+#elif defined(_WIN32)
+    if (!state.hwnd)
+        return 1;
+    BITMAPINFO bmi = {0};
+    bmi.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    bmi.bmiHeader.biWidth = window_width;
+    bmi.bmiHeader.biHeight = -window_height;
+    bmi.bmiHeader.biPlanes = 1;
+    bmi.bmiHeader.biBitCount = 32;
+    bmi.bmiHeader.biCompression = BI_RGB;
+    uint32_t *pixels = NULL;
+    HBITMAP bitmap = CreateDIBSection(state.hdc, &bmi, DIB_RGB_COLORS, (void **)&pixels, NULL, 0);
+    if (!bitmap || !pixels)
+    {
+        if (bitmap)
+            DeleteObject(bitmap);
+        return 1;
+    }
+    DeleteObject(state.hbitmap);
+    state.hbitmap = bitmap;
+    state.pixels = pixels;
+
+    RECT rect = {0, 0, window_width, window_height};
+    AdjustWindowRect(&rect, (DWORD)GetWindowLongPtr(state.hwnd, GWL_STYLE), FALSE);
+    SetWindowPos(state.hwnd, NULL, 0, 0, rect.right - rect.left, rect.bottom - rect.top, SWP_NOMOVE | SWP_NOZORDER);
+    SetWindowText(state.hwnd, window_title);
+#elif defined(ARCADE_XCB)
+    if (!state.connection)
+        return 1;
+    xcb_connection_t *c = state.connection;
+    uint32_t *pixels = arcade_alloc((size_t)window_width * window_height * sizeof(uint32_t), ARCADE_SIMD_ALIGN);
+    uint16_t *display_pixels = NULL;
+    size_t display_stride = ((size_t)window_width * sizeof(uint16_t) + 3) & ~(size_t)3; /* Rows pad to 32 bits */
+    if (pixels && state.format == ARCADE_FORMAT_RGB565)
+        display_pixels = arcade_alloc(display_stride * window_height, ARCADE_SIMD_ALIGN);
+    if (!pixels || (state.format == ARCADE_FORMAT_RGB565 && !display_pixels))
+    {
+        arcade_free(pixels);
+        return 1;
+    }
+    arcade_free(state.pixels);
+    arcade_free(state.display_pixels);
+    state.pixels = pixels;
+    state.display_pixels = display_pixels;
+    state.display_stride = display_pixels ? display_stride : 0;
+
+    /* Frames still queued keep their old pixmaps alive on the server; idle
+     * events for them no longer match and are ignored */
+    for (int i = 0; i < PRESENT_BUFFERS && state.present_pixmaps[i]; i++)
+    {
+        xcb_free_pixmap(c, state.present_pixmaps[i]);
+        state.present_pixmaps[i] = xcb_generate_id(c);
+        xcb_create_pixmap(c, state.depth, state.present_pixmaps[i], state.window, window_width, window_height);
+        state.present_busy[i] = 0;
+    }
+    state.present_pending = -1;
+    uint32_t size[] = {(uint32_t)window_width, (uint32_t)window_height};
+    xcb_configure_window(c, state.window, XCB_CONFIG_WINDOW_WIDTH | XCB_CONFIG_WINDOW_HEIGHT, size);
+    xcb_change_property(c, XCB_PROP_MODE_REPLACE, state.window, XCB_ATOM_WM_NAME, XCB_ATOM_STRING, 8,
+                        strlen(window_title), window_title);
+    xcb_flush(c);
+#else
+    if (!state.display)
+        return 1;
+    uint32_t *pixels = arcade_alloc((size_t)window_width * window_height * sizeof(uint32_t), ARCADE_SIMD_ALIGN);
+    if (!pixels)
+        return 1;
+    XImage *image;
+    if (state.format == ARCADE_FORMAT_RGB565)
+    {
+        int stride = (window_width * 2 + 3) & ~3; /* Rows pad to 32 bits */
+        char *data = arcade_alloc((size_t)stride * window_height, ARCADE_SIMD_ALIGN);
+        image = data ? XCreateImage(state.display, state.visual, 16, ZPixmap, 0, data, window_width, window_height, 32, stride)
+                     : NULL;
+        if (!image)
+            arcade_free(data);
+    }
+    else
+    {
+        image = XCreateImage(state.display, state.visual, state.depth, ZPixmap, 0,
+                             (char *)pixels, window_width, window_height, 32, 0);
+    }
+    if (!image)
+    {
+        arcade_free(pixels);
+        return 1;
+    }
+    if (state.image->data != (char *)state.pixels)
+        arcade_free(state.image->data); /* The RGB565 copy */
+    state.image->data = NULL;           /* Ours to free, not XDestroyImage's */
+    XDestroyImage(state.image);
+    arcade_free(state.pixels);
+    state.image = image;
+    state.pixels = pixels;
+
+#if defined(ARCADE_HAS_XRENDER)
+    if (backend_active == ARCADE_BACKEND_XRENDER)
+    {
+        /* Uploaded images stay; only the frame they are composited into changes size */
+        XRenderFreePicture(state.display, state.back_picture);
+        XFreePixmap(state.display, state.back);
+        state.back = XCreatePixmap(state.display, state.window, window_width, window_height, state.depth);
+        state.back_picture = XRenderCreatePicture(state.display, state.back,
+                                                  XRenderFindVisualFormat(state.display, state.visual), 0, NULL);
+    }
+#endif
+    XResizeWindow(state.display, state.window, window_width, window_height);
+    XStoreName(state.display, state.window, window_title);
+    XFlush(state.display);
+#endif
+    state.width = window_width;
+    state.height = window_height;
+    state.bg_color = bg_color;
+    for (int i = 0; i < window_width * window_height; i++)
+    {
+        state.pixels[i] = bg_color;
+    }
+    return 0;
+}
+
+void arcade_set_backend(int backend)
+{
+    backend_requested = backend;
+}
+
+int arcade_backend(void)
+{
+    return backend_active;
+}
+
+void arcade_set_vsync(int enable)
+{
+    vsync_requested = enable;
+}
+
+int arcade_vsync(void)
+{
+#if defined(ARCADE_XCB) && !defined(ARCADE_HEADLESS)
+    return state.vsync;
+#else
+    return 0;
+#endif
+}
+
+double arcade_present_time(void)
+{
+#if defined(ARCADE_XCB) && !defined(ARCADE_HEADLESS)
+    return state.vsync ? state.present_time : 0.0;
+#else
+    return 0.0;
+#endif
+}
+
+void arcade_set_pixel_format(int format)
+{
+    format_requested = format;
+}
+
+int arcade_pixel_format(void)
+{
+#if defined(ARCADE_HEADLESS) || defined(_WIN32)
+    return ARCADE_FORMAT_XRGB8888;
+#else
+    return state.format ? state.format : ARCADE_FORMAT_XRGB8888;
+#endif
+}
+
+void arcade_quit(void)
+{
+    log_stop(); /* Everything logged is out before the reports below */
+    arcade_arena_free(&frame_arena);
+    arcade_clear_asset_cache(); /* Images still in use stay for their sprites */
+    if (pass_pool_state == 1)
+        arcade_pool_free(&pass_pool);
+    pass_pool_state = 0;
+    if (frame_profile.enabled && frame_profile.frames)
+    {
+        double average = frame_profile.total / frame_profile.frames;
+        fprintf(stderr, "arcade: %ld frames, %.2f ms average (%.1f FPS), %.2f ms worst\n",
+                frame_profile.frames, average * 1000.0, 1.0 / average, frame_profile.worst * 1000.0);
+        frame_profile.frames = 0;
+        frame_profile.total = frame_profile.worst = frame_profile.last = 0.0;
+    }
+#if defined(ARCADE_HEADLESS)
+    arcade_free(state.pixels);
+    state.pixels = NULL;
+#elif defined(_WIN32)
+    if (state.hfont)
+    {
+        DeleteObject(state.hfont);
+        state.hfont = NULL;
+    }
+    if (state.hbitmap)
+    {
+        DeleteObject(state.hbitmap);
+        state.hbitmap = NULL;
+        state.pixels = NULL;
+    }
+    if (state.hdc)
+    {
+        ReleaseDC(state.hwnd, state.hdc);
+        state.hdc = NULL;
+    }
+    if (state.hwnd)
+    {
+        DestroyWindow(state.hwnd);
+        state.hwnd = NULL;
+    }
+#elif defined(ARCADE_XCB)
+    if (state.connection)
+    {
+        unsigned int *requests[] = {&state.protocols_request, &state.delete_request, &state.keymap_request, &state.font_request};
+        for (int i = 0; i < 4; i++)
+        {
+            if (*requests[i])
+                xcb_discard_reply(state.connection, *requests[i]);
+            *requests[i] = 0;
+        }
+        for (int i = 0; i < PRESENT_BUFFERS; i++)
+        {
+            if (state.present_pixmaps[i])
+                xcb_free_pixmap(state.connection, state.present_pixmaps[i]);
+            state.present_pixmaps[i] = 0;
+            state.present_busy[i] = 0;
+        }
+        state.present_pending = -1;
+        xcb_free_gc(state.connection, state.gc);
+        xcb_close_font(state.connection, state.font);
+        xcb_destroy_window(state.connection, state.window);
+        if (state.colormap)
+            xcb_free_colormap(state.connection, state.colormap);
+        state.colormap = 0;
+        xcb_disconnect(state.connection); /* Flushes the requests above */
+        state.connection = NULL;
+    }
+    arcade_free(state.keysyms);
+    state.keysyms = NULL;
+    arcade_free(state.pixels);
+    state.pixels = NULL;
+    arcade_free(state.display_pixels);
+    state.display_pixels = NULL;
+    state.wm_delete = 0;
+    state.char_width = 0;
+    state.max_request = 0;
+    state.vsync = state.present_started = 0;
+    state.present_msc = 0;
+    state.present_time = 0.0;
+#else
+#if defined(ARCADE_HAS_XRENDER)
+    if (state.display)
+        xrender_quit();
+    backend_active = ARCADE_BACKEND_SOFTWARE;
+#endif
+    if (state.font)
+    {
+        XFreeFont(state.display, state.font);
+        state.font = NULL;
+    }
+    if (state.image)
+    {
+        if (state.image->data != (char *)state.pixels)
+            arcade_free(state.image->data); /* The RGB565 copy */
+        state.image->data = NULL;           /* Ours to free, not XDestroyImage's */
+        XDestroyImage(state.image);
+        state.image = NULL;
+    }
+    arcade_free(state.pixels);
+    state.pixels = NULL;
+    if (state.gc)
+    {
+        XFreeGC(state.display, state.gc);
+        state.gc = NULL;
+    }
+    if (state.display && state.window)
+    {
+        XDestroyWindow(state.display, state.window);
+        state.window = 0;
+    }
+    if (state.display && state.colormap)
+    {
+        XFreeColormap(state.display, state.colormap);
+        state.colormap = 0;
+    }
+    if (state.display)
+    {
+        XCloseDisplay(state.display);
+        state.display = NULL;
+    }
+#endif
+}
+
+int arcade_update(void)
+{
+    arcade_arena_reset(&frame_arena); /* Last tick's scratch */
+#if defined(ARCADE_HAS_XRENDER)
+    state.server_frame = 0; /* Until xrender_scene composites the next one */
+#endif
+#if !defined(ARCADE_HEADLESS) && !defined(_WIN32)
+    scene_565 = 0;
+#endif
+    if (frame_profile.enabled)
+    {
+        double now = arcade_time();
+        if (frame_profile.last > 0.0)
+        {
+            double frame = now - frame_profile.last;
+            frame_profile.frames++;
+            frame_profile.total += frame;
+            frame_profile.worst = frame > frame_profile.worst ? frame : frame_profile.worst;
+        }
+        frame_profile.last = now;
+    }
+#if defined(ARCADE_HEADLESS)
+    /* No window events; the caller decides when to stop */
+#elif defined(_WIN32)
+    MSG msg;
+    while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+    {
+        if (msg.message == WM_QUIT)
+        {
+            state.running = 0;
+            return 0;
+        }
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+    }
+#elif defined(ARCADE_XCB)
+    present_send(); /* Last frame, if the game does not call arcade_wait_frame */
+    collect_replies();
+    /* One read takes whatever has arrived; the rest come from the queue */
+    xcb_generic_event_t *event = xcb_poll_for_event(state.connection);
+    while (event)
+    {
+        int open = handle_event(event);
+        free(event);
+        if (!open)
+        {
+            state.running = 0;
+            return 0;
+        }
+        event = xcb_poll_for_queued_event(state.connection);
+    }
+    if (xcb_connection_has_error(state.connection))
+    {
+        state.running = 0; /* Server gone */
+        return 0;
+    }
+#else
+    XEvent event;
+    while (XPending(state.display))
+    {
+        XNextEvent(state.display, &event);
+        if (event.type == ClientMessage && event.xclient.data.l[0] == state.wm_delete)
+        {
+            state.running = 0;
+            return 0;
+        }
+        else if (event.type == KeyPress)
+        {
+            KeySym keysym = XLookupKeysym(&event.xkey, 0);
+            key_states[keysym & 0xFF] = 1;
+        }
+        else if (event.type == KeyRelease)
+        {
+            KeySym keysym = XLookupKeysym(&event.xkey, 0);
+            key_states[keysym & 0xFF] = 0;
+        }
+    }
+#endif
+    global_frame_counter++;
+    return 1;
+}
+
+int arcade_running(void)
+{
+    return state.running;
+}
+
+void arcade_set_running(int value)
+{
+    state.running = value;
+}
+
+void arcade_sleep(unsigned int milliseconds)
+{
+#ifdef _WIN32
+    Sleep(milliseconds);
+#else
+    usleep(milliseconds * 1000); /* Convert ms to microseconds */
+#endif
+}
+
+double arcade_time(void)
+{
+    double current_time = 0.0;
+
+#ifdef _WIN32
+    /* Use high-resolution performance counter for precise timing on Windows */
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);        /* Get ticks per second */
+    QueryPerformanceCounter(&counter);            /* Get current tick count */
+    current_time = (double)counter.QuadPart / frequency.QuadPart;
+#else
+    struct timespec ts;
+    int clock_result = -1;
+#ifdef CLOCK_MONOTONIC
+    /* Prefer CLOCK_MONOTONIC for consistent timing (not affected by system clock changes) */
+    clock_result = clock_gettime(CLOCK_MONOTONIC, &ts);
+    if (clock_result == 0)
+    {
+        current_time = (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+    }
+#else
+#ifdef CLOCK_REALTIME
+    /* Fallback to CLOCK_REALTIME (less reliable due to system clock adjustments) */
+    clock_result = clock_gettime(CLOCK_REALTIME, &ts);
+    if (clock_result == 0)
+    {
+        current_time = (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+        fprintf(stderr, "Warning: Using CLOCK_REALTIME (less reliable for timing)\n");
+    }
+#else
+    /* Fallback to gettimeofday if no POSIX clocks are available */
+    fprintf(stderr, "Warning: No POSIX clocks available, falling back to gettimeofday\n");
+    struct timeval tv;
+    if (gettimeofday(&tv, NULL) == 0)
+    {
+        current_time = (double)tv.tv_sec + (double)tv.tv_usec / 1e6;
+    }
+    else
+    {
+        fprintf(stderr, "Error: gettimeofday failed\n");
+        current_time = 0.0;
+    }
+#endif
+#endif
+    if (clock_result != 0 && current_time == 0.0)
+    {
+        fprintf(stderr, "Warning: clock_gettime failed, falling back to gettimeofday\n");
+        struct timeval tv;
+        if (gettimeofday(&tv, NULL) == 0)
+        {
+            current_time = (double)tv.tv_sec + (double)tv.tv_usec / 1e6;
+        }
+        else
+        {
+            fprintf(stderr, "Error: gettimeofday failed\n");
+            current_time = 0.0;
+        }
+    }
+#endif
+
+    return current_time;
+}
+
+float arcade_delta_time(void)
+{
+    static double last_time = 0.0;                   /* Store time of the last frame */
+    static int last_vsync = 0;                       /* Clock the last call read */
+    double current_time = arcade_time();             /* Current frame time */
+    float delta_time;
+
+    /* With vsync, time moves in steps of the frames that reached the screen */
+    int vsync = arcade_present_time() > 0.0;
+    if (vsync)
+        current_time = arcade_present_time();
+    if (vsync != last_vsync)
+    {
+        last_vsync = vsync;
+        last_time = 0.0; /* The two clocks are not comparable; start over */
+    }
+
+    /* If first call or invalid time, initialize last_time and return 0 */
+    if (last_time == 0.0 || current_time == 0.0)
+    {
+        last_time = current_time;
+        return 0.0f;
+    }
+
+    /* Calculate delta time and update last_time */
+    delta_time = (float)(current_time - last_time);
+    last_time = current_time;
+
+    /* Clamp delta_time to avoid large jumps (e.g., during lag) */
+    if (delta_time > 0.1f)
+        delta_time = 0.1f;
+    if (delta_time < 0.0f)
+        delta_time = 0.0f;
+
+    return delta_time;
+}
+
+int arcade_run_game(const ArcadeGame *game)
+{
+    if (!game || arcade_init(game->width, game->height, game->name, game->bg_color) != 0)
+    {
+        fprintf(stderr, "Initialization failed\n");
+        return 1;
+    }
+    if (game->init && game->init() != 0)
+    {
+        if (game->shutdown)
+            game->shutdown(); /* Frees whatever init got to */
+        arcade_quit();
+        return 1;
+    }
+    while (arcade_running() && arcade_update() && game->update())
+        arcade_wait_frame();
+    if (game->shutdown)
+        game->shutdown();
+    arcade_quit();
+    return 0;
+}
+
+/* =========================================================================
+ * Input Handling
+ * ========================================================================= */
+
+int arcade_key_pressed(unsigned int key_val)
+{
+#if defined(_WIN32) && !defined(ARCADE_HEADLESS)
+    int vk = arcade_to_vk(key_val);
+    return key_states[vk] ? 2 : 0;
+#else
+    return key_states[key_val & 0xFF] ? 2 : 0;
+#endif
+}
+
+int arcade_key_pressed_once(unsigned int key_val)
+{
+#if defined(_WIN32) && !defined(ARCADE_HEADLESS)
+    int vk = arcade_to_vk(key_val);
+    int current = key_states[vk];
+    int last = last_key_states[vk];
+    last_key_states[vk] = current;
+    return current == 1 && last == 0 ? 2 : 0;
+#else
+    int key = key_val & 0xFF;
+    int current = key_states[key];
+    int last = last_key_states[key];
+    last_key_states[key] = current;
+    return current == 1 && last == 0 ? 2 : 0;
+#endif
+}
+
+void arcade_clear_keys(void)
+{
+    memset(key_states, 0, sizeof(key_states));
+    memset(last_key_states, 0, sizeof(last_key_states));
+}
+
+/* =========================================================================
+ * Sprite Management
+ * ========================================================================= */
+
+static void move_sprite(ArcadeSprite *sprite, float gravity, int window_height)
+{
+    if (!sprite || !sprite->active)
+        return;
+    sprite->vy += gravity;
+    sprite->y += sprite->vy;
+    sprite->x += sprite->vx;
+    if (sprite->y < 0.0f)
+    {
+        sprite->y = 0.0f;
+        sprite->vy = 0.0f;
+    }
+    if (sprite->y > window_height - sprite->height)
+    {
+        sprite->y = window_height - sprite->height;
+        sprite->vy = 0.0f;
+    }
+}
+
+void arcade_move_sprite(ArcadeSprite *sprite, float gravity, int window_height)
+{
+    if (sprite)
+        move_sprite(sprite, gravity, window_height);
+}
+
+void arcade_move_image_sprite(ArcadeImageSprite *sprite, float gravity, int window_height)
+{
+    if (!sprite || !sprite->active)
+        return;
+    sprite->vy += gravity;
+    sprite->y += sprite->vy;
+    sprite->x += sprite->vx;
+    if (sprite->y < 0.0f)
+    {
+        sprite->y = 0.0f;
+        sprite->vy = 0.0f;
+    }
+    if (sprite->y > window_height - sprite->height)
+    {
+        sprite->y = window_height - sprite->height;
+        sprite->vy = 0.0f;
+    }
+}
+
+static int check_collision(const ArcadeSprite *a, const ArcadeSprite *b)
+{
+    if (!a || !b || !a->active || !b->active)
+        return 0;
+    return (a->x < b->x + b->width &&
+            a->x + a->width > b->x &&
+            a->y < b->y + b->height &&
+            a->y + a->height > b->y);
+}
+
+int arcade_check_collision(ArcadeSprite *a, ArcadeSprite *b)
+{
+    if (!a || !b)
+        return 0;
+    return check_collision(a, b);
+}
+
+int arcade_check_image_collision(ArcadeImageSprite *a, ArcadeImageSprite *b)
+{
+    if (!a || !b || !a->active || !b->active)
+        return 0;
+    return (a->x < b->x + b->width &&
+            a->x + a->width > b->x &&
+            a->y < b->y + b->height &&
+            a->y + a->height > b->y);
+}
+
+/* QOI ("Quite OK Image", qoiformat.org): a 14-byte header, then one op
+ * per pixel or run of pixels, then 7 zero bytes and a 1 */
+#define QOI_HEADER_SIZE 14
+#define QOI_PADDING 8
+#define QOI_PIXELS_MAX 400000000u /* As the reference decoder */
+
+/* Checks a QOI file's header; 0 and its size if the image is valid */
+static int qoi_header(const unsigned char *data, size_t size, int *width, int *height)
+{
+    if (size < QOI_HEADER_SIZE + QOI_PADDING || memcmp(data, "qoif", 4) != 0)
+        return 1;
+    uint32_t w = (uint32_t)data[4] << 24 | (uint32_t)data[5] << 16 | (uint32_t)data[6] << 8 | data[7];
+    uint32_t h = (uint32_t)data[8] << 24 | (uint32_t)data[9] << 16 | (uint32_t)data[10] << 8 | data[11];
+    if (!w || !h || h >= QOI_PIXELS_MAX / w || (data[12] != 3 && data[12] != 4))
+        return 1;
+    *width = (int)w;
+    *height = (int)h;
+    return 0;
+}
+
+/* Decodes a QOI file that passed qoi_header into count RGBA pixels */
+static void qoi_decode(const unsigned char *data, size_t size, unsigned char *pixels, size_t count)
+{
+    unsigned char seen[64][4] = {{0}}; /* Pixels by hash, for QOI_OP_INDEX */
+    unsigned char px[4] = {0, 0, 0, 255};
+    size_t p = QOI_HEADER_SIZE, end = size - QOI_PADDING; /* Ops read at most 4 bytes past end: the padding */
+    int run = 0;
+    for (unsigned char *out = pixels, *last = pixels + count * 4; out < last; out += 4)
+    {
+        if (run > 0)
+            run--;
+        else if (p < end)
+        {
+            int op = data[p++];
+            if (op == 0xFE) /* QOI_OP_RGB */
+            {
+                px[0] = data[p];
+                px[1] = data[p + 1];
+                px[2] = data[p + 2];
+                p += 3;
+            }
+            else if (op == 0xFF) /* QOI_OP_RGBA */
+            {
+                memcpy(px, data + p, 4);
+                p += 4;
+            }
+            else if ((op & 0xC0) == 0x00) /* QOI_OP_INDEX */
+                memcpy(px, seen[op], 4);
+            else if ((op & 0xC0) == 0x40) /* QOI_OP_DIFF: -2..1 per channel */
+            {
+                px[0] += ((op >> 4) & 3) - 2;
+                px[1] += ((op >> 2) & 3) - 2;
+                px[2] += (op & 3) - 2;
+            }
+            else if ((op & 0xC0) == 0x80) /* QOI_OP_LUMA: green -32..31, red and blue relative to it */
+            {
+                int next = data[p++], dg = (op & 0x3F) - 32;
+                px[0] += dg - 8 + ((next >> 4) & 0x0F);
+                px[1] += dg;
+                px[2] += dg - 8 + (next & 0x0F);
+            }
+            else /* QOI_OP_RUN: 1..62 times the previous pixel */
+                run = op & 0x3F;
+            memcpy(seen[(px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) & 63], px, 4);
+        }
+        memcpy(out, px, 4);
+    }
+}
+
+#undef QOI_HEADER_SIZE
+#undef QOI_PADDING
+#undef QOI_PIXELS_MAX
+
+/* An image file opened by image_open: QOI stays encoded until the caller
+ * has a buffer for its pixels; anything else is decoded by stb_image */
+typedef struct
+{
+    int width, height;   /* Image size in pixels */
+    unsigned char *qoi;  /* The whole QOI file (arcade_alloc), or NULL */
+    size_t qoi_size;     /* Bytes in qoi */
+    unsigned char *rgba; /* stb_image's RGBA pixels, or NULL */
+} ImageFile;
+
+/* Opens an image file: QOI when it starts with its magic, anything
+ * stb_image reads otherwise; 0 on success (close with image_close) */
+static int image_open(const char *path, ImageFile *image)
+{
+    memset(image, 0, sizeof(*image));
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return 1;
+    unsigned char magic[4];
+    int channels;
+    if (fread(magic, 1, 4, file) != 4 || memcmp(magic, "qoif", 4) != 0)
+    {
+        if (fseek(file, 0, SEEK_SET) == 0)
+            image->rgba = stbi_load_from_file(file, &image->width, &image->height, &channels, 4);
+        fclose(file);
+        return image->rgba ? 0 : 1;
+    }
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) > 0 && fseek(file, 0, SEEK_SET) == 0)
+        image->qoi = arcade_alloc((size_t)size, 0);
+    if (image->qoi && fread(image->qoi, 1, (size_t)size, file) == (size_t)size)
+        image->qoi_size = (size_t)size;
+    fclose(file);
+    if (!image->qoi_size || qoi_header(image->qoi, image->qoi_size, &image->width, &image->height) != 0)
+    {
+        arcade_free(image->qoi);
+        image->qoi = NULL;
+        return 1;
+    }
+    return 0;
+}
+
+static void image_close(ImageFile *image)
+{
+    arcade_free(image->qoi);
+    stbi_image_free(image->rgba);
+    image->qoi = image->rgba = NULL;
+}
+
+/* Loads an image file as RGBA bytes (free with stbi_image_free) */
+static unsigned char *image_load(const char *path, int *width, int *height)
+{
+    ImageFile image;
+    if (image_open(path, &image) != 0)
+        return NULL;
+    unsigned char *pixels = image.rgba;
+    image.rgba = NULL;
+    if (image.qoi && (pixels = arcade_alloc((size_t)image.width * image.height * 4, 0)))
+        qoi_decode(image.qoi, image.qoi_size, pixels, (size_t)image.width * image.height);
+    image_close(&image);
+    *width = image.width;
+    *height = image.height;
+    return pixels;
+}
+
+/* The ARGB words of a uint32_t pixel buffer, as stb_image_resize byte
+ * layouts (plain and premultiplied) */
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+#define IMAGE_LAYOUT_ARGB STBIR_ARGB
+#define IMAGE_LAYOUT_ARGB_PM STBIR_ARGB_PM
+#else
+#define IMAGE_LAYOUT_ARGB STBIR_BGRA
+#define IMAGE_LAYOUT_ARGB_PM STBIR_BGRA_PM
+#endif
+
+/* Converts count RGBA pixels to ARGB words; pixels may be rgba itself */
+static void rgba_to_argb(const unsigned char *rgba, uint32_t *pixels, size_t count)
+{
+    for (size_t i = 0; i < count; i++, rgba += 4)
+        pixels[i] = (uint32_t)rgba[3] << 24 | (uint32_t)rgba[0] << 16 | (uint32_t)rgba[1] << 8 | rgba[2];
+}
+
+/* Resizes RGBA pixels straight into ARGB words with the image filter; 0 on success */
+static int resize_to_argb(const unsigned char *rgba, int width, int height, uint32_t *pixels, int target_width, int target_height)
+{
+    STBIR_RESIZE resize;
+    /* Point samples copy pixels whole, so alpha needs no weighting */
+    int point = image_filter == ARCADE_FILTER_POINT;
+    stbir_resize_init(&resize, rgba, width, height, 0, pixels, target_width, target_height, 0, STBIR_RGBA,
+                      image_filter == ARCADE_FILTER_SMOOTH ? STBIR_TYPE_UINT8_SRGB : STBIR_TYPE_UINT8);
+    stbir_set_pixel_layouts(&resize, point ? STBIR_RGBA_PM : STBIR_RGBA, point ? IMAGE_LAYOUT_ARGB_PM : IMAGE_LAYOUT_ARGB);
+    if (image_filter != ARCADE_FILTER_SMOOTH)
+    {
+        stbir_filter filter = point ? STBIR_FILTER_POINT_SAMPLE : STBIR_FILTER_TRIANGLE;
+        stbir_set_filters(&resize, filter, filter);
+    }
+    return stbir_resize_extended(&resize) ? 0 : 1;
+}
+
+#undef IMAGE_LAYOUT_ARGB
+#undef IMAGE_LAYOUT_ARGB_PM
+
+/* Decodes an image into a sprite's ARGB pixels at the target size. Only
+ * the pixels are allocated for good: a QOI file of that size decodes
+ * straight into them, one to be resized into the calling thread's frame
+ * arena (kept for the next load), and a PNG's decoded copy is freed as
+ * soon as it has been resized or converted */
+static int decode_image_sprite(ArcadeImageSprite *sprite, const char *filename, int target_width, int target_height)
+{
+    if (!sprite || !filename)
+        return 1;
+    ImageFile image;
+    if (image_open(filename, &image) != 0)
+    {
+        fprintf(stderr, "Cannot load %s\n", filename);
+        return 1;
+    }
+    size_t count = (size_t)target_width * target_height;
+    int same_size = image.width == target_width && image.height == target_height;
+    uint32_t *pixels = arcade_alloc(count * sizeof(uint32_t), ARCADE_SIMD_ALIGN);
+    ArcadeArena *scratch = arcade_frame_arena();
+    ArcadeArenaMark mark = arcade_arena_mark(scratch);
+    const unsigned char *rgba = image.rgba;
+    if (pixels && image.qoi)
+    {
+        unsigned char *decoded = same_size ? (unsigned char *)pixels
+                                           : arcade_arena_alloc(scratch, (size_t)image.width * image.height * 4, ARCADE_SIMD_ALIGN);
+        if (decoded)
+            qoi_decode(image.qoi, image.qoi_size, decoded, (size_t)image.width * image.height);
+        rgba = decoded;
+        arcade_free(image.qoi); /* Before the resize allocates */
+        image.qoi = NULL;
+    }
+    int failed = !pixels || !rgba;
+    if (!failed && same_size)
+        rgba_to_argb(rgba, pixels, count);
+    else if (!failed && resize_to_argb(rgba, image.width, image.height, pixels, target_width, target_height) != 0)
+    {
+        fprintf(stderr, "Failed to resize %s to %dx%d\n", filename, target_width, target_height);
+        failed = 1;
+    }
+    arcade_arena_release(scratch, mark);
+    image_close(&image);
+    if (failed)
+    {
+        arcade_free(pixels);
+        return 1;
+    }
+    sprite->pixels = pixels;
+    sprite->image_width = target_width;
+    sprite->image_height = target_height;
+    sprite->opaque = 1;
+    for (size_t i = 0; i < count && sprite->opaque; i++)
+        sprite->opaque = (pixels[i] >> 24) > 0;
+    sprite->width = (float)target_width;
+    sprite->height = (float)target_height;
+    sprite->active = 1;
+#if !defined(ARCADE_HEADLESS) && !defined(_WIN32)
+    if (state.format == ARCADE_FORMAT_RGB565 && backend_active == ARCADE_BACKEND_SOFTWARE)
+        rgb565_image(pixels, target_width, target_height); /* Converted once here rather than on first draw */
+#endif
+    return 0;
+}
+
+/* Absolute path of a file (for free), or NULL if it cannot be resolved */
+static char *asset_path(const char *filename)
+{
+#ifdef _WIN32
+    return _fullpath(NULL, filename, 0);
+#else
+    return realpath(filename, NULL);
+#endif
+}
+
+/* Loads an image sprite's pixels, sharing them through the asset cache when it is on */
+static int load_image_sprite(ArcadeImageSprite *sprite, const char *filename, int target_width, int target_height)
+{
+    char *path = asset_cache_enabled && sprite && filename ? asset_path(filename) : NULL;
+    if (!path)
+        return decode_image_sprite(sprite, filename, target_width, target_height);
+    for (int i = 0; i < asset_count; i++)
+    {
+        CachedAsset *asset = &assets[i];
+        if (asset->width == target_width && asset->height == target_height && asset->filter == image_filter &&
+            strcmp(asset->path, path) == 0)
+        {
+            free(path);
+            asset->users++;
+            sprite->pixels = asset->pixels;
+            sprite->image_width = sprite->width = target_width;
+            sprite->image_height = sprite->height = target_height;
+            sprite->opaque = asset->opaque;
+            sprite->active = 1;
+            return 0;
+        }
+    }
+    if (decode_image_sprite(sprite, filename, target_width, target_height) != 0)
+    {
+        free(path);
+        return 1;
+    }
+    if (asset_count == asset_capacity)
+    {
+        int capacity = asset_capacity ? asset_capacity * 2 : 16;
+        CachedAsset *grown = arcade_realloc(assets, capacity * sizeof(CachedAsset));
+        if (!grown)
+        {
+            free(path);
+            return 0; /* Loaded, just not shared */
+        }
+        assets = grown;
+        asset_capacity = capacity;
+    }
+    assets[asset_count++] = (CachedAsset){path, target_width, target_height, image_filter, sprite->pixels, sprite->opaque, 1};
+    return 0;
+}
+
+/* Frees pixels from load_image_sprite, or gives them back to the asset cache */
+static void release_image(uint32_t *pixels)
+{
+    for (int i = 0; i < asset_count; i++)
+    {
+        if (assets[i].pixels != pixels)
+            continue;
+        if (assets[i].users > 0)
+            assets[i].users--;
+        if (assets[i].users > 0 || asset_cache_enabled)
+            return; /* Still drawn, or kept for the next load */
+        free(assets[i].path);
+        assets[i] = assets[--asset_count];
+        break;
+    }
+#if defined(ARCADE_HAS_XRENDER)
+    xrender_forget(pixels);
+#endif
+#if !defined(ARCADE_HEADLESS) && !defined(_WIN32)
+    rgb565_forget(pixels);
+#endif
+    arcade_free(pixels);
+}
+
+void arcade_set_asset_cache(int enable)
+{
+    asset_cache_enabled = enable;
+    if (!enable)
+        arcade_clear_asset_cache();
+}
+
+void arcade_set_image_filter(int filter)
+{
+    image_filter = filter < ARCADE_FILTER_SMOOTH || filter > ARCADE_FILTER_POINT ? ARCADE_FILTER_SMOOTH : filter;
+}
+
+void arcade_clear_asset_cache(void)
+{
+    int kept = 0;
+    for (int i = 0; i < asset_count; i++)
+    {
+        if (assets[i].users > 0)
+        {
+            assets[kept++] = assets[i];
+            continue;
+        }
+#if defined(ARCADE_HAS_XRENDER)
+        xrender_forget(assets[i].pixels);
+#endif
+#if !defined(ARCADE_HEADLESS) && !defined(_WIN32)
+        rgb565_forget(assets[i].pixels);
+#endif
+        arcade_free(assets[i].pixels);
+        free(assets[i].path);
+    }
+    asset_count = kept;
+    if (!asset_count)
+    {
+        arcade_free(assets);
+        assets = NULL;
+        asset_capacity = 0;
+    }
+}
+
+ArcadeImageSprite arcade_create_image_sprite(float x, float y, float w, float h, const char *filename)
+{
+    ArcadeImageSprite sprite = {
+        .x = x, .y = y, .width = 0.0f, .height = 0.0f, .vx = 0.0f, .vy = 0.0f, .pixels = NULL, .image_width = 0, .image_height = 0, .active = 1, .opaque = 0};
+    if (filename && load_image_sprite(&sprite, filename, (int)w, (int)h) != 0)
+    {
+        sprite.pixels = NULL;
+    }
+    return sprite;
+}
+
+void arcade_free_image_sprite(ArcadeImageSprite *sprite)
+{
+    if (sprite && sprite->pixels)
+    {
+        release_image(sprite->pixels);
+        sprite->pixels = NULL;
+        sprite->image_width = 0;
+        sprite->image_height = 0;
+        sprite->active = 0;
+        sprite->opaque = 0;
+    }
+}
+
+ArcadeAnimatedSprite arcade_create_animated_sprite(float x, float y, float w, float h, const char **filenames, int frame_count, int frame_interval)
+{
+    ArcadeAnimatedSprite anim = {0};
+    anim.frames = arcade_alloc(frame_count * sizeof(ArcadeImageSprite), 0);
+    anim.frame_count = frame_count;
+    anim.frame_interval = frame_interval;
+    for (int i = 0; i < frame_count; i++)
+    {
+        anim.frames[i] = arcade_create_image_sprite(x, y, w, h, filenames[i]);
+        if (!anim.frames[i].pixels)
+        {
+            for (int j = 0; j < i; j++)
+                arcade_free_image_sprite(&anim.frames[j]);
+            arcade_free(anim.frames);
+            return (ArcadeAnimatedSprite){0};
+        }
+    }
+    anim.frames[0].active = 1;
+    return anim;
+}
+
+void arcade_free_animated_sprite(ArcadeAnimatedSprite *anim)
+{
+    if (!anim || !anim->frames)
+        return;
+    for (int i = 0; i < anim->frame_count; i++)
+        arcade_free_image_sprite(&anim->frames[i]);
+    arcade_free(anim->frames);
+    anim->frames = NULL;
+    anim->frame_count = 0;
+}
+
+void arcade_move_animated_sprite(ArcadeAnimatedSprite *anim, float gravity, int window_height)
+{
+    if (!anim || !anim->frames[0].active)
+        return;
+    ArcadeImageSprite *current = &anim->frames[anim->current_frame];
+    arcade_move_image_sprite(current, gravity, window_height);
+    for (int i = 0; i < anim->frame_count; i++)
+    {
+        anim->frames[i].x = current->x;
+        anim->frames[i].y = current->y;
+        anim->frames[i].vx = current->vx;
+        anim->frames[i].vy = current->vy;
+    }
+    if (++anim->frame_counter >= anim->frame_interval)
+    {
+        anim->current_frame = (anim->current_frame + 1) % anim->frame_count;
+        anim->frame_counter = 0;
+    }
+}
+
+int arcade_check_animated_collision(ArcadeAnimatedSprite *anim, ArcadeImageSprite *other)
+{
+    if (!anim || !other || !anim->frames[0].active || !other->active)
+        return 0;
+    return arcade_check_image_collision(&anim->frames[anim->current_frame], other);
+}
+
+ArcadeScrollLayer arcade_create_scroll_layer(float x, float y, float w, float h, const char *filename, int image_width, int image_height, float speed_x, float speed_y)
+{
+    ArcadeScrollLayer layer = {
+        .x = x, .y = y, .width = w, .height = h, .speed_x = speed_x, .speed_y = speed_y, .pixels = NULL, .active = 1};
+    ArcadeImageSprite image = {0};
+    if (filename && image_width > 0 && image_height > 0 && load_image_sprite(&image, filename, image_width, image_height) == 0)
+    {
+        layer.pixels = image.pixels;
+        layer.image_width = image.image_width;
+        layer.image_height = image.image_height;
+        layer.opaque = image.opaque;
+    }
+    return layer;
+}
+
+/* Wraps an offset to [0, size) without libm */
+static float wrap_scroll(float offset, int size)
+{
+    double wrapped = offset - (double)size * (long long)(offset / size);
+    if (wrapped < 0)
+        wrapped += size;
+    return wrapped < size ? (float)wrapped : 0.0f; /* Rounding can land on size */
+}
+
+void arcade_scroll_layer(ArcadeScrollLayer *layer, float camera_x, float camera_y)
+{
+    if (!layer || !layer->pixels)
+        return;
+    layer->scroll_x = wrap_scroll(camera_x * layer->speed_x, layer->image_width);
+    layer->scroll_y = wrap_scroll(camera_y * layer->speed_y, layer->image_height);
+}
+
+void arcade_free_scroll_layer(ArcadeScrollLayer *layer)
+{
+    if (layer && layer->pixels)
+    {
+        release_image(layer->pixels);
+        layer->pixels = NULL;
+        layer->image_width = 0;
+        layer->image_height = 0;
+        layer->active = 0;
+        layer->opaque = 0;
+    }
+}
+
+/* =========================================================================
+ * Rendering
+ * ========================================================================= */
+
+#define FILL_STREAM_BYTES (1 << 20) /* Opaque fills this large bypass the cache */
+
+/* Sets count pixels to color; stream = non-temporal stores */
+static void fill_span(uint32_t *dst, size_t count, uint32_t color, int stream)
+{
+#if defined(ARCADE_SSE2)
+    if (count >= 4 && count <= 64)
+    {
+        /* Short spans (shape rows, small sprites): unaligned stores and one
+         * overlapping store for the tail, so varying lengths cost few branches */
+        __m128i v4 = _mm_set1_epi32((int)color);
+        for (size_t i = 0; i + 4 < count; i += 4)
+            _mm_storeu_si128((__m128i *)(dst + i), v4);
+        _mm_storeu_si128((__m128i *)(dst + count - 4), v4);
+        return;
+    }
+    while (count && ((uintptr_t)dst & 15)) /* Single pixels up to a 16-byte boundary */
+    {
+        *dst++ = color;
+        count--;
+    }
+    __m128i v = _mm_set1_epi32((int)color);
+    if (stream)
+    {
+        for (; count >= 16; count -= 16, dst += 16)
+        {
+            _mm_stream_si128((__m128i *)dst, v);
+            _mm_stream_si128((__m128i *)(dst + 4), v);
+            _mm_stream_si128((__m128i *)(dst + 8), v);
+            _mm_stream_si128((__m128i *)(dst + 12), v);
+        }
+        for (; count >= 4; count -= 4, dst += 4)
+            _mm_stream_si128((__m128i *)dst, v);
+        _mm_sfence(); /* Streamed pixels are visible before anything draws over them */
+    }
+    else
+    {
+#if defined(__AVX2__)
+        __m256i v8 = _mm256_set1_epi32((int)color);
+        for (; count >= 16; count -= 16, dst += 16)
+        {
+            _mm256_storeu_si256((__m256i *)dst, v8);
+            _mm256_storeu_si256((__m256i *)(dst + 8), v8);
+        }
+#endif
+        for (; count >= 8; count -= 8, dst += 8)
+        {
+            _mm_store_si128((__m128i *)dst, v);
+            _mm_store_si128((__m128i *)(dst + 4), v);
+        }
+        for (; count >= 4; count -= 4, dst += 4)
+            _mm_store_si128((__m128i *)dst, v);
+    }
+#else
+    (void)stream;
+#endif
+    while (count--)
+        *dst++ = color;
+}
+
+/*
+ * Blends color over count pixels: out = (color * a + dst * (255 - a)) / 255
+ * per channel, with a = the color's alpha. The destination alpha is kept.
+ * Vector and scalar paths give identical results.
+ */
+static void blend_span(uint32_t *dst, size_t count, uint32_t color)
+{
+    uint32_t a = color >> 24, inv = 255 - a;
+    uint32_t sr = ((color >> 16) & 0xFF) * a, sg = ((color >> 8) & 0xFF) * a, sb = (color & 0xFF) * a;
+    size_t i = 0;
+#if defined(ARCADE_SSE2)
+    /* Pixels widened to 16-bit B, G, R, A lanes; alpha lane: dst * 255 / 255 */
+    __m128i zero = _mm_setzero_si128();
+    __m128i src = _mm_set_epi16(0, (short)sr, (short)sg, (short)sb, 0, (short)sr, (short)sg, (short)sb);
+    __m128i scale = _mm_set_epi16(255, (short)inv, (short)inv, (short)inv, 255, (short)inv, (short)inv, (short)inv);
+    __m128i bias = _mm_set1_epi16(128);
+#if defined(__AVX2__)
+    __m256i zero8 = _mm256_setzero_si256();
+    __m256i src8 = _mm256_broadcastsi128_si256(src);
+    __m256i scale8 = _mm256_broadcastsi128_si256(scale);
+    __m256i bias8 = _mm256_set1_epi16(128);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+        __m256i lo = _mm256_unpacklo_epi8(d, zero8), hi = _mm256_unpackhi_epi8(d, zero8);
+        lo = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(lo, scale8), src8), bias8);
+        hi = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(hi, scale8), src8), bias8);
+        lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_srli_epi16(lo, 8)), 8); /* Exact / 255 */
+        hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_srli_epi16(hi, 8)), 8);
+        _mm256_storeu_si256((__m256i *)(dst + i), _mm256_packus_epi16(lo, hi));
+    }
+#endif
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i lo = _mm_unpacklo_epi8(d, zero), hi = _mm_unpackhi_epi8(d, zero);
+        lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(lo, scale), src), bias);
+        hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(hi, scale), src), bias);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8); /* Exact / 255 */
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        uint32_t d = dst[i];
+        uint32_t r = ((d >> 16) & 0xFF) * inv + sr + 128;
+        uint32_t g = ((d >> 8) & 0xFF) * inv + sg + 128;
+        uint32_t b = (d & 0xFF) * inv + sb + 128;
+        r = (r + (r >> 8)) >> 8;
+        g = (g + (g >> 8)) >> 8;
+        b = (b + (b >> 8)) >> 8;
+        dst[i] = (d & 0xFF000000) | (r << 16) | (g << 8) | b;
+    }
+}
+
+/* Fills [x0, x1) x [y0, y1), clipped to the target; alpha 0x01-0xFE blends */
+static void fill_rect(ArcadeFramebuffer *target, int x0, int y0, int x1, int y1, uint32_t color)
+{
+    if (x0 < 0)
+        x0 = 0;
+    if (y0 < 0)
+        y0 = 0;
+    if (x1 > target->width)
+        x1 = target->width;
+    if (y1 > target->height)
+        y1 = target->height;
+    if (x0 >= x1 || y0 >= y1)
+        return;
+
+    uint32_t alpha = color >> 24;
+    size_t stride = (size_t)target->width;
+    if (alpha != 0 && alpha != 0xFF)
+    {
+        for (int y = y0; y < y1; y++)
+            blend_span(target->pixels + y * stride + x0, (size_t)(x1 - x0), color);
+    }
+    else if (x0 == 0 && x1 == target->width)
+    {
+        /* Whole rows are one contiguous span */
+        size_t count = stride * (size_t)(y1 - y0);
+        fill_span(target->pixels + y0 * stride, count, color, count * sizeof(uint32_t) >= FILL_STREAM_BYTES);
+    }
+    else
+    {
+        for (int y = y0; y < y1; y++)
+            fill_span(target->pixels + y * stride + x0, (size_t)(x1 - x0), color, 0);
+    }
+}
+
+void arcade_fill_rect(ArcadeFramebuffer *target, int x, int y, int width, int height, uint32_t color)
+{
+    if (!target || !target->pixels || width <= 0 || height <= 0)
+        return;
+    fill_rect(target, x, y, x + width, y + height, color);
+}
+
+/* Screen area a sprite draws into, clipped to the target */
+typedef struct
+{
+    int x0, y0, x1, y1; /* Pixels [x0, x1) x [y0, y1) */
+} SpriteRect;
+
+/* A see-through sprite waiting for what is behind it, and its coverage rows */
+typedef struct
+{
+    int index;     /* Sprite index in the scene */
+    SpriteRect r;  /* Area it draws into */
+    size_t saved;  /* Offset of its coverage rows in the saved-coverage buffer */
+} DeferredSprite;
+
+/*
+ * Finds the pixels a sprite draws into, with the same rounding as
+ * the blit kernels. Images are cropped (never stretched) to the sprite size
+ * and layers repeat to fill theirs; at other scales every visible sprite is at
+ * least one pixel wide and tall.
+ * Returns 0 if the sprite is inactive or entirely off the target.
+ */
+static int sprite_rect(const ArcadeFramebuffer *target, const ArcadeAnySprite *sprite, int type, SpriteRect *r)
+{
+    float x, y, w, h;
+    if (type == SPRITE_COLOR && sprite->sprite.active)
+    {
+        const ArcadeSprite *s = &sprite->sprite;
+        x = s->x;
+        y = s->y;
+        w = s->width;
+        h = s->height;
+    }
+    else if (type == SPRITE_IMAGE && sprite->image_sprite.active && sprite->image_sprite.pixels)
+    {
+        const ArcadeImageSprite *s = &sprite->image_sprite;
+        x = s->x;
+        y = s->y;
+        w = s->width < s->image_width ? s->width : (float)s->image_width;
+        h = s->height < s->image_height ? s->height : (float)s->image_height;
+    }
+    else if (type == SPRITE_LAYER && sprite->layer.active && sprite->layer.pixels)
+    {
+        const ArcadeScrollLayer *s = &sprite->layer;
+        x = s->x;
+        y = s->y;
+        w = s->width;
+        h = s->height;
+    }
+    else
+        return 0;
+
+    if (target->scale_x != 1.0f || target->scale_y != 1.0f)
+    {
+        r->x0 = (int)(x * target->scale_x);
+        r->y0 = (int)(y * target->scale_y);
+        r->x1 = (int)((x + w) * target->scale_x);
+        r->y1 = (int)((y + h) * target->scale_y);
+        if (w > 0 && r->x1 == r->x0)
+            r->x1++; /* Keep small sprites visible */
+        if (h > 0 && r->y1 == r->y0)
+            r->y1++;
+    }
+    else
+    {
+        r->x0 = (int)x;
+        r->y0 = (int)y;
+        r->x1 = r->x0 + (int)w;
+        r->y1 = r->y0 + (int)h;
+    }
+    if (r->x0 < 0)
+        r->x0 = 0;
+    if (r->y0 < 0)
+        r->y0 = 0;
+    if (r->x1 > target->width)
+        r->x1 = target->width;
+    if (r->y1 > target->height)
+        r->y1 = target->height;
+    return r->x0 < r->x1 && r->y0 < r->y1;
+}
+
+/* Whether a tint's alpha fades what it tints (alpha 0 counts as 0xFF) */
+static int tint_fades(uint32_t tint)
+{
+    uint32_t alpha = tint >> 24;
+    return alpha != 0 && alpha != 0xFF;
+}
+
+/* Whether a sprite overwrites every pixel of its sprite_rect */
+static int sprite_is_opaque(const ArcadeAnySprite *sprite, int type)
+{
+    if (type == SPRITE_COLOR)
+    {
+        uint32_t alpha = sprite->sprite.color >> 24;
+        return alpha == 0 || alpha == 0xFF; /* Alpha 0 is a plain 0xRRGGBB color */
+    }
+    if (type == SPRITE_LAYER)
+        return sprite->layer.opaque && !tint_fades(sprite->layer.tint);
+    return sprite->image_sprite.opaque && !tint_fades(sprite->image_sprite.tint);
+}
+
+/* Color modulation of one draw: c = src * mul / 255 + add, then blended over
+ * the target by fade / 255 */
+typedef struct
+{
+    uint32_t mul_r, mul_g, mul_b; /* Multipliers (255 = unchanged) */
+    uint32_t add;                 /* Added 0xRRGGBB, saturating */
+    uint32_t fade;                /* Opacity (255 = pixels are copied) */
+} SpriteTint;
+
+/* Fills t from a sprite's tint and flash; returns 0 if they change nothing */
+static int sprite_tint(uint32_t tint, uint32_t flash, SpriteTint *t)
+{
+    if (tint == 0 && (flash & 0xFFFFFF) == 0)
+        return 0;
+    if (tint == 0)
+        tint = 0xFFFFFF;
+    t->mul_r = (tint >> 16) & 0xFF;
+    t->mul_g = (tint >> 8) & 0xFF;
+    t->mul_b = tint & 0xFF;
+    t->add = flash & 0xFFFFFF;
+    t->fade = tint_fades(tint) ? tint >> 24 : 255;
+    return 1;
+}
+
+/*
+ * Sprite blitting. Every combination of source (image, or a layer that
+ * repeats), sampling (1:1, or nearest-neighbour on a scaled framebuffer),
+ * alpha (opaque, or keyed: alpha 0 pixels are skipped) and tint (none,
+ * tinted, tinted and faded) is its own kernel, expanded from the generic
+ * bodies below with the modes as constants. sprite_blit picks the kernel
+ * once per sprite, so the loops test no modes.
+ */
+
+#if defined(_MSC_VER)
+#define BLIT_INLINE static __forceinline
+#elif defined(__GNUC__)
+#define BLIT_INLINE static inline __attribute__((always_inline))
+#else
+#define BLIT_INLINE static inline
+#endif
+
+/* Tint modes */
+enum
+{
+    BLIT_PLAIN, /* Pixels copied */
+    BLIT_TINT,  /* Modulated by a SpriteTint with fade 255 */
+    BLIT_FADE   /* Modulated, then blended over the target */
+};
+
+/* A sprite ready to draw: its kernel and what the kernel reads */
+typedef struct SpriteBlit SpriteBlit;
+
+/* Draws pixels [x0, x1) of target row y; row = the start of that row */
+typedef void (*BlitKernel)(const SpriteBlit *b, uint32_t *row, int y, int x0, int x1);
+
+struct SpriteBlit
+{
+    BlitKernel span;               /* Kernel for this sprite's modes */
+    const uint32_t *pixels;        /* Image (NULL for color sprites) */
+    int image_width, image_height; /* Image dimensions */
+    int ox, oy;                    /* Image pixel minus target pixel at scale 1 */
+    float x, y;                    /* Sprite position, for scaled sampling */
+    int scroll_x, scroll_y;        /* Layer scroll, for scaled sampling */
+    float scale_x, scale_y;        /* Target pixels per scene pixel */
+    uint32_t color;                /* Color sprites: fill or blend color */
+    SpriteTint tint;               /* Tint modes other than BLIT_PLAIN */
+};
+
+/* Rounded v / 255, exact for v up to 255 * 255 + 127 */
+static inline uint32_t div255(uint32_t v)
+{
+    v += 128;
+    return (v + (v >> 8)) >> 8;
+}
+
+/* One pixel: src drawn over dst */
+BLIT_INLINE uint32_t blit_pixel(uint32_t dst, uint32_t src, const SpriteTint *t, const int opaque, const int mode)
+{
+    if (!opaque && (src >> 24) == 0)
+        return dst;
+    if (mode == BLIT_PLAIN)
+        return src;
+    uint32_t r = div255(((src >> 16) & 0xFF) * t->mul_r) + ((t->add >> 16) & 0xFF);
+    uint32_t g = div255(((src >> 8) & 0xFF) * t->mul_g) + ((t->add >> 8) & 0xFF);
+    uint32_t b = div255((src & 0xFF) * t->mul_b) + (t->add & 0xFF);
+    r = r > 255 ? 255 : r;
+    g = g > 255 ? 255 : g;
+    b = b > 255 ? 255 : b;
+    if (mode == BLIT_TINT)
+        return (src & 0xFF000000) | (r << 16) | (g << 8) | b;
+    uint32_t inv = 255 - t->fade; /* Blend like blend_span: the target keeps its alpha */
+    r = div255(r * t->fade + ((dst >> 16) & 0xFF) * inv);
+    g = div255(g * t->fade + ((dst >> 8) & 0xFF) * inv);
+    b = div255(b * t->fade + (dst & 0xFF) * inv);
+    return (dst & 0xFF000000) | (r << 16) | (g << 8) | b;
+}
+
+/*
+ * Draws count consecutive image pixels. The target is only read when the
+ * result depends on it (keyed or faded). Vector and scalar paths give
+ * identical results.
+ */
+BLIT_INLINE void blit_row(uint32_t *dst, const uint32_t *src, int count, const SpriteTint *t, const int opaque, const int mode)
+{
+    if (mode == BLIT_PLAIN && opaque)
+    {
+        memcpy(dst, src, (size_t)count * sizeof(uint32_t));
+        return;
+    }
+    int i = 0;
+#if defined(ARCADE_SSE2)
+    __m128i zero = _mm_setzero_si128(), alpha = _mm_set1_epi32((int)0xFF000000);
+    if (mode == BLIT_PLAIN)
+    {
+        /* Keep the target where the source alpha is 0 */
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+            __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+            __m128i clear = _mm_cmpeq_epi32(_mm_and_si128(s, alpha), zero);
+            _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_and_si128(clear, d), _mm_andnot_si128(clear, s)));
+        }
+    }
+    else
+    {
+        /* Pixels widened to 16-bit B, G, R, A lanes; the alpha lane multiplies
+         * by 255 (unchanged), adds nothing and, when fading, keeps the target's */
+        __m128i mul = _mm_set_epi16(255, (short)t->mul_r, (short)t->mul_g, (short)t->mul_b,
+                                    255, (short)t->mul_r, (short)t->mul_g, (short)t->mul_b);
+        __m128i add = _mm_set1_epi32((int)t->add);
+        __m128i src_w = _mm_set_epi16(0, (short)t->fade, (short)t->fade, (short)t->fade, 0, (short)t->fade, (short)t->fade, (short)t->fade);
+        __m128i dst_w = _mm_sub_epi16(_mm_set1_epi16(255), src_w);
+        __m128i bias = _mm_set1_epi16(128), v257 = _mm_set1_epi16(257);
+#if defined(__AVX2__)
+        __m256i zero8 = _mm256_setzero_si256();
+        __m256i mul8 = _mm256_broadcastsi128_si256(mul);
+        __m256i add8 = _mm256_broadcastsi128_si256(add);
+        __m256i src_w8 = _mm256_broadcastsi128_si256(src_w);
+        __m256i dst_w8 = _mm256_broadcastsi128_si256(dst_w);
+        __m256i bias8 = _mm256_set1_epi16(128), v257_8 = _mm256_set1_epi16(257);
+        __m256i alpha8 = _mm256_set1_epi32((int)0xFF000000);
+        for (; i + 8 <= count; i += 8)
+        {
+            __m256i s = _mm256_loadu_si256((const __m256i *)(src + i));
+            __m256i lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(s, zero8), mul8), bias8);
+            __m256i hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(s, zero8), mul8), bias8);
+            lo = _mm256_mulhi_epu16(lo, v257_8); /* Exact / 255: v * 257 >> 16, v biased by 128 */
+            hi = _mm256_mulhi_epu16(hi, v257_8);
+            __m256i c = _mm256_adds_epu8(_mm256_packus_epi16(lo, hi), add8);
+            if (mode == BLIT_TINT && opaque)
+            {
+                _mm256_storeu_si256((__m256i *)(dst + i), c);
+                continue;
+            }
+            __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+            if (mode == BLIT_FADE)
+            {
+                lo = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpacklo_epi8(c, zero8), src_w8), bias8);
+                hi = _mm256_add_epi16(_mm256_mullo_epi16(_mm256_unpackhi_epi8(c, zero8), src_w8), bias8);
+                lo = _mm256_add_epi16(lo, _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero8), dst_w8));
+                hi = _mm256_add_epi16(hi, _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero8), dst_w8));
+                lo = _mm256_mulhi_epu16(lo, v257_8);
+                hi = _mm256_mulhi_epu16(hi, v257_8);
+                c = _mm256_packus_epi16(lo, hi);
+            }
+            if (!opaque)
+                c = _mm256_blendv_epi8(c, d, _mm256_cmpeq_epi32(_mm256_and_si256(s, alpha8), zero8)); /* Transparent source */
+            _mm256_storeu_si256((__m256i *)(dst + i), c);
+        }
+#endif
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+            __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), mul), bias);
+            __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), mul), bias);
+            lo = _mm_mulhi_epu16(lo, v257); /* Exact / 255: v * 257 >> 16, v biased by 128 */
+            hi = _mm_mulhi_epu16(hi, v257);
+            __m128i c = _mm_adds_epu8(_mm_packus_epi16(lo, hi), add);
+            if (mode == BLIT_TINT && opaque)
+            {
+                _mm_storeu_si128((__m128i *)(dst + i), c);
+                continue;
+            }
+            __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+            if (mode == BLIT_FADE)
+            {
+                lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(c, zero), src_w), bias);
+                hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(c, zero), src_w), bias);
+                lo = _mm_add_epi16(lo, _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), dst_w));
+                hi = _mm_add_epi16(hi, _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), dst_w));
+                lo = _mm_mulhi_epu16(lo, v257);
+                hi = _mm_mulhi_epu16(hi, v257);
+                c = _mm_packus_epi16(lo, hi);
+            }
+            if (!opaque)
+            {
+                __m128i clear = _mm_cmpeq_epi32(_mm_and_si128(s, alpha), zero); /* Transparent source */
+                c = _mm_or_si128(_mm_and_si128(clear, d), _mm_andnot_si128(clear, c));
+            }
+            _mm_storeu_si128((__m128i *)(dst + i), c);
+        }
+    }
+#endif
+    for (; i < count; i++)
+        dst[i] = blit_pixel(dst[i], src[i], t, opaque, mode);
+}
+
+/* Wraps an image coordinate to [0, size) */
+static int wrap_index(int value, int size)
+{
+    value %= size;
+    return value < 0 ? value + size : value;
+}
+
+/* Image coordinate v (of size) for a source that wraps or clamps at its edges */
+BLIT_INLINE int blit_source_index(int v, int size, const int wrap)
+{
+    if (wrap)
+        return wrap_index(v, size);
+    return v < 0 ? 0 : (v >= size ? size - 1 : v);
+}
+
+/* Generic kernel body; wrap = layer, scaled = nearest-neighbour sampling */
+BLIT_INLINE void blit_span(const SpriteBlit *b, uint32_t *row, int y, int x0, int x1,
+                           const int wrap, const int scaled, const int opaque, const int mode)
+{
+    int iw = b->image_width;
+    if (!scaled)
+    {
+        if (!wrap)
+        {
+            blit_row(row + x0, b->pixels + (size_t)(y + b->oy) * iw + (x0 + b->ox), x1 - x0, &b->tint, opaque, mode);
+            return;
+        }
+        const uint32_t *src = b->pixels + (size_t)wrap_index(y + b->oy, b->image_height) * iw;
+        int sx = wrap_index(x0 + b->ox, iw);
+        while (x0 < x1)
+        {
+            /* Up to the image's right edge, then around to its left edge */
+            int count = iw - sx < x1 - x0 ? iw - sx : x1 - x0;
+            blit_row(row + x0, src + sx, count, &b->tint, opaque, mode);
+            x0 += count;
+            sx = 0;
+        }
+        return;
+    }
+    int sy = blit_source_index((int)((y + 0.5f) / b->scale_y - b->y) + b->scroll_y, b->image_height, wrap);
+    const uint32_t *src = b->pixels + (size_t)sy * iw;
+    for (int x = x0; x < x1; x++)
+    {
+        int sx = blit_source_index((int)((x + 0.5f) / b->scale_x - b->x) + b->scroll_x, iw, wrap);
+        row[x] = blit_pixel(row[x], src[sx], &b->tint, opaque, mode);
+    }
+}
+
+/* One kernel per mode combination */
+#define BLIT_KERNEL(name, wrap, scaled, opaque, mode)                                 \
+    static void name(const SpriteBlit *b, uint32_t *row, int y, int x0, int x1)      \
+    {                                                                                \
+        blit_span(b, row, y, x0, x1, wrap, scaled, opaque, mode);                    \
+    }
+#define BLIT_KERNELS(prefix, wrap, scaled)                                           \
+    BLIT_KERNEL(prefix##_keyed, wrap, scaled, 0, BLIT_PLAIN)                         \
+    BLIT_KERNEL(prefix##_keyed_tint, wrap, scaled, 0, BLIT_TINT)                     \
+    BLIT_KERNEL(prefix##_keyed_fade, wrap, scaled, 0, BLIT_FADE)                     \
+    BLIT_KERNEL(prefix##_opaque, wrap, scaled, 1, BLIT_PLAIN)                        \
+    BLIT_KERNEL(prefix##_opaque_tint, wrap, scaled, 1, BLIT_TINT)                    \
+    BLIT_KERNEL(prefix##_opaque_fade, wrap, scaled, 1, BLIT_FADE)
+#define BLIT_TABLE(prefix)                                                           \
+    {{prefix##_keyed, prefix##_keyed_tint, prefix##_keyed_fade},                     \
+     {prefix##_opaque, prefix##_opaque_tint, prefix##_opaque_fade}}
+
+BLIT_KERNELS(blit_image, 0, 0)
+BLIT_KERNELS(blit_image_scaled, 0, 1)
+BLIT_KERNELS(blit_layer, 1, 0)
+BLIT_KERNELS(blit_layer_scaled, 1, 1)
+
+/* Indexed [layer][scaled][opaque][tint mode] */
+static const BlitKernel blit_kernels[2][2][2][3] = {
+    {BLIT_TABLE(blit_image), BLIT_TABLE(blit_image_scaled)},
+    {BLIT_TABLE(blit_layer), BLIT_TABLE(blit_layer_scaled)}};
+
+/* Color sprite kernels */
+static void blit_fill(const SpriteBlit *b, uint32_t *row, int y, int x0, int x1)
+{
+    (void)y;
+    fill_span(row + x0, (size_t)(x1 - x0), b->color, 0);
+}
+
+static void blit_blend(const SpriteBlit *b, uint32_t *row, int y, int x0, int x1)
+{
+    (void)y;
+    blend_span(row + x0, (size_t)(x1 - x0), b->color);
+}
+
+/* Picks a drawable sprite's kernel and fills in what it reads */
+static void sprite_blit(const ArcadeFramebuffer *target, const ArcadeAnySprite *sprite, int type, SpriteBlit *b)
+{
+    memset(b, 0, sizeof(*b));
+    if (type == SPRITE_COLOR)
+    {
+        uint32_t alpha = sprite->sprite.color >> 24;
+        b->color = sprite->sprite.color;
+        b->span = alpha != 0 && alpha != 0xFF ? blit_blend : blit_fill;
+        return;
+    }
+    int layer = type == SPRITE_LAYER, opaque, mode = BLIT_PLAIN;
+    if (layer)
+    {
+        const ArcadeScrollLayer *s = &sprite->layer;
+        b->pixels = s->pixels;
+        b->image_width = s->image_width;
+        b->image_height = s->image_height;
+        b->x = s->x;
+        b->y = s->y;
+        b->scroll_x = (int)s->scroll_x;
+        b->scroll_y = (int)s->scroll_y;
+        opaque = s->opaque != 0;
+        if (sprite_tint(s->tint, s->flash, &b->tint))
+            mode = b->tint.fade == 255 ? BLIT_TINT : BLIT_FADE;
+    }
+    else
+    {
+        const ArcadeImageSprite *s = &sprite->image_sprite;
+        b->pixels = s->pixels;
+        b->image_width = s->image_width;
+        b->image_height = s->image_height;
+        b->x = s->x;
+        b->y = s->y;
+        opaque = s->opaque != 0;
+        if (sprite_tint(s->tint, s->flash, &b->tint))
+            mode = b->tint.fade == 255 ? BLIT_TINT : BLIT_FADE;
+    }
+    b->ox = b->scroll_x - (int)b->x;
+    b->oy = b->scroll_y - (int)b->y;
+    b->scale_x = target->scale_x;
+    b->scale_y = target->scale_y;
+    int scaled = target->scale_x != 1.0f || target->scale_y != 1.0f;
+    b->span = blit_kernels[layer][scaled][opaque][mode];
+}
+
+/* Draws pixels [x0, x1) of row y of a sprite; they must lie in its sprite_rect */
+static void draw_sprite_span(ArcadeFramebuffer *target, const SpriteBlit *b, int y, int x0, int x1)
+{
+    b->span(b, target->pixels + (size_t)y * target->width, y, x0, x1);
+}
+
+/* Index of the lowest set bit of a nonzero word */
+static int lowest_bit(uint64_t word)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int n = 0;
+    while (!(word & 0xFF))
+    {
+        word >>= 8;
+        n += 8;
+    }
+    while (!(word & 1))
+    {
+        word >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/* First x in [x, end) whose coverage bit equals covered, or end */
+static int coverage_find(const uint64_t *row, int x, int end, int covered)
+{
+    while (x < end)
+    {
+        uint64_t word = covered ? row[x >> 6] : ~row[x >> 6];
+        word >>= x & 63;
+        if (word)
+        {
+            x += lowest_bit(word);
+            return x < end ? x : end;
+        }
+        x = (x | 63) + 1; /* Next word */
+    }
+    return end;
+}
+
+/* Marks pixels [x0, x1) of a coverage row (x0 < x1) */
+static void coverage_set(uint64_t *row, int x0, int x1)
+{
+    int first = x0 >> 6, last = (x1 - 1) >> 6;
+    uint64_t head = ~(uint64_t)0 << (x0 & 63);
+    uint64_t tail = ~(uint64_t)0 >> (63 - ((x1 - 1) & 63));
+    if (first == last)
+    {
+        row[first] |= head & tail;
+        return;
+    }
+    row[first] |= head;
+    for (int i = first + 1; i < last; i++)
+        row[i] = ~(uint64_t)0;
+    row[last] |= tail;
+}
+
+/* Draws row y of a sprite wherever the coverage row is clear; base = x of bit 0 */
+static void draw_uncovered(ArcadeFramebuffer *target, const SpriteBlit *b, int y,
+                           const uint64_t *row, int base, int x0, int x1)
+{
+    for (int x = coverage_find(row, x0 - base, x1 - base, 0); x < x1 - base;)
+    {
+        int end = coverage_find(row, x, x1 - base, 1);
+        draw_sprite_span(target, b, y, x + base, end + base);
+        x = coverage_find(row, end, x1 - base, 0);
+    }
+}
+
+/* Painter's algorithm: clear, then every sprite back-to-front */
+static void render_painter(ArcadeFramebuffer *target, const ArcadeAnySprite *sprites, int count, const int *types)
+{
+    fill_rect(target, 0, 0, target->width, target->height, target->bg_color & 0xFFFFFF); /* Clears are opaque */
+    for (int i = 0; i < count; i++)
+    {
+        SpriteRect r;
+        if (!sprite_rect(target, &sprites[i], types[i], &r))
+            continue;
+        if (types[i] == SPRITE_COLOR)
+            fill_rect(target, r.x0, r.y0, r.x1, r.y1, sprites[i].sprite.color);
+        else
+        {
+            SpriteBlit b;
+            sprite_blit(target, &sprites[i], types[i], &b);
+            for (int y = r.y0; y < r.y1; y++)
+                draw_sprite_span(target, &b, y, r.x0, r.x1);
+        }
+    }
+}
+
+void arcade_render_scene_to(ArcadeFramebuffer *target, const ArcadeAnySprite *sprites, int count, const int *types)
+{
+    if (!target || !target->pixels)
+        return;
+    int opaque = 0;
+    for (int i = 0; i < count && !opaque; i++)
+        opaque = sprite_is_opaque(&sprites[i], types[i]);
+    /* Masks and lists come from this thread's scratch arena, so a steady
+     * scene reuses the same memory every frame */
+    ArcadeArena *scratch = &frame_arena;
+    ArcadeArenaMark mark = arcade_arena_mark(scratch);
+    size_t words = ((size_t)target->width + 63) / 64;
+    uint64_t *coverage = opaque ? arcade_arena_alloc(scratch, words * target->height * sizeof(uint64_t), ARCADE_SIMD_ALIGN) : NULL;
+    DeferredSprite *deferred = coverage ? arcade_arena_alloc(scratch, (size_t)count * sizeof(DeferredSprite), 0) : NULL;
+    if (!deferred)
+    {
+        /* Nothing can hide anything (or no memory): draw it all */
+        arcade_arena_release(scratch, mark);
+        render_painter(target, sprites, count, types);
+        return;
+    }
+    memset(coverage, 0, words * target->height * sizeof(uint64_t));
+
+    /*
+     * Front-to-back: an opaque sprite draws only the pixels no sprite in front
+     * of it covers, then covers its own. See-through sprites (translucent
+     * colors, images with transparent pixels) depend on what is behind them,
+     * so they save the coverage of their area and draw afterwards.
+     */
+    uint64_t *saved = NULL;
+    size_t saved_used = 0, saved_size = 0;
+    int deferred_count = 0;
+    for (int i = count - 1; i >= 0; i--)
+    {
+        SpriteRect r;
+        if (!sprite_rect(target, &sprites[i], types[i], &r))
+            continue;
+        if (sprite_is_opaque(&sprites[i], types[i]))
+        {
+            SpriteBlit b;
+            sprite_blit(target, &sprites[i], types[i], &b);
+            for (int y = r.y0; y < r.y1; y++)
+            {
+                uint64_t *row = coverage + (size_t)y * words;
+                draw_uncovered(target, &b, y, row, 0, r.x0, r.x1);
+                coverage_set(row, r.x0, r.x1);
+            }
+            continue;
+        }
+        size_t first = (size_t)r.x0 >> 6, span = (((size_t)r.x1 - 1) >> 6) - first + 1;
+        size_t needed = saved_used + span * (size_t)(r.y1 - r.y0);
+        if (needed > saved_size)
+        {
+            size_t new_size = saved_size ? saved_size * 2 : words * target->height;
+            while (new_size < needed)
+                new_size *= 2;
+            uint64_t *grown = arcade_arena_alloc(scratch, new_size * sizeof(uint64_t), 0);
+            if (!grown)
+            {
+                arcade_arena_release(scratch, mark);
+                render_painter(target, sprites, count, types); /* Starts over with a clear */
+                return;
+            }
+            if (saved_used)
+                memcpy(grown, saved, saved_used * sizeof(uint64_t));
+            saved = grown;
+            saved_size = new_size;
+        }
+        for (int y = r.y0; y < r.y1; y++)
+            memcpy(saved + saved_used + (size_t)(y - r.y0) * span, coverage + (size_t)y * words + first, span * sizeof(uint64_t));
+        deferred[deferred_count++] = (DeferredSprite){i, r, saved_used};
+        saved_used = needed;
+    }
+
+    /* The clear is the rearmost opaque sprite */
+    uint32_t clear = target->bg_color & 0xFFFFFF;
+    for (int y = 0; y < target->height; y++)
+    {
+        const uint64_t *row = coverage + (size_t)y * words;
+        uint32_t *pixels = target->pixels + (size_t)y * target->width;
+        for (int x = coverage_find(row, 0, target->width, 0); x < target->width;)
+        {
+            int end = coverage_find(row, x, target->width, 1);
+            fill_span(pixels + x, (size_t)(end - x), clear, 0);
+            x = coverage_find(row, end, target->width, 0);
+        }
+    }
+
+    /* See-through sprites back-to-front, over everything behind them */
+    for (int d = deferred_count - 1; d >= 0; d--)
+    {
+        const DeferredSprite *s = &deferred[d];
+        int base = s->r.x0 & ~63;
+        size_t span = (((size_t)s->r.x1 - 1) >> 6) - ((size_t)s->r.x0 >> 6) + 1;
+        SpriteBlit b;
+        sprite_blit(target, &sprites[s->index], types[s->index], &b);
+        for (int y = s->r.y0; y < s->r.y1; y++)
+        {
+            const uint64_t *row = saved + s->saved + (size_t)(y - s->r.y0) * span;
+            draw_uncovered(target, &b, y, row, base, s->r.x0, s->r.x1);
+        }
+    }
+    arcade_arena_release(scratch, mark);
+}
+
+#if defined(ARCADE_HAS_XRENDER)
+/* An XRender color from 0xRRGGBB and an opacity (0-255), premultiplied */
+static XRenderColor xrender_color(uint32_t rgb, uint32_t alpha)
+{
+    XRenderColor color;
+    color.red = (unsigned short)(((rgb >> 16) & 0xFF) * alpha * 257 / 255);
+    color.green = (unsigned short)(((rgb >> 8) & 0xFF) * alpha * 257 / 255);
+    color.blue = (unsigned short)((rgb & 0xFF) * alpha * 257 / 255);
+    color.alpha = (unsigned short)(alpha * 257);
+    return color;
+}
+
+/*
+ * Composites [sx, sy) of an uploaded image into r of the frame, with the
+ * sprite's tint and flash. Untinted images are one Over; tinted ones punch
+ * out what they cover, then add the tinted pixels (a component-alpha mask
+ * multiplies each channel) and the flash.
+ */
+static void xrender_draw_image(Picture image, int sx, int sy, const SpriteRect *r, uint32_t tint, uint32_t flash)
+{
+    Display *d = state.display;
+    int w = r->x1 - r->x0, h = r->y1 - r->y0;
+    SpriteTint t;
+    if (!sprite_tint(tint, flash, &t))
+    {
+        XRenderComposite(d, PictOpOver, image, None, state.back_picture, sx, sy, 0, 0, r->x0, r->y0, w, h);
+        return;
+    }
+
+    XRenderColor fade = xrender_color(0, t.fade);
+    Picture fade_mask = t.fade != 255 ? XRenderCreateSolidFill(d, &fade) : None;
+    XRenderComposite(d, PictOpOutReverse, image, fade_mask, state.back_picture, sx, sy, 0, 0, r->x0, r->y0, w, h);
+
+    XRenderColor multiply = {
+        (unsigned short)(t.mul_r * t.fade * 257 / 255), (unsigned short)(t.mul_g * t.fade * 257 / 255),
+        (unsigned short)(t.mul_b * t.fade * 257 / 255), (unsigned short)(t.fade * 257)};
+    Picture tint_mask = XRenderCreateSolidFill(d, &multiply);
+    XRenderPictureAttributes attributes = {0};
+    attributes.component_alpha = True;
+    XRenderChangePicture(d, tint_mask, CPComponentAlpha, &attributes);
+    XRenderComposite(d, PictOpAdd, image, tint_mask, state.back_picture, sx, sy, 0, 0, r->x0, r->y0, w, h);
+    XRenderFreePicture(d, tint_mask);
+
+    if (t.add)
+    {
+        XRenderColor add = xrender_color(t.add, t.fade);
+        Picture flash_fill = XRenderCreateSolidFill(d, &add);
+        XRenderComposite(d, PictOpAdd, flash_fill, image, state.back_picture, 0, 0, sx, sy, r->x0, r->y0, w, h);
+        XRenderFreePicture(d, flash_fill);
+    }
+    if (fade_mask)
+        XRenderFreePicture(d, fade_mask);
+}
+
+/*
+ * arcade_render_scene for ARCADE_BACKEND_XRENDER: clears the server-side
+ * frame, composites the sprites in order and copies the frame to the window.
+ * Same sprite rectangles and image offsets as the software renderer.
+ */
+static void xrender_scene(const ArcadeAnySprite *sprites, int count, const int *types)
+{
+    Display *d = state.display;
+    ArcadeFramebuffer screen = {NULL, state.width, state.height, state.bg_color, 1.0f, 1.0f};
+    XRenderColor bg = xrender_color(state.bg_color, 0xFF);
+    XRenderFillRectangle(d, PictOpSrc, state.back_picture, &bg, 0, 0, state.width, state.height);
+
+    for (int i = 0; i < count; i++)
+    {
+        SpriteRect r;
+        if (!sprite_rect(&screen, &sprites[i], types[i], &r))
+            continue;
+        if (types[i] == SPRITE_COLOR)
+        {
+            uint32_t color = sprites[i].sprite.color, alpha = color >> 24;
+            int blend = alpha != 0 && alpha != 0xFF;
+            XRenderColor fill = xrender_color(color, blend ? alpha : 0xFF);
+            XRenderFillRectangle(d, blend ? PictOpOver : PictOpSrc, state.back_picture, &fill, r.x0, r.y0,
+                                 (unsigned)(r.x1 - r.x0), (unsigned)(r.y1 - r.y0));
+        }
+        else if (types[i] == SPRITE_LAYER)
+        {
+            const ArcadeScrollLayer *s = &sprites[i].layer;
+            Picture image = xrender_image(s->pixels, s->image_width, s->image_height);
+            if (image)
+                xrender_draw_image(image, wrap_index(r.x0 - (int)s->x + (int)s->scroll_x, s->image_width),
+                                   wrap_index(r.y0 - (int)s->y + (int)s->scroll_y, s->image_height), &r, s->tint, s->flash);
+        }
+        else
+        {
+            const ArcadeImageSprite *s = &sprites[i].image_sprite;
+            Picture image = xrender_image(s->pixels, s->image_width, s->image_height);
+            if (image)
+                xrender_draw_image(image, r.x0 - (int)s->x, r.y0 - (int)s->y, &r, s->tint, s->flash);
+        }
+    }
+    XRenderComposite(d, PictOpSrc, state.back_picture, None, state.window_picture, 0, 0, 0, 0, 0, 0, state.width, state.height);
+    state.server_frame = 1;
+}
+#endif
+
+#if !defined(ARCADE_HEADLESS) && !defined(_WIN32)
+/* =========================================================================
+ * 16-bit Rendering
+ * ========================================================================= */
+
+/* The window's RGB565 frame and its row length in pixels, or NULL at 32 bits */
+static uint16_t *rgb565_frame(size_t *stride)
+{
+    if (state.format != ARCADE_FORMAT_RGB565)
+        return NULL;
+#if defined(ARCADE_XCB)
+    *stride = state.display_stride / sizeof(uint16_t);
+    return state.display_pixels;
+#else
+    if (!state.image)
+        return NULL;
+    *stride = (size_t)state.image->bytes_per_line / sizeof(uint16_t);
+    return (uint16_t *)state.image->data;
+#endif
+}
+
+/* Sets count 16-bit pixels, the first at x of row y, to color (0xRRGGBB),
+ * dithered as arcade_convert_rgb565 would */
+static void fill_span_565(uint16_t *dst, size_t count, uint32_t color, int x, int y)
+{
+    uint16_t pattern[4]; /* The dither repeats every 4 pixels */
+    for (int k = 0; k < 4; k++)
+        pattern[k] = rgb565_pixel(color, dither_matrix[y & 3][(x + k) & 3]);
+    size_t i = 0;
+#if defined(ARCADE_SSE2)
+    __m128i v = _mm_set_epi16((short)pattern[3], (short)pattern[2], (short)pattern[1], (short)pattern[0],
+                              (short)pattern[3], (short)pattern[2], (short)pattern[1], (short)pattern[0]);
+    for (; i + 8 <= count; i += 8)
+        _mm_storeu_si128((__m128i *)(dst + i), v);
+#endif
+    for (; i < count; i++)
+        dst[i] = pattern[i & 3];
+}
+
+/*
+ * Blends color over count 16-bit pixels, the first at x of row y: each is
+ * widened to 8 bits per channel, blended as blend_span does and dithered
+ * back. Vector and scalar paths give identical results.
+ */
+static void blend_span_565(uint16_t *dst, size_t count, uint32_t color, int x, int y)
+{
+    uint32_t a = color >> 24, inv = 255 - a;
+    uint32_t sr = ((color >> 16) & 0xFF) * a + 128, sg = ((color >> 8) & 0xFF) * a + 128, sb = (color & 0xFF) * a + 128;
+    const uint8_t *row = dither_matrix[y & 3];
+    size_t i = 0;
+#if defined(ARCADE_SSE2)
+    /* One 16-bit lane per pixel and channel; 8 pixels span the pattern twice */
+    short offset_rb[8], offset_g[8];
+    for (int k = 0; k < 8; k++)
+    {
+        offset_rb[k] = (short)(row[(x + k) & 3] >> 1);
+        offset_g[k] = (short)(row[(x + k) & 3] >> 2);
+    }
+    const __m128i dither_rb = _mm_loadu_si128((const __m128i *)offset_rb), dither_g = _mm_loadu_si128((const __m128i *)offset_g);
+    const __m128i scale = _mm_set1_epi16((short)inv), max = _mm_set1_epi16(255);
+    const __m128i src_r = _mm_set1_epi16((short)sr), src_g = _mm_set1_epi16((short)sg), src_b = _mm_set1_epi16((short)sb);
+    const __m128i mask5 = _mm_set1_epi16(31), mask6 = _mm_set1_epi16(63);
+    const __m128i red = _mm_set1_epi16((short)0xF800), green = _mm_set1_epi16(0x07E0);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i r = _mm_srli_epi16(d, 11), g = _mm_and_si128(_mm_srli_epi16(d, 5), mask6), b = _mm_and_si128(d, mask5);
+        r = _mm_or_si128(_mm_slli_epi16(r, 3), _mm_srli_epi16(r, 2)); /* To 8 bits, 31 -> 255 */
+        g = _mm_or_si128(_mm_slli_epi16(g, 2), _mm_srli_epi16(g, 4));
+        b = _mm_or_si128(_mm_slli_epi16(b, 3), _mm_srli_epi16(b, 2));
+        r = _mm_add_epi16(_mm_mullo_epi16(r, scale), src_r);
+        g = _mm_add_epi16(_mm_mullo_epi16(g, scale), src_g);
+        b = _mm_add_epi16(_mm_mullo_epi16(b, scale), src_b);
+        r = _mm_srli_epi16(_mm_add_epi16(r, _mm_srli_epi16(r, 8)), 8); /* Exact / 255 */
+        g = _mm_srli_epi16(_mm_add_epi16(g, _mm_srli_epi16(g, 8)), 8);
+        b = _mm_srli_epi16(_mm_add_epi16(b, _mm_srli_epi16(b, 8)), 8);
+        r = _mm_min_epi16(_mm_add_epi16(r, dither_rb), max);
+        g = _mm_min_epi16(_mm_add_epi16(g, dither_g), max);
+        b = _mm_min_epi16(_mm_add_epi16(b, dither_rb), max);
+        __m128i out = _mm_or_si128(_mm_and_si128(_mm_slli_epi16(r, 8), red),
+                                   _mm_or_si128(_mm_and_si128(_mm_slli_epi16(g, 3), green), _mm_srli_epi16(b, 3)));
+        _mm_storeu_si128((__m128i *)(dst + i), out);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        uint32_t d = dst[i], r = d >> 11, g = (d >> 5) & 63, b = d & 31;
+        r = ((r << 3) | (r >> 2)) * inv + sr;
+        g = ((g << 2) | (g >> 4)) * inv + sg;
+        b = ((b << 3) | (b >> 2)) * inv + sb;
+        int threshold = row[(x + i) & 3];
+        r = ((r + (r >> 8)) >> 8) + (threshold >> 1);
+        g = ((g + (g >> 8)) >> 8) + (threshold >> 2);
+        b = ((b + (b >> 8)) >> 8) + (threshold >> 1);
+        r = r > 255 ? 255 : r;
+        g = g > 255 ? 255 : g;
+        b = b > 255 ? 255 : b;
+        dst[i] = (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+    }
+}
+
+/* Copies count pixels of a 16-bit image copy, keeping the target where the
+ * copy is RGB565_KEY */
+static void blit_keyed_565(uint16_t *dst, const uint16_t *src, int count)
+{
+    int i = 0;
+#if defined(ARCADE_SSE2)
+    const __m128i key = _mm_set1_epi16((short)RGB565_KEY);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m128i s = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+        __m128i clear = _mm_cmpeq_epi16(s, key);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_or_si128(_mm_and_si128(clear, d), _mm_andnot_si128(clear, s)));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        if (src[i] != RGB565_KEY)
+            dst[i] = src[i];
+    }
+}
+
+/* Draws pixels [x0, x1) of row y of an untinted sprite from its 16-bit copy;
+ * row = the start of that frame row */
+static void draw_span_565(uint16_t *row, const SpriteBlit *b, const uint16_t *rgb, int wrap, int opaque, int y, int x0, int x1)
+{
+    int iw = b->image_width;
+    const uint16_t *src = rgb + (size_t)(wrap ? wrap_index(y + b->oy, b->image_height) : y + b->oy) * iw;
+    int sx = wrap ? wrap_index(x0 + b->ox, iw) : x0 + b->ox;
+    while (x0 < x1)
+    {
+        /* Layers: up to the image's right edge, then around to its left edge */
+        int count = wrap && iw - sx < x1 - x0 ? iw - sx : x1 - x0;
+        if (opaque)
+            memcpy(row + x0, src + sx, (size_t)count * sizeof(uint16_t));
+        else
+            blit_keyed_565(row + x0, src + sx, count);
+        x0 += count;
+        sx = 0;
+    }
+}
+
+/* Draws pixels [x0, x1) of row y with the sprite's 32-bit kernel: they are
+ * widened into wide (a scratch row as long as the frame's), drawn there and
+ * dithered back */
+static void draw_span_wide(uint16_t *row, uint32_t *wide, const SpriteBlit *b, int y, int x0, int x1)
+{
+    for (int x = x0; x < x1; x++)
+    {
+        uint32_t p = row[x], r = p >> 11, g = (p >> 5) & 63, bl = p & 31;
+        wide[x] = 0xFF000000 | ((r << 3) | (r >> 2)) << 16 | ((g << 2) | (g >> 4)) << 8 | ((bl << 3) | (bl >> 2));
+    }
+    b->span(b, wide, y, x0, x1);
+    arcade_convert_rgb565(row + x0, wide + x0, x1 - x0, x0, y);
+}
+
+/*
+ * arcade_render_scene at RGB565: draws straight into the window's 16-bit
+ * frame, which arcade_present then sends as it is. Sprites go back to front
+ * from the last one that hides the whole frame (the clear only when none
+ * does). Colors and untinted images use the 16-bit kernels and copies;
+ * tinted and faded images go through their 32-bit kernel a span at a time.
+ * Returns 1 if there is no 16-bit frame to draw into.
+ */
+static int render_scene_565(const ArcadeAnySprite *sprites, int count, const int *types)
+{
+    size_t stride;
+    uint16_t *frame = rgb565_frame(&stride);
+    if (!frame)
+        return 1;
+    ArcadeFramebuffer screen = arcade_screen();
+    int first = -1;
+    for (int i = count - 1; i >= 0 && first < 0; i--)
+    {
+        SpriteRect r;
+        if (sprite_is_opaque(&sprites[i], types[i]) && sprite_rect(&screen, &sprites[i], types[i], &r) && r.x0 == 0 &&
+            r.y0 == 0 && r.x1 == screen.width && r.y1 == screen.height)
+            first = i;
+    }
+    if (first < 0)
+    {
+        for (int y = 0; y < screen.height; y++)
+            fill_span_565(frame + (size_t)y * stride, (size_t)screen.width, screen.bg_color & 0xFFFFFF, 0, y);
+        first = 0;
+    }
+
+    ArcadeArena *scratch = &frame_arena;
+    ArcadeArenaMark mark = arcade_arena_mark(scratch);
+    uint32_t *wide = NULL; /* Allocated by the first sprite that needs it */
+    for (int i = first; i < count; i++)
+    {
+        SpriteRect r;
+        if (!sprite_rect(&screen, &sprites[i], types[i], &r))
+            continue;
+        size_t width = (size_t)(r.x1 - r.x0);
+        if (types[i] == SPRITE_COLOR)
+        {
+            uint32_t color = sprites[i].sprite.color, alpha = color >> 24;
+            for (int y = r.y0; y < r.y1; y++)
+            {
+                uint16_t *row = frame + (size_t)y * stride + r.x0;
+                if (alpha != 0 && alpha != 0xFF)
+                    blend_span_565(row, width, color, r.x0, y);
+                else
+                    fill_span_565(row, width, color & 0xFFFFFF, r.x0, y);
+            }
+            continue;
+        }
+        SpriteBlit b;
+        SpriteTint tint;
+        sprite_blit(&screen, &sprites[i], types[i], &b);
+        int layer = types[i] == SPRITE_LAYER;
+        int opaque = layer ? sprites[i].layer.opaque : sprites[i].image_sprite.opaque;
+        int tinted = layer ? sprite_tint(sprites[i].layer.tint, sprites[i].layer.flash, &tint)
+                           : sprite_tint(sprites[i].image_sprite.tint, sprites[i].image_sprite.flash, &tint);
+        const uint16_t *rgb = tinted ? NULL : rgb565_image(b.pixels, b.image_width, b.image_height);
+        if (!rgb && !wide && !(wide = arcade_arena_alloc(scratch, (size_t)screen.width * sizeof(uint32_t), ARCADE_SIMD_ALIGN)))
+            continue; /* No memory to draw it with */
+        for (int y = r.y0; y < r.y1; y++)
+        {
+            uint16_t *row = frame + (size_t)y * stride;
+            if (rgb)
+                draw_span_565(row, &b, rgb, layer, opaque, y, r.x0, r.x1);
+            else
+                draw_span_wide(row, wide, &b, y, r.x0, r.x1);
+        }
+    }
+    arcade_arena_release(scratch, mark);
+    return 0;
+}
+#endif
+
+ArcadeFramebuffer arcade_screen(void)
+{
+    return (ArcadeFramebuffer){state.pixels, state.width, state.height, state.bg_color, 1.0f, 1.0f};
+}
+
+void arcade_render_scene(ArcadeAnySprite *sprites, int count, int *types)
+{
+#if defined(ARCADE_HAS_XRENDER)
+    if (backend_active == ARCADE_BACKEND_XRENDER)
+    {
+        xrender_scene(sprites, count, types);
+        return;
+    }
+#endif
+#if !defined(ARCADE_HEADLESS) && !defined(_WIN32)
+    if (render_scene_565(sprites, count, types) == 0)
+    {
+        frame_565 = scene_565 = 1; /* Sent as drawn, without a conversion pass */
+        arcade_present();
+        return;
+    }
+#endif
+    ArcadeFramebuffer screen = arcade_screen();
+    arcade_render_scene_to(&screen, sprites, count, types);
+    arcade_present();
+}
+
+void arcade_present(void)
+{
+#if defined(ARCADE_HEADLESS)
+    /* Nothing to present; the frame stays in the pixel buffer */
+#elif defined(_WIN32)
+    HDC memDC = CreateCompatibleDC(state.hdc);
+    SelectObject(memDC, state.hbitmap);
+    BitBlt(state.hdc, 0, 0, state.width, state.height, memDC, 0, 0, SRCCOPY);
+    DeleteDC(memDC);
+#elif defined(ARCADE_XCB)
+    if (!state.vsync || present_frame() != 0)
+    {
+        put_frame(state.window);
+        xcb_flush(state.connection);
+    }
+    frame_565 = 0;
+#else
+    if (state.format == ARCADE_FORMAT_RGB565 && !frame_565)
+    {
+        for (int y = 0; y < state.height; y++)
+            arcade_convert_rgb565((uint16_t *)(state.image->data + (size_t)y * state.image->bytes_per_line),
+                                  state.pixels + (size_t)y * state.width, state.width, 0, y);
+    }
+    XPutImage(state.display, state.window, state.gc, state.image, 0, 0, 0, 0, state.width, state.height);
+    frame_565 = 0;
+#endif
+}
+
+void arcade_render_text(const char *text, float x, float y, unsigned int color)
+{
+    if (!text)
+        return;
+#if defined(ARCADE_HEADLESS)
+    (void)x;
+    (void)y;
+    (void)color; /* No font without a window system */
+#elif defined(_WIN32)
+    if (!state.hfont)
+    {
+        arcade_log(ARCADE_LOG_WARN, "arcade", "arcade_render_text: Skipping (font=%p)", (void *)state.hfont);
+        return;
+    }
+    HDC memDC = CreateCompatibleDC(state.hdc);
+    SelectObject(memDC, state.hbitmap);
+    SelectObject(memDC, state.hfont);
+    SetTextColor(memDC, color);
+    SetBkMode(memDC, TRANSPARENT);
+    TextOut(memDC, (int)x, (int)y, text, strlen(text));
+    BitBlt(state.hdc, 0, 0, state.width, state.height, memDC, 0, 0, SRCCOPY);
+    DeleteDC(memDC);
+#elif defined(ARCADE_XCB)
+    if (!state.connection)
+        return;
+    xcb_change_gc(state.connection, state.gc, XCB_GC_FOREGROUND, &(uint32_t){display_color(color)});
+    /* With vsync the text joins the frame waiting in its pixmap, which is
+     * only presented once the frame is done (present_send) */
+    xcb_drawable_t target = state.present_pending >= 0 ? state.present_pixmaps[state.present_pending] : state.window;
+    /* PolyText8 items: length, delta, then up to 254 characters */
+    size_t length = strlen(text);
+    uint8_t items[256];
+    for (size_t done = 0; done < length;)
+    {
+        uint8_t count = (uint8_t)(length - done < 254 ? length - done : 254);
+        items[0] = count;
+        items[1] = 0;
+        memcpy(items + 2, text + done, count);
+        xcb_poly_text_8(state.connection, target, state.gc, (int16_t)x + (int16_t)(done * state.char_width), (int16_t)y,
+                        count + 2, items);
+        done += count;
+    }
+    xcb_flush(state.connection);
+#else
+    if (!state.font)
+    {
+        arcade_log(ARCADE_LOG_WARN, "arcade", "arcade_render_text: Skipping (font=%p)", (void *)state.font);
+        return;
+    }
+    XSetForeground(state.display, state.gc, display_color(color));
+    XSetFont(state.display, state.gc, state.font->fid);
+    XDrawString(state.display, state.window, state.gc, (int)x, (int)y, text, strlen(text));
+    XFlush(state.display);
+#endif
+}
+
+void arcade_render_text_centered(const char *text, float y, unsigned int color)
+{
+    if (!text)
+        return;
+#if defined(ARCADE_HEADLESS)
+    (void)y;
+    (void)color; /* No font without a window system */
+#elif defined(_WIN32)
+    if (!state.hfont)
+        return;
+    SIZE size;
+    HDC memDC = CreateCompatibleDC(state.hdc);
+    SelectObject(memDC, state.hfont);
+    GetTextExtentPoint32(memDC, text, strlen(text), &size);
+    float x = (state.width - size.cx) / 2.0f;
+    arcade_render_text(text, x, y, color);
+    DeleteDC(memDC);
+#elif defined(ARCADE_XCB)
+    if (!state.connection)
+        return;
+    if (!state.char_width && state.font_request)
+    {
+        /* Only if the metrics are still on their way: wait once for them */
+        xcb_query_font_reply_t *font = xcb_query_font_reply(state.connection, (xcb_query_font_cookie_t){state.font_request}, NULL);
+        state.font_request = 0;
+        state.char_width = font ? font->max_bounds.character_width : 9;
+        free(font);
+    }
+    int text_width = (int)strlen(text) * state.char_width; /* Fixed-width font */
+    float x = (state.width - text_width) / 2.0f;
+    arcade_render_text(text, x, y, color);
+#else
+    if (!state.font)
+        return;
+    int text_width = XTextWidth(state.font, text, strlen(text));
+    float x = (state.width - text_width) / 2.0f;
+    arcade_render_text(text, x, y, color);
+#endif
+}
+
+void arcade_render_text_centered_blink(const char *text, float y, unsigned int color, int blink_interval)
+{
+    if (!text)
+        return;
+    if ((global_frame_counter % (2 * blink_interval)) < blink_interval)
+    {
+        arcade_render_text_centered(text, y, color);
+    }
+}
+
+/* =========================================================================
+ * Vector Shapes
+ * ========================================================================= */
+
+/* Floor and ceiling of a pixel coordinate, without a libm call per pixel */
+static int floor_px(float v)
+{
+    int i = (int)v;
+    return i - (v < (float)i);
+}
+
+static int ceil_px(float v)
+{
+    int i = (int)v;
+    return i + (v > (float)i);
+}
+
+/* Polygon edge: the rows whose centers it spans, and its x along them */
+typedef struct
+{
+    int first, end;     /* Rows [first, end) */
+    float x, y, slope;  /* Upper end point, and x per unit of y */
+} ShapeEdge;
+
+/* Writes pixels [x0, x1) of row y, clipped; opaque or blended like fill_rect */
+static void shape_span(ArcadeFramebuffer *target, int y, int x0, int x1, uint32_t color)
+{
+    if (y < 0 || y >= target->height)
+        return;
+    if (x0 < 0)
+        x0 = 0;
+    if (x1 > target->width)
+        x1 = target->width;
+    if (x0 >= x1)
+        return;
+    uint32_t *dst = target->pixels + (size_t)y * target->width + x0;
+    uint32_t alpha = color >> 24;
+    if (alpha != 0 && alpha != 0xFF)
+        blend_span(dst, (size_t)(x1 - x0), color);
+    else
+        fill_span(dst, (size_t)(x1 - x0), color, 0);
+}
+
+/* Draws one pixel of an antialiased line; alpha = the color's (0 = opaque) scaled by coverage/255 */
+static inline void shape_plot(ArcadeFramebuffer *target, int x, int y, uint32_t color, uint32_t alpha, uint32_t coverage)
+{
+    if ((unsigned)x >= (unsigned)target->width || (unsigned)y >= (unsigned)target->height)
+        return;
+    alpha = (alpha * coverage + 128) * 257 >> 16; /* alpha * coverage / 255, rounded */
+    if (alpha == 0)
+        return;
+    uint32_t *dst = target->pixels + (size_t)y * target->width + x;
+    if (alpha == 0xFF)
+    {
+        *dst = color;
+        return;
+    }
+    /* Same result as blend_span, with red and blue in one 32-bit multiply
+     * (16 bits apart, so the products cannot carry into each other) */
+    uint32_t d = *dst, inv = 255 - alpha;
+    uint32_t rb = (d & 0xFF00FF) * inv + (color & 0xFF00FF) * alpha + 0x800080;
+    uint32_t g = ((d >> 8) & 0xFF) * inv + ((color >> 8) & 0xFF) * alpha + 128;
+    rb = ((rb + ((rb >> 8) & 0xFF00FF)) >> 8) & 0xFF00FF;
+    g = (g + (g >> 8)) >> 8;
+    *dst = (d & 0xFF000000) | rb | (g << 8);
+}
+
+/* Clips a line to the target grown by margin pixels (Liang-Barsky); 0 if it misses */
+static int clip_line(const ArcadeFramebuffer *target, float margin, float *x0, float *y0, float *x1, float *y1)
+{
+    if (*x0 >= 0.0f && *x1 >= 0.0f && *y0 >= 0.0f && *y1 >= 0.0f && *x0 <= target->width && *x1 <= target->width &&
+        *y0 <= target->height && *y1 <= target->height)
+        return 1; /* Inside already; the common case */
+    float dx = *x1 - *x0, dy = *y1 - *y0, t0 = 0.0f, t1 = 1.0f;
+    float p[4] = {-dx, dx, -dy, dy};
+    float q[4] = {*x0 + margin, target->width + margin - *x0, *y0 + margin, target->height + margin - *y0};
+    for (int i = 0; i < 4; i++)
+    {
+        if (p[i] == 0.0f)
+        {
+            if (q[i] < 0.0f)
+                return 0; /* Parallel to this edge and outside it */
+            continue;
+        }
+        float t = q[i] / p[i];
+        if (p[i] < 0.0f)
+        {
+            if (t > t1)
+                return 0;
+            if (t > t0)
+                t0 = t;
+        }
+        else
+        {
+            if (t < t0)
+                return 0;
+            if (t < t1)
+                t1 = t;
+        }
+    }
+    float sx = *x0, sy = *y0;
+    *x0 = sx + t0 * dx;
+    *y0 = sy + t0 * dy;
+    *x1 = sx + t1 * dx;
+    *y1 = sy + t1 * dy;
+    return 1;
+}
+
+void arcade_draw_line(ArcadeFramebuffer *target, float x0, float y0, float x1, float y1, uint32_t color)
+{
+    if (!target || !target->pixels || !clip_line(target, 1.0f, &x0, &y0, &x1, &y1))
+        return;
+    int x = floor_px(x0), y = floor_px(y0);
+    int end_x = floor_px(x1), end_y = floor_px(y1);
+    int dx = abs(end_x - x), dy = -abs(end_y - y);
+    int step_x = x < end_x ? 1 : -1, step_y = y < end_y ? 1 : -1;
+    int err = dx + dy;
+    int run = x; /* First pixel of the current row */
+    while (x != end_x || y != end_y)
+    {
+        int e2 = 2 * err, last = x;
+        if (e2 >= dy)
+        {
+            err += dy;
+            x += step_x;
+        }
+        if (e2 <= dx)
+        {
+            /* Leaving the row: write its pixels as one span */
+            err += dx;
+            shape_span(target, y, run < last ? run : last, (run < last ? last : run) + 1, color);
+            y += step_y;
+            run = x;
+        }
+    }
+    shape_span(target, y, run < x ? run : x, (run < x ? x : run) + 1, color);
+}
+
+void arcade_draw_line_aa(ArcadeFramebuffer *target, float x0, float y0, float x1, float y1, uint32_t color)
+{
+    if (!target || !target->pixels || !clip_line(target, 2.0f, &x0, &y0, &x1, &y1))
+        return;
+    uint32_t alpha = color >> 24 ? color >> 24 : 0xFF;
+    /* Move pixel centers to integer coordinates, as Wu's algorithm has them */
+    x0 -= 0.5f;
+    y0 -= 0.5f;
+    x1 -= 0.5f;
+    y1 -= 0.5f;
+    int steep = fabsf(y1 - y0) > fabsf(x1 - x0);
+    float t;
+    if (steep)
+    {
+        t = x0, x0 = y0, y0 = t;
+        t = x1, x1 = y1, y1 = t;
+    }
+    if (x0 > x1)
+    {
+        t = x0, x0 = x1, x1 = t;
+        t = y0, y0 = y1, y1 = t;
+    }
+    float dx = x1 - x0, gradient = dx == 0.0f ? 1.0f : (y1 - y0) / dx;
+
+    /* End points: weighted by how much of their pixel the line covers */
+    int xs[2];
+    for (int end = 0; end < 2; end++)
+    {
+        float px = end ? x1 : x0, py = end ? y1 : y0;
+        int ix = floor_px(px + 0.5f);
+        float yend = py + gradient * (ix - px);
+        float xgap = end ? (px + 0.5f) - ix : 1.0f - ((px + 0.5f) - ix);
+        int iy = floor_px(yend);
+        uint32_t lower = (uint32_t)((yend - iy) * xgap * 255.0f + 0.5f);
+        uint32_t upper = (uint32_t)((1.0f - (yend - iy)) * xgap * 255.0f + 0.5f);
+        xs[end] = ix;
+        if (steep)
+        {
+            shape_plot(target, iy, ix, color, alpha, upper);
+            shape_plot(target, iy + 1, ix, color, alpha, lower);
+        }
+        else
+        {
+            shape_plot(target, ix, iy, color, alpha, upper);
+            shape_plot(target, ix, iy + 1, color, alpha, lower);
+        }
+    }
+
+    /* Between them: the two pixels straddling the line at each step, with
+     * y in 16.16 fixed point (clipping keeps it within a few pixels of the
+     * buffer, far inside the range) */
+    int32_t fy = (int32_t)((y0 + gradient * ((float)xs[0] - x0) + gradient) * 65536.0f);
+    int32_t step = (int32_t)(gradient * 65536.0f);
+    for (int x = xs[0] + 1; x < xs[1]; x++, fy += step)
+    {
+        int iy = fy >> 16; /* Floor, also below zero */
+        uint32_t lower = (uint32_t)(fy >> 8) & 0xFF;
+        if (steep)
+        {
+            shape_plot(target, iy, x, color, alpha, 255 - lower);
+            shape_plot(target, iy + 1, x, color, alpha, lower);
+        }
+        else
+        {
+            shape_plot(target, x, iy, color, alpha, 255 - lower);
+            shape_plot(target, x, iy + 1, color, alpha, lower);
+        }
+    }
+}
+
+void arcade_fill_polygon(ArcadeFramebuffer *target, const ArcadePoint *points, int count, uint32_t color)
+{
+    if (!target || !target->pixels || !points || count < 3)
+        return;
+    /* Edges, active edges and crossings; a row crosses at most count edges */
+    ShapeEdge stack_edges[32];
+    int stack_active[32];
+    float stack_crossings[32];
+    ShapeEdge *edges = stack_edges;
+    int *active = stack_active;
+    float *crossings = stack_crossings;
+    ArcadeArenaMark mark = arcade_arena_mark(&frame_arena);
+    if (count > 32)
+    {
+        edges = arcade_arena_alloc(&frame_arena, (size_t)count * (sizeof(ShapeEdge) + sizeof(int) + sizeof(float)), 0);
+        if (!edges)
+            return;
+        active = (int *)(edges + count);
+        crossings = (float *)(active + count);
+    }
+
+    /* Edges spanning at least one visible row's center (y + 0.5), sorted by first row */
+    int edge_count = 0;
+    for (int i = 0, j = count - 1; i < count; j = i++)
+    {
+        const ArcadePoint *a = &points[j], *b = &points[i];
+        if (a->y > b->y)
+        {
+            const ArcadePoint *swap = a;
+            a = b;
+            b = swap;
+        }
+        ShapeEdge e = {ceil_px(a->y - 0.5f), ceil_px(b->y - 0.5f), a->x, a->y, 0.0f};
+        if (e.first < 0)
+            e.first = 0;
+        if (e.end > target->height)
+            e.end = target->height;
+        if (e.first >= e.end)
+            continue; /* Horizontal, or off the buffer */
+        e.slope = (b->x - a->x) / (b->y - a->y);
+        int k = edge_count++;
+        for (; k > 0 && edges[k - 1].first > e.first; k--)
+            edges[k] = edges[k - 1];
+        edges[k] = e;
+    }
+
+    /* Scanlines: only the edges crossing the row are looked at */
+    int active_count = 0, next = 0;
+    for (int y = edge_count ? edges[0].first : 0; next < edge_count || active_count; y++)
+    {
+        while (next < edge_count && edges[next].first == y)
+            active[active_count++] = next++;
+        float cy = y + 0.5f;
+        int n = 0;
+        for (int i = 0; i < active_count; i++)
+        {
+            const ShapeEdge *e = &edges[active[i]];
+            if (e->end <= y)
+            {
+                active[i--] = active[--active_count]; /* Finished */
+                continue;
+            }
+            crossings[n++] = e->x + (cy - e->y) * e->slope;
+        }
+        if (n == 2)
+        {
+            /* Most rows of most shapes: one span, ordered without branching */
+            float left = crossings[0] < crossings[1] ? crossings[0] : crossings[1];
+            float right = crossings[0] < crossings[1] ? crossings[1] : crossings[0];
+            shape_span(target, y, ceil_px(left - 0.5f), ceil_px(right - 0.5f), color);
+            continue;
+        }
+        for (int i = 1; i < n; i++) /* Insertion sort; n is small */
+        {
+            float x = crossings[i];
+            int k = i;
+            for (; k > 0 && crossings[k - 1] > x; k--)
+                crossings[k] = crossings[k - 1];
+            crossings[k] = x;
+        }
+        for (int k = 0; k + 1 < n; k += 2)
+            shape_span(target, y, ceil_px(crossings[k] - 0.5f), ceil_px(crossings[k + 1] - 0.5f), color);
+    }
+    arcade_arena_release(&frame_arena, mark);
+}
+
+void arcade_draw_polygon(ArcadeFramebuffer *target, const ArcadePoint *points, int count, uint32_t color)
+{
+    if (!points || count < 2)
+        return;
+    for (int i = 0, j = count - 1; i < count; j = i++)
+        arcade_draw_line(target, points[j].x, points[j].y, points[i].x, points[i].y, color);
+}
+
+void arcade_draw_polygon_aa(ArcadeFramebuffer *target, const ArcadePoint *points, int count, uint32_t color)
+{
+    if (!points || count < 2)
+        return;
+    for (int i = 0, j = count - 1; i < count; j = i++)
+        arcade_draw_line_aa(target, points[j].x, points[j].y, points[i].x, points[i].y, color);
+}
+
+void arcade_fill_circle(ArcadeFramebuffer *target, float cx, float cy, float radius, uint32_t color)
+{
+    if (!target || !target->pixels || radius <= 0.0f)
+        return;
+    int y0 = ceil_px(cy - radius - 0.5f), y1 = ceil_px(cy + radius - 0.5f);
+    if (y0 < 0)
+        y0 = 0;
+    if (y1 > target->height)
+        y1 = target->height;
+    for (int y = y0; y < y1; y++)
+    {
+        float dy = y + 0.5f - cy;
+        float half = radius * radius - dy * dy;
+        if (half <= 0.0f)
+            continue;
+        half = sqrtf(half); /* Half the chord at this row's centers */
+        shape_span(target, y, ceil_px(cx - half - 0.5f), ceil_px(cx + half - 0.5f), color);
+    }
+}
+
+/* =========================================================================
+ * Pixel Passes
+ * ========================================================================= */
+
+#define PASS_PARALLEL_PIXELS 65536 /* Smaller frames are not worth waking the pool */
+
+typedef struct
+{
+    ArcadeFramebuffer *target;
+    ArcadePixelKernel kernel;
+    void *user;
+} PixelPass;
+
+/* One pool item: one row (the pool hands out rows in bands) */
+static void pixel_pass_row(void *context, int index, int worker)
+{
+    const PixelPass *pass = context;
+    (void)worker;
+    pass->kernel(pass->target->pixels + (size_t)index * pass->target->width, pass->target->width, 0, index, pass->user);
+}
+
+void arcade_pixel_pass_to(ArcadeFramebuffer *target, ArcadePixelKernel kernel, void *user)
+{
+    if (!target || !target->pixels || !kernel || target->width <= 0 || target->height <= 0)
+        return;
+    PixelPass pass = {target, kernel, user};
+    if ((size_t)target->width * target->height >= PASS_PARALLEL_PIXELS && pass_pool_state == 0)
+        pass_pool_state = arcade_pool_init(&pass_pool, 0) == 0 ? 1 : -1;
+    if ((size_t)target->width * target->height < PASS_PARALLEL_PIXELS || pass_pool_state != 1)
+    {
+        for (int y = 0; y < target->height; y++)
+            pixel_pass_row(&pass, y, 0);
+        return;
+    }
+    arcade_pool_run(&pass_pool, target->height, pixel_pass_row, &pass);
+}
+
+int arcade_pixel_pass(ArcadePixelKernel kernel, void *user)
+{
+#if defined(ARCADE_HAS_XRENDER)
+    if (state.server_frame)
+        return 1; /* The frame was composited on the server */
+#endif
+#if !defined(ARCADE_HEADLESS) && !defined(_WIN32)
+    if (scene_565)
+        return 1; /* The frame was drawn at 16 bits */
+#endif
+    if (!state.pixels)
+        return 1;
+    ArcadeFramebuffer screen = arcade_screen();
+    arcade_pixel_pass_to(&screen, kernel, user);
+    return 0;
+}
+
+void arcade_effect_mix(uint32_t *pixels, int count, int x, int y, void *user)
+{
+    const ArcadeMix *mix = user;
+    (void)x;
+    (void)y;
+    if (mix->amount <= 0)
+        return;
+    if (mix->amount >= 255)
+        fill_span(pixels, (size_t)count, (pixels[0] & 0xFF000000) | (mix->color & 0xFFFFFF), 0);
+    else
+        blend_span(pixels, (size_t)count, ((uint32_t)mix->amount << 24) | (mix->color & 0xFFFFFF));
+}
+
+void arcade_effect_scanlines(uint32_t *pixels, int count, int x, int y, void *user)
+{
+    const ArcadeScanlines *lines = user;
+    (void)x;
+    if (lines->spacing < 1 || y % lines->spacing != lines->spacing - 1 || lines->level >= 255)
+        return;
+    int dark = lines->level <= 0 ? 255 : 255 - lines->level;
+    blend_span(pixels, (size_t)count, (uint32_t)dark << 24); /* Black at 255 - level: pixel * level / 255 */
+}
+
+void arcade_effect_grade(uint32_t *pixels, int count, int x, int y, void *user)
+{
+    const ArcadeColorGrade *grade = user;
+    (void)x;
+    (void)y;
+    for (int i = 0; i < count; i++)
+    {
+        uint32_t c = pixels[i];
+        pixels[i] = (c & 0xFF000000) | ((uint32_t)grade->r[(c >> 16) & 0xFF] << 16) |
+                    ((uint32_t)grade->g[(c >> 8) & 0xFF] << 8) | grade->b[c & 0xFF];
+    }
+}
+
+void arcade_color_grade_init(ArcadeColorGrade *grade, float brightness, float contrast, float gamma)
+{
+    if (!grade)
+        return;
+    for (int i = 0; i < 256; i++)
+    {
+        float v = i / 255.0f;
+        if (gamma > 0.0f && gamma != 1.0f)
+            v = powf(v, gamma);
+        v = (v - 0.5f) * contrast + 0.5f + brightness;
+        int value = (int)(v * 255.0f + 0.5f);
+        value = value < 0 ? 0 : value > 255 ? 255 : value;
+        grade->r[i] = grade->g[i] = grade->b[i] = (uint8_t)value;
+    }
+}
+
+#undef PASS_PARALLEL_PIXELS
+
+/* =========================================================================
+ * Sprite Groups
+ * ========================================================================= */
+
+void arcade_init_group(SpriteGroup *group, int capacity)
+{
+    group->sprites = arcade_alloc(capacity * sizeof(ArcadeAnySprite), 0);
+    group->types = arcade_alloc(capacity * sizeof(int), 0);
+    group->count = 0;
+    group->capacity = capacity;
+}
+
+void arcade_add_sprite_to_group(SpriteGroup *group, ArcadeAnySprite sprite, int type)
+{
+    if (group->count < group->capacity)
+    {
+        group->sprites[group->count] = sprite;
+        group->types[group->count] = type;
+        group->count++;
+    }
+}
+
+void arcade_add_animated_to_group(SpriteGroup *group, ArcadeAnimatedSprite *anim)
+{
+    if (!anim || !anim->frames[0].active)
+        return;
+    arcade_add_sprite_to_group(group, (ArcadeAnySprite){.image_sprite = anim->frames[anim->current_frame]}, SPRITE_IMAGE);
+}
+
+void arcade_render_group(SpriteGroup *group)
+{
+    arcade_render_scene(group->sprites, group->count, group->types);
+}
+
+void arcade_free_group(SpriteGroup *group)
+{
+    arcade_free(group->sprites);
+    arcade_free(group->types);
+    group->count = 0;
+    group->capacity = 0;
+}
+
+/* =========================================================================
+ * Audio
+ * ========================================================================= */
+
+int arcade_play_sound(const char *audio_file_path)
+{
+#if defined(ARCADE_HEADLESS)
+    (void)audio_file_path; /* Silent without a window system */
+    return 0;
+#elif defined(_WIN32)
+    /* Play WAV file asynchronously using Windows API */
+    return PlaySound(audio_file_path, NULL, SND_FILENAME | SND_ASYNC) ? 0 : 1;
+#else
+    /* Use aplay to play WAV file in the background on Linux */
+    char command[256];
+    snprintf(command, sizeof(command), "aplay -q %s &", audio_file_path); /* Quiet playback in background */
+    return system(command); /* Execute system command and return status */
+#endif
+}
+
+int arcade_stop_sound(void)
+{
+#if defined(ARCADE_HEADLESS)
+    return 0;
+#elif defined(_WIN32)
+    /* Stop any currently playing sound using Windows API */
+    return PlaySound(NULL, NULL, 0) ? 0 : 1;
+#else
+    /* Terminate all background aplay processes on Linux */
+    return system("pkill -f 'aplay -q' > /dev/null 2>&1"); /* Kill aplay processes silently */
+#endif
+}
+
+/* =========================================================================
+ * Image Manipulation
+ * ========================================================================= */
+
+char *arcade_flip_image(const char *input_path, int flip_type)
+{
+    int width, height;
+    unsigned char *data = image_load(input_path, &width, &height);
+    if (!data)
+    {
+        fprintf(stderr, "Failed to load image %s for flipping\n", input_path);
+        return NULL;
+    }
+    unsigned char *flipped_data = arcade_alloc((size_t)width * height * 4, 0);
+    if (!flipped_data)
+    {
+        stbi_image_free(data);
+        fprintf(stderr, "Memory allocation failed for flipped image\n");
+        return NULL;
+    }
+    if (flip_type == 1)
+    {
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                int src_idx = (height - 1 - y) * width * 4 + x * 4;
+                int dst_idx = y * width * 4 + x * 4;
+                for (int c = 0; c < 4; c++)
+                {
+                    flipped_data[dst_idx + c] = data[src_idx + c];
+                }
+            }
+        }
+    }
+    else
+    {
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                int src_idx = y * width * 4 + (width - 1 - x) * 4;
+                int dst_idx = y * width * 4 + x * 4;
+                for (int c = 0; c < 4; c++)
+                {
+                    flipped_data[dst_idx + c] = data[src_idx + c];
+                }
+            }
+        }
+    }
+#ifdef _WIN32
+    char temp_path[MAX_PATH];
+    if (!GetTempFileName(".", "arc", 0, temp_path))
+    {
+        stbi_image_free(data);
+        arcade_free(flipped_data);
+        fprintf(stderr, "Failed to create temporary file\n");
+        return NULL;
+    }
+    char full_path[MAX_PATH];
+    snprintf(full_path, sizeof(full_path), "%s.png", temp_path);
+#else
+    char temp_path[] = "/tmp/arcade_flip_XXXXXX";
+    int fd = mkstemp(temp_path);
+    if (fd == -1)
+    {
+        stbi_image_free(data);
+        arcade_free(flipped_data);
+        fprintf(stderr, "Failed to create temporary file: %s\n", strerror(errno));
+        return NULL;
+    }
+    close(fd);
+    char full_path[sizeof(temp_path) + 4];
+    snprintf(full_path, sizeof(full_path), "%s.png", temp_path);
+#endif
+    if (!stbi_write_png(full_path, width, height, 4, flipped_data, width * 4))
+    {
+        remove(full_path);
+        stbi_image_free(data);
+        arcade_free(flipped_data);
+        fprintf(stderr, "Failed to write flipped image to %s\n", full_path);
+        return NULL;
+    }
+    stbi_image_free(data);
+    arcade_free(flipped_data);
+#ifdef _WIN32
+    char *result = strdup(full_path);
+    if (!result)
+    {
+        DeleteFile(temp_path);
+        fprintf(stderr, "Failed to duplicate path\n");
+        return NULL;
+    }
+    DeleteFile(temp_path);
+    return result;
+#else
+    char *result = strdup(full_path);
+    if (!result)
+    {
+        remove(temp_path);
+        fprintf(stderr, "Failed to duplicate path\n");
+        return NULL;
+    }
+    return result;
+#endif
+}
+
+char *arcade_rotate_image(const char *input_path, int degrees)
+{
+    int width, height;
+    unsigned char *data = image_load(input_path, &width, &height);
+    if (!data)
+    {
+        fprintf(stderr, "Failed to load image %s for rotation\n", input_path);
+        return NULL;
+    }
+    int new_width = (degrees == 90 || degrees == 270) ? height : width;
+    int new_height = (degrees == 90 || degrees == 270) ? width : height;
+    unsigned char *rotated_data = arcade_alloc((size_t)new_width * new_height * 4, 0);
+    if (!rotated_data)
+    {
+        stbi_image_free(data);
+        fprintf(stderr, "Memory allocation failed for rotated image\n");
+        return NULL;
+    }
+    for (int y = 0; y < new_height; y++)
+    {
+        for (int x = 0; x < new_width; x++)
+        {
+            int src_x, src_y;
+            if (degrees == 90)
+            {
+                src_x = y;
+                src_y = new_width - 1 - x;
+            }
+            else if (degrees == 180)
+            {
+                src_x = width - 1 - x;
+                src_y = height - 1 - y;
+            }
+            else if (degrees == 270)
+            {
+                src_x = new_height - 1 - y;
+                src_y = x;
+            }
+            else
+            {
+                src_x = x;
+                src_y = y;
+            }
+            int src_idx = src_y * width * 4 + src_x * 4;
+            int dst_idx = y * new_width * 4 + x * 4;
+            for (int c = 0; c < 4; c++)
+            {
+                rotated_data[dst_idx + c] = data[src_idx + c];
+            }
+        }
+    }
+#ifdef _WIN32
+    char temp_path[MAX_PATH];
+    if (!GetTempFileName(".", "arc", 0, temp_path))
+    {
+        stbi_image_free(data);
+        arcade_free(rotated_data);
+        fprintf(stderr, "Failed to create temporary file\n");
+        return NULL;
+    }
+    char full_path[MAX_PATH];
+    snprintf(full_path, sizeof(full_path), "%s.png", temp_path);
+#else
+    char temp_path[] = "/tmp/arcade_rotate_XXXXXX";
+    int fd = mkstemp(temp_path);
+    if (fd == -1)
+    {
+        stbi_image_free(data);
+        arcade_free(rotated_data);
+        fprintf(stderr, "Failed to create temporary file: %s\n", strerror(errno));
+        return NULL;
+    }
+    close(fd);
+    char full_path[sizeof(temp_path) + 4];
+    snprintf(full_path, sizeof(full_path), "%s.png", temp_path);
+#endif
+    if (!stbi_write_png(full_path, new_width, new_height, 4, rotated_data, new_width * 4))
+    {
+        remove(full_path);
+        stbi_image_free(data);
+        arcade_free(rotated_data);
+        fprintf(stderr, "Failed to write rotated image to %s\n", full_path);
+        return NULL;
+    }
+    stbi_image_free(data);
+    arcade_free(rotated_data);
+#ifdef _WIN32
+    char *result = strdup(full_path);
+    if (!result)
+    {
+        DeleteFile(temp_path);
+        fprintf(stderr, "Failed to duplicate path\n");
+        return NULL;
+    }
+    DeleteFile(temp_path);
+    return result;
+#else
+    char *result = strdup(full_path);
+    if (!result)
+    {
+        remove(temp_path);
+        fprintf(stderr, "Failed to duplicate path\n");
+        return NULL;
+    }
+    return result;
+#endif
+}
+
+/* =========================================================================
+ * Snapshots
+ * ========================================================================= */
+
+int arcade_snapshot_ring_init(ArcadeSnapshotRing *ring, size_t state_size, int capacity)
+{
+    if (!ring || state_size == 0 || capacity <= 0)
+        return 1;
+    ring->data = arcade_alloc(state_size * (size_t)capacity, 0);
+    if (!ring->data)
+    {
+        fprintf(stderr, "Cannot allocate snapshot ring\n");
+        return 1;
+    }
+    ring->size = state_size;
+    ring->capacity = capacity;
+    ring->head = 0;
+    ring->count = 0;
+    return 0;
+}
+
+void arcade_snapshot_ring_free(ArcadeSnapshotRing *ring)
+{
+    if (!ring)
+        return;
+    arcade_free(ring->data);
+    ring->data = NULL;
+    ring->capacity = 0;
+    ring->head = 0;
+    ring->count = 0;
+}
+
+void arcade_snapshot_ring_clear(ArcadeSnapshotRing *ring)
+{
+    if (!ring)
+        return;
+    ring->head = 0;
+    ring->count = 0;
+}
+
+void arcade_snapshot_push(ArcadeSnapshotRing *ring, const void *state)
+{
+    if (!ring || !ring->data || !state)
+        return;
+    memcpy(ring->data + (size_t)ring->head * ring->size, state, ring->size);
+    ring->head = (ring->head + 1) % ring->capacity;
+    if (ring->count < ring->capacity)
+        ring->count++;
+}
+
+const void *arcade_snapshot_peek(const ArcadeSnapshotRing *ring, int frames_back)
+{
+    if (!ring || !ring->data || frames_back < 0 || frames_back >= ring->count)
+        return NULL;
+    int slot = (ring->head - 1 - frames_back + ring->capacity) % ring->capacity;
+    return ring->data + (size_t)slot * ring->size;
+}
+
+int arcade_snapshot_restore(const ArcadeSnapshotRing *ring, int frames_back, void *state)
+{
+    const void *snapshot = arcade_snapshot_peek(ring, frames_back);
+    if (!snapshot || !state)
+        return 1;
+    memcpy(state, snapshot, ring->size);
+    return 0;
+}
+
+int arcade_snapshot_pop(ArcadeSnapshotRing *ring, void *state)
+{
+    if (arcade_snapshot_restore(ring, 0, state) != 0)
+        return 1;
+    ring->head = (ring->head - 1 + ring->capacity) % ring->capacity;
+    ring->count--;
+    return 0;
+}
+
+/* Byte i counts as unchanged when it equals the base (never without a base) */
+#define DELTA_SAME(b, s, i) ((b) && (b)[i] == (s)[i])
+
+int arcade_delta_encode(const void *base, const void *state, size_t size, unsigned char *out, int out_size)
+{
+    const unsigned char *b = base;
+    const unsigned char *s = state;
+    size_t i = 0;
+    int n = 0;
+    if (!state || !out)
+        return -1;
+    while (i < size)
+    {
+        size_t skip = 0;
+        while (i + skip < size && skip < 255 && DELTA_SAME(b, s, i + skip))
+            skip++;
+        i += skip;
+        if (i == size)
+            break; /* Trailing unchanged bytes need no run */
+
+        /* Changed run; gaps of 1-2 unchanged bytes are cheaper to copy than to skip */
+        size_t run = 0;
+        while (i + run < size && run < 255)
+        {
+            if (DELTA_SAME(b, s, i + run))
+            {
+                size_t same = 0;
+                while (same < 3 && i + run + same < size && DELTA_SAME(b, s, i + run + same))
+                    same++;
+                if (same == 3 || i + run + same == size)
+                    break;
+            }
+            run++;
+        }
+        if (n + 2 + (int)run > out_size)
+            return -1;
+        out[n++] = (unsigned char)skip;
+        out[n++] = (unsigned char)run;
+        memcpy(out + n, s + i, run);
+        n += (int)run;
+        i += run;
+    }
+    return n;
+}
+
+#undef DELTA_SAME
+
+int arcade_delta_decode(const void *base, const unsigned char *delta, int delta_size, void *state, size_t size)
+{
+    unsigned char *s = state;
+    size_t i = 0;
+    int n = 0;
+    if (!state || delta_size < 0 || (!delta && delta_size > 0))
+        return 1;
+    if (!base)
+        memset(s, 0, size);
+    else if (base != state)
+        memcpy(s, base, size);
+    while (n < delta_size)
+    {
+        if (n + 2 > delta_size)
+            return 1;
+        size_t skip = delta[n];
+        size_t run = delta[n + 1];
+        n += 2;
+        if (i + skip + run > size || n + (int)run > delta_size)
+            return 1;
+        i += skip;
+        memcpy(s + i, delta + n, run);
+        i += run;
+        n += (int)run;
+    }
+    return 0;
+}
+
+/* =========================================================================
+ * Networking
+ * ========================================================================= */
+
+#ifdef _WIN32
+#define ARCADE_BAD_SOCKET ((intptr_t)INVALID_SOCKET)
+#else
+#define ARCADE_BAD_SOCKET ((intptr_t)-1)
+#endif
+
+static void net_close_socket(intptr_t sock)
+{
+#ifdef _WIN32
+    closesocket((SOCKET)sock);
+#else
+    close((int)sock);
+#endif
+}
+
+static int net_send_now(ArcadeNet *net, const void *data, int size)
+{
+    struct sockaddr_in to = {0};
+    to.sin_family = AF_INET;
+    to.sin_addr.s_addr = net->remote_ip;
+    to.sin_port = net->remote_port;
+#ifdef _WIN32
+    int result = sendto((SOCKET)net->socket, (const char *)data, size, 0, (struct sockaddr *)&to, sizeof(to));
+#else
+    int result = (int)sendto((int)net->socket, data, (size_t)size, 0, (struct sockaddr *)&to, sizeof(to));
+#endif
+    if (result != size)
+        return 1;
+    net->sent++;
+    return 0;
+}
+
+static void net_flush_queue(ArcadeNet *net)
+{
+    double now = arcade_time();
+    while (net->queue_count > 0 && net->queue[net->queue_head].release_time <= now)
+    {
+        ArcadeNetPacket *packet = &net->queue[net->queue_head];
+        net_send_now(net, packet->data, packet->size);
+        net->queue_head = (net->queue_head + 1) % ARCADE_NET_QUEUE;
+        net->queue_count--;
+    }
+}
+
+int arcade_net_open(ArcadeNet *net, int local_port, const char *remote_host, int remote_port)
+{
+    if (!net || !remote_host)
+        return 1;
+    memset(net, 0, sizeof(*net));
+    net->socket = ARCADE_BAD_SOCKET;
+    net->loss_seed = 2463534242u;
+
+#ifdef _WIN32
+    static int winsock_ready = 0;
+    if (!winsock_ready)
+    {
+        WSADATA wsa;
+        if (WSAStartup(MAKEWORD(2, 2), &wsa) != 0)
+        {
+            fprintf(stderr, "Cannot initialize Winsock\n");
+            return 1;
+        }
+        winsock_ready = 1;
+    }
+#endif
+
+    /* Resolve the peer (IPv4 only) */
+    struct addrinfo hints = {0}, *found = NULL;
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_DGRAM;
+    if (getaddrinfo(remote_host, NULL, &hints, &found) != 0 || !found)
+    {
+        fprintf(stderr, "Cannot resolve host %s\n", remote_host);
+        return 1;
+    }
+    net->remote_ip = ((struct sockaddr_in *)found->ai_addr)->sin_addr.s_addr;
+    net->remote_port = htons((uint16_t)remote_port);
+    freeaddrinfo(found);
+
+    /* Create, bind and unblock the socket */
+    net->socket = (intptr_t)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (net->socket == ARCADE_BAD_SOCKET)
+    {
+        fprintf(stderr, "Cannot create UDP socket\n");
+        return 1;
+    }
+    struct sockaddr_in local = {0};
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_ANY);
+    local.sin_port = htons((uint16_t)local_port);
+#ifdef _WIN32
+    u_long non_blocking = 1;
+    int failed = bind((SOCKET)net->socket, (struct sockaddr *)&local, sizeof(local)) != 0 ||
+                 ioctlsocket((SOCKET)net->socket, FIONBIO, &non_blocking) != 0;
+#else
+    int failed = bind((int)net->socket, (struct sockaddr *)&local, sizeof(local)) != 0 ||
+                 fcntl((int)net->socket, F_SETFL, fcntl((int)net->socket, F_GETFL, 0) | O_NONBLOCK) != 0;
+#endif
+    if (failed)
+    {
+        fprintf(stderr, "Cannot bind UDP port %d\n", local_port);
+        arcade_net_close(net);
+        return 1;
+    }
+    return 0;
+}
+
+void arcade_net_simulate(ArcadeNet *net, int latency_ms, int loss_percent)
+{
+    if (!net)
+        return;
+    net->latency_ms = latency_ms > 0 ? latency_ms : 0;
+    net->loss_percent = loss_percent < 0 ? 0 : (loss_percent > 100 ? 100 : loss_percent);
+}
+
+int arcade_net_send(ArcadeNet *net, const void *data, int size)
+{
+    if (!net || net->socket == ARCADE_BAD_SOCKET || !data || size <= 0 || size > ARCADE_NET_MAX_PACKET)
+        return 1;
+    net_flush_queue(net);
+
+    /* Simulated loss (xorshift32, independent of rand() so games stay deterministic) */
+    if (net->loss_percent > 0)
+    {
+        net->loss_seed ^= net->loss_seed << 13;
+        net->loss_seed ^= net->loss_seed >> 17;
+        net->loss_seed ^= net->loss_seed << 5;
+        if ((int)(net->loss_seed % 100) < net->loss_percent)
+        {
+            net->dropped++;
+            return 0;
+        }
+    }
+
+    if (net->latency_ms == 0 && net->queue_count == 0)
+        return net_send_now(net, data, size);
+
+    /* Simulated latency: hold the packet until its release time */
+    if (net->queue_count == ARCADE_NET_QUEUE)
+    {
+        net->dropped++; /* Queue full; behaves like a congested link */
+        return 0;
+    }
+    ArcadeNetPacket *packet = &net->queue[(net->queue_head + net->queue_count) % ARCADE_NET_QUEUE];
+    packet->release_time = arcade_time() + net->latency_ms / 1000.0;
+    packet->size = size;
+    memcpy(packet->data, data, (size_t)size);
+    net->queue_count++;
+    return 0;
+}
+
+int arcade_net_recv(ArcadeNet *net, void *buffer, int size)
+{
+    if (!net || net->socket == ARCADE_BAD_SOCKET || !buffer || size <= 0)
+        return 0;
+    net_flush_queue(net);
+    for (;;)
+    {
+        struct sockaddr_in from;
+        socklen_t from_size = sizeof(from);
+#ifdef _WIN32
+        int result = recvfrom((SOCKET)net->socket, (char *)buffer, size, 0, (struct sockaddr *)&from, &from_size);
+#else
+        int result = (int)recvfrom((int)net->socket, buffer, (size_t)size, 0, (struct sockaddr *)&from, &from_size);
+#endif
+        if (result <= 0)
+            return 0; /* Nothing waiting (or a transient error such as ICMP port unreachable) */
+        if (from.sin_addr.s_addr != net->remote_ip || from.sin_port != net->remote_port)
+            continue; /* Not our peer */
+        net->received++;
+        return result;
+    }
+}
+
+void arcade_net_close(ArcadeNet *net)
+{
+    if (!net)
+        return;
+    if (net->socket != ARCADE_BAD_SOCKET)
+        net_close_socket(net->socket);
+    net->socket = ARCADE_BAD_SOCKET;
+    net->queue_count = 0;
+}
+
+/* =========================================================================
+ * Rollback
+ * ========================================================================= */
+
+/*
+ * Packet layout (integers big-endian):
+ *   [0]      'R'
+ *   [1..4]   ping: sender's clock (ms)
+ *   [5..8]   pong: newest ping received from the peer, echoed back
+ *   [9..12]  ack: newest frame of the peer's input the sender has
+ *   [13..16] first: frame of the first input carried
+ *   [17]     count: number of inputs carried
+ *   [18..]   inputs for frames first .. first + count - 1
+ */
+#define ROLLBACK_HEADER 18
+#define ROLLBACK_MASK (ARCADE_ROLLBACK_HISTORY - 1)
+
+static void rollback_put_u32(unsigned char *p, uint32_t v)
+{
+    p[0] = (unsigned char)(v >> 24);
+    p[1] = (unsigned char)(v >> 16);
+    p[2] = (unsigned char)(v >> 8);
+    p[3] = (unsigned char)v;
+}
+
+static uint32_t rollback_get_u32(const unsigned char *p)
+{
+    return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+}
+
+static uint32_t rollback_clock_ms(void)
+{
+    return (uint32_t)(arcade_time() * 1000.0);
+}
+
+/* Runs one frame, predicting the peer's input when it is not confirmed yet */
+static void rollback_step(ArcadeRollback *session, int frame)
+{
+    int remote = 1 - session->local_player;
+    uint8_t inputs[ARCADE_ROLLBACK_PLAYERS];
+    if (frame > session->remote_frame)
+        session->inputs[remote][frame & ROLLBACK_MASK] = session->inputs[remote][session->remote_frame & ROLLBACK_MASK];
+    for (int p = 0; p < ARCADE_ROLLBACK_PLAYERS; p++)
+        inputs[p] = session->inputs[p][frame & ROLLBACK_MASK];
+    arcade_snapshot_push(&session->history, session->state);
+    session->step(session->state, inputs);
+}
+
+/* Reads every waiting packet; returns the first mispredicted frame, or session->frame if none */
+static int rollback_receive(ArcadeRollback *session)
+{
+    int remote = 1 - session->local_player;
+    int rollback_from = session->frame;
+    unsigned char packet[ARCADE_NET_MAX_PACKET];
+    int size;
+    while ((size = arcade_net_recv(session->net, packet, sizeof(packet))) >= ROLLBACK_HEADER)
+    {
+        if (packet[0] != 'R' || size < ROLLBACK_HEADER + packet[17])
+            continue;
+        uint32_t pong = rollback_get_u32(packet + 5);
+        int ack = (int)rollback_get_u32(packet + 9);
+        int first = (int)rollback_get_u32(packet + 13);
+        session->peer_ping = rollback_get_u32(packet + 1);
+        if (pong != 0)
+        {
+            float sample = (float)(rollback_clock_ms() - pong);
+            session->rtt_ms = session->rtt_ms == 0.0f ? sample : session->rtt_ms * 0.9f + sample * 0.1f;
+        }
+        if (ack > session->remote_ack)
+            session->remote_ack = ack;
+
+        /* Accept inputs in order only; later packets repeat anything lost */
+        for (int i = 0; i < packet[17]; i++)
+        {
+            int frame = first + i;
+            if (frame != session->remote_frame + 1)
+                continue;
+            uint8_t input = packet[ROLLBACK_HEADER + i];
+            if (frame < session->frame && session->inputs[remote][frame & ROLLBACK_MASK] != input && frame < rollback_from)
+                rollback_from = frame; /* Already simulated with a wrong prediction */
+            session->inputs[remote][frame & ROLLBACK_MASK] = input;
+            session->remote_frame = frame;
+        }
+    }
+    return rollback_from;
+}
+
+static void rollback_send(ArcadeRollback *session)
+{
+    unsigned char packet[ROLLBACK_HEADER + ARCADE_ROLLBACK_SEND];
+    int first = session->remote_ack + 1;
+    if (first < session->local_frame - ARCADE_ROLLBACK_SEND + 1)
+        first = session->local_frame - ARCADE_ROLLBACK_SEND + 1;
+    int count = session->local_frame - first + 1;
+    if (count < 0)
+        count = 0;
+    packet[0] = 'R';
+    rollback_put_u32(packet + 1, rollback_clock_ms() | 1u); /* Never 0, which means "no ping yet" */
+    rollback_put_u32(packet + 5, session->peer_ping);
+    rollback_put_u32(packet + 9, (uint32_t)session->remote_frame);
+    rollback_put_u32(packet + 13, (uint32_t)first);
+    packet[17] = (unsigned char)count;
+    for (int i = 0; i < count; i++)
+        packet[ROLLBACK_HEADER + i] = session->inputs[session->local_player][(first + i) & ROLLBACK_MASK];
+    arcade_net_send(session->net, packet, ROLLBACK_HEADER + count);
+}
+
+int arcade_rollback_init(ArcadeRollback *session, ArcadeNet *net, void *state, size_t state_size,
+                         ArcadeStepFunc step, int local_player, int input_delay)
+{
+    if (!session || !net || !state || !step || local_player < 0 || local_player >= ARCADE_ROLLBACK_PLAYERS ||
+        input_delay < 0 || input_delay > ARCADE_ROLLBACK_FRAMES)
+        return 1;
+    memset(session, 0, sizeof(*session));
+    /* One snapshot per frame that may still be resimulated, plus the current one */
+    if (arcade_snapshot_ring_init(&session->history, state_size, ARCADE_ROLLBACK_FRAMES + 1) != 0)
+        return 1;
+    session->net = net;
+    session->state = state;
+    session->step = step;
+    session->local_player = local_player;
+    session->input_delay = input_delay;
+    /* The first input_delay frames have no input on either side */
+    session->local_frame = input_delay - 1;
+    session->remote_frame = input_delay - 1;
+    session->remote_ack = input_delay - 1;
+    return 0;
+}
+
+int arcade_rollback_update(ArcadeRollback *session, uint8_t local_input)
+{
+    if (!session || !session->step)
+        return 0;
+
+    /* Roll back to the first mispredicted frame and resimulate up to the present */
+    int rollback_from = rollback_receive(session);
+    session->last_rollback = session->frame - rollback_from;
+    if (session->last_rollback > 0)
+    {
+        for (int i = 0; i < session->last_rollback; i++)
+            arcade_snapshot_pop(&session->history, session->state);
+        for (int frame = rollback_from; frame < session->frame; frame++)
+            rollback_step(session, frame);
+    }
+
+    /* Advance one frame unless that would predict too far ahead of the peer */
+    int advanced = 0;
+    if (session->frame - session->remote_frame <= ARCADE_ROLLBACK_FRAMES)
+    {
+        session->local_frame = session->frame + session->input_delay;
+        session->inputs[session->local_player][session->local_frame & ROLLBACK_MASK] = local_input;
+        rollback_step(session, session->frame);
+        session->frame++;
+        advanced = 1;
+    }
+    else
+    {
+        session->stalls++;
+    }
+
+    rollback_send(session);
+    return advanced;
+}
+
+int arcade_rollback_suggest_delay(const ArcadeRollback *session, float frame_ms)
+{
+    if (!session || frame_ms <= 0.0f)
+        return 0;
+    int delay = (int)(session->rtt_ms / 2.0f / frame_ms + 0.999f);
+    return delay > ARCADE_ROLLBACK_FRAMES ? ARCADE_ROLLBACK_FRAMES : delay;
+}
+
+void arcade_rollback_free(ArcadeRollback *session)
+{
+    if (!session)
+        return;
+    arcade_snapshot_ring_free(&session->history);
+}
+
+/* =========================================================================
+ * Worker Pool
+ * ========================================================================= */
+
+typedef struct PoolShared PoolShared;
+
+typedef struct
+{
+    PoolShared *shared; /* Pool the thread belongs to */
+    int index;          /* Worker number (1 and up; 0 is the caller) */
+} PoolWorker;
+
+struct PoolShared
+{
+#ifdef _WIN32
+    CRITICAL_SECTION lock;
+    CONDITION_VARIABLE wake; /* New batch or stop */
+    CONDITION_VARIABLE done; /* Last worker finished a batch */
+    HANDLE *threads;
+#else
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+    pthread_cond_t done;
+    pthread_t *threads;
+#endif
+    PoolWorker *workers;
+    int worker_count;    /* Threads besides the caller */
+    ArcadeJobFunc func;  /* Current batch */
+    void *context;
+    int count;           /* Items in the batch */
+    int next;            /* Next item to hand out */
+    int chunk;           /* Items handed out at once */
+    int pending;         /* Workers still busy with the batch */
+    unsigned int batch;  /* Batch number, bumped to wake the workers */
+    int stop;            /* Set by arcade_pool_free */
+};
+
+#ifdef _WIN32
+#define POOL_LOCK(p) EnterCriticalSection(&(p)->lock)
+#define POOL_UNLOCK(p) LeaveCriticalSection(&(p)->lock)
+#define POOL_WAIT(p, cond) SleepConditionVariableCS(&(p)->cond, &(p)->lock, INFINITE)
+#define POOL_SIGNAL(p, cond) WakeAllConditionVariable(&(p)->cond)
+#else
+#define POOL_LOCK(p) pthread_mutex_lock(&(p)->lock)
+#define POOL_UNLOCK(p) pthread_mutex_unlock(&(p)->lock)
+#define POOL_WAIT(p, cond) pthread_cond_wait(&(p)->cond, &(p)->lock)
+#define POOL_SIGNAL(p, cond) pthread_cond_broadcast(&(p)->cond)
+#endif
+
+/* Runs chunks of the current batch until none are left */
+static void pool_work(PoolShared *p, int worker)
+{
+    for (;;)
+    {
+        POOL_LOCK(p);
+        int start = p->next;
+        p->next += p->chunk;
+        POOL_UNLOCK(p);
+        if (start >= p->count)
+            return;
+        int end = start + p->chunk < p->count ? start + p->chunk : p->count;
+        for (int i = start; i < end; i++)
+            p->func(p->context, i, worker);
+    }
+}
+
+#ifdef _WIN32
+static DWORD WINAPI pool_thread(LPVOID arg)
+#else
+static void *pool_thread(void *arg)
+#endif
+{
+    PoolWorker *w = arg;
+    PoolShared *p = w->shared;
+    unsigned int seen = 0;
+    POOL_LOCK(p);
+    for (;;)
+    {
+        while (!p->stop && p->batch == seen)
+            POOL_WAIT(p, wake);
+        if (p->stop)
+            break;
+        seen = p->batch;
+        POOL_UNLOCK(p);
+        pool_work(p, w->index);
+        POOL_LOCK(p);
+        if (--p->pending == 0)
+            POOL_SIGNAL(p, done);
+    }
+    POOL_UNLOCK(p);
+    arcade_arena_free(&frame_arena); /* This thread's scratch */
+    log_detach();                    /* and log ring, for the next thread */
+#ifdef _WIN32
+    return 0;
+#else
+    return NULL;
+#endif
+}
+
+int arcade_cpu_count(void)
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#else
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+#endif
+}
+
+int arcade_pool_init(ArcadeWorkerPool *pool, int thread_count)
+{
+    if (!pool)
+        return 1;
+    if (thread_count <= 0)
+        thread_count = worker_threads > 0 ? worker_threads : arcade_cpu_count();
+    pool->thread_count = thread_count;
+    pool->internal = NULL;
+    if (pool->thread_count == 1)
+        return 0; /* Batches run on the caller */
+
+    PoolShared *p = alloc_zeroed(sizeof(PoolShared));
+    if (!p)
+        return 1;
+    p->worker_count = pool->thread_count - 1;
+    p->workers = alloc_zeroed((size_t)p->worker_count * sizeof(PoolWorker));
+#ifdef _WIN32
+    p->threads = alloc_zeroed((size_t)p->worker_count * sizeof(HANDLE));
+#else
+    p->threads = alloc_zeroed((size_t)p->worker_count * sizeof(pthread_t));
+#endif
+    if (!p->workers || !p->threads)
+    {
+        arcade_free(p->workers);
+        arcade_free(p->threads);
+        arcade_free(p);
+        return 1;
+    }
+#ifdef _WIN32
+    InitializeCriticalSection(&p->lock);
+    InitializeConditionVariable(&p->wake);
+    InitializeConditionVariable(&p->done);
+#else
+    pthread_mutex_init(&p->lock, NULL);
+    pthread_cond_init(&p->wake, NULL);
+    pthread_cond_init(&p->done, NULL);
+#endif
+    pool->internal = p;
+
+    for (int i = 0; i < p->worker_count; i++)
+    {
+        p->workers[i].shared = p;
+        p->workers[i].index = i + 1;
+#ifdef _WIN32
+        p->threads[i] = CreateThread(NULL, 0, pool_thread, &p->workers[i], 0, NULL);
+        int failed = p->threads[i] == NULL;
+#else
+        int failed = pthread_create(&p->threads[i], NULL, pool_thread, &p->workers[i]) != 0;
+#endif
+        if (failed)
+        {
+            fprintf(stderr, "Cannot create worker thread\n");
+            p->worker_count = i; /* Join only the threads that started */
+            arcade_pool_free(pool);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+void arcade_pool_run(ArcadeWorkerPool *pool, int count, ArcadeJobFunc func, void *context)
+{
+    if (!pool || !func || count <= 0)
+        return;
+    PoolShared *p = pool->internal;
+    if (!p)
+    {
+        for (int i = 0; i < count; i++)
+            func(context, i, 0);
+        return;
+    }
+
+    POOL_LOCK(p);
+    p->func = func;
+    p->context = context;
+    p->count = count;
+    p->next = 0;
+    p->chunk = count / (pool->thread_count * 8); /* About 8 chunks per thread */
+    if (p->chunk < 1)
+        p->chunk = 1;
+    p->pending = p->worker_count;
+    p->batch++;
+    POOL_SIGNAL(p, wake);
+    POOL_UNLOCK(p);
+
+    pool_work(p, 0); /* The caller works too */
+
+    POOL_LOCK(p);
+    while (p->pending > 0)
+        POOL_WAIT(p, done);
+    POOL_UNLOCK(p);
+}
+
+void arcade_pool_free(ArcadeWorkerPool *pool)
+{
+    if (!pool || !pool->internal)
+        return;
+    PoolShared *p = pool->internal;
+    POOL_LOCK(p);
+    p->stop = 1;
+    POOL_SIGNAL(p, wake);
+    POOL_UNLOCK(p);
+    for (int i = 0; i < p->worker_count; i++)
+    {
+#ifdef _WIN32
+        WaitForSingleObject(p->threads[i], INFINITE);
+        CloseHandle(p->threads[i]);
+#else
+        pthread_join(p->threads[i], NULL);
+#endif
+    }
+#ifdef _WIN32
+    DeleteCriticalSection(&p->lock);
+#else
+    pthread_cond_destroy(&p->wake);
+    pthread_cond_destroy(&p->done);
+    pthread_mutex_destroy(&p->lock);
+#endif
+    arcade_free(p->workers);
+    arcade_free(p->threads);
+    arcade_free(p);
+    pool->internal = NULL;
+}
+
+#undef POOL_LOCK
+#undef POOL_UNLOCK
+#undef POOL_WAIT
+#undef POOL_SIGNAL
+
+/* =========================================================================
+ * Environments
+ * ========================================================================= */
+
+int arcade_env_init(ArcadeEnv *env, const ArcadeEnvDef *def, int obs_type, int obs_width, int obs_height)
+{
+    if (!env || !def || !def->reset || !def->step || obs_type < ARCADE_OBS_STATE || obs_type > ARCADE_OBS_RGB)
+        return 1;
+    if (obs_type == ARCADE_OBS_STATE ? !def->observe : !def->draw)
+        return 1;
+    memset(env, 0, sizeof(*env));
+    env->def = def;
+    env->obs_type = obs_type;
+    env->obs_width = obs_width > 0 ? obs_width : def->world_width;
+    env->obs_height = obs_height > 0 ? obs_height : def->world_height;
+    env->state = alloc_zeroed(def->state_size);
+    if (!env->state)
+        return 1;
+    if (obs_type != ARCADE_OBS_STATE)
+    {
+        /* The scene is drawn straight at observation size; no full-size frame */
+        env->frame.pixels = arcade_alloc((size_t)env->obs_width * env->obs_height * sizeof(uint32_t), ARCADE_SIMD_ALIGN);
+        env->frame.width = env->obs_width;
+        env->frame.height = env->obs_height;
+        env->frame.bg_color = def->bg_color;
+        env->frame.scale_x = (float)env->obs_width / def->world_width;
+        env->frame.scale_y = (float)env->obs_height / def->world_height;
+        env->sprites = arcade_alloc((size_t)def->max_sprites * sizeof(ArcadeAnySprite), 0);
+        env->types = arcade_alloc((size_t)def->max_sprites * sizeof(int), 0);
+        if (!env->frame.pixels || !env->sprites || !env->types)
+        {
+            arcade_env_free(env);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+size_t arcade_env_obs_size(const ArcadeEnv *env)
+{
+    switch (env->obs_type)
+    {
+    case ARCADE_OBS_GRAY:
+        return (size_t)env->obs_width * env->obs_height;
+    case ARCADE_OBS_RGB:
+        return (size_t)env->obs_width * env->obs_height * 3;
+    default:
+        return (size_t)env->def->state_dims * sizeof(float);
+    }
+}
+
+void arcade_env_observe(ArcadeEnv *env, void *obs)
+{
+    if (!env || !obs)
+        return;
+    if (env->obs_type == ARCADE_OBS_STATE)
+    {
+        env->def->observe(env->state, obs);
+        return;
+    }
+
+    int count = env->def->draw(env->state, env->sprites, env->types);
+    arcade_render_scene_to(&env->frame, env->sprites, count, env->types);
+
+    unsigned char *out = obs;
+    int pixel_count = env->obs_width * env->obs_height;
+    for (int i = 0; i < pixel_count; i++)
+    {
+        uint32_t pixel = env->frame.pixels[i];
+        unsigned int r = (pixel >> 16) & 0xFF, g = (pixel >> 8) & 0xFF, b = pixel & 0xFF;
+        if (env->obs_type == ARCADE_OBS_GRAY)
+        {
+            out[i] = (unsigned char)((r * 77 + g * 150 + b * 29) >> 8); /* BT.601 luma */
+        }
+        else
+        {
+            out[i * 3] = (unsigned char)r;
+            out[i * 3 + 1] = (unsigned char)g;
+            out[i * 3 + 2] = (unsigned char)b;
+        }
+    }
+}
+
+void arcade_env_reset(ArcadeEnv *env, uint32_t seed, void *obs)
+{
+    if (!env)
+        return;
+    env->seed = seed;
+    env->steps = 0;
+    env->episode_reward = 0.0f;
+    env->def->reset(env->state, seed);
+    arcade_env_observe(env, obs);
+}
+
+float arcade_env_step(ArcadeEnv *env, int action, void *obs, int *done)
+{
+    int finished = 0;
+    if (action < 0 || action >= env->def->action_count)
+        action = 0;
+    float reward = env->def->step(env->state, action, &finished);
+    env->steps++;
+    env->episode_reward += reward;
+    if (done)
+        *done = finished;
+    arcade_env_observe(env, obs);
+    return reward;
+}
+
+void arcade_env_free(ArcadeEnv *env)
+{
+    if (!env)
+        return;
+    arcade_free(env->state);
+    arcade_free(env->frame.pixels);
+    arcade_free(env->sprites);
+    arcade_free(env->types);
+    env->state = NULL;
+    env->frame.pixels = NULL;
+    env->sprites = NULL;
+    env->types = NULL;
+}
+
+int arcade_vec_env_init(ArcadeVecEnv *vec, const ArcadeEnvDef *def, int count, int obs_type,
+                        int obs_width, int obs_height, int threads)
+{
+    if (!vec || count <= 0)
+        return 1;
+    memset(vec, 0, sizeof(*vec));
+    vec->envs = alloc_zeroed((size_t)count * sizeof(ArcadeEnv));
+    if (!vec->envs)
+        return 1;
+    for (int i = 0; i < count; i++)
+    {
+        if (arcade_env_init(&vec->envs[i], def, obs_type, obs_width, obs_height) != 0)
+        {
+            vec->count = i;
+            arcade_vec_env_free(vec);
+            return 1;
+        }
+    }
+    vec->count = count;
+    if (arcade_pool_init(&vec->pool, threads) != 0)
+    {
+        arcade_vec_env_free(vec);
+        return 1;
+    }
+    return 0;
+}
+
+void arcade_vec_env_reset(ArcadeVecEnv *vec, uint32_t seed, void *obs)
+{
+    if (!vec || vec->count == 0)
+        return;
+    size_t obs_size = arcade_env_obs_size(&vec->envs[0]);
+    for (int i = 0; i < vec->count; i++)
+    {
+        arcade_env_reset(&vec->envs[i], seed + (uint32_t)i, obs ? (unsigned char *)obs + i * obs_size : NULL);
+    }
+}
+
+/* Worker job: steps one environment, resetting it when its episode ends */
+static void vec_env_step_job(void *context, int index, int worker)
+{
+    (void)worker;
+    ArcadeVecEnv *vec = context;
+    ArcadeEnv *env = &vec->envs[index];
+    int done = 0;
+    vec->rewards[index] = arcade_env_step(env, vec->actions[index], NULL, &done);
+    vec->dones[index] = done;
+    if (done)
+        arcade_env_reset(env, env->seed + (uint32_t)vec->count, NULL); /* Next seed of this stream */
+    if (vec->obs)
+        arcade_env_observe(env, vec->obs + index * arcade_env_obs_size(env));
+}
+
+void arcade_vec_env_step(ArcadeVecEnv *vec, const int *actions, void *obs, float *rewards, int *dones)
+{
+    if (!vec || !actions || !rewards || !dones)
+        return;
+    vec->actions = actions;
+    vec->obs = obs;
+    vec->rewards = rewards;
+    vec->dones = dones;
+    arcade_pool_run(&vec->pool, vec->count, vec_env_step_job, vec);
+}
+
+void arcade_vec_env_free(ArcadeVecEnv *vec)
+{
+    if (!vec)
+        return;
+    for (int i = 0; i < vec->count; i++)
+    {
+        arcade_env_free(&vec->envs[i]);
+    }
+    arcade_free(vec->envs);
+    vec->envs = NULL;
+    vec->count = 0;
+    arcade_pool_free(&vec->pool);
+}
+
+/* =========================================================================
+ * Random Numbers
+ * ========================================================================= */
+
+/* splitmix64 step: spreads any seed over the generator state */
+static uint64_t rng_splitmix64(uint64_t *x)
+{
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+void arcade_rng_seed(ArcadeRng *rng, uint64_t seed)
+{
+    arcade_rng_seed_stream(rng, seed, 0);
+}
+
+void arcade_rng_seed_stream(ArcadeRng *rng, uint64_t seed, uint64_t stream)
+{
+    uint64_t x = seed;
+    if (stream)
+    {
+        uint64_t y = stream;
+        x ^= rng_splitmix64(&y); /* Unrelated starting points per stream */
+    }
+    uint64_t a = rng_splitmix64(&x), b = rng_splitmix64(&x);
+    rng->s[0] = (uint32_t)a;
+    rng->s[1] = (uint32_t)(a >> 32);
+    rng->s[2] = (uint32_t)b;
+    rng->s[3] = (uint32_t)(b >> 32);
+    if (!(rng->s[0] | rng->s[1] | rng->s[2] | rng->s[3]))
+        rng->s[0] = 1; /* The all-zero state never leaves zero */
+}
+
+static inline uint32_t rng_rotl(uint32_t x, int k)
+{
+    return (x << k) | (x >> (32 - k));
+}
+
+uint32_t arcade_rng_next(ArcadeRng *rng)
+{
+    uint32_t *s = rng->s;
+    uint32_t result = rng_rotl(s[1] * 5, 7) * 9;
+    uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 11);
+    return result;
+}
+
+uint32_t arcade_rng_below(ArcadeRng *rng, uint32_t bound)
+{
+    /* Lemire's multiply-shift; rejects only the few values that would bias it */
+    uint64_t m = (uint64_t)arcade_rng_next(rng) * bound;
+    uint32_t low = (uint32_t)m;
+    if (low < bound)
+    {
+        uint32_t threshold = (0u - bound) % bound;
+        while (low < threshold)
+        {
+            m = (uint64_t)arcade_rng_next(rng) * bound;
+            low = (uint32_t)m;
+        }
+    }
+    return (uint32_t)(m >> 32);
+}
+
+int arcade_rng_range(ArcadeRng *rng, int min, int max)
+{
+    if (max <= min)
+        return min;
+    uint32_t span = (uint32_t)max - (uint32_t)min + 1u;
+    if (span == 0) /* Full 32-bit range */
+        return (int)arcade_rng_next(rng);
+    return (int)((uint32_t)min + arcade_rng_below(rng, span));
+}
+
+float arcade_rng_float(ArcadeRng *rng)
+{
+    return (float)(arcade_rng_next(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+float arcade_rng_float_range(ArcadeRng *rng, float min, float max)
+{
+    return min + (max - min) * arcade_rng_float(rng);
+}
+
+void arcade_rng_fill(ArcadeRng *rng, uint32_t *out, size_t count)
+{
+    /* State kept in locals so the loop runs in registers */
+    uint32_t s0 = rng->s[0], s1 = rng->s[1], s2 = rng->s[2], s3 = rng->s[3];
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = rng_rotl(s1 * 5, 7) * 9;
+        uint32_t t = s1 << 9;
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= t;
+        s3 = rng_rotl(s3, 11);
+    }
+    rng->s[0] = s0;
+    rng->s[1] = s1;
+    rng->s[2] = s2;
+    rng->s[3] = s3;
+}
+
+void arcade_rng_fill_floats(ArcadeRng *rng, float *out, size_t count, float min, float max)
+{
+    float scale = (max - min) * (1.0f / 16777216.0f);
+    uint32_t block[256]; /* Filled in bulk, then converted */
+    for (size_t done = 0; done < count;)
+    {
+        size_t n = count - done < 256 ? count - done : 256;
+        arcade_rng_fill(rng, block, n);
+        for (size_t i = 0; i < n; i++)
+            out[done + i] = min + (float)(block[i] >> 8) * scale;
+        done += n;
+    }
+}
+
+/* =========================================================================
+ * Timers
+ * ========================================================================= */
+
+#define TIMER_MASK (ARCADE_TIMER_SLOTS - 1)
+#define TIMER_RANGE ((uint64_t)1 << (ARCADE_TIMER_BITS * ARCADE_TIMER_LEVELS)) /* Ticks the wheel spans */
+#define TIMER_FIRING (ARCADE_TIMER_LEVELS * ARCADE_TIMER_SLOTS)                /* heads[] entry being delivered */
+#define TIMER_FREE (-1)                                                        /* list: unused */
+#define TIMER_FIRED (-2)                                                       /* list: expired, waiting in the poll queue */
+
+static ArcadeTimer *timer_nodes(const ArcadeTimerWheel *wheel)
+{
+    return (ArcadeTimer *)((char *)wheel + wheel->storage);
+}
+
+/* Resolves a handle to its timer index, or -1 if it is stale */
+static int32_t timer_index(const ArcadeTimerWheel *wheel, ArcadeTimerId id)
+{
+    int32_t index = (int32_t)(id & ARCADE_TIMER_MAX) - 1;
+    if (index < 0 || index >= wheel->capacity)
+        return -1;
+    const ArcadeTimer *timer = &timer_nodes(wheel)[index];
+    if (timer->list == TIMER_FREE || timer->generation != (id >> 20))
+        return -1;
+    return index;
+}
+
+static void timer_link(ArcadeTimerWheel *wheel, int32_t index, int32_t list)
+{
+    ArcadeTimer *nodes = timer_nodes(wheel);
+    nodes[index].list = list;
+    nodes[index].prev = -1;
+    nodes[index].next = wheel->heads[list];
+    if (wheel->heads[list] >= 0)
+        nodes[wheel->heads[list]].prev = index;
+    wheel->heads[list] = index;
+}
+
+static void timer_unlink(ArcadeTimerWheel *wheel, int32_t index)
+{
+    ArcadeTimer *nodes = timer_nodes(wheel);
+    ArcadeTimer *timer = &nodes[index];
+    if (timer->prev >= 0)
+        nodes[timer->prev].next = timer->next;
+    else
+        wheel->heads[timer->list] = timer->next;
+    if (timer->next >= 0)
+        nodes[timer->next].prev = timer->prev;
+}
+
+/* Files a timer in the wheel slot for its expiry, relative to wheel->now */
+static void timer_place(ArcadeTimerWheel *wheel, int32_t index)
+{
+    uint64_t when = timer_nodes(wheel)[index].expires;
+    if (when - wheel->now >= TIMER_RANGE)
+        when = wheel->now + TIMER_RANGE - 1; /* Parked in the top level; refiled when it cascades */
+    uint64_t delta = when - wheel->now;
+    int level = 0;
+    while (level < ARCADE_TIMER_LEVELS - 1 && delta >= (uint64_t)1 << (ARCADE_TIMER_BITS * (level + 1)))
+        level++;
+    int slot = (int)((when >> (ARCADE_TIMER_BITS * level)) & TIMER_MASK);
+    timer_link(wheel, index, level * ARCADE_TIMER_SLOTS + slot);
+    wheel->active++;
+}
+
+static void timer_release(ArcadeTimerWheel *wheel, int32_t index)
+{
+    ArcadeTimer *timer = &timer_nodes(wheel)[index];
+    timer->list = TIMER_FREE;
+    timer->generation = (uint16_t)((timer->generation + 1) & 0xFFF);
+    timer->next = wheel->free_head;
+    wheel->free_head = index;
+}
+
+static void timer_unqueue(ArcadeTimerWheel *wheel, int32_t index)
+{
+    ArcadeTimer *nodes = timer_nodes(wheel);
+    ArcadeTimer *timer = &nodes[index];
+    if (timer->queue_prev >= 0)
+        nodes[timer->queue_prev].queue_next = timer->queue_next;
+    else
+        wheel->queue_head = timer->queue_next;
+    if (timer->queue_next >= 0)
+        nodes[timer->queue_next].queue_prev = timer->queue_prev;
+    else
+        wheel->queue_tail = timer->queue_prev;
+    timer->queued = 0;
+}
+
+int arcade_timers_init(ArcadeTimerWheel *wheel, ArcadeTimer *timers, int capacity, uint64_t now)
+{
+    if (!wheel || !timers || capacity <= 0 || capacity > ARCADE_TIMER_MAX)
+        return 1;
+    wheel->now = now;
+    wheel->storage = (char *)timers - (char *)wheel;
+    wheel->capacity = capacity;
+    wheel->active = 0;
+    wheel->queue_head = wheel->queue_tail = -1;
+    for (int i = 0; i <= TIMER_FIRING; i++)
+        wheel->heads[i] = -1;
+    for (int i = 0; i < capacity; i++)
+    {
+        timers[i].list = TIMER_FREE;
+        timers[i].generation = 0;
+        timers[i].queued = 0;
+        timers[i].next = i + 1 < capacity ? i + 1 : -1;
+    }
+    wheel->free_head = 0;
+    return 0;
+}
+
+ArcadeTimerId arcade_timer_start(ArcadeTimerWheel *wheel, uint64_t delay, uint32_t period, int event, int param)
+{
+    int32_t index = wheel->free_head;
+    if (index < 0)
+        return 0;
+    ArcadeTimer *timer = &timer_nodes(wheel)[index];
+    wheel->free_head = timer->next;
+    timer->expires = wheel->now + (delay ? delay : 1);
+    timer->period = period;
+    timer->event = event;
+    timer->param = param;
+    timer->queued = 0;
+    timer_place(wheel, index);
+    return ((ArcadeTimerId)timer->generation << 20) | (ArcadeTimerId)(index + 1);
+}
+
+int arcade_timer_cancel(ArcadeTimerWheel *wheel, ArcadeTimerId id)
+{
+    int32_t index = timer_index(wheel, id);
+    if (index < 0)
+        return 0;
+    ArcadeTimer *timer = &timer_nodes(wheel)[index];
+    if (timer->list >= 0)
+    {
+        timer_unlink(wheel, index);
+        if (timer->list != TIMER_FIRING)
+            wheel->active--;
+    }
+    if (timer->queued)
+        timer_unqueue(wheel, index);
+    timer_release(wheel, index);
+    return 1;
+}
+
+int arcade_timer_pending(const ArcadeTimerWheel *wheel, ArcadeTimerId id)
+{
+    int32_t index = timer_index(wheel, id);
+    return index >= 0 && timer_nodes(wheel)[index].list >= 0 && timer_nodes(wheel)[index].list != TIMER_FIRING;
+}
+
+uint64_t arcade_timer_remaining(const ArcadeTimerWheel *wheel, ArcadeTimerId id)
+{
+    if (!arcade_timer_pending(wheel, id))
+        return 0;
+    return timer_nodes(wheel)[timer_index(wheel, id)].expires - wheel->now;
+}
+
+int arcade_timers_advance(ArcadeTimerWheel *wheel, uint64_t now, ArcadeTimerFunc func, void *context)
+{
+    ArcadeTimer *nodes = timer_nodes(wheel);
+    int delivered = 0;
+    while (wheel->now < now)
+    {
+        if (wheel->active == 0)
+        {
+            wheel->now = now; /* Nothing can expire: jump straight there */
+            break;
+        }
+        uint64_t tick = wheel->now + 1;
+
+        /* At a slot boundary, refile the next block of each higher level (top down) */
+        for (int level = ARCADE_TIMER_LEVELS - 1; level > 0; level--)
+        {
+            int shift = ARCADE_TIMER_BITS * level;
+            if (tick & (((uint64_t)1 << shift) - 1))
+                continue;
+            int32_t list = level * ARCADE_TIMER_SLOTS + (int32_t)((tick >> shift) & TIMER_MASK);
+            int32_t index = wheel->heads[list];
+            wheel->heads[list] = -1;
+            while (index >= 0)
+            {
+                int32_t next = nodes[index].next;
+                wheel->active--;
+                timer_place(wheel, index); /* Relative to tick - 1, so nothing lands in a passed slot */
+                index = next;
+            }
+        }
+        wheel->now = tick;
+
+        /* Everything in this tick's level-0 slot expires now */
+        int32_t list = (int32_t)(tick & TIMER_MASK);
+        while (wheel->heads[list] >= 0)
+        {
+            int32_t index = wheel->heads[list];
+            ArcadeTimer *timer = &nodes[index];
+            timer_unlink(wheel, index);
+            wheel->active--;
+            if (timer->event == 0 || !func)
+            {
+                if (timer->event != 0)
+                {
+                    /* Queue for arcade_timers_poll (once, counting repeats) */
+                    if (timer->queued++ == 0)
+                    {
+                        timer->queue_next = -1;
+                        timer->queue_prev = wheel->queue_tail;
+                        if (wheel->queue_tail >= 0)
+                            nodes[wheel->queue_tail].queue_next = index;
+                        else
+                            wheel->queue_head = index;
+                        wheel->queue_tail = index;
+                    }
+                    delivered++;
+                }
+                if (timer->period)
+                {
+                    timer->expires += timer->period;
+                    timer_place(wheel, index);
+                }
+                else if (timer->queued)
+                    timer->list = TIMER_FIRED;
+                else
+                    timer_release(wheel, index);
+            }
+            else
+            {
+                timer_link(wheel, index, TIMER_FIRING);
+            }
+        }
+
+        /* Callbacks run last, so they may start or cancel any timer */
+        while (wheel->heads[TIMER_FIRING] >= 0)
+        {
+            int32_t index = wheel->heads[TIMER_FIRING];
+            ArcadeTimer *timer = &nodes[index];
+            int event = timer->event, param = timer->param;
+            timer_unlink(wheel, index);
+            if (timer->period)
+            {
+                timer->expires += timer->period;
+                timer_place(wheel, index);
+            }
+            else
+            {
+                if (timer->queued)
+                    timer_unqueue(wheel, index);
+                timer_release(wheel, index);
+            }
+            func(context, event, param);
+            delivered++;
+        }
+    }
+    return delivered;
+}
+
+int arcade_timers_poll(ArcadeTimerWheel *wheel, int *event, int *param)
+{
+    int32_t index = wheel->queue_head;
+    if (index < 0)
+        return 0;
+    ArcadeTimer *timer = &timer_nodes(wheel)[index];
+    if (event)
+        *event = timer->event;
+    if (param)
+        *param = timer->param;
+    if (--timer->queued == 0)
+    {
+        timer_unqueue(wheel, index);
+        if (timer->list == TIMER_FIRED)
+            timer_release(wheel, index);
+    }
+    return 1;
+}
+
+#undef TIMER_MASK
+#undef TIMER_RANGE
+#undef TIMER_FIRING
+#undef TIMER_FREE
+#undef TIMER_FIRED
+
+/* =========================================================================
+ * Performance Configuration
+ * ========================================================================= */
+
+void arcade_set_target_fps(int fps)
+{
+    target_fps = fps > 0 ? fps : 0;
+}
+
+int arcade_target_fps(void)
+{
+    return target_fps;
+}
+
+void arcade_set_pacing(int mode)
+{
+    pacing_requested = mode;
+    vsync_requested = mode == ARCADE_PACING_VSYNC;
+}
+
+void arcade_wait_frame(void)
+{
+    static double next_frame = 0.0; /* When the next frame is due (arcade_time) */
+#if defined(ARCADE_XCB)
+    present_send(); /* The frame and its text are complete */
+#endif
+    if (pacing_requested == ARCADE_PACING_NONE || target_fps <= 0 || arcade_vsync())
+    {
+        next_frame = 0.0; /* Presentation (or nothing) paces the frames */
+        return;
+    }
+    double period = 1.0 / target_fps, now = arcade_time();
+    if (next_frame == 0.0 || now - next_frame > period)
+        next_frame = now; /* First frame, or too late to catch up */
+    next_frame += period;
+    double wait = next_frame - now;
+    if (wait <= 0.0)
+        return;
+#ifdef _WIN32
+    Sleep((DWORD)(wait * 1000.0));
+#else
+    usleep((useconds_t)(wait * 1e6));
+#endif
+}
+
+void arcade_set_worker_threads(int count)
+{
+    worker_threads = count > 0 ? count : 0;
+}
+
+void arcade_set_image_cache_budget(size_t bytes)
+{
+    image_cache_budget = bytes;
+}
+
+void arcade_set_profile(int enable)
+{
+    frame_profile.enabled = enable;
+    frame_profile.last = 0.0;
+}
+
+#define JSON_MAX_DEPTH 32 /* Deepest nesting json_skip follows (bounds its recursion) */
+
+/* Skips JSON whitespace */
+static const char *json_space(const char *p)
+{
+    while (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
+        p++;
+    return p;
+}
+
+/* Reads the string at p into out (truncated to size, escapes reduced to the
+ * escaped character); returns the text after it, or NULL if malformed */
+static const char *json_string(const char *p, char *out, size_t size)
+{
+    size_t n = 0;
+    if (*p++ != '"')
+        return NULL;
+    while (*p != '"')
+    {
+        if (*p == '\0')
+            return NULL;
+        if (*p == '\\' && *++p == '\0')
+            return NULL;
+        if (n + 1 < size)
+            out[n++] = *p;
+        p++;
+    }
+    if (size)
+        out[n] = '\0';
+    return p + 1;
+}
+
+/* Skips the value at p, nested depth deep; returns the text after it, or
+ * NULL if malformed or nested past JSON_MAX_DEPTH */
+static const char *json_skip(const char *p, int depth)
+{
+    p = json_space(p);
+    if (*p == '"')
+        return json_string(p, NULL, 0);
+    if (*p == '{' || *p == '[')
+    {
+        if (depth >= JSON_MAX_DEPTH)
+            return NULL;
+        char close = *p == '{' ? '}' : ']';
+        p = json_space(p + 1);
+        if (*p == close)
+            return p + 1;
+        for (;;)
+        {
+            if (close == '}')
+            {
+                p = json_string(json_space(p), NULL, 0);
+                if (!p || *(p = json_space(p)) != ':')
+                    return NULL;
+                p++;
+            }
+            if (!(p = json_skip(p, depth + 1)))
+                return NULL;
+            p = json_space(p);
+            if (*p == close)
+                return p + 1;
+            if (*p++ != ',')
+                return NULL;
+        }
+    }
+    /* Number, true, false or null */
+    const char *start = p;
+    while (*p && !strchr(" \t\r\n,]}", *p))
+        p++;
+    return p > start ? p : NULL;
+}
+
+/* Applies one setting; value is the text of a string, number or literal */
+static void config_set(const char *source, const char *key, const char *value)
+{
+    static const char *const pacings[] = {"vsync", "sleep", "none"};
+    static const char *const formats[] = {"auto", "xrgb8888", "rgb565"};
+    static const char *const filters[] = {"smooth", "linear", "point"};
+    char *end;
+    long number = strtol(value, &end, 10);
+    int is_number = *value && *end == '\0' && number >= 0;
+    int known = 1, valid = 1;
+    if (strcmp(key, "target_fps") == 0)
+    {
+        if ((valid = is_number))
+            arcade_set_target_fps((int)number);
+    }
+    else if (strcmp(key, "pacing") == 0 || strcmp(key, "pixel_format") == 0 || strcmp(key, "image_filter") == 0)
+    {
+        const char *const *names = strcmp(key, "pacing") == 0 ? pacings : strcmp(key, "pixel_format") == 0 ? formats : filters;
+        int i = 0;
+        while (i < 3 && strcmp(value, names[i]) != 0)
+            i++;
+        if ((valid = i < 3))
+        {
+            if (names == pacings)
+                arcade_set_pacing(i);
+            else if (names == formats)
+                arcade_set_pixel_format(i);
+            else
+                arcade_set_image_filter(i);
+        }
+    }
+    else if (strcmp(key, "backend") == 0)
+    {
+        if (strcmp(value, "software") == 0 || strcmp(value, "xlib") == 0)
+            arcade_set_backend(ARCADE_BACKEND_SOFTWARE);
+        else if (strcmp(value, "xrender") == 0)
+            arcade_set_backend(ARCADE_BACKEND_XRENDER);
+        else
+            valid = 0;
+    }
+    else if (strcmp(key, "worker_threads") == 0)
+    {
+        if ((valid = is_number))
+            arcade_set_worker_threads((int)number);
+    }
+    else if (strcmp(key, "image_cache_mb") == 0)
+    {
+        if ((valid = is_number))
+            arcade_set_image_cache_budget((size_t)number << 20);
+    }
+    else if (strcmp(key, "log_level") == 0)
+    {
+        int i = ARCADE_LOG_DEBUG;
+        while (i <= ARCADE_LOG_ERROR && strcmp(value, log_level_names[i]) != 0)
+            i++;
+        if ((valid = i <= ARCADE_LOG_ERROR))
+            arcade_set_log_level(i);
+    }
+    else if (strcmp(key, "profile") == 0 || strcmp(key, "asset_cache") == 0)
+    {
+        void (*set)(int) = strcmp(key, "profile") == 0 ? arcade_set_profile : arcade_set_asset_cache;
+        if (strcmp(value, "true") == 0 || strcmp(value, "1") == 0)
+            set(1);
+        else if (strcmp(value, "false") == 0 || strcmp(value, "0") == 0)
+            set(0);
+        else
+            valid = 0;
+    }
+    else
+        known = 0;
+    if (!known)
+        fprintf(stderr, "%s: unknown performance setting %s\n", source, key);
+    else if (!valid)
+        fprintf(stderr, "%s: invalid %s \"%s\"\n", source, key, value);
+}
+
+/* Applies the settings of the performance object at p; returns the text
+ * after it, or NULL if malformed */
+static const char *config_section(const char *path, const char *p)
+{
+    p = json_space(p);
+    if (*p != '{')
+        return json_skip(p, 1); /* Not an object: nothing to apply */
+    p = json_space(p + 1);
+    if (*p == '}')
+        return p + 1;
+    for (;;)
+    {
+        char key[64], value[64];
+        if (!(p = json_string(json_space(p), key, sizeof(key))) || *(p = json_space(p)) != ':')
+            return NULL;
+        p = json_space(p + 1);
+        const char *end = json_skip(p, 2);
+        if (!end)
+            return NULL;
+        if (*p == '"')
+            json_string(p, value, sizeof(value));
+        else
+        {
+            size_t n = (size_t)(end - p) < sizeof(value) - 1 ? (size_t)(end - p) : sizeof(value) - 1;
+            memcpy(value, p, n);
+            value[n] = '\0';
+        }
+        config_set(path, key, value);
+        p = json_space(end);
+        if (*p == '}')
+            return p + 1;
+        if (*p++ != ',')
+            return NULL;
+    }
+}
+
+/* Reads path and applies its performance section; returns 0 on success,
+ * 1 if it cannot be read, 2 if it is not valid JSON */
+static int config_file(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return 1;
+    char *text = NULL;
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0 && (size = ftell(file)) >= 0 && fseek(file, 0, SEEK_SET) == 0)
+        text = arcade_alloc((size_t)size + 1, 0);
+    int ok = text && fread(text, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+    if (!ok)
+    {
+        arcade_free(text);
+        return 1;
+    }
+    text[size] = '\0';
+
+    const char *p = json_space(text);
+    ok = *p == '{';
+    p = ok ? json_space(p + 1) : NULL;
+    if (ok && *p == '}')
+        p = NULL; /* Empty object */
+    while (ok && p)
+    {
+        char key[64];
+        if (!(p = json_string(json_space(p), key, sizeof(key))) || *(p = json_space(p)) != ':')
+            ok = 0;
+        else if (!(p = strcmp(key, "performance") == 0 ? config_section(path, p + 1) : json_skip(p + 1, 1)))
+            ok = 0;
+        else if (*(p = json_space(p)) == '}')
+            p = NULL;
+        else if (*p++ != ',')
+            ok = 0;
+    }
+    arcade_free(text);
+    if (!ok)
+        fprintf(stderr, "%s: not valid JSON; settings after the error are ignored\n", path);
+    return ok ? 0 : 2;
+}
+
+int arcade_load_config(const char *path)
+{
+    static const char *const keys[] = {"target_fps", "pacing", "backend", "pixel_format",
+                                       "worker_threads", "image_cache_mb", "asset_cache", "profile",
+                                       "log_level", "image_filter"};
+    int result = path ? config_file(path) : 1;
+    config_loaded = 1;
+
+    /* ARCADE_<SETTING> overrides the file */
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++)
+    {
+        char name[32] = "ARCADE_";
+        for (size_t n = 0; keys[i][n]; n++)
+            name[7 + n] = (char)(keys[i][n] - ('a' <= keys[i][n] && keys[i][n] <= 'z' ? 'a' - 'A' : 0));
+        const char *value = getenv(name);
+        if (value && *value)
+            config_set(name, keys[i], value);
+    }
+    return result;
+}
+
+#endif /* ARCADE_IMPLEMENTATION */
\ No newline at end of file
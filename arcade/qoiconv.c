@@ -0,0 +1,257 @@
+/* =========================================================================
+ * QOI Converter - Documentation
+ * =========================================================================
+ * Converts sprite images to QOI, which the library usually decodes several
+ * times faster than PNG, and compares the load times of the two formats on
+ * the same images.
+ *
+ * Usage:
+ *   qoiconv convert sprite.png ...   Writes sprite.qoi next to each image
+ *                                    that loads faster as QOI
+ *   qoiconv bench sprite.png ...     Loads each image and its .qoi, checks
+ *                                    they hold the same pixels and reports
+ *                                    the time per load
+ *
+ * Compilation:
+ * With make, in this directory:
+ *   make qoi            Converts every game's assets/sprites/*.png
+ *   make bench-images   Converts them, then benchmarks PNG against QOI
+ * Or by hand (headless: no window system needed):
+ *   gcc -O3 -o qoiconv qoiconv.c -lm -lpthread
+ *
+ * Notes:
+ * - Images without transparency are written with 3 channels.
+ * - QOI loses to PNG on some images (rows that repeat, like the pipes, which
+ *   PNG's filters shrink to almost nothing): convert times both and removes
+ *   the .qoi unless it loads QOI_MIN_SPEEDUP times faster, so the game keeps
+ *   using the PNG.
+ * - Loads go through the library's own image loader (QOI by header,
+ *   anything else through stb_image), as arcade_create_image_sprite does.
+ * ========================================================================= */
+
+#define ARCADE_HEADLESS
+#define ARCADE_IMPLEMENTATION
+#include "arcade.h"
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#define BENCH_SECONDS 0.2    /* Time spent loading each file in each format */
+#define BENCH_ROUNDS 5       /* Rounds it is split into; the fastest counts */
+#define QOI_MIN_SPEEDUP 1.25 /* Speedup a .qoi needs over its source to be kept */
+
+/* Encodes RGBA bytes as QOI (arcade_alloc); returns NULL if out of memory */
+static unsigned char *qoi_encode(const unsigned char *pixels, int width, int height, size_t *size)
+{
+    size_t count = (size_t)width * height;
+    int channels = 3;
+    for (size_t i = 0; i < count && channels == 3; i++)
+        channels = pixels[i * 4 + 3] == 255 ? 3 : 4;
+
+    unsigned char *out = arcade_alloc(14 + count * 5 + 8, 0); /* Worst case: QOI_OP_RGBA each */
+    if (!out)
+        return NULL;
+    size_t p = 0;
+    memcpy(out, "qoif", 4);
+    for (int i = 0; i < 4; i++)
+    {
+        out[4 + i] = (unsigned char)((uint32_t)width >> (24 - 8 * i));
+        out[8 + i] = (unsigned char)((uint32_t)height >> (24 - 8 * i));
+    }
+    out[12] = (unsigned char)channels;
+    out[13] = 0; /* sRGB with linear alpha */
+    p = 14;
+
+    unsigned char seen[64][4] = {{0}};
+    unsigned char prev[4] = {0, 0, 0, 255};
+    int run = 0;
+    for (size_t i = 0; i < count; i++)
+    {
+        const unsigned char *px = pixels + i * 4;
+        if (memcmp(px, prev, 4) == 0)
+        {
+            if (++run == 62 || i == count - 1)
+            {
+                out[p++] = (unsigned char)(0xC0 | (run - 1)); /* QOI_OP_RUN */
+                run = 0;
+            }
+            continue;
+        }
+        if (run)
+        {
+            out[p++] = (unsigned char)(0xC0 | (run - 1));
+            run = 0;
+        }
+        int hash = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) & 63;
+        if (memcmp(seen[hash], px, 4) == 0)
+            out[p++] = (unsigned char)hash; /* QOI_OP_INDEX */
+        else if (px[3] != prev[3])
+        {
+            out[p++] = 0xFF; /* QOI_OP_RGBA */
+            memcpy(out + p, px, 4);
+            p += 4;
+        }
+        else
+        {
+            signed char dr = (signed char)(px[0] - prev[0]), dg = (signed char)(px[1] - prev[1]), db = (signed char)(px[2] - prev[2]);
+            signed char dr_dg = (signed char)(dr - dg), db_dg = (signed char)(db - dg);
+            if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+                out[p++] = (unsigned char)(0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)); /* QOI_OP_DIFF */
+            else if (dg >= -32 && dg <= 31 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7)
+            {
+                out[p++] = (unsigned char)(0x80 | (dg + 32)); /* QOI_OP_LUMA */
+                out[p++] = (unsigned char)((dr_dg + 8) << 4 | (db_dg + 8));
+            }
+            else
+            {
+                out[p++] = 0xFE; /* QOI_OP_RGB */
+                memcpy(out + p, px, 3);
+                p += 3;
+            }
+        }
+        memcpy(seen[hash], px, 4);
+        memcpy(prev, px, 4);
+    }
+    memcpy(out + p, "\0\0\0\0\0\0\0\1", 8);
+    *size = p + 8;
+    return out;
+}
+
+/* path with its extension replaced by .qoi */
+static void qoi_path(const char *path, char *out, size_t size)
+{
+    const char *dot = strrchr(path, '.');
+    const char *slash = strrchr(path, '/');
+    size_t stem = dot && (!slash || dot > slash) ? (size_t)(dot - path) : strlen(path);
+    snprintf(out, size, "%.*s.qoi", (int)stem, path);
+}
+
+static long file_size(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    long size = -1;
+    if (file && fseek(file, 0, SEEK_END) == 0)
+        size = ftell(file);
+    if (file)
+        fclose(file);
+    return size;
+}
+
+/* Seconds per image_load of path: the best of BENCH_ROUNDS rounds of
+ * loads, which together take about BENCH_SECONDS */
+static double time_load(const char *path)
+{
+    double best = 0.0;
+    int width, height;
+    for (int round = 0; round < BENCH_ROUNDS; round++)
+    {
+        int loads = 0;
+        double start = arcade_time(), now = start;
+        while (now - start < BENCH_SECONDS / BENCH_ROUNDS || loads < 3)
+        {
+            stbi_image_free(image_load(path, &width, &height));
+            loads++;
+            now = arcade_time();
+        }
+        if (round == 0 || (now - start) / loads < best)
+            best = (now - start) / loads;
+    }
+    return best;
+}
+
+static int convert(const char *path)
+{
+    char out_path[1024];
+    int width, height;
+    unsigned char *pixels = image_load(path, &width, &height);
+    if (!pixels)
+    {
+        fprintf(stderr, "Cannot load %s\n", path);
+        return 1;
+    }
+    size_t size;
+    unsigned char *qoi = qoi_encode(pixels, width, height, &size);
+    stbi_image_free(pixels);
+    qoi_path(path, out_path, sizeof(out_path));
+    FILE *file = qoi ? fopen(out_path, "wb") : NULL;
+    int failed = !file || fwrite(qoi, 1, size, file) != size;
+    if (file && fclose(file) != 0)
+        failed = 1;
+    arcade_free(qoi);
+    if (failed)
+    {
+        fprintf(stderr, "Cannot write %s\n", out_path);
+        return 1;
+    }
+    double speedup = time_load(path) / time_load(out_path);
+    if (speedup < QOI_MIN_SPEEDUP)
+    {
+        remove(out_path);
+        printf("%s: kept (QOI loads %.1fx as fast)\n", path, speedup);
+        return 0;
+    }
+    printf("%s -> %s (%ld -> %zu bytes, %.1fx faster)\n", path, out_path, file_size(path), size, speedup);
+    return 0;
+}
+
+static int bench(char **paths, int count)
+{
+    double total_source = 0.0, total_qoi = 0.0;
+    long bytes_source = 0, bytes_qoi = 0;
+    int failed = 0;
+    printf("%-48s %9s %9s %10s %10s %7s\n", "image", "bytes", "qoi", "load us", "qoi us", "faster");
+    for (int i = 0; i < count; i++)
+    {
+        char path_qoi[1024];
+        qoi_path(paths[i], path_qoi, sizeof(path_qoi));
+        if (file_size(path_qoi) < 0)
+        {
+            printf("%-48s %9ld %9s\n", paths[i], file_size(paths[i]), "kept");
+            continue;
+        }
+        int w1, h1, w2, h2;
+        unsigned char *a = image_load(paths[i], &w1, &h1), *b = image_load(path_qoi, &w2, &h2);
+        int same = a && b && w1 == w2 && h1 == h2 && memcmp(a, b, (size_t)w1 * h1 * 4) == 0;
+        stbi_image_free(a);
+        stbi_image_free(b);
+        if (!same)
+        {
+            fprintf(stderr, "%s: %s is missing or differs (run convert first)\n", paths[i], path_qoi);
+            failed = 1;
+            continue;
+        }
+        double t_source = time_load(paths[i]), t_qoi = time_load(path_qoi);
+        long s_source = file_size(paths[i]), s_qoi = file_size(path_qoi);
+        printf("%-48s %9ld %9ld %10.1f %10.1f %6.1fx\n", paths[i], s_source, s_qoi, t_source * 1e6, t_qoi * 1e6,
+               t_source / t_qoi);
+        total_source += t_source;
+        total_qoi += t_qoi;
+        bytes_source += s_source;
+        bytes_qoi += s_qoi;
+    }
+    if (total_qoi > 0.0)
+        printf("%-48s %9ld %9ld %10.1f %10.1f %6.1fx\n", "all", bytes_source, bytes_qoi, total_source * 1e6,
+               total_qoi * 1e6, total_source / total_qoi);
+    return failed;
+}
+
+int main(int argc, char **argv)
+{
+#if defined(__GLIBC__)
+    /* glibc raises its mmap threshold as large blocks are freed, which makes
+     * later loads skip the page faults a game's first load pays, by different
+     * amounts per format. A fixed threshold keeps timings comparable */
+    mallopt(M_MMAP_THRESHOLD, 128 * 1024);
+#endif
+    if (argc < 3 || (strcmp(argv[1], "convert") != 0 && strcmp(argv[1], "bench") != 0))
+    {
+        fprintf(stderr, "Usage: %s convert|bench image...\n", argv[0]);
+        return 2;
+    }
+    if (strcmp(argv[1], "bench") == 0)
+        return bench(argv + 2, argc - 2);
+    int failed = 0;
+    for (int i = 2; i < argc; i++)
+        failed |= convert(argv[i]);
+    return failed;
+}
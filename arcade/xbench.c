@@ -0,0 +1,329 @@
+/* =========================================================================
+ * Window System Benchmark - Documentation
+ * =========================================================================
+ * Times the library's X11 backends against each other on a real or virtual
+ * X server (Xvfb), the same scene and the same frame count for each.
+ *
+ * Usage:
+ *   xbench render software|xrender [frames]
+ *       Draws a scene of a full-window background, 150 image sprites and 50
+ *       translucent rectangles every frame and reports the time per frame,
+ *       waiting for the server to finish each one. Needs the XRender build.
+ *   xbench startup
+ *       Times arcade_init up to the first frame on screen: opening the
+ *       display, creating the window and presenting one cleared frame.
+ *   xbench events [frames]
+ *       Times arcade_update alone, once with no events waiting and once with
+ *       16 key presses and releases sent to the window before each call.
+ *   xbench present [frames]
+ *       Shows frames at vertical blanks (XCB build, Present extension) and
+ *       reports the interval between completed frames, its jitter and the
+ *       vblanks skipped. Xvfb has no display, so its Present extension
+ *       fakes a vblank every 1/60 s; the intervals should sit at 16.7 ms.
+ *
+ * Compilation:
+ * With make, in this directory (runs everything under xvfb-run, from the
+ * xvfb package):
+ *   make bench-xrender   Software rendering against XRender
+ *   make bench-xcb       Startup and event cost of Xlib against XCB
+ *   make bench-present   Frame pacing at Xvfb's fake vblank
+ * Or by hand:
+ *   gcc -O3 -DARCADE_XRENDER -o xbench xbench.c -lX11 -lXrender -lm -lpthread
+ *   gcc -O3 -DARCADE_XCB -o xbench xbench.c -lxcb -lm -lpthread
+ *   xvfb-run -a -s "-screen 0 1024x768x24" ./xbench render xrender
+ *
+ * Notes:
+ * - Run from this directory: sprites come from ../SuperJumpAdventure.
+ * - Every frame ends with a round trip to the server (XSync), so the time
+ *   includes the server's drawing and not only sending the requests.
+ * - startup measures one window per process; bench-xcb runs it five times.
+ * ========================================================================= */
+
+#define ARCADE_IMPLEMENTATION
+#include "arcade.h"
+
+#define BENCH_WIDTH 800
+#define BENCH_HEIGHT 600
+#define BENCH_WARMUP 30      /* Frames drawn before timing (uploads, caches) */
+#define BENCH_FRAMES 300     /* Frames timed, unless given */
+#define BENCH_IMAGES 150     /* Image sprites in the render scene */
+#define BENCH_RECTS 50       /* Translucent rectangles in the render scene */
+#define BENCH_KEYS 16         /* Key presses (and releases) per frame in events */
+#define SPRITE_DIR "../SuperJumpAdventure/assets/sprites/"
+
+#if defined(ARCADE_XCB)
+#define BENCH_BACKEND "xcb"
+#else
+#define BENCH_BACKEND "xlib"
+#endif
+
+/* Waits until the X server has carried out every request sent so far */
+static void server_sync(void)
+{
+#if defined(ARCADE_XCB)
+    free(xcb_get_input_focus_reply(state.connection, xcb_get_input_focus(state.connection), NULL));
+#elif !defined(ARCADE_HEADLESS) && !defined(_WIN32)
+    XSync(state.display, False);
+#endif
+}
+
+/* =========================================================================
+ * Render: software rendering against XRender
+ * ========================================================================= */
+
+static int bench_render(const char *backend, int frames)
+{
+    static const char *const files[] = {"player-idle.qoi", "player-run-1.qoi", "enemy-run-1.qoi", "enemy-run-2.qoi",
+                                        "platform.qoi", "flag.qoi", "bullet.qoi"};
+    static ArcadeAnySprite sprites[1 + BENCH_IMAGES + BENCH_RECTS];
+    static int types[1 + BENCH_IMAGES + BENCH_RECTS];
+    ArcadeImageSprite images[7];
+    int xrender = strcmp(backend, "xrender") == 0;
+
+    arcade_set_backend(xrender ? ARCADE_BACKEND_XRENDER : ARCADE_BACKEND_SOFTWARE);
+    arcade_set_pacing(ARCADE_PACING_NONE);
+    if (arcade_init(BENCH_WIDTH, BENCH_HEIGHT, "xbench", 0x000000) != 0)
+    {
+        fprintf(stderr, "Cannot open a window (is DISPLAY set?)\n");
+        return 1;
+    }
+    if (xrender && arcade_backend() != ARCADE_BACKEND_XRENDER)
+    {
+        fprintf(stderr, "XRender is not available (build with -DARCADE_XRENDER, server with RENDER)\n");
+        arcade_quit();
+        return 1;
+    }
+
+    int count = 0;
+    ArcadeImageSprite background = arcade_create_image_sprite(0, 0, BENCH_WIDTH, BENCH_HEIGHT, SPRITE_DIR "background.qoi");
+    sprites[count] = (ArcadeAnySprite){.image_sprite = background};
+    types[count++] = SPRITE_IMAGE;
+    for (int i = 0; i < 7; i++)
+    {
+        char path[256];
+        snprintf(path, sizeof(path), SPRITE_DIR "%s", files[i]);
+        images[i] = arcade_create_image_sprite(0, 0, 48, 48, path);
+    }
+    for (int i = 0; i < 7 && background.pixels; i++)
+    {
+        if (!images[i].pixels)
+            background.pixels = NULL;
+    }
+    if (!background.pixels)
+    {
+        fprintf(stderr, "Cannot load the sprites in " SPRITE_DIR " (run from arcade/)\n");
+        arcade_quit();
+        return 1;
+    }
+    ArcadeRng rng;
+    arcade_rng_seed(&rng, 1);
+    for (int i = 0; i < BENCH_IMAGES; i++)
+    {
+        ArcadeImageSprite sprite = images[i % 7];
+        sprite.x = arcade_rng_float_range(&rng, 0.0f, BENCH_WIDTH - 48);
+        sprite.y = arcade_rng_float_range(&rng, 0.0f, BENCH_HEIGHT - 48);
+        sprite.vx = arcade_rng_float_range(&rng, -3.0f, 3.0f);
+        sprite.vy = arcade_rng_float_range(&rng, -3.0f, 3.0f);
+        sprites[count] = (ArcadeAnySprite){.image_sprite = sprite};
+        types[count++] = SPRITE_IMAGE;
+    }
+    for (int i = 0; i < BENCH_RECTS; i++)
+    {
+        ArcadeSprite rect = {arcade_rng_float_range(&rng, 0.0f, BENCH_WIDTH - 80), arcade_rng_float_range(&rng, 0.0f, BENCH_HEIGHT - 40),
+                             80.0f, 40.0f, arcade_rng_float_range(&rng, -2.0f, 2.0f), arcade_rng_float_range(&rng, -2.0f, 2.0f),
+                             0x80000000u | arcade_rng_next(&rng) >> 8, 1};
+        sprites[count] = (ArcadeAnySprite){.sprite = rect};
+        types[count++] = SPRITE_COLOR;
+    }
+
+    double start = 0.0;
+    for (int frame = 0; frame < BENCH_WARMUP + frames && arcade_update(); frame++)
+    {
+        if (frame == BENCH_WARMUP)
+            start = arcade_time();
+        for (int i = 1; i < count; i++)
+        {
+            /* Bounce every sprite off the window edges */
+            float *x = types[i] == SPRITE_IMAGE ? &sprites[i].image_sprite.x : &sprites[i].sprite.x;
+            float *y = types[i] == SPRITE_IMAGE ? &sprites[i].image_sprite.y : &sprites[i].sprite.y;
+            float *vx = types[i] == SPRITE_IMAGE ? &sprites[i].image_sprite.vx : &sprites[i].sprite.vx;
+            float *vy = types[i] == SPRITE_IMAGE ? &sprites[i].image_sprite.vy : &sprites[i].sprite.vy;
+            *x += *vx;
+            *y += *vy;
+            if (*x < 0.0f || *x > BENCH_WIDTH - 80)
+                *vx = -*vx;
+            if (*y < 0.0f || *y > BENCH_HEIGHT - 48)
+                *vy = -*vy;
+        }
+        arcade_render_scene(sprites, count, types);
+        server_sync();
+    }
+    double elapsed = arcade_time() - start;
+    printf("render %-8s %d sprites: %7.3f ms/frame (%6.1f fps)\n", backend, count, elapsed * 1000.0 / frames,
+           frames / elapsed);
+
+    for (int i = 0; i < 7; i++)
+        arcade_free_image_sprite(&images[i]);
+    arcade_free_image_sprite(&background);
+    arcade_quit();
+    return 0;
+}
+
+/* =========================================================================
+ * Startup and events: Xlib against XCB
+ * ========================================================================= */
+
+static int bench_startup(void)
+{
+    double start = arcade_time();
+    if (arcade_init(BENCH_WIDTH, BENCH_HEIGHT, "xbench", 0x000000) != 0)
+    {
+        fprintf(stderr, "Cannot open a window (is DISPLAY set?)\n");
+        return 1;
+    }
+    double init = arcade_time();
+    arcade_render_scene(NULL, 0, NULL);
+    server_sync();
+    double end = arcade_time();
+    printf("startup %-4s init %7.3f ms, first frame %7.3f ms, total %7.3f ms\n", BENCH_BACKEND,
+           (init - start) * 1000.0, (end - init) * 1000.0, (end - start) * 1000.0);
+    arcade_quit();
+    return 0;
+}
+
+/* Queues a press and a release of one key on the window, as the server
+ * would deliver them */
+static void send_key(int keycode)
+{
+#if defined(ARCADE_XCB)
+    xcb_key_press_event_t event = {0};
+    event.event = state.window;
+    event.detail = (xcb_keycode_t)keycode;
+    event.same_screen = 1;
+    event.response_type = XCB_KEY_PRESS;
+    xcb_send_event(state.connection, 0, state.window, XCB_EVENT_MASK_KEY_PRESS, (const char *)&event);
+    event.response_type = XCB_KEY_RELEASE;
+    xcb_send_event(state.connection, 0, state.window, XCB_EVENT_MASK_KEY_RELEASE, (const char *)&event);
+#else
+    XEvent event = {0};
+    event.xkey.display = state.display;
+    event.xkey.window = state.window;
+    event.xkey.keycode = (unsigned int)keycode;
+    event.xkey.same_screen = True;
+    event.xkey.type = KeyPress;
+    XSendEvent(state.display, state.window, False, KeyPressMask, &event);
+    event.xkey.type = KeyRelease;
+    XSendEvent(state.display, state.window, False, KeyReleaseMask, &event);
+#endif
+}
+
+static int bench_events(int frames)
+{
+    arcade_set_pacing(ARCADE_PACING_NONE);
+    if (arcade_init(BENCH_WIDTH, BENCH_HEIGHT, "xbench", 0x000000) != 0)
+    {
+        fprintf(stderr, "Cannot open a window (is DISPLAY set?)\n");
+        return 1;
+    }
+    for (int frame = 0; frame < BENCH_WARMUP; frame++)
+    {
+        arcade_update();
+        arcade_render_scene(NULL, 0, NULL);
+    }
+    server_sync();
+
+    for (int keys = 0; keys <= BENCH_KEYS; keys += BENCH_KEYS)
+    {
+        double elapsed = 0.0;
+        for (int frame = 0; frame < frames; frame++)
+        {
+            /* Keycodes 38 to 53 are letter keys on the usual keymaps */
+            for (int i = 0; i < keys; i++)
+                send_key(38 + i);
+            server_sync();
+            double start = arcade_time();
+            if (!arcade_update())
+                break;
+            elapsed += arcade_time() - start;
+        }
+        printf("events  %-4s %2d keys/frame: %7.2f us/update\n", BENCH_BACKEND, keys, elapsed * 1e6 / frames);
+    }
+    arcade_quit();
+    return 0;
+}
+
+/* =========================================================================
+ * Present: frame pacing at vertical blanks
+ * ========================================================================= */
+
+static int bench_present(int frames)
+{
+#if defined(ARCADE_XCB)
+    arcade_set_pacing(ARCADE_PACING_VSYNC);
+    if (arcade_init(BENCH_WIDTH, BENCH_HEIGHT, "xbench", 0x000000) != 0)
+    {
+        fprintf(stderr, "Cannot open a window (is DISPLAY set?)\n");
+        return 1;
+    }
+
+    double last_time = 0.0, sum = 0.0, sum_squares = 0.0, longest = 0.0;
+    uint64_t last_msc = 0, skipped = 0;
+    int intervals = 0;
+    for (int frame = 0; frame < BENCH_WARMUP + frames && arcade_update(); frame++)
+    {
+        /* A completed frame since the last update: time it against the one before */
+        if (state.present_msc != last_msc)
+        {
+            if (last_msc && frame > BENCH_WARMUP)
+            {
+                double interval = state.present_time - last_time;
+                sum += interval;
+                sum_squares += interval * interval;
+                longest = interval > longest ? interval : longest;
+                skipped += state.present_msc - last_msc - 1;
+                intervals++;
+            }
+            last_msc = state.present_msc;
+            last_time = state.present_time;
+        }
+        /* Text goes on the frame after it is presented, as in the games */
+        arcade_render_scene(NULL, 0, NULL);
+        arcade_render_text("xbench", 10.0f, 20.0f, 0xFFFFFF);
+        arcade_wait_frame();
+    }
+
+    if (!arcade_vsync() || intervals == 0)
+    {
+        fprintf(stderr, "No frames completed at vblanks (does the server have the Present extension?)\n");
+        arcade_quit();
+        return 1;
+    }
+    double mean = sum / intervals;
+    double variance = sum_squares / intervals - mean * mean;
+    printf("present %d frames: %6.2f ms mean, %5.2f ms jitter, %6.2f ms longest, %llu vblanks skipped\n", intervals,
+           mean * 1000.0, sqrt(variance > 0.0 ? variance : 0.0) * 1000.0, longest * 1000.0, (unsigned long long)skipped);
+    arcade_quit();
+    return 0;
+#else
+    (void)frames;
+    fprintf(stderr, "Frames are only shown at vblanks by the XCB build (-DARCADE_XCB)\n");
+    return 1;
+#endif
+}
+
+int main(int argc, char **argv)
+{
+    const char *count = argc >= 2 && strcmp(argv[1], "render") == 0 ? (argc > 3 ? argv[3] : NULL) : (argc > 2 ? argv[2] : NULL);
+    int frames = count ? atoi(count) : BENCH_FRAMES;
+    frames = frames > 0 ? frames : BENCH_FRAMES;
+    if (argc >= 3 && strcmp(argv[1], "render") == 0)
+        return bench_render(argv[2], frames);
+    if (argc >= 2 && strcmp(argv[1], "startup") == 0)
+        return bench_startup();
+    if (argc >= 2 && strcmp(argv[1], "events") == 0)
+        return bench_events(frames);
+    if (argc >= 2 && strcmp(argv[1], "present") == 0)
+        return bench_present(frames);
+    fprintf(stderr, "Usage: %s render software|xrender [frames] | startup | events [frames] | present [frames]\n", argv[0]);
+    return 2;
+}